@@ -1,13 +1,49 @@
+import contextlib
+import ctypes
 import mmap
 import os
+import shutil
+import subprocess
+import sys
 import tempfile
+import threading
+import time
 
 from memray import AllocatorType
 from memray import FileReader
-from memray import MemoryAllocator
 from memray import Tracker
+from memray._test import MemoryAllocator
+from memray._test import _cython_malloc_free_loop
+from memray._test import write_synthetic_capture
+from memray.reporters.flamegraph import FlameGraphReporter
+from memray.reporters.stats import StatsReporter
+from memray.reporters.summary import SummaryReporter
+from memray.reporters.table import TableReporter
+from memray.reporters.tree import TreeReporter
 
 MAX_ITERS = 100000
+ALLOCATIONS_PER_THREAD = 20000
+MULTITHREADED_EXTENSION = os.path.join(
+    os.path.dirname(__file__), "..", "tests", "integration", "multithreaded_extension"
+)
+# 100 million allocations make captures of a few GB.
+SYNTHETIC_ALLOCATIONS = int(
+    os.environ.get("MEMRAY_BENCHMARK_SYNTHETIC_ALLOCATIONS", 2_000_000)
+)
+LOADED_SHARED_OBJECTS = []
+
+
+def load_shared_objects(count):
+    """Load distinct copies of a shared object until *count* are loaded"""
+    import _ctypes
+
+    if not LOADED_SHARED_OBJECTS:
+        LOADED_SHARED_OBJECTS.append(tempfile.TemporaryDirectory())
+    directory = LOADED_SHARED_OBJECTS[0].name
+    while len(LOADED_SHARED_OBJECTS) <= count:
+        path = os.path.join(directory, f"copy{len(LOADED_SHARED_OBJECTS)}.so")
+        shutil.copyfile(_ctypes.__file__, path)
+        LOADED_SHARED_OBJECTS.append(ctypes.CDLL(path))
 
 
 class TracebackBenchmarks:
@@ -98,6 +134,157 @@ class AllocatorBenchmarks:
                     mmap_obj[0:100] = b"a" * 100
 
 
+class AllocationHotPathBenchmarks:
+    params = ([False, True], [False, True])
+    param_names = ["native_traces", "timestamps"]
+
+    def setup(self, native_traces, timestamps):
+        self.tempfile = tempfile.NamedTemporaryFile()
+
+    def time_malloc_free_loop(self, native_traces, timestamps):
+        os.unlink(self.tempfile.name)
+        with Tracker(
+            self.tempfile.name, native_traces=native_traces, timestamps=timestamps
+        ):
+            _cython_malloc_free_loop(1234, MAX_ITERS)
+
+
+class FrameRegistrationBenchmarks:
+    params = [1, 8]
+    param_names = ["threads"]
+
+    def setup(self, threads):
+        self.tempfile = tempfile.NamedTemporaryFile()
+        allocator = MemoryAllocator()
+        namespace = {"allocator": allocator}
+        self.functions = []
+        for thread in range(threads):
+            source = "".join(
+                f"def func_{thread}_{index}():\n"
+                f"    allocator.valloc(1234)\n"
+                f"    allocator.free()\n"
+                for index in range(1000)
+            )
+            exec(source, namespace)
+            self.functions.append(
+                [namespace[f"func_{thread}_{index}"] for index in range(1000)]
+            )
+
+    def time_register_distinct_frames(self, threads):
+        def call_all(functions):
+            for function in functions:
+                function()
+
+        os.unlink(self.tempfile.name)
+        with Tracker(self.tempfile.name):
+            workers = [
+                threading.Thread(target=call_all, args=(functions,))
+                for functions in self.functions
+            ]
+            for worker in workers:
+                worker.start()
+            for worker in workers:
+                worker.join()
+
+
+class MultithreadedTrackingBenchmarks:
+    """Allocation throughput of concurrent threads while tracking
+
+    Every thread makes the same number of allocations, so the throughput grows
+    linearly with the number of threads unless the tracker serializes them.
+    """
+
+    params = ([1, 2, 4, 8, 16], [False, True], [False, True])
+    param_names = ["threads", "native_traces", "trace_python_allocators"]
+    unit = "allocations/s"
+
+    def setup_cache(self):
+        extension_path = os.path.abspath("multithreaded_extension")
+        shutil.copytree(MULTITHREADED_EXTENSION, extension_path)
+        subprocess.run(
+            [sys.executable, "setup.py", "build_ext", "--inplace"],
+            check=True,
+            cwd=extension_path,
+            capture_output=True,
+        )
+        return extension_path
+
+    def setup(self, extension_path, threads, native_traces, trace_python_allocators):
+        if extension_path not in sys.path:
+            sys.path.append(extension_path)
+        import testext
+
+        self.testext = testext
+        self.tempfile = tempfile.NamedTemporaryFile()
+        os.unlink(self.tempfile.name)
+
+    def _throughput(self, workload, threads, native_traces, trace_python_allocators):
+        with Tracker(
+            self.tempfile.name,
+            native_traces=native_traces,
+            trace_python_allocators=trace_python_allocators,
+        ):
+            start = time.perf_counter()
+            workload()
+            elapsed = time.perf_counter() - start
+        return threads * ALLOCATIONS_PER_THREAD / elapsed
+
+    def track_python_threads(
+        self, extension_path, threads, native_traces, trace_python_allocators
+    ):
+        """Python threads allocating through MemoryAllocator, holding the GIL"""
+        start = threading.Barrier(threads)
+
+        def allocate():
+            allocator = MemoryAllocator()
+            start.wait()
+            for _ in range(ALLOCATIONS_PER_THREAD):
+                allocator.malloc(1234)
+                allocator.free()
+
+        def workload():
+            workers = [threading.Thread(target=allocate) for _ in range(threads)]
+            for worker in workers:
+                worker.start()
+            for worker in workers:
+                worker.join()
+
+        return self._throughput(
+            workload, threads, native_traces, trace_python_allocators
+        )
+
+    def track_native_threads(
+        self, extension_path, threads, native_traces, trace_python_allocators
+    ):
+        """Threads created by an extension module, without the GIL"""
+
+        def workload():
+            self.testext.allocate_in_threads(threads, ALLOCATIONS_PER_THREAD)
+
+        return self._throughput(
+            workload, threads, native_traces, trace_python_allocators
+        )
+
+
+class StartupBenchmarks:
+    params = [0, 300]
+    param_names = ["extra_shared_objects"]
+
+    def setup(self, extra_shared_objects):
+        self.tempfile = tempfile.NamedTemporaryFile()
+        load_shared_objects(extra_shared_objects)
+
+    def time_tracker_startup(self, extra_shared_objects):
+        os.unlink(self.tempfile.name)
+        with Tracker(self.tempfile.name):
+            pass
+
+    def time_tracker_startup_with_native_traces(self, extra_shared_objects):
+        os.unlink(self.tempfile.name)
+        with Tracker(self.tempfile.name, native_traces=True):
+            pass
+
+
 class ParserBenchmarks:
     def setup(self):
         self.tempfile = tempfile.NamedTemporaryFile()
@@ -145,3 +332,93 @@ class HighWatermarkBenchmarks:
                 merge_threads=False
             )
         )
+
+
+class SyntheticCaptureBenchmarks:
+    """Read big synthetic captures with FileReader and every reporter"""
+
+    params = [False, True]
+    param_names = ["native_traces"]
+    timeout = 3600
+
+    def setup_cache(self):
+        captures = {}
+        for native_traces in self.params:
+            captures[native_traces] = os.path.abspath(f"synthetic-{native_traces}.bin")
+            write_synthetic_capture(
+                captures[native_traces],
+                allocations=SYNTHETIC_ALLOCATIONS,
+                threads=8,
+                leak_fraction=0.001,
+                native_traces=native_traces,
+                dlopen_churn=100 if native_traces else 0,
+            )
+        return captures
+
+    def setup(self, captures, native_traces):
+        self.reader = FileReader(captures[native_traces])
+        self.output = open(os.devnull, "w")
+
+    def teardown(self, captures, native_traces):
+        self.output.close()
+
+    def time_all_allocation_records(self, captures, native_traces):
+        for _ in self.reader.get_allocation_records():
+            pass
+
+    def time_high_watermark_records(self, captures, native_traces):
+        list(self.reader.get_high_watermark_allocation_records(merge_threads=False))
+
+    def time_leaked_records(self, captures, native_traces):
+        list(self.reader.get_leaked_allocation_records(merge_threads=False))
+
+    def time_memory_records(self, captures, native_traces):
+        list(self.reader.get_memory_records())
+
+    def time_flamegraph_reporter(self, captures, native_traces):
+        reporter = FlameGraphReporter.from_snapshot(
+            self.reader.get_high_watermark_allocation_records(merge_threads=False),
+            memory_records=tuple(self.reader.get_memory_records()),
+            native_traces=native_traces,
+        )
+        reporter.render(
+            outfile=self.output,
+            metadata=self.reader.metadata,
+            show_memory_leaks=False,
+            merge_threads=False,
+        )
+
+    def time_table_reporter(self, captures, native_traces):
+        reporter = TableReporter.from_snapshot(
+            self.reader.get_high_watermark_allocation_records(merge_threads=True),
+            memory_records=tuple(self.reader.get_memory_records()),
+            native_traces=native_traces,
+        )
+        reporter.render(
+            outfile=self.output,
+            metadata=self.reader.metadata,
+            show_memory_leaks=False,
+        )
+
+    def time_tree_reporter(self, captures, native_traces):
+        reporter = TreeReporter.from_snapshot(
+            self.reader.get_high_watermark_allocation_records(merge_threads=False),
+            native_traces=native_traces,
+        )
+        reporter.render(file=self.output)
+
+    def time_summary_reporter(self, captures, native_traces):
+        reporter = SummaryReporter.from_snapshot(
+            self.reader.get_high_watermark_allocation_records(merge_threads=True),
+            native=native_traces,
+        )
+        reporter.render(sort_column=1, file=self.output)
+
+    def time_stats_reporter(self, captures, native_traces):
+        reporter = StatsReporter.from_snapshot(
+            self.reader.get_high_watermark_allocation_records(merge_threads=True),
+            num_largest=5,
+            metadata=self.reader.metadata,
+        )
+        with contextlib.redirect_stdout(self.output):
+            reporter.render(file=self.output)
@@ -0,0 +1,102 @@
+"""Write a synthetic capture file, to benchmark the reader and the reporters.
+
+The capture is generated from a model of a tracked process instead of by
+running one, so it can have any size. For example, this writes a capture of a
+few GB with native traces, where shared objects are loaded and unloaded a
+thousand times:
+
+    python benchmarks/generate_capture.py big.bin --allocations 100000000 \\
+        --native-traces --dlopen-churn 1000
+"""
+import argparse
+import os
+import time
+
+from memray._test import write_synthetic_capture
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("output", help="Capture file to write")
+    parser.add_argument(
+        "--allocations", type=int, default=1_000_000, help="Number of allocations"
+    )
+    parser.add_argument("--threads", type=int, default=4, help="Number of threads")
+    parser.add_argument(
+        "--functions", type=int, default=500, help="Number of distinct Python functions"
+    )
+    parser.add_argument(
+        "--mean-stack-depth",
+        type=float,
+        default=15,
+        help="Mean depth of the Python stacks, which follow a Poisson distribution",
+    )
+    parser.add_argument(
+        "--max-stack-depth", type=int, default=30, help="Maximum Python stack depth"
+    )
+    parser.add_argument(
+        "--min-size", type=int, default=16, help="Smallest allocation, in bytes"
+    )
+    parser.add_argument(
+        "--max-size", type=int, default=65536, help="Biggest allocation, in bytes"
+    )
+    parser.add_argument(
+        "--mean-lifetime",
+        type=float,
+        default=10_000,
+        help="Mean number of allocations made before an allocation is freed",
+    )
+    parser.add_argument(
+        "--leak-fraction",
+        type=float,
+        default=0,
+        help="Fraction of the allocations that are never freed",
+    )
+    parser.add_argument(
+        "--mmap-fraction",
+        type=float,
+        default=0.01,
+        help="Fraction of the allocations made with mmap instead of malloc",
+    )
+    parser.add_argument(
+        "--native-traces", action="store_true", help="Record native stacks"
+    )
+    parser.add_argument(
+        "--dlopen-churn",
+        type=int,
+        default=0,
+        help="Number of times a shared object is unloaded and loaded back "
+        "(needs --native-traces)",
+    )
+    parser.add_argument("--seed", type=int, default=42, help="Random seed")
+    args = parser.parse_args()
+
+    start = time.perf_counter()
+    records = write_synthetic_capture(
+        args.output,
+        allocations=args.allocations,
+        threads=args.threads,
+        functions=args.functions,
+        mean_stack_depth=args.mean_stack_depth,
+        max_stack_depth=args.max_stack_depth,
+        min_size=args.min_size,
+        max_size=args.max_size,
+        mean_lifetime=args.mean_lifetime,
+        leak_fraction=args.leak_fraction,
+        mmap_fraction=args.mmap_fraction,
+        native_traces=args.native_traces,
+        dlopen_churn=args.dlopen_churn,
+        seed=args.seed,
+    )
+    elapsed = time.perf_counter() - start
+    size = os.path.getsize(args.output)
+    print(
+        f"Wrote {records} records ({size / 2**20:.1f} MiB) "
+        f"to {args.output} in {elapsed:.1f}s"
+    )
+
+
+if __name__ == "__main__":
+    main()
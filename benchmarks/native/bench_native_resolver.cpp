@@ -0,0 +1,123 @@
+#include <climits>
+#include <link.h>
+#include <unistd.h>
+
+#include "benchmark.h"
+#include "native_resolver.h"
+
+namespace memray::benchmarks {
+
+using namespace memray::tracking_api;
+using native_resolver::SymbolResolver;
+
+namespace {  // unnamed
+
+const size_t INSTRUCTION_POINTERS = 2000;
+
+struct ExecutableText
+{
+    std::string filename;
+    uintptr_t base{0};
+    std::vector<Segment> segments;
+    uintptr_t text_start{0};
+    uintptr_t text_end{0};
+};
+
+int
+findExecutable(struct dl_phdr_info* info, size_t, void* data)
+{
+    // The executable is the first object, and the only one without a name.
+    auto* executable = static_cast<ExecutableText*>(data);
+    executable->base = info->dlpi_addr;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type != PT_LOAD) {
+            continue;
+        }
+        executable->segments.push_back(Segment{phdr.p_vaddr, phdr.p_memsz});
+        if (phdr.p_flags & PF_X) {
+            executable->text_start = info->dlpi_addr + phdr.p_vaddr;
+            executable->text_end = executable->text_start + phdr.p_memsz;
+        }
+    }
+    return 1;
+}
+
+bool
+executableText(ExecutableText* executable)
+{
+    char path[PATH_MAX + 1];
+    ssize_t len = readlink("/proc/self/exe", path, PATH_MAX);
+    if (len <= 0) {
+        return false;
+    }
+    executable->filename.assign(path, len);
+    dl_iterate_phdr(&findExecutable, executable);
+    return executable->text_end > executable->text_start;
+}
+
+// Instruction pointers spread evenly over the benchmark's own code, which
+// has symbols and debug information like a typical extension module.
+std::vector<uintptr_t>
+instructionPointers(const ExecutableText& executable)
+{
+    std::vector<uintptr_t> ips;
+    uintptr_t step = (executable.text_end - executable.text_start) / INSTRUCTION_POINTERS;
+    for (size_t i = 0; i < INSTRUCTION_POINTERS; ++i) {
+        ips.push_back(executable.text_start + i * step + 1);
+    }
+    return ips;
+}
+
+void
+resolve(State& state, bool cached)
+{
+    ExecutableText executable;
+    if (!executableText(&executable)) {
+        state.skip("the benchmark's own code could not be found");
+        return;
+    }
+    auto ips = instructionPointers(executable);
+
+    SymbolResolver resolver;
+    resolver.startNewSegmentGeneration();
+    resolver.addSegments(executable.filename, executable.base, executable.segments);
+    if (cached) {
+        for (auto ip : ips) {
+            resolver.resolve(ip, resolver.currentSegmentGeneration());
+        }
+    }
+
+    while (state.keepRunning()) {
+        if (!cached) {
+            // A new generation keeps the same segments and the debug
+            // information that was already loaded, but none of the frames
+            // that were resolved.
+            state.pauseTiming();
+            resolver.startNewSegmentGeneration();
+            state.resumeTiming();
+        }
+        for (auto ip : ips) {
+            resolver.resolve(ip, resolver.currentSegmentGeneration());
+        }
+    }
+    state.setItemsPerIteration(ips.size());
+}
+
+void
+symbol_resolver_uncached(State& state, const Options&)
+{
+    resolve(state, false);
+}
+MEMRAY_BENCHMARK(symbol_resolver_uncached);
+
+void
+symbol_resolver_cached(State& state, const Options&)
+{
+    resolve(state, true);
+}
+MEMRAY_BENCHMARK(symbol_resolver_cached);
+
+}  // unnamed namespace
+
+}  // namespace memray::benchmarks
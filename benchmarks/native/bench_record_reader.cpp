@@ -0,0 +1,67 @@
+#include <memory>
+#include <sys/stat.h>
+
+#include "benchmark.h"
+#include "record_reader.h"
+#include "source.h"
+
+namespace memray::benchmarks {
+
+using namespace memray::tracking_api;
+using api::RecordReader;
+
+namespace {  // unnamed
+
+void
+readCapture(State& state, const Options& options, bool native_traces, bool track_stacks)
+{
+    std::string file_name = benchmarkCapture(options, native_traces);
+    struct stat file_stat;
+    if (file_name.empty() || stat(file_name.c_str(), &file_stat) != 0) {
+        state.skip("the capture could not be written");
+        return;
+    }
+
+    // Each iteration reads the whole capture. Times and sizes are given per
+    // allocation record, which includes the cost of the other records.
+    size_t allocations = 0;
+    while (state.keepRunning()) {
+        allocations = 0;
+        RecordReader reader(std::make_unique<io::FileSource>(file_name), track_stacks);
+        RecordReader::RecordResult result;
+        while ((result = reader.nextRecord()) != RecordReader::RecordResult::END_OF_FILE) {
+            if (result == RecordReader::RecordResult::ERROR) {
+                state.skip("the capture could not be read");
+                return;
+            }
+            allocations += result == RecordReader::RecordResult::ALLOCATION_RECORD;
+        }
+    }
+    state.setItemsPerIteration(allocations);
+    state.setBytesPerIteration(file_stat.st_size);
+}
+
+void
+record_reader_python_stacks(State& state, const Options& options)
+{
+    readCapture(state, options, false, true);
+}
+MEMRAY_BENCHMARK(record_reader_python_stacks);
+
+void
+record_reader_native_stacks(State& state, const Options& options)
+{
+    readCapture(state, options, true, true);
+}
+MEMRAY_BENCHMARK(record_reader_native_stacks);
+
+void
+record_reader_without_stacks(State& state, const Options& options)
+{
+    readCapture(state, options, false, false);
+}
+MEMRAY_BENCHMARK(record_reader_without_stacks);
+
+}  // unnamed namespace
+
+}  // namespace memray::benchmarks
@@ -0,0 +1,152 @@
+#include <memory>
+#include <random>
+
+#include "benchmark.h"
+#include "record_writer.h"
+#include "sink.h"
+
+namespace memray::benchmarks {
+
+using namespace memray::tracking_api;
+
+namespace {  // unnamed
+
+const size_t RECORDS_PER_ITERATION = 100000;
+
+// Counts the bytes written to it and throws them away, so that the benchmarks
+// measure the encoding without any I/O.
+class CountingSink : public io::Sink
+{
+  public:
+    explicit CountingSink(size_t* bytes)
+    : d_bytes(bytes)
+    {
+    }
+
+    bool writeAll(const char*, size_t length) override
+    {
+        *d_bytes += length;
+        return true;
+    }
+
+    bool seek(off_t, int) override
+    {
+        return true;
+    }
+
+    std::unique_ptr<io::Sink> cloneInChildProcess() override
+    {
+        return std::make_unique<CountingSink>(d_bytes);
+    }
+
+  private:
+    size_t* d_bytes;
+};
+
+// Addresses and sizes that look like the ones of a real heap, so that the
+// delta and varint encodings see realistic values.
+std::vector<AllocationRecord>
+heapRecords(size_t count)
+{
+    std::mt19937_64 random(42);
+    std::vector<AllocationRecord> records;
+    records.reserve(count);
+    std::vector<uintptr_t> live;
+    for (size_t i = 0; i < count; ++i) {
+        if (!live.empty() && random() % 2) {
+            size_t index = random() % live.size();
+            records.push_back({live[index], 0, hooks::Allocator::FREE});
+            live[index] = live.back();
+            live.pop_back();
+        } else {
+            uintptr_t address = 0x55d4a0000000 + (random() % (1 << 26)) * 16;
+            records.push_back({address, 16 + random() % 4096, hooks::Allocator::MALLOC});
+            live.push_back(address);
+        }
+    }
+    return records;
+}
+
+void
+writeAllocations(State& state, unsigned int threads, bool timestamps = false)
+{
+    size_t bytes = 0;
+    RecordWriter writer(std::make_unique<CountingSink>(&bytes), "benchmark", false, timestamps);
+    auto records = heapRecords(RECORDS_PER_ITERATION);
+
+    size_t bytes_at_start = bytes;
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < records.size(); ++i) {
+            writer.writeThreadSpecificRecord(1 + i % threads, records[i]);
+        }
+    }
+    state.setItemsPerIteration(records.size());
+    state.setBytesPerIteration((bytes - bytes_at_start) / std::max<size_t>(state.iterations(), 1));
+}
+
+void
+record_writer_allocations(State& state, const Options&)
+{
+    writeAllocations(state, 1);
+}
+MEMRAY_BENCHMARK(record_writer_allocations);
+
+void
+record_writer_allocations_context_switches(State& state, const Options&)
+{
+    writeAllocations(state, 4);
+}
+MEMRAY_BENCHMARK(record_writer_allocations_context_switches);
+
+void
+record_writer_allocations_timestamps(State& state, const Options&)
+{
+    writeAllocations(state, 1, true);
+}
+MEMRAY_BENCHMARK(record_writer_allocations_timestamps);
+
+void
+record_writer_native_allocations(State& state, const Options&)
+{
+    size_t bytes = 0;
+    RecordWriter writer(std::make_unique<CountingSink>(&bytes), "benchmark", true);
+    std::mt19937_64 random(42);
+    std::vector<NativeAllocationRecord> records;
+    for (const auto& record : heapRecords(RECORDS_PER_ITERATION)) {
+        if (record.allocator == hooks::Allocator::MALLOC) {
+            records.push_back({record.address, record.size, record.allocator, 1 + random() % 100000});
+        }
+    }
+
+    size_t bytes_at_start = bytes;
+    while (state.keepRunning()) {
+        for (const auto& record : records) {
+            writer.writeThreadSpecificRecord(1, record);
+        }
+    }
+    state.setItemsPerIteration(records.size());
+    state.setBytesPerIteration((bytes - bytes_at_start) / std::max<size_t>(state.iterations(), 1));
+}
+MEMRAY_BENCHMARK(record_writer_native_allocations);
+
+void
+record_writer_frame_push_pop(State& state, const Options&)
+{
+    size_t bytes = 0;
+    RecordWriter writer(std::make_unique<CountingSink>(&bytes), "benchmark", false);
+
+    size_t bytes_at_start = bytes;
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < RECORDS_PER_ITERATION / 2; ++i) {
+            writer.writeThreadSpecificRecord(1, FramePush{i % 1000});
+            writer.writeThreadSpecificRecord(1, FramePop{1});
+        }
+    }
+    state.setItemsPerIteration(RECORDS_PER_ITERATION);
+    state.setBytesPerIteration((bytes - bytes_at_start) / std::max<size_t>(state.iterations(), 1));
+}
+MEMRAY_BENCHMARK(record_writer_frame_push_pop);
+
+}  // unnamed namespace
+
+}  // namespace memray::benchmarks
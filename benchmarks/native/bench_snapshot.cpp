@@ -0,0 +1,129 @@
+#include <random>
+
+#include "benchmark.h"
+#include "snapshot.h"
+#include "synthetic.h"
+
+namespace memray::benchmarks {
+
+using namespace memray::tracking_api;
+
+namespace {  // unnamed
+
+bool
+loadAllocations(State& state, const Options& options, std::vector<Allocation>* allocations)
+{
+    std::string file_name = benchmarkCapture(options, false);
+    if (!file_name.empty()) {
+        *allocations = readAllocations(file_name);
+    }
+    if (allocations->empty()) {
+        state.skip("the capture has no allocations");
+        return false;
+    }
+    return true;
+}
+
+void
+snapshot_aggregator(State& state, const Options& options)
+{
+    std::vector<Allocation> allocations;
+    if (!loadAllocations(state, options, &allocations)) {
+        return;
+    }
+    while (state.keepRunning()) {
+        api::SnapshotAllocationAggregator aggregator;
+        for (const auto& allocation : allocations) {
+            aggregator.addAllocation(allocation);
+        }
+        auto snapshot = aggregator.getSnapshotAllocations(true);
+        if (snapshot.empty() && allocations.size() > 1000000000) {
+            state.skip("unreachable, keeps the snapshot from being optimized away");
+        }
+    }
+    state.setItemsPerIteration(allocations.size());
+}
+MEMRAY_BENCHMARK(snapshot_aggregator);
+
+void
+high_watermark_finder(State& state, const Options& options)
+{
+    std::vector<Allocation> allocations;
+    if (!loadAllocations(state, options, &allocations)) {
+        return;
+    }
+    while (state.keepRunning()) {
+        api::HighWatermarkFinder finder;
+        for (const auto& allocation : allocations) {
+            finder.processAllocation(allocation);
+        }
+        if (finder.getHighWatermark().index > allocations.size()) {
+            state.skip("unreachable, keeps the finder from being optimized away");
+        }
+    }
+    state.setItemsPerIteration(allocations.size());
+}
+MEMRAY_BENCHMARK(high_watermark_finder);
+
+void
+intervalTree(State& state, size_t live_mappings)
+{
+    // Map regions of a few pages, unmapping a random earlier region once there
+    // are too many, like a program growing and trimming its arenas.
+    const size_t page_size = 4096;
+    const size_t mappings = 20000;
+    struct Operation
+    {
+        uintptr_t address;
+        size_t size;
+        bool unmap;
+    };
+    std::mt19937_64 random(42);
+    std::vector<Operation> operations;
+    std::vector<Operation> live;
+    uintptr_t next_address = 0x7f0000000000;
+    for (size_t i = 0; i < mappings; ++i) {
+        Operation mmap{next_address, (1 + random() % 16) * page_size, false};
+        operations.push_back(mmap);
+        live.push_back(mmap);
+        next_address += mmap.size + page_size;
+        if (live.size() > live_mappings) {
+            size_t index = random() % live.size();
+            operations.push_back({live[index].address, live[index].size, true});
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    Allocation allocation{};
+    allocation.allocator = hooks::Allocator::MMAP;
+    while (state.keepRunning()) {
+        api::IntervalTree<Allocation> tree;
+        for (const auto& operation : operations) {
+            if (operation.unmap) {
+                tree.removeInterval(operation.address, operation.size);
+            } else {
+                tree.addInterval(operation.address, operation.size, allocation);
+            }
+        }
+    }
+    state.setItemsPerIteration(operations.size());
+}
+
+void
+interval_tree_100_mappings(State& state, const Options&)
+{
+    intervalTree(state, 100);
+}
+MEMRAY_BENCHMARK(interval_tree_100_mappings);
+
+void
+interval_tree_1000_mappings(State& state, const Options&)
+{
+    intervalTree(state, 1000);
+}
+MEMRAY_BENCHMARK(interval_tree_1000_mappings);
+
+}  // unnamed namespace
+
+}  // namespace memray::benchmarks
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace memray::benchmarks {
+
+/**
+ * Timing state of a single benchmark run.
+ *
+ * Benchmarks do their setup first and then loop on keepRunning(), processing
+ * the same amount of work on every iteration. The clock only runs between the
+ * first call to keepRunning() and the one that returns false, except while it's
+ * paused, so anything done before the loop isn't measured. An iteration that
+ * pauses the clock must resume it before it ends.
+ **/
+class State
+{
+  public:
+    explicit State(double min_seconds);
+
+    bool keepRunning();
+    void pauseTiming();
+    void resumeTiming();
+
+    // Work done by each iteration, used to report the time and the size per item.
+    void setItemsPerIteration(size_t items);
+    void setBytesPerIteration(size_t bytes);
+    void skip(const std::string& reason);
+
+    size_t iterations() const;
+    double seconds() const;
+    size_t itemsPerIteration() const;
+    size_t bytesPerIteration() const;
+    const std::string& skipReason() const;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    double d_min_seconds;
+    size_t d_iterations{0};
+    bool d_running{false};
+    clock::time_point d_started{};
+    clock::duration d_elapsed{};
+    size_t d_items{0};
+    size_t d_bytes{0};
+    std::string d_skip_reason;
+};
+
+struct Options
+{
+    // Capture file to use instead of the synthetic streams, if any.
+    std::string capture_file;
+    // Directory for the synthetic captures.
+    std::string work_dir;
+};
+
+using benchmark_fn_t = void (*)(State& state, const Options& options);
+
+// Path of the capture that reader and aggregator benchmarks should use: the
+// one given on the command line, or a synthetic one written on first use.
+std::string
+benchmarkCapture(const Options& options, bool native_traces);
+
+struct Benchmark
+{
+    const char* name;
+    benchmark_fn_t function;
+};
+
+std::vector<Benchmark>&
+registeredBenchmarks();
+
+bool
+registerBenchmark(const char* name, benchmark_fn_t function);
+
+#define MEMRAY_BENCHMARK(function)                                                                      \
+    static const bool function##_registered =                                                           \
+            memray::benchmarks::registerBenchmark(#function, function)
+
+}  // namespace memray::benchmarks
@@ -0,0 +1,216 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+#include <Python.h>
+
+#include "benchmark.h"
+
+namespace memray::benchmarks {
+
+State::State(double min_seconds)
+: d_min_seconds(min_seconds)
+{
+}
+
+bool
+State::keepRunning()
+{
+    if (!d_skip_reason.empty()) {
+        return false;
+    }
+    if (d_iterations == 0) {
+        ++d_iterations;
+        resumeTiming();
+        return true;
+    }
+    // Part of an iteration that ended with the clock paused was never timed, so
+    // counting it would make the time per iteration look smaller than it is.
+    if (!d_running) {
+        fprintf(stderr, "memray-benchmarks: an iteration ended without resuming the timing\n");
+        abort();
+    }
+    if (d_elapsed + (clock::now() - d_started) < std::chrono::duration<double>(d_min_seconds)) {
+        ++d_iterations;
+        return true;
+    }
+    pauseTiming();
+    return false;
+}
+
+void
+State::pauseTiming()
+{
+    if (d_running) {
+        d_elapsed += clock::now() - d_started;
+        d_running = false;
+    }
+}
+
+void
+State::resumeTiming()
+{
+    if (!d_running) {
+        d_started = clock::now();
+        d_running = true;
+    }
+}
+
+void
+State::setItemsPerIteration(size_t items)
+{
+    d_items = items;
+}
+
+void
+State::setBytesPerIteration(size_t bytes)
+{
+    d_bytes = bytes;
+}
+
+void
+State::skip(const std::string& reason)
+{
+    d_skip_reason = reason;
+}
+
+size_t
+State::iterations() const
+{
+    return d_iterations;
+}
+
+double
+State::seconds() const
+{
+    return std::chrono::duration<double>(d_elapsed).count();
+}
+
+size_t
+State::itemsPerIteration() const
+{
+    return d_items;
+}
+
+size_t
+State::bytesPerIteration() const
+{
+    return d_bytes;
+}
+
+const std::string&
+State::skipReason() const
+{
+    return d_skip_reason;
+}
+
+std::vector<Benchmark>&
+registeredBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool
+registerBenchmark(const char* name, benchmark_fn_t function)
+{
+    registeredBenchmarks().push_back({name, function});
+    return true;
+}
+
+}  // namespace memray::benchmarks
+
+namespace {  // unnamed
+
+using namespace memray::benchmarks;
+
+void
+usage(const char* program)
+{
+    fprintf(stderr,
+            "usage: %s [--min-time SECONDS] [--capture FILE] [--work-dir DIR] [FILTER...]\n"
+            "\n"
+            "Run the benchmarks whose name contains any of the FILTERs (all of them by default).\n"
+            "Reader and aggregator benchmarks use synthetic captures written in DIR, or FILE if given.\n",
+            program);
+}
+
+void
+report(const char* name, const State& state)
+{
+    if (!state.skipReason().empty()) {
+        printf("%-44s skipped: %s\n", name, state.skipReason().c_str());
+        return;
+    }
+    double ns_per_iteration = state.seconds() * 1e9 / state.iterations();
+    printf("%-44s %10zu iterations", name, state.iterations());
+    if (state.itemsPerIteration()) {
+        printf(" %12.2f ns/record", ns_per_iteration / state.itemsPerIteration());
+        if (state.bytesPerIteration()) {
+            printf(" %8.2f bytes/record",
+                   static_cast<double>(state.bytesPerIteration()) / state.itemsPerIteration());
+        }
+    } else {
+        printf(" %12.0f ns/iteration", ns_per_iteration);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+}  // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    double min_seconds = 1.0;
+    Options options;
+    std::vector<std::string> filters;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            min_seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--capture") && i + 1 < argc) {
+            options.capture_file = argv[++i];
+        } else if (!strcmp(argv[i], "--work-dir") && i + 1 < argc) {
+            options.work_dir = argv[++i];
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            filters.emplace_back(argv[i]);
+        }
+    }
+
+    char temporary_dir[] = "/tmp/memray-benchmarks-XXXXXX";
+    if (options.work_dir.empty()) {
+        if (!mkdtemp(temporary_dir)) {
+            perror("mkdtemp");
+            return 1;
+        }
+        options.work_dir = temporary_dir;
+    }
+
+    // The reader and the resolver use the Python API, so they need an interpreter.
+    Py_Initialize();
+
+    for (const auto& benchmark : registeredBenchmarks()) {
+        bool selected = filters.empty();
+        for (const auto& filter : filters) {
+            selected |= std::string(benchmark.name).find(filter) != std::string::npos;
+        }
+        if (!selected) {
+            continue;
+        }
+        State state(min_seconds);
+        benchmark.function(state, options);
+        report(benchmark.name, state);
+    }
+
+    Py_FinalizeEx();
+    if (options.work_dir == temporary_dir) {
+        std::filesystem::remove_all(options.work_dir);
+    }
+    return 0;
+}
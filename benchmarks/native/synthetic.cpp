@@ -0,0 +1,49 @@
+#include <memory>
+#include <unistd.h>
+
+#include "benchmark.h"
+#include "record_reader.h"
+#include "source.h"
+#include "synthetic.h"
+
+namespace memray::benchmarks {
+
+using namespace memray::tracking_api;
+
+std::vector<Allocation>
+readAllocations(const std::string& file_name)
+{
+    std::vector<Allocation> allocations;
+    api::RecordReader reader(std::make_unique<io::FileSource>(file_name));
+    while (true) {
+        switch (reader.nextRecord()) {
+            case api::RecordReader::RecordResult::ALLOCATION_RECORD:
+                allocations.push_back(reader.getLatestAllocation());
+                break;
+            case api::RecordReader::RecordResult::MEMORY_RECORD:
+                break;
+            case api::RecordReader::RecordResult::ERROR:
+            case api::RecordReader::RecordResult::END_OF_FILE:
+                return allocations;
+        }
+    }
+}
+
+std::string
+benchmarkCapture(const Options& options, bool native_traces)
+{
+    if (!options.capture_file.empty()) {
+        return options.capture_file;
+    }
+    std::string file_name = options.work_dir + (native_traces ? "/native.bin" : "/python.bin");
+    if (access(file_name.c_str(), F_OK) != 0) {
+        SyntheticWorkload workload;
+        workload.native_traces = native_traces;
+        if (!writeSyntheticCapture(file_name, workload)) {
+            return "";
+        }
+    }
+    return file_name;
+}
+
+}  // namespace memray::benchmarks
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "records.h"
+#include "synthetic_capture.h"
+
+namespace memray::benchmarks {
+
+// Returns every allocation and deallocation in the capture, in order.
+std::vector<tracking_api::Allocation>
+readAllocations(const std::string& file_name);
+
+}  // namespace memray::benchmarks
@@ -0,0 +1,218 @@
+"""Measure the overhead of `memray run` on realistic workloads.
+
+Every workload in the workloads directory runs untracked first, and then
+under `memray run` in each tracking mode. For every run the report shows
+the slowdown ratio against the untracked run, the rate at which the
+capture file is written, and how much more memory the process needed at
+its peak. Each measurement is the fastest of several runs, to reduce noise.
+
+Runs are timed from the moment the workload starts until the process exits,
+so the startup of the interpreter and of the tracker isn't counted, and
+neither is the live mode's wait for its client to connect.
+
+Workloads that need a package that isn't installed (like numpy or pandas)
+are skipped.
+"""
+import argparse
+import contextlib
+import importlib.util
+import json
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+from memray import SocketReader
+
+WORKLOADS_DIR = Path(__file__).parent / "workloads"
+
+REQUIREMENTS = {
+    "numpy_ops": ["numpy"],
+    "pandas_ops": ["numpy", "pandas"],
+}
+
+# Runs a workload after recording when it started, in a file named by the
+# first argument. CLOCK_MONOTONIC is shared by every process, so the runner
+# can compare the start with the time when the process exits.
+START_AND_RUN = """\
+import runpy, sys, time
+with open(sys.argv[1], "w") as start_file:
+    start_file.write(repr(time.monotonic()))
+sys.argv = sys.argv[2:]
+runpy.run_path(sys.argv[0], run_name="__main__")
+"""
+
+MODES = {
+    "file": [],
+    "live": ["--live-remote"],
+    "native": ["--native"],
+    "pymalloc": ["--trace-python-allocators"],
+}
+
+
+def get_free_port():
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
+        sock.bind(("localhost", 0))
+        return sock.getsockname()[1]
+
+
+def run_once(args, start_file, live_port=None):
+    """Run a command, and return its wall time and peak RSS in bytes.
+
+    The wall time starts when the workload does, as written to the start
+    file by START_AND_RUN, and ends when the process exits.
+    """
+    process = subprocess.Popen(args, stdout=subprocess.DEVNULL)
+    with contextlib.ExitStack() as stack:
+        if live_port is not None:
+            # Drain the stream like a live client would. The process waits for
+            # the client before running the workload.
+            stack.enter_context(SocketReader(port=live_port))
+        _, status, rusage = os.wait4(process.pid, 0)
+    end = time.monotonic()
+    process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+    if process.returncode != 0:
+        raise RuntimeError(f"{' '.join(args)} failed with status {status}")
+    start = float(Path(start_file).read_text())
+    return end - start, rusage.ru_maxrss * 1024
+
+
+def measure(workload, mode, repeat, work_dir):
+    """Return the fastest of several runs of a workload in a tracking mode."""
+    results = []
+    for _ in range(repeat):
+        capture = Path(work_dir) / "capture.bin"
+        start_file = Path(work_dir) / "start"
+        live_port = None
+        if mode is None:
+            args = [sys.executable]
+        else:
+            args = [sys.executable, "-m", "memray", "run", "--quiet", *MODES[mode]]
+            if mode == "live":
+                live_port = get_free_port()
+                args += ["--live-port", str(live_port)]
+            else:
+                args += ["--force", "--no-compress", "--output", str(capture)]
+        args += ["-c", START_AND_RUN, str(start_file), str(workload)]
+
+        elapsed, peak_rss = run_once(args, start_file, live_port)
+        capture_size = capture.stat().st_size if capture.exists() else None
+        results.append((elapsed, peak_rss, capture_size))
+        with contextlib.suppress(FileNotFoundError):
+            capture.unlink()
+    return min(results, key=lambda result: result[0])
+
+
+def missing_requirements(workload):
+    return [
+        package
+        for package in REQUIREMENTS.get(workload.stem, [])
+        if importlib.util.find_spec(package) is None
+    ]
+
+
+def size_fmt(num_bytes):
+    for unit in ["B", "KiB", "MiB", "GiB"]:
+        if abs(num_bytes) < 1024:
+            return f"{num_bytes:.1f}{unit}"
+        num_bytes /= 1024
+    return f"{num_bytes:.1f}TiB"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument(
+        "--repeat", type=int, default=3, help="Runs of each measurement (default: 3)"
+    )
+    parser.add_argument(
+        "--workload",
+        action="append",
+        help="Only run this workload (can be given more than once)",
+    )
+    parser.add_argument(
+        "--mode",
+        action="append",
+        choices=sorted(MODES),
+        help="Only use this tracking mode (can be given more than once)",
+    )
+    parser.add_argument("--json", help="Also write the results to this JSON file")
+    args = parser.parse_args()
+
+    workloads = sorted(WORKLOADS_DIR.glob("*.py"))
+    if args.workload:
+        workloads = [w for w in workloads if w.stem in args.workload]
+    modes = args.mode or list(MODES)
+
+    results = []
+    row = "{:<14} {:<10} {:>9} {:>9} {:>12} {:>12} {:>12}"
+    print(
+        row.format(
+            "workload", "mode", "time", "slowdown", "capture/s", "peak RSS", "extra RSS"
+        )
+    )
+    with tempfile.TemporaryDirectory() as work_dir:
+        for workload in workloads:
+            missing = missing_requirements(workload)
+            if missing:
+                missing = ", ".join(missing)
+                print(f"{workload.stem:<14} skipped: {missing} not installed")
+                continue
+
+            baseline_time, baseline_rss, _ = measure(
+                workload, None, args.repeat, work_dir
+            )
+            print(
+                row.format(
+                    workload.stem,
+                    "untracked",
+                    f"{baseline_time:.2f}s",
+                    "1.00x",
+                    "-",
+                    size_fmt(baseline_rss),
+                    "-",
+                )
+            )
+            for mode in modes:
+                elapsed, peak_rss, capture_size = measure(
+                    workload, mode, args.repeat, work_dir
+                )
+                result = {
+                    "workload": workload.stem,
+                    "mode": mode,
+                    "baseline_seconds": baseline_time,
+                    "seconds": elapsed,
+                    "slowdown": elapsed / baseline_time,
+                    "capture_bytes_per_second": (
+                        capture_size / elapsed if capture_size is not None else None
+                    ),
+                    "baseline_peak_rss": baseline_rss,
+                    "peak_rss": peak_rss,
+                    "extra_peak_rss": peak_rss - baseline_rss,
+                }
+                results.append(result)
+                rate = result["capture_bytes_per_second"]
+                print(
+                    row.format(
+                        "",
+                        mode,
+                        f"{elapsed:.2f}s",
+                        f"{result['slowdown']:.2f}x",
+                        size_fmt(rate) if rate is not None else "-",
+                        size_fmt(peak_rss),
+                        size_fmt(result["extra_peak_rss"]),
+                    ),
+                    flush=True,
+                )
+
+    if args.json:
+        with open(args.json, "w") as output:
+            json.dump(results, output, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,32 @@
+"""Serialize and parse JSON documents with many small objects."""
+import json
+import random
+
+
+def make_document(rng, n_records):
+    return [
+        {
+            "id": index,
+            "name": f"user-{rng.randrange(10**6)}",
+            "active": rng.random() < 0.5,
+            "score": rng.random() * 100,
+            "tags": [f"tag{rng.randrange(50)}" for _ in range(rng.randrange(8))],
+            "address": {
+                "city": f"city-{rng.randrange(1000)}",
+                "zip": rng.randrange(10**5),
+            },
+        }
+        for index in range(n_records)
+    ]
+
+
+def main():
+    rng = random.Random(42)
+    text = json.dumps(make_document(rng, 20_000))
+    for _ in range(10):
+        document = json.loads(text)
+        text = json.dumps(document)
+
+
+if __name__ == "__main__":
+    main()
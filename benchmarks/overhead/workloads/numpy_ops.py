@@ -0,0 +1,16 @@
+"""Create, combine and reduce NumPy arrays of different sizes."""
+import numpy as np
+
+
+def main():
+    rng = np.random.default_rng(42)
+    for size in (1_000, 100_000, 1_000_000) * 10:
+        a = rng.random(size)
+        b = rng.random(size)
+        c = np.sqrt(a * b) + np.sin(a)
+        np.sort(c)
+        np.cumsum(c).reshape(-1, 10).mean(axis=1)
+
+
+if __name__ == "__main__":
+    main()
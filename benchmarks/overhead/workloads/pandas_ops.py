@@ -0,0 +1,24 @@
+"""Group, join and reshape pandas data frames."""
+import numpy as np
+import pandas as pd
+
+
+def main():
+    rng = np.random.default_rng(42)
+    for _ in range(5):
+        frame = pd.DataFrame(
+            {
+                "key": rng.integers(0, 1_000, 200_000),
+                "category": rng.choice(["a", "b", "c", "d"], 200_000),
+                "value": rng.random(200_000),
+            }
+        )
+        grouped = frame.groupby(["key", "category"])["value"].agg(["sum", "mean"])
+        lookup = grouped.reset_index().rename(columns={"sum": "total"})
+        merged = frame.merge(lookup, on=["key", "category"])
+        merged.pivot_table(index="key", columns="category", values="total")
+        frame.astype({"key": str}).to_csv()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,31 @@
+"""Build and walk binary trees with recursive pure Python code."""
+
+
+class Node:
+    __slots__ = ("left", "right", "value")
+
+    def __init__(self, left, right, value):
+        self.left = left
+        self.right = right
+        self.value = value
+
+
+def build(depth, value=0):
+    if depth == 0:
+        return Node(None, None, value)
+    return Node(build(depth - 1, 2 * value), build(depth - 1, 2 * value + 1), value)
+
+
+def total(node):
+    if node is None:
+        return 0
+    return node.value + total(node.left) + total(node.right)
+
+
+def main():
+    for _ in range(10):
+        total(build(16))
+
+
+if __name__ == "__main__":
+    main()
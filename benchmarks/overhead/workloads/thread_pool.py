@@ -0,0 +1,20 @@
+"""Run many small text processing tasks on a thread pool."""
+import collections
+import concurrent.futures
+
+
+def count_words(seed):
+    words = [f"word{(seed * 7919 + index) % 1000}" for index in range(5_000)]
+    text = " ".join(words)
+    return collections.Counter(text.split())
+
+
+def main():
+    with concurrent.futures.ThreadPoolExecutor(max_workers=8) as executor:
+        totals = collections.Counter()
+        for counts in executor.map(count_words, range(400)):
+            totals.update(counts)
+
+
+if __name__ == "__main__":
+    main()
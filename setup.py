@@ -208,6 +208,15 @@ MEMRAY_EXTENSION = Extension(
         "src/memray/_memray/snapshot.cpp",
         "src/memray/_memray/socket_reader_thread.cpp",
         "src/memray/_memray/native_resolver.cpp",
+        "src/memray/_memray/lifetime.cpp",
+        "src/memray/_memray/page_occupancy.cpp",
+        "src/memray/_memray/temporal_snapshot.cpp",
+        "src/memray/_memray/snapshot_diff.cpp",
+        "src/memray/_memray/capture_rewriter.cpp",
+        "src/memray/_memray/multi_capture.cpp",
+        "src/memray/_memray/spilling_snapshot.cpp",
+        "src/memray/_memray/replay.cpp",
+        "src/memray/_memray/synthetic_capture.cpp",
     ],
     libraries=["unwind", "lz4"],
     library_dirs=[str(LIBBACKTRACE_LIBDIR)],
@@ -277,5 +286,5 @@ setup(
     cmdclass={
         "build_ext": BuildMemray,
     },
-    package_data={"memray": ["py.typed"]},
+    package_data={"memray": ["py.typed", "include/*.h"]},
 )
@@ -1,31 +1,46 @@
+import pathlib
+
 from ._memray import AllocationRecord
 from ._memray import AllocatorType
 from ._memray import Destination
 from ._memray import FileDestination
 from ._memray import FileReader
 from ._memray import MemoryRecord
+from ._memray import MultiFileReader
 from ._memray import SocketDestination
 from ._memray import SocketReader
+from ._memray import SymbolCache
 from ._memray import Tracker
+from ._memray import compute_snapshot_diff
 from ._memray import dump_all_records
 from ._memray import set_log_level
 from ._memray import start_thread_trace
 from ._metadata import Metadata
 from ._version import __version__
 
+
+def get_include() -> str:
+    """Return the directory that contains Memray's C API header, ``memray.h``."""
+    return str(pathlib.Path(__file__).parent / "include")
+
+
 __all__ = [
     "AllocationRecord",
     "AllocatorType",
     "MemoryRecord",
     "dump_all_records",
+    "compute_snapshot_diff",
     "start_thread_trace",
     "Tracker",
     "FileReader",
+    "MultiFileReader",
     "SocketReader",
+    "SymbolCache",
     "Destination",
     "FileDestination",
     "SocketDestination",
     "Metadata",
     "__version__",
     "set_log_level",
+    "get_include",
 ]
@@ -10,3 +10,5 @@ from ._memray import MemoryRecord as MemoryRecord
 from ._memray import SocketReader as SocketReader
 from ._memray import Tracker as Tracker
 from ._memray import dump_all_records as dump_all_records
+
+def get_include() -> str: ...
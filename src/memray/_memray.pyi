@@ -1,9 +1,13 @@
 import enum
+from datetime import datetime
+from datetime import timedelta
 from pathlib import Path
 from types import FrameType
 from types import TracebackType
 from typing import Any
 from typing import Callable
+from typing import Collection
+from typing import Dict
 from typing import Iterable
 from typing import Iterator
 from typing import List
@@ -23,6 +27,54 @@ from . import Destination
 PythonStackElement = Tuple[str, str, int]
 NativeStackElement = Tuple[str, str, int]
 MemoryRecord = NamedTuple("MemoryRecord", [("time", int), ("rss", int)])
+AllocationLifetimeRecord = NamedTuple(
+    "AllocationLifetimeRecord",
+    [
+        ("allocation", AllocationRecord),
+        ("n_freed", int),
+        ("median_lifetime", int),
+        ("p90_lifetime", int),
+        ("histogram", List[Tuple[int, int]]),
+    ],
+)
+PageOccupancyRecord = NamedTuple(
+    "PageOccupancyRecord",
+    [
+        ("time", int),
+        ("rss", int),
+        ("heap_size", int),
+        ("occupied_pages", int),
+        ("partially_used_pages", int),
+        ("sparse_pages", int),
+        ("regions", int),
+    ],
+)
+TemporalAllocationRecord = NamedTuple(
+    "TemporalAllocationRecord",
+    [
+        ("allocation", AllocationRecord),
+        ("intervals", List[Tuple[int, int, int, int]]),
+    ],
+)
+SnapshotDiffRecord = NamedTuple(
+    "SnapshotDiffRecord",
+    [
+        ("stack_trace", List[PythonStackElement]),
+        ("size_before", int),
+        ("n_allocations_before", int),
+        ("size_after", int),
+        ("n_allocations_after", int),
+    ],
+)
+ProcessAllocationRecord = NamedTuple(
+    "ProcessAllocationRecord",
+    [
+        ("pid", Optional[int]),
+        ("stack_trace", List[PythonStackElement]),
+        ("size", int),
+        ("n_allocations", int),
+    ],
+)
 
 def set_log_level(level: int) -> None: ...
 
@@ -34,6 +86,10 @@ class AllocationRecord:
     @property
     def n_allocations(self) -> int: ...
     @property
+    def pool_id(self) -> int: ...
+    @property
+    def timestamp(self) -> Optional[int]: ...
+    @property
     def size(self) -> int: ...
     @property
     def stack_id(self) -> int: ...
@@ -75,13 +131,26 @@ class AllocatorType(enum.IntEnum):
     PYMALLOC_CALLOC: int
     PYMALLOC_REALLOC: int
     PYMALLOC_FREE: int
+    MREMAP: int
+    MADVISE: int
+    POOL_ALLOC: int
+    POOL_FREE: int
 
 def start_thread_trace(frame: FrameType, event: str, arg: Any) -> None: ...
 
+class SymbolCache:
+    def __len__(self) -> int: ...
+
 class FileReader:
     @property
     def metadata(self) -> Metadata: ...
-    def __init__(self, file_name: Union[str, Path]) -> None: ...
+    def __init__(
+        self,
+        file_name: Union[str, Path],
+        *,
+        spill_directory: Union[str, Path, None] = ...,
+        symbol_cache: Optional[SymbolCache] = ...,
+    ) -> None: ...
     def get_allocation_records(self) -> Iterable[AllocationRecord]: ...
     def get_high_watermark_allocation_records(
         self,
@@ -90,7 +159,46 @@ class FileReader:
     def get_leaked_allocation_records(
         self, merge_threads: bool
     ) -> Iterable[AllocationRecord]: ...
+    def get_snapshot_at(
+        self,
+        time_or_index: Union[datetime, timedelta, int],
+        merge_threads: bool = ...,
+    ) -> Iterable[AllocationRecord]: ...
     def get_memory_records(self) -> Iterable[MemoryRecord]: ...
+    def get_allocation_lifetime_records(
+        self, merge_threads: bool = ...
+    ) -> Iterable[AllocationLifetimeRecord]: ...
+    def get_temporal_allocation_records(
+        self, merge_threads: bool = ...
+    ) -> Iterable[TemporalAllocationRecord]: ...
+    def get_page_occupancy_records(
+        self, *, page_size: int = ..., sparse_threshold: float = ...
+    ) -> Iterable[PageOccupancyRecord]: ...
+    def get_sparse_page_allocation_records(
+        self,
+        *,
+        leaks: bool = ...,
+        merge_threads: bool = ...,
+        page_size: int = ...,
+        sparse_threshold: float = ...,
+    ) -> Iterable[AllocationRecord]: ...
+    def write_slice(
+        self,
+        destination: Union[str, Path],
+        start: Union[datetime, timedelta, int, None] = ...,
+        end: Union[datetime, timedelta, int, None] = ...,
+        *,
+        overwrite: bool = ...,
+        compress: bool = ...,
+    ) -> int: ...
+    def write_compacted(
+        self,
+        destination: Union[str, Path],
+        *,
+        max_lifetime: int = ...,
+        overwrite: bool = ...,
+        compress: bool = ...,
+    ) -> int: ...
     def __enter__(self) -> Any: ...
     def __exit__(
         self,
@@ -103,6 +211,36 @@ class FileReader:
     def close(self) -> None: ...
 
 def dump_all_records(file_name: Union[str, Path]) -> None: ...
+class MultiFileReader:
+    @property
+    def metadata(self) -> Metadata: ...
+    @property
+    def process_metadata(self) -> List[Metadata]: ...
+    def __init__(self, file_names: Iterable[Union[str, Path]]) -> None: ...
+    def get_high_watermark_allocation_records(
+        self, merge_processes: bool = ...
+    ) -> List[ProcessAllocationRecord]: ...
+    def get_leaked_allocation_records(
+        self, merge_processes: bool = ...
+    ) -> List[ProcessAllocationRecord]: ...
+    def get_memory_records(self) -> Iterable[MemoryRecord]: ...
+    def __enter__(self) -> Any: ...
+    def __exit__(
+        self,
+        exctype: Optional[Type[BaseException]],
+        excinst: Optional[BaseException],
+        exctb: Optional[TracebackType],
+    ) -> bool: ...
+    @property
+    def closed(self) -> bool: ...
+    def close(self) -> None: ...
+
+def compute_snapshot_diff(
+    baseline: FileReader, candidate: FileReader, *, leaks: bool = ...
+) -> List[SnapshotDiffRecord]: ...
+def replay_allocations(
+    file_name: Union[str, Path], *, preserve_order: bool = ...
+) -> Dict[str, Any]: ...
 
 class SocketReader:
     def __init__(self, port: int) -> None: ...
@@ -137,6 +275,14 @@ class Tracker:
         memory_interval_ms: int = ...,
         follow_fork: bool = ...,
         trace_python_allocators: bool = ...,
+        min_allocation_size: int = ...,
+        allocators: Optional[Collection[AllocatorType]] = ...,
+        thread_names: Optional[Collection[str]] = ...,
+        max_python_stack_depth: int = ...,
+        excluded_modules: Optional[Collection[str]] = ...,
+        max_native_stack_depth: int = ...,
+        native_stop_at_python: bool = ...,
+        timestamps: bool = ...,
     ) -> None: ...
     @overload
     def __init__(
@@ -147,6 +293,14 @@ class Tracker:
         memory_interval_ms: int = ...,
         follow_fork: bool = ...,
         trace_python_allocators: bool = ...,
+        min_allocation_size: int = ...,
+        allocators: Optional[Collection[AllocatorType]] = ...,
+        thread_names: Optional[Collection[str]] = ...,
+        max_python_stack_depth: int = ...,
+        excluded_modules: Optional[Collection[str]] = ...,
+        max_native_stack_depth: int = ...,
+        native_stop_at_python: bool = ...,
+        timestamps: bool = ...,
     ) -> None: ...
     def __enter__(self) -> Any: ...
     def __exit__(
@@ -185,10 +339,36 @@ class MmapAllocator:
     @property
     def address(self) -> int: ...
     def munmap(self, length: int, offset: int = 0) -> None: ...
+    def mremap(self, old_size: int, new_size: int) -> None: ...
+    def madvise_dontneed(self, length: int, offset: int = 0) -> None: ...
+
+class PoolAllocator:
+    def __init__(self, size: int, pool_id: int = 0) -> None: ...
+    def alloc(self, size: int) -> int: ...
+    def free(self, address: int) -> None: ...
 
+def write_synthetic_capture(
+    path: Union[str, Path],
+    *,
+    allocations: int = ...,
+    threads: int = ...,
+    functions: int = ...,
+    mean_stack_depth: float = ...,
+    max_stack_depth: int = ...,
+    min_size: int = ...,
+    max_size: int = ...,
+    mean_lifetime: float = ...,
+    leak_fraction: float = ...,
+    mmap_fraction: float = ...,
+    native_traces: bool = ...,
+    dlopen_churn: int = ...,
+    seed: int = ...,
+) -> int: ...
+def register_frames_concurrently(n_threads: int, n_frames: int) -> int: ...
 def _cython_nested_allocation(
     allocator_fn: Callable[[int], None], size: int
 ) -> None: ...
 def _cython_allocate_in_two_places(size: int) -> None: ...
+def _cython_malloc_free_loop(size: int, iterations: int) -> int: ...
 def size_fmt(num: int, suffix: str = "B") -> str: ...
 def set_thread_name(name: str) -> int: ...
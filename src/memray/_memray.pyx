@@ -8,13 +8,26 @@ cimport cython
 
 import threading
 from datetime import datetime
+from datetime import timedelta
 
+from _memray.capture_rewriter cimport CaptureCompactor
+from _memray.capture_rewriter cimport CaptureRewriter
+from _memray.lifetime cimport AllocationLifetimeAggregator
+from _memray.lifetime cimport SiteLifetimes
 from _memray.logging cimport setLogThreshold
+from _memray.multi_capture cimport CaptureSummary
+from _memray.multi_capture cimport MultiCaptureReader
+from _memray.multi_capture cimport ProcessLocation
+from _memray.native_resolver cimport BacktraceStateCache
+from _memray.page_occupancy cimport PageOccupancy
+from _memray.page_occupancy cimport PageOccupancyAggregator
 from _memray.record_reader cimport RecordReader
 from _memray.record_reader cimport RecordResult
 from _memray.record_writer cimport RecordWriter
 from _memray.records cimport Allocation as _Allocation
 from _memray.records cimport MemoryRecord as _MemoryRecord
+from _memray.replay cimport AllocationReplayer
+from _memray.replay cimport ReplayStats
 from _memray.sink cimport FileSink
 from _memray.sink cimport NullSink
 from _memray.sink cimport Sink
@@ -24,12 +37,22 @@ from _memray.snapshot cimport HighWatermarkFinder
 from _memray.snapshot cimport Py_GetSnapshotAllocationRecords
 from _memray.snapshot cimport Py_ListFromSnapshotAllocationRecords
 from _memray.snapshot cimport SnapshotAllocationAggregator
+from _memray.snapshot cimport reduced_snapshot_map_t
+from _memray.snapshot_diff cimport LocationDelta
+from _memray.snapshot_diff cimport SnapshotDiffAggregator
 from _memray.socket_reader_thread cimport BackgroundSocketReader
 from _memray.source cimport FileSource
 from _memray.source cimport SocketSource
+from _memray.spilling_snapshot cimport SpillingHighWatermarkFinder
+from _memray.spilling_snapshot cimport SpillingSnapshotAggregator
+from _memray.temporal_snapshot cimport TemporalAllocationAggregator
+from _memray.temporal_snapshot cimport TemporalLocation
+from _memray.tracking_api cimport AllocationFilter
+from _memray.tracking_api cimport PythonFrameFilter
 from _memray.tracking_api cimport Tracker as NativeTracker
 from _memray.tracking_api cimport install_trace_function
 from cpython cimport PyErr_CheckSignals
+from cpython.pycapsule cimport PyCapsule_New
 from libcpp cimport bool
 from libcpp.limits cimport numeric_limits
 from libcpp.memory cimport make_shared
@@ -76,6 +99,18 @@ cpdef enum AllocatorType:
     PYMALLOC_CALLOC = 13
     PYMALLOC_REALLOC = 14
     PYMALLOC_FREE = 15
+    MREMAP = 16
+    MADVISE = 17
+    POOL_ALLOC = 18
+    POOL_FREE = 19
+
+_DEALLOCATORS = {
+    AllocatorType.FREE,
+    AllocatorType.MUNMAP,
+    AllocatorType.PYMALLOC_FREE,
+    AllocatorType.MADVISE,
+    AllocatorType.POOL_FREE,
+}
 
 cpdef enum PythonAllocatorType:
     PYTHON_ALLOCATOR_PYMALLOC = 1
@@ -94,6 +129,9 @@ def size_fmt(num, suffix='B'):
 
 PYTHON_VERSION = (sys.version_info.major, sys.version_info.minor)
 
+# Public C API used by include/memray.h
+_C_API = PyCapsule_New(<void*>NativeTracker.getCAPI(), "memray._memray._C_API", NULL)
+
 @cython.freelist(1024)
 cdef class AllocationRecord:
     cdef object _tuple
@@ -139,6 +177,20 @@ cdef class AllocationRecord:
     def n_allocations(self):
         return self._tuple[5]
 
+    @property
+    def pool_id(self):
+        return self._tuple[8]
+
+    @property
+    def timestamp(self):
+        """Milliseconds since the epoch when the allocation was made, or None.
+
+        Only captures made with ``timestamps=True`` record when each
+        allocation happened. The time is read from a coarse clock, so it is
+        only precise to within a few milliseconds.
+        """
+        return self._tuple[9] or None
+
     @property
     def thread_name(self):
         if self.tid == -1:
@@ -151,7 +203,12 @@ cdef class AllocationRecord:
     def stack_trace(self, max_stacks=None):
         assert self._reader.get() != NULL, "Cannot get stack trace without reader."
         if self._stack_trace is None:
-            if self.allocator in (AllocatorType.FREE, AllocatorType.MUNMAP):
+            if self.allocator in (
+                AllocatorType.FREE,
+                AllocatorType.MUNMAP,
+                AllocatorType.MADVISE,
+                AllocatorType.POOL_FREE,
+            ):
                 raise NotImplementedError("Stack traces for deallocations aren't captured.")
 
             if max_stacks is None:
@@ -163,7 +220,12 @@ cdef class AllocationRecord:
     def native_stack_trace(self, max_stacks=None):
         assert self._reader.get() != NULL, "Cannot get stack trace without reader."
         if self._native_stack_trace is None:
-            if self.allocator in (AllocatorType.FREE, AllocatorType.MUNMAP):
+            if self.allocator in (
+                AllocatorType.FREE,
+                AllocatorType.MUNMAP,
+                AllocatorType.MADVISE,
+                AllocatorType.POOL_FREE,
+            ):
                 raise NotImplementedError("Stack traces for deallocations aren't captured.")
 
             if max_stacks is None:
@@ -187,8 +249,10 @@ cdef class AllocationRecord:
     def hybrid_stack_trace(self, max_stacks=None):
         python_stack = tuple(self._pure_python_stack_trace(max_stacks))
         n_python_frames_left = len(python_stack) if python_stack else None
+        python_frames = python_stack
         python_stack = iter(python_stack)
-        for native_frame in self.native_stack_trace(max_stacks):
+        native_stack = self.native_stack_trace(max_stacks)
+        for native_frame in native_stack:
             if n_python_frames_left == 0:
                 break
             symbol, *_ = native_frame
@@ -198,6 +262,19 @@ cdef class AllocationRecord:
                 yield python_frame
             else:
                 yield native_frame
+        else:
+            # Native stacks captured with native_stop_at_python end at the
+            # first evaluation loop frame: the Python frames it was running
+            # provide the rest of the stack.
+            if (
+                n_python_frames_left
+                and native_stack
+                and self._is_eval_frame(native_stack[len(native_stack) - 1][0])
+                and (max_stacks is None or len(native_stack) < max_stacks)
+            ):
+                first = len(python_frames) - n_python_frames_left
+                last = None if max_stacks is None else first + max_stacks - len(native_stack)
+                yield from python_frames[first:last]
 
     def __repr__(self):
         return (f"AllocationRecord<tid={hex(self.tid)}, address={hex(self.address)}, "
@@ -207,6 +284,29 @@ cdef class AllocationRecord:
 
 MemoryRecord = collections.namedtuple("MemoryRecord", "time rss")
 
+AllocationLifetimeRecord = collections.namedtuple(
+    "AllocationLifetimeRecord",
+    "allocation n_freed median_lifetime p90_lifetime histogram",
+)
+
+PageOccupancyRecord = collections.namedtuple(
+    "PageOccupancyRecord",
+    "time rss heap_size occupied_pages partially_used_pages sparse_pages regions",
+)
+
+TemporalAllocationRecord = collections.namedtuple(
+    "TemporalAllocationRecord", "allocation intervals"
+)
+
+SnapshotDiffRecord = collections.namedtuple(
+    "SnapshotDiffRecord",
+    "stack_trace size_before n_allocations_before size_after n_allocations_after",
+)
+
+ProcessAllocationRecord = collections.namedtuple(
+    "ProcessAllocationRecord", "pid stack_trace size n_allocations"
+)
+
 cdef class Tracker:
     """Context manager for tracking memory allocations in a Python script.
 
@@ -246,11 +346,53 @@ cdef class Tracker:
             memory usage over time that appears at the top of the flame graph,
             for instance. This parameter lets you adjust the frequency between
             updates, though you shouldn't need to change it.
+        min_allocation_size (int): Allocations smaller than this many bytes
+            are not recorded. Defaults to 0, which records every allocation.
+        allocators (Collection[AllocatorType]): If provided, only allocations
+            made by one of these allocators are recorded. Deallocations are
+            recorded if any of the allocators whose memory they can release is
+            included.
+        thread_names (Collection[str]): If provided, only allocations made by
+            threads whose name matches one of these shell-style wildcard
+            patterns are recorded. A thread's name is the one it last set
+            through ``prctl(PR_SET_NAME)`` or ``pthread_setname_np``, which
+            defaults to the name of the process. Deallocations are recorded
+            regardless of the thread that performs them.
+        max_python_stack_depth (int): If not 0, only the outermost this many
+            Python frames of each stack are recorded. Allocations made deeper
+            than that are attributed to the deepest recorded frame. Defaults
+            to 0.
+        excluded_modules (Collection[str]): Python frames running code from
+            any of these modules, or from any of their submodules, are not
+            recorded. Allocations made by them are attributed to their closest
+            recorded caller.
+        max_native_stack_depth (int): If not 0, at most this many native
+            frames are recorded for each allocation. Only used when
+            *native_traces* is True. Defaults to 0.
+        native_stop_at_python (bool): Whether to stop unwinding the native
+            stack at the first frame of the Python evaluation loop, leaving
+            the rest of the stack to the Python frames that memray already
+            tracks. This makes native tracking cheaper in deep Python call
+            stacks, at the cost of hiding native frames between Python calls.
+            Only used when *native_traces* is True. Defaults to False.
+        timestamps (bool): Whether or not to record when each allocation is
+            made, with the precision of the system's coarse monotonic clock
+            (typically a few milliseconds). A timestamp is only written when
+            the clock has advanced since the previous allocation, so this
+            makes captures just slightly bigger. Defaults to False.
+
+    Allocations skipped because of *min_allocation_size*, *allocators* or
+    *thread_names* are counted in the capture file's metadata, so that reports
+    can point out how much of the program's activity they don't show.
     """
     cdef bool _native_traces
+    cdef size_t _max_native_stack_depth
+    cdef bool _native_stop_at_python
     cdef unsigned int _memory_interval_ms
     cdef bool _follow_fork
     cdef bool _trace_python_allocators
+    cdef AllocationFilter _filter
+    cdef PythonFrameFilter _frame_filter
     cdef object _previous_profile_func
     cdef object _previous_thread_profile_func
     cdef unique_ptr[RecordWriter] _writer
@@ -278,16 +420,45 @@ cdef class Tracker:
 
     def __cinit__(self, object file_name=None, *, object destination=None,
                   bool native_traces=False, unsigned int memory_interval_ms = 10,
-                  bool follow_fork=False, bool trace_python_allocators=False):
+                  bool follow_fork=False, bool trace_python_allocators=False,
+                  size_t min_allocation_size=0, object allocators=None,
+                  object thread_names=None, unsigned int max_python_stack_depth=0,
+                  object excluded_modules=None, size_t max_native_stack_depth=0,
+                  bool native_stop_at_python=False, bool timestamps=False):
         if (file_name, destination).count(None) != 1:
             raise TypeError("Exactly one of 'file_name' or 'destination' argument must be specified")
 
         cdef cppstring command_line = " ".join(sys.argv)
         self._native_traces = native_traces
+        self._max_native_stack_depth = max_native_stack_depth
+        self._native_stop_at_python = native_stop_at_python
         self._memory_interval_ms = memory_interval_ms
         self._follow_fork = follow_fork
         self._trace_python_allocators = trace_python_allocators
 
+        self._filter.min_size = min_allocation_size
+        if allocators is not None:
+            self._filter.allocators = 0
+            for allocator in allocators:
+                allocator = AllocatorType(allocator)
+                if allocator in _DEALLOCATORS:
+                    raise ValueError(f"{allocator.name} is not an allocator")
+                self._filter.allocators |= 1 << allocator
+        if thread_names is not None:
+            if isinstance(thread_names, str):
+                raise TypeError("thread_names must be a collection of strings")
+            self._filter.thread_name_patterns = [
+                os.fsencode(pattern) for pattern in thread_names
+            ]
+
+        self._frame_filter.max_depth = max_python_stack_depth
+        if excluded_modules is not None:
+            if isinstance(excluded_modules, str):
+                raise TypeError("excluded_modules must be a collection of strings")
+            self._frame_filter.excluded_modules = [
+                module.encode() for module in excluded_modules
+            ]
+
         if file_name is not None:
             destination = FileDestination(path=file_name)
 
@@ -295,7 +466,7 @@ cdef class Tracker:
             raise RuntimeError("follow_fork requires an output file")
 
         self._writer = make_unique[RecordWriter](
-                move(self._make_writer(destination)), command_line, native_traces
+                move(self._make_writer(destination)), command_line, native_traces, timestamps
             )
 
     @cython.profile(False)
@@ -319,6 +490,10 @@ cdef class Tracker:
             self._memory_interval_ms,
             self._follow_fork,
             self._trace_python_allocators,
+            self._filter,
+            self._frame_filter,
+            self._max_native_stack_depth,
+            self._native_stop_at_python,
         )
         return self
 
@@ -335,23 +510,92 @@ def start_thread_trace(frame, event, arg):
     return start_thread_trace
 
 
+def _check_page_occupancy_arguments(size_t page_size, double sparse_threshold):
+    if page_size == 0 or page_size & (page_size - 1):
+        raise ValueError(f"page_size must be a power of two, not {page_size}")
+    if not 0 < sparse_threshold <= 1:
+        raise ValueError(
+            f"sparse_threshold must be between 0 and 1, not {sparse_threshold}"
+        )
+
+
+cdef object _metadata_from_header(dict header, size_t peak_memory):
+    def millis_to_dt(millis) -> datetime:
+        return datetime.fromtimestamp(millis // 1000).replace(
+            microsecond=millis % 1000 * 1000)
+
+    stats = header["stats"]
+    allocator_id_to_name = {
+        PythonAllocatorType.PYTHON_ALLOCATOR_PYMALLOC: "pymalloc",
+        PythonAllocatorType.PYTHON_ALLOCATOR_PYMALLOC_DEBUG: "pymalloc debug",
+        PythonAllocatorType.PYTHON_ALLOCATOR_MALLOC: "malloc",
+        PythonAllocatorType.PYTHON_ALLOCATOR_OTHER: "unknown",
+    }
+    python_allocator = allocator_id_to_name[header["python_allocator"]]
+    return Metadata(start_time=millis_to_dt(stats["start_time"]),
+                    end_time=millis_to_dt(stats["end_time"]),
+                    total_allocations=stats["n_allocations"],
+                    total_frames=stats["n_frames"],
+                    peak_memory=peak_memory,
+                    command_line=header["command_line"],
+                    pid=header["pid"],
+                    python_allocator=python_allocator,
+                    has_native_traces=header["native_traces"],
+                    has_timestamps=header["timestamps"],
+                    dropped_by_size=stats["n_dropped_by_size"],
+                    dropped_by_allocator=stats["n_dropped_by_allocator"],
+                    dropped_by_thread=stats["n_dropped_by_thread"])
+
+
+cdef class SymbolCache:
+    """The symbols and debug information of the shared objects that the
+    native stack traces of captures refer to.
+
+    Reading them is the slowest part of resolving native stack traces. Every
+    ``FileReader`` has a cache of its own by default, but the readers of
+    captures of programs that load the same shared objects, like the ones of
+    the same build collected from many hosts, can be given the same cache to
+    read each object file only once. A cache can be shared by readers that are
+    used from different threads.
+    """
+    cdef shared_ptr[BacktraceStateCache] _cache
+
+    def __cinit__(self):
+        self._cache = make_shared[BacktraceStateCache]()
+
+    def __len__(self):
+        return self._cache.get().size()
+
+
 cdef class FileReader:
     cdef cppstring _path
 
     cdef object _file
     cdef vector[_MemoryRecord] _memory_records
+    # Number of allocation records that precede each memory record.
+    cdef vector[size_t] _memory_record_indices
     cdef HighWatermark _high_watermark
     cdef object _header
+    cdef object _spill_directory
+    cdef shared_ptr[BacktraceStateCache] _symbol_cache
 
-    def __cinit__(self, object file_name):
+    def __cinit__(self, object file_name, *, object spill_directory=None,
+                  SymbolCache symbol_cache=None):
         try:
             self._file = open(file_name)
         except OSError as exc:
             raise OSError(f"Could not open file {file_name}: {exc.strerror}") from None
 
         self._path = "/proc/self/fd/" + str(self._file.fileno())
+        if spill_directory is not None:
+            self._spill_directory = os.fspath(spill_directory)
+        if symbol_cache is not None:
+            self._symbol_cache = symbol_cache._cache
+        else:
+            self._symbol_cache = make_shared[BacktraceStateCache]()
 
-        # Initial pass to populate _header, _high_watermark, and _memory_records.
+        # Initial pass to populate _header, _high_watermark, _memory_records,
+        # and _memory_record_indices.
         cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
             unique_ptr[FileSource](new FileSource(self._path)),
             False
@@ -365,18 +609,37 @@ cdef class FileReader:
         if 0 < stats["start_time"] < stats["end_time"]:
             n_memory_records_approx = (stats["end_time"] - stats["start_time"]) / 10
         self._memory_records.reserve(n_memory_records_approx)
+        self._memory_record_indices.reserve(n_memory_records_approx)
 
         cdef HighWatermarkFinder finder
+        cdef unique_ptr[SpillingHighWatermarkFinder] spilling_finder
+        if self._spill_directory is not None:
+            spilling_finder = unique_ptr[SpillingHighWatermarkFinder](
+                new SpillingHighWatermarkFinder(self._spill_directory)
+            )
+        cdef size_t n_allocation_records = 0
         while True:
             PyErr_CheckSignals()
             ret = reader.nextRecord()
             if ret == RecordResult.RecordResultAllocationRecord:
-                finder.processAllocation(reader.getLatestAllocation())
+                if spilling_finder.get() != NULL:
+                    spilling_finder.get().processAllocation(reader.getLatestAllocation())
+                else:
+                    finder.processAllocation(reader.getLatestAllocation())
+                n_allocation_records += 1
             elif ret == RecordResult.RecordResultMemoryRecord:
                 self._memory_records.push_back(reader.getLatestMemoryRecord())
+                self._memory_record_indices.push_back(n_allocation_records)
             else:
                 break
-        self._high_watermark = finder.getHighWatermark()
+
+        cdef HighWatermark high_watermark
+        if spilling_finder.get() != NULL:
+            with nogil:
+                high_watermark = spilling_finder.get().getHighWatermark()
+            self._high_watermark = high_watermark
+        else:
+            self._high_watermark = finder.getHighWatermark()
 
     def __dealloc__(self):
         self.close()
@@ -401,10 +664,18 @@ cdef class FileReader:
     def __exit__(self, exc_type, exc_value, exc_traceback):
         self.close()
 
-    def _yield_unfreed_allocations(self, size_t records_to_process, bool merge_threads):
+    def _yield_unfreed_allocations(self, size_t records_to_process, bool merge_threads,
+                                   long long stop_time=0):
         cdef SnapshotAllocationAggregator aggregator
+        cdef unique_ptr[SpillingSnapshotAggregator] spilling_aggregator
+        if self._spill_directory is not None:
+            spilling_aggregator = unique_ptr[SpillingSnapshotAggregator](
+                new SpillingSnapshotAggregator(self._spill_directory)
+            )
         cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
-            unique_ptr[FileSource](new FileSource(self._path))
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
         )
         cdef RecordReader* reader = reader_sp.get()
 
@@ -412,16 +683,27 @@ cdef class FileReader:
             PyErr_CheckSignals()
             ret = reader.nextRecord()
             if ret == RecordResult.RecordResultAllocationRecord:
-                aggregator.addAllocation(reader.getLatestAllocation())
+                if stop_time and reader.getLatestAllocation().timestamp > stop_time:
+                    break
+                if spilling_aggregator.get() != NULL:
+                    spilling_aggregator.get().addAllocation(reader.getLatestAllocation())
+                else:
+                    aggregator.addAllocation(reader.getLatestAllocation())
                 records_to_process -= 1
             elif ret == RecordResult.RecordResultMemoryRecord:
                 pass
             else:
                 break
 
-        for elem in Py_ListFromSnapshotAllocationRecords(
-            aggregator.getSnapshotAllocations(merge_threads)
-        ):
+        cdef reduced_snapshot_map_t snapshot
+        if spilling_aggregator.get() != NULL:
+            with nogil:
+                snapshot = spilling_aggregator.get().getSnapshotAllocations(merge_threads)
+            spilling_aggregator.reset()
+        else:
+            snapshot = aggregator.getSnapshotAllocations(merge_threads)
+
+        for elem in Py_ListFromSnapshotAllocationRecords(snapshot):
             alloc = AllocationRecord(elem)
             (<AllocationRecord> alloc)._reader = reader_sp
             yield alloc
@@ -439,10 +721,261 @@ cdef class FileReader:
         cdef size_t max_records = numeric_limits[size_t].max()
         yield from self._yield_unfreed_allocations(max_records, merge_threads)
 
+    cdef size_t _allocation_records_before(self, long long ms_since_epoch):
+        # The allocation records that precede the first memory record taken
+        # after the given time, found by bisecting the memory records.
+        cdef size_t lo = 0
+        cdef size_t hi = self._memory_records.size()
+        cdef size_t mid
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if <long long> self._memory_records[mid].ms_since_epoch <= ms_since_epoch:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo == self._memory_records.size():
+            return numeric_limits[size_t].max()
+        return self._memory_record_indices[lo]
+
+    cdef tuple _resolve_point(self, object time_or_index):
+        # The number of allocation records to process to reach a point of the
+        # capture, and the time of the point if it was given as one.
+        cdef long long point_time = 0
+        cdef size_t max_records
+        if isinstance(time_or_index, int):
+            if time_or_index < 0:
+                raise ValueError(
+                    f"The allocation record index can't be negative: {time_or_index}"
+                )
+            max_records = time_or_index
+        elif isinstance(time_or_index, (datetime, timedelta)):
+            if isinstance(time_or_index, timedelta):
+                point_time = (self._header["stats"]["start_time"]
+                              + time_or_index // timedelta(milliseconds=1))
+            else:
+                point_time = int(time_or_index.timestamp() * 1000)
+            max_records = self._allocation_records_before(point_time)
+        else:
+            raise TypeError(
+                "Expected a datetime, a timedelta, or an allocation record index,"
+                f" not {type(time_or_index).__name__}"
+            )
+        return max_records, point_time
+
+    def get_snapshot_at(self, time_or_index, merge_threads=True):
+        """Yield the allocations that were alive at a given point of the capture.
+
+        *time_or_index* can be a `datetime.timedelta` since the start of the
+        tracking, a `datetime.datetime`, or an `int` with the number of
+        allocation records to process, counting from the start of the
+        capture. Only the records up to that point are read: the memory
+        records found when the `FileReader` was created tell which allocation
+        records precede a given time. If the capture has allocation
+        timestamps, the snapshot stops exactly at the given time, otherwise
+        it stops at the first memory record after it.
+        """
+        self._ensure_not_closed()
+        max_records, stop_time = self._resolve_point(time_or_index)
+        if not self._header["timestamps"]:
+            stop_time = 0
+        return self._yield_unfreed_allocations(max_records, merge_threads, stop_time)
+
+    def get_allocation_lifetime_records(self, merge_threads=True):
+        """Yield how long the allocations made at each location lived.
+
+        An `AllocationLifetimeRecord` is produced for every location, with an
+        `AllocationRecord` aggregating the allocations made there, how many of
+        them were freed, and the median and 90th percentile of their
+        lifetimes. Lifetimes are measured in records of the capture, and the
+        histogram is a list of ``(lower_bound, count)`` pairs for each bucket
+        of lifetimes that isn't empty. Memory mappings are not included.
+        """
+        self._ensure_not_closed()
+        cdef unique_ptr[AllocationLifetimeAggregator] aggregator = unique_ptr[
+            AllocationLifetimeAggregator
+        ](new AllocationLifetimeAggregator(merge_threads))
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
+        )
+        cdef RecordReader* reader = reader_sp.get()
+
+        while True:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                aggregator.get().addAllocation(reader.getLatestAllocation())
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                pass
+            else:
+                break
+
+        cdef vector[SiteLifetimes] sites = aggregator.get().getSiteLifetimes()
+        aggregator.reset()
+        for site in sites:
+            alloc = AllocationRecord(site.allocation.toPythonObject())
+            (<AllocationRecord> alloc)._reader = reader_sp
+            yield AllocationLifetimeRecord(
+                alloc,
+                site.n_freed,
+                site.lifetimes.quantile(0.5),
+                site.lifetimes.quantile(0.9),
+                site.lifetimes.buckets(),
+            )
+
+        reader.close()
+
+    def get_temporal_allocation_records(self, merge_threads=True):
+        """Yield how much memory each location had alive over time.
+
+        A snapshot of the heap is taken at each memory record of the capture,
+        and one more at its end, so snapshot ``i`` matches the ``i``-th
+        record of `get_memory_records`. A `TemporalAllocationRecord` is
+        produced for every location that had memory alive in any snapshot,
+        with an `AllocationRecord` for the first allocation made there and a
+        list of ``(begin, end, n_allocations, n_bytes)`` intervals: from
+        snapshot ``begin`` up to, but not including, snapshot ``end``, the
+        location had *n_allocations* allocations alive using *n_bytes* bytes.
+        Locations don't use memory in the snapshots that no interval covers.
+        """
+        self._ensure_not_closed()
+        cdef unique_ptr[TemporalAllocationAggregator] aggregator = unique_ptr[
+            TemporalAllocationAggregator
+        ](new TemporalAllocationAggregator(merge_threads))
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
+        )
+        cdef RecordReader* reader = reader_sp.get()
+
+        while True:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                aggregator.get().addAllocation(reader.getLatestAllocation())
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                aggregator.get().captureSnapshot()
+            else:
+                break
+        aggregator.get().captureSnapshot()
+
+        cdef vector[TemporalLocation] locations = aggregator.get().getTemporalLocations()
+        aggregator.reset()
+        for location in locations:
+            alloc = AllocationRecord(location.allocation.toPythonObject())
+            (<AllocationRecord> alloc)._reader = reader_sp
+            yield TemporalAllocationRecord(
+                alloc,
+                [
+                    (interval.begin, interval.end, interval.n_allocations, interval.n_bytes)
+                    for interval in location.intervals
+                ],
+            )
+
+        reader.close()
+
+    def get_page_occupancy_records(self, *, size_t page_size=4096,
+                                   double sparse_threshold=0.5):
+        """Yield how the live heap allocations occupy pages over time.
+
+        A `PageOccupancyRecord` is produced for every memory record in the
+        capture, with the resident set size that the tracked process had at
+        that time and the pages that its live heap allocations were occupying.
+        Pages that less than *sparse_threshold* of their bytes are used by live
+        allocations are counted as sparse pages. Regions are aligned 2 MiB
+        blocks of the address space that contain occupied pages.
+        """
+        self._ensure_not_closed()
+        _check_page_occupancy_arguments(page_size, sparse_threshold)
+        cdef unique_ptr[PageOccupancyAggregator] aggregator = unique_ptr[
+            PageOccupancyAggregator
+        ](new PageOccupancyAggregator(page_size, sparse_threshold))
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            False
+        )
+        cdef RecordReader* reader = reader_sp.get()
+        cdef _MemoryRecord memory_record
+        cdef PageOccupancy occupancy
+
+        while True:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                aggregator.get().addAllocation(reader.getLatestAllocation())
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                memory_record = reader.getLatestMemoryRecord()
+                occupancy = aggregator.get().getOccupancy()
+                yield PageOccupancyRecord(
+                    memory_record.ms_since_epoch,
+                    memory_record.rss,
+                    occupancy.heap_size,
+                    occupancy.occupied_pages,
+                    occupancy.partially_used_pages,
+                    occupancy.sparse_pages,
+                    occupancy.regions,
+                )
+            else:
+                break
+
+        reader.close()
+
+    def get_sparse_page_allocation_records(self, *, bool leaks=False,
+                                           bool merge_threads=True,
+                                           size_t page_size=4096,
+                                           double sparse_threshold=0.5):
+        """Yield the allocations that keep mostly empty pages occupied.
+
+        The live heap allocations are taken at the moment of the peak memory
+        usage, or at the end of the capture if *leaks* is True. Allocations
+        made at the same location are aggregated into a single record whose
+        ``n_allocations`` is the number of them that live on sparse pages, and
+        whose ``size`` is the unused part of those pages, split evenly between
+        the allocations that share each page.
+        """
+        self._ensure_not_closed()
+        _check_page_occupancy_arguments(page_size, sparse_threshold)
+        cdef size_t records_to_process = self._high_watermark.index + 1
+        if leaks:
+            records_to_process = numeric_limits[size_t].max()
+        cdef unique_ptr[PageOccupancyAggregator] aggregator = unique_ptr[
+            PageOccupancyAggregator
+        ](new PageOccupancyAggregator(page_size, sparse_threshold))
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
+        )
+        cdef RecordReader* reader = reader_sp.get()
+
+        while records_to_process > 0:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                aggregator.get().addAllocation(reader.getLatestAllocation())
+                records_to_process -= 1
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                pass
+            else:
+                break
+
+        for elem in Py_ListFromSnapshotAllocationRecords(
+            aggregator.get().getSparsePageAllocations(merge_threads)
+        ):
+            alloc = AllocationRecord(elem)
+            (<AllocationRecord> alloc)._reader = reader_sp
+            yield alloc
+
+        reader.close()
+
     def get_allocation_records(self):
         self._ensure_not_closed()
         cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
-            unique_ptr[FileSource](new FileSource(self._path))
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
         )
         cdef RecordReader* reader = reader_sp.get()
 
@@ -460,33 +993,375 @@ cdef class FileReader:
 
         reader.close()
 
+    cdef unique_ptr[Sink] _make_rewrite_sink(self, object destination, bool overwrite,
+                                             bool compress) except *:
+        cdef str path = str(destination)
+        if os.path.exists(path) and os.path.samefile(path, self._path):
+            raise ValueError(f"Can't overwrite the capture being read: {path}")
+        return unique_ptr[Sink](new FileSink(path, overwrite, compress))
+
+    def write_slice(self, destination, start=None, end=None, *, bool overwrite=False,
+                    bool compress=True):
+        """Write the records between two points of the capture to a new capture.
+
+        *start* and *end* accept the same values as the *time_or_index*
+        argument of `get_snapshot_at`, and default to the start and the end of
+        the capture. The allocations that are still alive at *start* are
+        written first, so the new capture accounts for all the memory in use
+        during the slice. Only the frames, native frames and memory maps that
+        the written allocations need are copied, and times stay relative to
+        the start of the original capture.
+
+        Returns the number of allocation records written.
+        """
+        self._ensure_not_closed()
+        cdef size_t start_index = 0
+        cdef size_t end_index = numeric_limits[size_t].max()
+        cdef long long start_time = 0
+        cdef long long end_time = 0
+        if start is not None:
+            start_index, start_time = self._resolve_point(start)
+        if end is not None:
+            end_index, end_time = self._resolve_point(end)
+        cdef bool timestamps = self._header["timestamps"]
+        if start_time and start_time <= self._header["stats"]["start_time"]:
+            start = None
+        elif start_time and timestamps:
+            # The timestamps tell exactly where the slice starts.
+            start_index = 0
+
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
+        )
+        cdef RecordReader* reader = reader_sp.get()
+        cdef unique_ptr[CaptureRewriter] rewriter = unique_ptr[CaptureRewriter](
+            new CaptureRewriter(
+                reader[0], move(self._make_rewrite_sink(destination, overwrite, compress))
+            )
+        )
+        cdef SnapshotAllocationAggregator live_allocations
+        cdef bool started = start is None
+        cdef bool stopped = False
+        cdef size_t n_allocation_records = 0
+        cdef long long last_time = 0
+        cdef _Allocation allocation
+        cdef _MemoryRecord memory_record
+
+        while True:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                allocation = reader.getLatestAllocation()
+                if n_allocation_records >= end_index or (
+                    end_time and timestamps and allocation.timestamp > end_time
+                ):
+                    stopped = True
+                    break
+                n_allocation_records += 1
+                if not started and n_allocation_records > start_index and (
+                    not start_time or not timestamps or allocation.timestamp > start_time
+                ):
+                    started = True
+                    rewriter.get().writeLiveAllocations(
+                        live_allocations.getLiveAllocations()
+                    )
+                if not started:
+                    live_allocations.addAllocation(allocation)
+                    continue
+                rewriter.get().writeAllocation(allocation)
+                last_time = max(last_time, allocation.timestamp)
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                memory_record = reader.getLatestMemoryRecord()
+                if end_time and <long long> memory_record.ms_since_epoch > end_time:
+                    stopped = True
+                    break
+                if not started and (
+                    <long long> memory_record.ms_since_epoch > start_time
+                    if start_time else n_allocation_records >= start_index
+                ):
+                    started = True
+                    rewriter.get().writeLiveAllocations(
+                        live_allocations.getLiveAllocations()
+                    )
+                if started:
+                    rewriter.get().writeMemoryRecord(memory_record)
+                    last_time = max(last_time, <long long> memory_record.ms_since_epoch)
+            else:
+                break
+
+        if not started:
+            # The slice starts after the last record, when only the memory
+            # that was never freed is left.
+            rewriter.get().writeLiveAllocations(live_allocations.getLiveAllocations())
+
+        cdef long long capture_end_time = self._header["stats"]["end_time"]
+        if stopped and end_time:
+            capture_end_time = min(capture_end_time, end_time)
+        elif stopped and last_time:
+            capture_end_time = last_time
+        rewriter.get().finish(capture_end_time)
+        cdef size_t written = rewriter.get().allocationsWritten()
+        rewriter.reset()
+        reader.close()
+        return written
+
+    def write_compacted(self, destination, *, size_t max_lifetime=1000,
+                        bool overwrite=False, bool compress=True):
+        """Write a smaller copy of the capture, without its short-lived allocations.
+
+        Allocations that are freed within *max_lifetime* allocation records
+        are left out of the new capture, along with their deallocations, and
+        so are the frames that only they used. The memory that is still in use
+        at any point of the capture is unaffected, so leaks and the memory
+        that accumulates over time can be studied in the compacted capture,
+        but the peak memory usage may be lower than in the original one.
+        Memory mappings are always kept.
+
+        Returns the number of allocation records written.
+        """
+        self._ensure_not_closed()
+        cdef shared_ptr[RecordReader] reader_sp = make_shared[RecordReader](
+            unique_ptr[FileSource](new FileSource(self._path)),
+            True,
+            self._symbol_cache
+        )
+        cdef RecordReader* reader = reader_sp.get()
+        cdef unique_ptr[CaptureRewriter] rewriter = unique_ptr[CaptureRewriter](
+            new CaptureRewriter(
+                reader[0], move(self._make_rewrite_sink(destination, overwrite, compress))
+            )
+        )
+        cdef unique_ptr[CaptureCompactor] compactor = unique_ptr[CaptureCompactor](
+            new CaptureCompactor(rewriter.get()[0], max_lifetime)
+        )
+
+        while True:
+            PyErr_CheckSignals()
+            ret = reader.nextRecord()
+            if ret == RecordResult.RecordResultAllocationRecord:
+                compactor.get().addAllocation(reader.getLatestAllocation())
+            elif ret == RecordResult.RecordResultMemoryRecord:
+                compactor.get().addMemoryRecord(reader.getLatestMemoryRecord())
+            else:
+                break
+
+        compactor.get().flush()
+        rewriter.get().finish(self._header["stats"]["end_time"])
+        cdef size_t written = rewriter.get().allocationsWritten()
+        compactor.reset()
+        rewriter.reset()
+        reader.close()
+        return written
+
     def get_memory_records(self):
         for record in self._memory_records:
             yield MemoryRecord(record.ms_since_epoch, record.rss)
 
     @property
     def metadata(self):
-        def millis_to_dt(millis) -> datetime:
-            return datetime.fromtimestamp(millis // 1000).replace(
-                microsecond=millis % 1000 * 1000)
+        return _metadata_from_header(self._header, self._high_watermark.peak_memory)
+
+
+cdef void _add_snapshot_to_diff(FileReader reader, SnapshotDiffAggregator* aggregator,
+                                bool baseline, bool leaks) except *:
+    reader._ensure_not_closed()
+    cdef size_t records_to_process = reader._high_watermark.index + 1
+    if leaks:
+        records_to_process = numeric_limits[size_t].max()
+    cdef SnapshotAllocationAggregator snapshot
+    cdef unique_ptr[RecordReader] record_reader = make_unique[RecordReader](
+        unique_ptr[FileSource](new FileSource(reader._path)),
+        True,
+        reader._symbol_cache
+    )
+
+    while records_to_process > 0:
+        PyErr_CheckSignals()
+        ret = record_reader.get().nextRecord()
+        if ret == RecordResult.RecordResultAllocationRecord:
+            snapshot.addAllocation(record_reader.get().getLatestAllocation())
+            records_to_process -= 1
+        elif ret == RecordResult.RecordResultMemoryRecord:
+            pass
+        else:
+            break
 
-        stats = self._header["stats"]
-        allocator_id_to_name = {
-            PythonAllocatorType.PYTHON_ALLOCATOR_PYMALLOC: "pymalloc",
-            PythonAllocatorType.PYTHON_ALLOCATOR_PYMALLOC_DEBUG: "pymalloc debug",
-            PythonAllocatorType.PYTHON_ALLOCATOR_MALLOC: "malloc",
-            PythonAllocatorType.PYTHON_ALLOCATOR_OTHER: "unknown",
-        }
-        python_allocator = allocator_id_to_name[self._header["python_allocator"]]
-        return Metadata(start_time=millis_to_dt(stats["start_time"]),
-                        end_time=millis_to_dt(stats["end_time"]),
-                        total_allocations=stats["n_allocations"],
-                        total_frames=stats["n_frames"],
-                        peak_memory=self._high_watermark.peak_memory,
-                        command_line=self._header["command_line"],
-                        pid=self._header["pid"],
-                        python_allocator=python_allocator,
-                        has_native_traces=self._header["native_traces"])
+    if baseline:
+        aggregator.addBaseline(record_reader.get()[0], snapshot.getSnapshotAllocations(True))
+    else:
+        aggregator.addCandidate(record_reader.get()[0], snapshot.getSnapshotAllocations(True))
+    record_reader.get().close()
+
+
+def compute_snapshot_diff(FileReader baseline, FileReader candidate, *, bool leaks=False):
+    """Compare the memory in use in two captures, allocation site by allocation site.
+
+    The snapshots at the peak memory usage of each capture are compared, or
+    the leaks of each capture if *leaks* is True. The captures are read one
+    after the other, and the allocation sites of both snapshots are matched on
+    the function, file and line of each frame of their Python stacks, so the
+    captures can come from different builds or runs of a program.
+
+    A list of `SnapshotDiffRecord` is returned, with one record for each
+    allocation site that had memory in either snapshot, sorted by how much its
+    size changed, from the biggest change to the smallest. The stack trace of
+    each record is a list of ``(function, filename, lineno)`` tuples, from the
+    innermost frame to the outermost one.
+    """
+    cdef unique_ptr[SnapshotDiffAggregator] aggregator = make_unique[SnapshotDiffAggregator]()
+    _add_snapshot_to_diff(baseline, aggregator.get(), True, leaks)
+    _add_snapshot_to_diff(candidate, aggregator.get(), False, leaks)
+
+    cdef vector[LocationDelta] deltas = aggregator.get().getLocationDeltas()
+    aggregator.reset()
+    return [
+        SnapshotDiffRecord(
+            [(frame.function_name, frame.filename, frame.lineno) for frame in delta.stack],
+            delta.size_before,
+            delta.n_allocations_before,
+            delta.size_after,
+            delta.n_allocations_after,
+        )
+        for delta in deltas
+    ]
+
+
+cdef class MultiFileReader:
+    """Read the captures of several processes as if they were one.
+
+    This is meant for the captures that ``memray run --follow-fork`` writes
+    for every process that the tracked one forks. Every capture is decoded on
+    its own thread, and the allocation sites of all of them are matched on the
+    function, file and line of each frame of their Python stacks, so their
+    snapshots can be added together or grouped by process.
+    """
+
+    cdef list _files
+    cdef unique_ptr[MultiCaptureReader] _reader
+
+    def __cinit__(self, object file_names):
+        self._files = []
+        for file_name in file_names:
+            try:
+                self._files.append(open(file_name))
+            except OSError as exc:
+                self.close()
+                raise OSError(f"Could not open file {file_name}: {exc.strerror}") from None
+        if not self._files:
+            raise ValueError("At least one capture file is needed")
+
+        cdef vector[cppstring] paths
+        for file in self._files:
+            paths.push_back("/proc/self/fd/" + str(file.fileno()))
+        self._reader = unique_ptr[MultiCaptureReader](new MultiCaptureReader(paths))
+
+        # Initial pass, reading every capture concurrently to find their
+        # headers, high watermarks and memory records.
+        with nogil:
+            self._reader.get().readSummaries()
+
+    def __dealloc__(self):
+        self.close()
+
+    cpdef close(self):
+        if self._files is None:
+            return
+        files = self._files
+        self._files = None
+        for file in files:
+            file.close()
+
+    cdef void _ensure_not_closed(self) except *:
+        if self._files is None:
+            raise ValueError("Operation on a closed MultiFileReader")
+
+    @property
+    def closed(self):
+        return self._files is None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, exc_traceback):
+        self.close()
+
+    @property
+    def process_metadata(self):
+        """The metadata of every capture, in the order that they were given."""
+        cdef vector[CaptureSummary] summaries = self._reader.get().getSummaries()
+        return [
+            _metadata_from_header(summary.header, summary.high_watermark.peak_memory)
+            for summary in summaries
+        ]
+
+    @property
+    def metadata(self):
+        """The metadata of all the captures together.
+
+        The command line and pid are the ones of the first capture, and the
+        peak memory usage is the sum of the peaks of every process, even if
+        they didn't happen at the same time.
+        """
+        processes = self.process_metadata
+        first = processes[0]
+        return Metadata(
+            start_time=min(metadata.start_time for metadata in processes),
+            end_time=max(metadata.end_time for metadata in processes),
+            total_allocations=sum(metadata.total_allocations for metadata in processes),
+            total_frames=sum(metadata.total_frames for metadata in processes),
+            peak_memory=sum(metadata.peak_memory for metadata in processes),
+            command_line=first.command_line,
+            pid=first.pid,
+            python_allocator=first.python_allocator,
+            has_native_traces=all(metadata.has_native_traces for metadata in processes),
+            has_timestamps=all(metadata.has_timestamps for metadata in processes),
+            dropped_by_size=sum(metadata.dropped_by_size for metadata in processes),
+            dropped_by_allocator=sum(
+                metadata.dropped_by_allocator for metadata in processes
+            ),
+            dropped_by_thread=sum(metadata.dropped_by_thread for metadata in processes),
+        )
+
+    def get_memory_records(self):
+        """The resident set size of all the processes added together."""
+        self._ensure_not_closed()
+        for record in self._reader.get().getMergedMemoryRecords():
+            yield MemoryRecord(record.ms_since_epoch, record.rss)
+
+    def _get_snapshot_records(self, bool leaks, bool merge_processes):
+        self._ensure_not_closed()
+        cdef vector[ProcessLocation] locations
+        with nogil:
+            locations = self._reader.get().getSnapshotLocations(leaks, merge_processes)
+        return [
+            ProcessAllocationRecord(
+                None if merge_processes else location.pid,
+                [(frame.function_name, frame.filename, frame.lineno) for frame in location.stack],
+                location.size,
+                location.n_allocations,
+            )
+            for location in locations
+        ]
+
+    def get_high_watermark_allocation_records(self, merge_processes=True):
+        """Get the memory in use at the peak memory usage of every process.
+
+        A list of `ProcessAllocationRecord` is returned, with one record for
+        each allocation site, or for each allocation site of each process if
+        *merge_processes* is False, sorted by size from the biggest. The stack
+        trace of each record is a list of ``(function, filename, lineno)``
+        tuples, from the innermost frame to the outermost one.
+        """
+        return self._get_snapshot_records(False, merge_processes)
+
+    def get_leaked_allocation_records(self, merge_processes=True):
+        """Get the memory that every process leaked.
+
+        The records are returned like in `get_high_watermark_allocation_records`.
+        """
+        return self._get_snapshot_records(True, merge_processes)
 
 
 def dump_all_records(object file_name):
@@ -499,6 +1374,38 @@ def dump_all_records(object file_name):
     _reader.get().dumpAllRecords()
 
 
+def replay_allocations(object file_name, *, bool preserve_order=False):
+    cdef str path = str(file_name)
+    if not pathlib.Path(path).exists():
+        raise IOError(f"No such file: {path}")
+
+    cdef unique_ptr[RecordReader] reader = make_unique[RecordReader](
+        unique_ptr[FileSource](new FileSource(path)), False
+    )
+    cdef unique_ptr[AllocationReplayer] replayer = unique_ptr[AllocationReplayer](
+        new AllocationReplayer(preserve_order)
+    )
+    if not replayer.get().loadCapture(reader.get()[0]):
+        raise IOError(f"Failed to read the allocations in {path}")
+    reader.reset()
+
+    cdef ReplayStats stats
+    with nogil:
+        stats = replayer.get().replay()
+
+    return {
+        "threads": stats.threads,
+        "operations": stats.operations,
+        "skipped_records": stats.skipped_records,
+        "failed_allocations": stats.failed_allocations,
+        "seconds": stats.seconds,
+        "peak_live_bytes": stats.peak_live_bytes,
+        "final_live_bytes": stats.final_live_bytes,
+        "peak_rss": stats.peak_rss,
+        "final_rss": stats.final_rss,
+    }
+
+
 cdef class SocketReader:
     cdef BackgroundSocketReader* _impl
     cdef shared_ptr[RecordReader] _reader
@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <ios>
+#include <tuple>
+#include <utility>
+
+#include "capture_rewriter.h"
+
+namespace memray::api {
+
+CaptureRewriter::CaptureRewriter(RecordReader& reader, std::unique_ptr<io::Sink> sink)
+: d_reader(reader)
+, d_header(reader.getHeader())
+, d_writer(std::move(sink), d_header)
+{
+    if (!d_writer.writeHeader(false)) {
+        throw std::ios_base::failure("Failed to write the header of the new capture");
+    }
+}
+
+template<typename T>
+void
+CaptureRewriter::write(const T& record)
+{
+    if (!d_writer.writeRecord(record)) {
+        throw std::ios_base::failure("Failed to write to the new capture");
+    }
+}
+
+template<typename T>
+void
+CaptureRewriter::writeForThread(thread_id_t tid, const T& record)
+{
+    if (!d_writer.writeThreadSpecificRecord(tid, record)) {
+        throw std::ios_base::failure("Failed to write to the new capture");
+    }
+}
+
+CaptureRewriter::ThreadState&
+CaptureRewriter::threadState(thread_id_t tid)
+{
+    if (d_last_thread != nullptr && d_last_tid == tid) {
+        return *d_last_thread;
+    }
+    ThreadState& thread = d_threads[tid];
+    d_last_tid = tid;
+    d_last_thread = &thread;
+    // Thread names can change at any time, so look for a new one whenever
+    // another thread starts allocating.
+    writeThreadName(tid, thread);
+    return thread;
+}
+
+void
+CaptureRewriter::writeThreadName(thread_id_t tid, ThreadState& thread)
+{
+    std::string name = d_reader.getThreadName(tid);
+    if (!name.empty() && name != thread.name) {
+        writeForThread(tid, ThreadRecord{name.c_str()});
+        thread.name = std::move(name);
+    }
+}
+
+void
+CaptureRewriter::moveStack(thread_id_t tid, ThreadState& thread, FrameTree::index_t frame_index)
+{
+    if (thread.frame_index == frame_index) {
+        return;
+    }
+
+    // The reader gives the innermost frame first, but the thread's stack
+    // keeps the outermost one first, as they are pushed.
+    std::vector<frame_id_t> frame_ids = d_reader.getStackFrameIds(frame_index);
+    std::reverse(frame_ids.begin(), frame_ids.end());
+
+    auto [first_change, unused] =
+            std::mismatch(thread.stack.begin(), thread.stack.end(), frame_ids.begin(), frame_ids.end());
+    size_t common = first_change - thread.stack.begin();
+    if (thread.stack.size() > common) {
+        writeForThread(tid, FramePop{thread.stack.size() - common});
+        thread.stack.resize(common);
+    }
+
+    for (size_t i = common; i < frame_ids.size(); ++i) {
+        frame_id_t frame_id = frame_ids[i];
+        if (d_written_frames.insert(frame_id).second) {
+            Frame frame = d_reader.getFrame(frame_id);
+            RawFrame raw_frame{frame.function_name.c_str(), frame.filename.c_str(), frame.lineno};
+            write(pyrawframe_map_val_t{frame_id, raw_frame});
+        }
+        writeForThread(tid, FramePush{frame_id});
+        thread.stack.push_back(frame_id);
+    }
+    thread.frame_index = frame_index;
+}
+
+size_t
+CaptureRewriter::writeNativeFrame(size_t index)
+{
+    // Find the frames of the chain that weren't written yet, and write them
+    // from the outermost one, so every frame can refer to its parent.
+    std::vector<std::pair<size_t, UnresolvedNativeFrame>> missing;
+    while (index != 0 && d_native_frame_indices.find(index) == d_native_frame_indices.end()) {
+        UnresolvedNativeFrame frame = d_reader.getNativeFrame(index);
+        missing.emplace_back(index, frame);
+        index = frame.index;
+    }
+
+    size_t parent = index == 0 ? 0 : d_native_frame_indices[index];
+    for (auto it = missing.rbegin(); it != missing.rend(); ++it) {
+        write(UnresolvedNativeFrame{it->second.ip, parent});
+        parent = d_native_frame_indices.size() + 1;
+        d_native_frame_indices.emplace(it->first, parent);
+    }
+    return parent;
+}
+
+void
+CaptureRewriter::writeMemoryMaps(size_t generation)
+{
+    // Every generation only holds the changes since the previous one, so all
+    // of them are needed to rebuild the memory map of a later one.
+    while (d_memory_map_generation < generation) {
+        ++d_memory_map_generation;
+        write(MemoryMapStart{});
+        for (const auto& image : d_reader.getMemoryMap(d_memory_map_generation)) {
+            write(SegmentHeader{
+                    image.filename.c_str(),
+                    image.segments.size(),
+                    image.addr,
+                    image.removed});
+            for (const auto& segment : image.segments) {
+                write(segment);
+            }
+        }
+    }
+}
+
+void
+CaptureRewriter::writeAllocation(const Allocation& allocation)
+{
+    ThreadState& thread = threadState(allocation.tid);
+
+    if (d_header.timestamps) {
+        millis_t ms_since_start = allocation.timestamp - d_header.stats.start_time;
+        if (ms_since_start != d_last_timestamp) {
+            write(Timestamp{ms_since_start});
+            d_last_timestamp = ms_since_start;
+        }
+    }
+
+    // The stack of a deallocation is never read.
+    if (!hooks::isDeallocator(allocation.allocator)) {
+        moveStack(allocation.tid, thread, allocation.frame_index);
+    }
+
+    if (allocation.native_frame_id != 0) {
+        writeMemoryMaps(allocation.native_segment_generation);
+        NativeAllocationRecord record{
+                allocation.address,
+                allocation.size,
+                allocation.allocator,
+                writeNativeFrame(allocation.native_frame_id),
+                allocation.pool_id};
+        writeForThread(allocation.tid, record);
+    } else {
+        AllocationRecord record{
+                allocation.address,
+                allocation.size,
+                allocation.allocator,
+                allocation.pool_id};
+        writeForThread(allocation.tid, record);
+    }
+    ++d_allocations_written;
+}
+
+void
+CaptureRewriter::writeMemoryRecord(const MemoryRecord& record)
+{
+    write(record);
+}
+
+void
+CaptureRewriter::writeLiveAllocations(std::vector<Allocation> allocations)
+{
+    // Without timestamps, the memory map generation is the only clue left
+    // about the order in which the allocations were made.
+    std::stable_sort(allocations.begin(), allocations.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.timestamp, lhs.native_segment_generation)
+               < std::tie(rhs.timestamp, rhs.native_segment_generation);
+    });
+    for (const auto& allocation : allocations) {
+        writeAllocation(allocation);
+    }
+}
+
+void
+CaptureRewriter::finish(millis_t end_time)
+{
+    for (auto& [tid, thread] : d_threads) {
+        writeThreadName(tid, thread);
+    }
+    d_writer.setEndTime(end_time);
+    if (!d_writer.writeHeader(true)) {
+        throw std::ios_base::failure("Failed to write the header of the new capture");
+    }
+}
+
+size_t
+CaptureRewriter::allocationsWritten() const noexcept
+{
+    return d_allocations_written;
+}
+
+CaptureCompactor::CaptureCompactor(CaptureRewriter& rewriter, size_t max_lifetime)
+: d_rewriter(rewriter)
+, d_max_lifetime(max_lifetime)
+{
+}
+
+void
+CaptureCompactor::addAllocation(const Allocation& allocation)
+{
+    size_t index = d_allocation_index++;
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
+            auto it = d_droppable.find(AllocationKey(allocation));
+            if (it != d_droppable.end()) {
+                d_pending[it->second - d_first_pending].dropped = true;
+                d_droppable.erase(it);
+                writeRecordsBefore(index);
+                return;
+            }
+            break;
+        }
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
+            if (d_max_lifetime != 0) {
+                d_droppable[AllocationKey(allocation)] = d_first_pending + d_pending.size();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    d_pending.push_back({true, false, index, allocation, {}});
+    writeRecordsBefore(index);
+}
+
+void
+CaptureCompactor::addMemoryRecord(const MemoryRecord& record)
+{
+    d_pending.push_back({false, false, d_allocation_index, {}, record});
+    writeRecordsBefore(d_allocation_index);
+}
+
+void
+CaptureCompactor::writeRecordsBefore(size_t allocation_index)
+{
+    // An allocation can be written once it's too old for a deallocation to
+    // drop it. Memory records are written as soon as the allocations that
+    // precede them are.
+    while (!d_pending.empty()) {
+        const PendingRecord& record = d_pending.front();
+        if (record.is_allocation && record.index + d_max_lifetime > allocation_index) {
+            break;
+        }
+        if (!record.is_allocation) {
+            d_rewriter.writeMemoryRecord(record.memory_record);
+        } else if (!record.dropped) {
+            auto it = d_droppable.find(AllocationKey(record.allocation));
+            if (it != d_droppable.end() && it->second == d_first_pending) {
+                d_droppable.erase(it);
+            }
+            d_rewriter.writeAllocation(record.allocation);
+        }
+        d_pending.pop_front();
+        ++d_first_pending;
+    }
+}
+
+void
+CaptureCompactor::flush()
+{
+    d_droppable.clear();
+    for (const auto& record : d_pending) {
+        if (!record.is_allocation) {
+            d_rewriter.writeMemoryRecord(record.memory_record);
+        } else if (!record.dropped) {
+            d_rewriter.writeAllocation(record.allocation);
+        }
+    }
+    d_first_pending += d_pending.size();
+    d_pending.clear();
+}
+
+}  // namespace memray::api
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "record_reader.h"
+#include "record_writer.h"
+#include "records.h"
+#include "sink.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+/**
+ * Writes a new capture with some of the allocations read from another one.
+ *
+ * Nothing is copied until an allocation needs it: the Python frames of its
+ * stack, the chain of its native frames and the memory maps to resolve them
+ * are written right before the allocation is, so the frames that no written
+ * allocation uses are left out. The frame push and pop records that each
+ * thread needs to reach the stack of an allocation are synthesized from the
+ * stacks that the reader resolved, which also allows writing allocations that
+ * are not next to each other in the original capture.
+ *
+ * The header of the original capture is kept, including its start time, so
+ * the times of the records don't change.
+ **/
+class CaptureRewriter
+{
+  public:
+    CaptureRewriter(RecordReader& reader, std::unique_ptr<io::Sink> sink);
+
+    void writeAllocation(const Allocation& allocation);
+    void writeMemoryRecord(const MemoryRecord& record);
+    // Write allocations that were made before the rewriting started, oldest first.
+    void writeLiveAllocations(std::vector<Allocation> allocations);
+    void finish(millis_t end_time);
+
+    size_t allocationsWritten() const noexcept;
+
+  private:
+    struct ThreadState
+    {
+        FrameTree::index_t frame_index{0};
+        std::vector<frame_id_t> stack;
+        std::string name;
+    };
+
+    ThreadState& threadState(thread_id_t tid);
+    void writeThreadName(thread_id_t tid, ThreadState& thread);
+    void moveStack(thread_id_t tid, ThreadState& thread, FrameTree::index_t frame_index);
+    size_t writeNativeFrame(size_t index);
+    void writeMemoryMaps(size_t generation);
+    template<typename T>
+    void write(const T& record);
+    template<typename T>
+    void writeForThread(thread_id_t tid, const T& record);
+
+    RecordReader& d_reader;
+    const HeaderRecord d_header;
+    RecordWriter d_writer;
+    std::unordered_map<thread_id_t, ThreadState> d_threads;
+    thread_id_t d_last_tid{0};
+    ThreadState* d_last_thread{nullptr};
+    std::unordered_set<frame_id_t> d_written_frames;
+    // The index in the new capture of each native frame that was written.
+    std::unordered_map<size_t, size_t> d_native_frame_indices;
+    size_t d_memory_map_generation{0};
+    millis_t d_last_timestamp{0};
+    size_t d_allocations_written{0};
+};
+
+/**
+ * Forwards allocations to a CaptureRewriter, except for the ones that are
+ * freed within a given number of allocation records, which are dropped along
+ * with their deallocations.
+ *
+ * Allocations are held back only until it's known whether they are freed in
+ * time, so the memory used is bounded by the maximum lifetime. Memory
+ * mappings are always kept, as they can be partially unmapped.
+ **/
+class CaptureCompactor
+{
+  public:
+    CaptureCompactor(CaptureRewriter& rewriter, size_t max_lifetime);
+
+    void addAllocation(const Allocation& allocation);
+    void addMemoryRecord(const MemoryRecord& record);
+    void flush();
+
+  private:
+    struct PendingRecord
+    {
+        bool is_allocation;
+        bool dropped;
+        size_t index;
+        Allocation allocation;
+        MemoryRecord memory_record;
+    };
+
+    void writeRecordsBefore(size_t allocation_index);
+
+    CaptureRewriter& d_rewriter;
+    const size_t d_max_lifetime;
+    std::deque<PendingRecord> d_pending;
+    // The position in d_pending of the allocations that can still be dropped,
+    // counting from the first record that was ever added.
+    std::unordered_map<AllocationKey, size_t, AllocationKey::Hash> d_droppable;
+    size_t d_first_pending{0};
+    size_t d_allocation_index{0};
+};
+
+}  // namespace memray::api
@@ -0,0 +1,22 @@
+from _memray.record_reader cimport RecordReader
+from _memray.records cimport Allocation
+from _memray.records cimport MemoryRecord
+from _memray.sink cimport Sink
+from libcpp.memory cimport unique_ptr
+from libcpp.vector cimport vector
+
+
+cdef extern from "capture_rewriter.h" namespace "memray::api":
+    cdef cppclass CaptureRewriter:
+        CaptureRewriter(RecordReader&, unique_ptr[Sink]) except+
+        void writeAllocation(const Allocation&) except+
+        void writeMemoryRecord(const MemoryRecord&) except+
+        void writeLiveAllocations(vector[Allocation]) except+
+        void finish(long long end_time) except+
+        size_t allocationsWritten()
+
+    cdef cppclass CaptureCompactor:
+        CaptureCompactor(CaptureRewriter&, size_t max_lifetime)
+        void addAllocation(const Allocation&) except+
+        void addMemoryRecord(const MemoryRecord&) except+
+        void flush() except+
@@ -1,8 +1,11 @@
+#include <array>
 #include <cstring>
+#include <iterator>
 #include <set>
 #include <string>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <utility>
 
 #include "elf_shenanigans.h"
 #include "elf_utils.h"
@@ -13,11 +16,16 @@
 
 namespace {
 
+using memray::elf::SymbolPatcher;
+
 /* Private struct to pass data to phdrs_callback. */
 struct elf_patcher_context_t
 {
     bool restore_original;
-    std::set<std::string> patched;
+    // Objects patched by previous passes, with their patch sites
+    SymbolPatcher::patched_objects_t* patched;
+    // Objects seen during this pass
+    std::set<SymbolPatcher::patched_objects_t::key_type> seen;
 };
 
 }  // namespace
@@ -36,34 +44,107 @@ unprotect_page(Addr addr)
 
 template<typename Hook>
 static void
-patch_symbol(
-        const Hook& hook,
-        typename Hook::signature_t intercept,
-        const char* symname,
-        Addr addr,
-        bool restore_original)
+patch_symbol(const Hook& hook, typename Hook::signature_t intercept, Addr addr, bool restore_original)
 {
-    // Make sure that we can read and write to the page where the address that we are trying to
-    // patch;
-    if (unprotect_page(addr) < 0) {
-        LOG(WARNING) << "Could not prepare the memory page for symbol " << symname << " for patching";
-    }
-
     // Patch the address with the new function or the original one depending on the value of
     // *restore_original*.
     auto typedAddr = reinterpret_cast<typename Hook::signature_t*>(addr);
     *typedAddr = restore_original ? hook.d_original : intercept;
 
-    LOG(DEBUG) << symname << " intercepted!";
+    LOG(DEBUG) << hook.d_symbol << " intercepted!";
+}
+
+/* Matching relocations against the hooked symbols */
+
+// Every relocation of every loaded object is checked against the hooked symbols, so instead of
+// comparing each name against all of them we look it up in a perfect hash table that is built at
+// compile time. Only a short prefix of the names is hashed: that's enough to tell the hooked
+// symbols apart, and relocation tables are full of long mangled names not worth hashing whole.
+static constexpr size_t HASHED_PREFIX_LENGTH = 8;
+static constexpr size_t HOOK_TABLE_SIZE = 64;
+
+static constexpr const char* HOOKED_SYMBOLS[] = {
+#define FOR_EACH_HOOKED_FUNCTION(f) #f,
+        MEMRAY_HOOKED_FUNCTIONS
+#undef FOR_EACH_HOOKED_FUNCTION
+};
+static constexpr size_t NUM_HOOKED_SYMBOLS = std::size(HOOKED_SYMBOLS);
+static_assert(NUM_HOOKED_SYMBOLS < HOOK_TABLE_SIZE);
+
+static constexpr size_t
+hook_table_slot(const char* symname, uint32_t seed)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < HASHED_PREFIX_LENGTH && symname[i]; ++i) {
+        hash ^= static_cast<unsigned char>(symname[i]);
+        hash *= 16777619u;
+    }
+    return hash % HOOK_TABLE_SIZE;
+}
+
+struct HookTable
+{
+    bool valid;
+    uint32_t seed;
+    std::array<int, HOOK_TABLE_SIZE> slots;
+};
+
+static constexpr HookTable
+build_hook_table()
+{
+    // Find a seed for which no two hooked symbols land in the same slot
+    for (uint32_t seed = 0; seed < 4096; ++seed) {
+        HookTable table{true, seed, {}};
+        for (auto& slot : table.slots) {
+            slot = -1;
+        }
+        for (size_t i = 0; table.valid && i < NUM_HOOKED_SYMBOLS; ++i) {
+            auto& slot = table.slots[hook_table_slot(HOOKED_SYMBOLS[i], seed)];
+            if (slot != -1) {
+                table.valid = false;
+            }
+            slot = static_cast<int>(i);
+        }
+        if (table.valid) {
+            return table;
+        }
+    }
+    return HookTable{false, 0, {}};
+}
+
+static constexpr HookTable HOOK_TABLE = build_hook_table();
+static_assert(HOOK_TABLE.valid, "Could not build a perfect hash table for the hooked symbols");
+
+static inline int
+find_hook_index(const char* symname)
+{
+    const int index = HOOK_TABLE.slots[hook_table_slot(symname, HOOK_TABLE.seed)];
+    if (index < 0 || strcmp(HOOKED_SYMBOLS[index], symname) != 0) {
+        return -1;
+    }
+    return index;
 }
 
+using patch_function_t = void (*)(Addr addr, bool restore_original);
+
+static constexpr patch_function_t HOOK_PATCHERS[] = {
+#define FOR_EACH_HOOKED_FUNCTION(f)                                                                     \
+    [](Addr addr, bool restore_original) {                                                              \
+        patch_symbol(hooks::f, &intercept::f, addr, restore_original);                                  \
+    },
+        MEMRAY_HOOKED_FUNCTIONS
+#undef FOR_EACH_HOOKED_FUNCTION
+};
+static_assert(std::size(HOOK_PATCHERS) == NUM_HOOKED_SYMBOLS);
+
 template<typename Table>
 static void
-overwrite_elf_table(
+find_patch_sites(
         const Table& table,
         const SymbolTable& symbols,
         const Addr base_addr,
-        bool restore_original) noexcept
+        SymbolPatcher::patch_sites_t& sites) noexcept
 {
     for (const auto& relocation : table) {
         /* Every element contains relocation entries that look like this:
@@ -81,15 +162,12 @@ overwrite_elf_table(
          */
         const auto index = ELF_R_SYM(relocation.r_info);
         const char* symname = symbols.getSymbolNameByIndex(index);
-        auto symbol_addr = relocation.r_offset + base_addr;
-#define FOR_EACH_HOOKED_FUNCTION(hookname)                                                              \
-    if (strcmp(hooks::hookname.d_symbol, symname) == 0) {                                               \
-        patch_symbol(hooks::hookname, &intercept::hookname, symname, symbol_addr, restore_original);    \
-        continue;                                                                                       \
-    }
-        MEMRAY_HOOKED_FUNCTIONS
+        const int hook_index = find_hook_index(symname);
+        if (hook_index < 0) {
+            continue;
+        }
+        sites.push_back({relocation.r_offset + base_addr, static_cast<size_t>(hook_index)});
     }
-#undef FOR_EACH_HOOKED_FUNCTION
 }
 
 static Sxword
@@ -110,7 +188,10 @@ get_jump_table_type(const Dyn* dynamic_section)
 }
 
 static void
-patch_symbols(const Dyn* dyn_info_struct, const Addr base, bool restore_original) noexcept
+find_symbols_to_patch(
+        const Dyn* dyn_info_struct,
+        const Addr base,
+        SymbolPatcher::patch_sites_t& sites) noexcept
 {
     SymbolTable symbols(base, dyn_info_struct);
 
@@ -127,23 +208,23 @@ patch_symbols(const Dyn* dyn_info_struct, const Addr base, bool restore_original
      *
      */
 
-    LOG(DEBUG) << "Patching symbols with RELS relocation type";
+    LOG(DEBUG) << "Looking for symbols with RELS relocation type";
     RelTable rels_relocations_table(base, dyn_info_struct);
-    overwrite_elf_table(rels_relocations_table, symbols, base, restore_original);
+    find_patch_sites(rels_relocations_table, symbols, base, sites);
 
-    LOG(DEBUG) << "Patching symbols with RELAS relocation type";
+    LOG(DEBUG) << "Looking for symbols with RELAS relocation type";
     RelaTable relas_relocations_table(base, dyn_info_struct);
-    overwrite_elf_table(relas_relocations_table, symbols, base, restore_original);
+    find_patch_sites(relas_relocations_table, symbols, base, sites);
 
-    LOG(DEBUG) << "Patching symbols with JMPRELS relocation type";
+    LOG(DEBUG) << "Looking for symbols with JMPRELS relocation type";
     switch (get_jump_table_type(dyn_info_struct)) {
         case DT_REL: {
             JmpRelTable jmp_relocations_table(base, dyn_info_struct);
-            overwrite_elf_table(jmp_relocations_table, symbols, base, restore_original);
+            find_patch_sites(jmp_relocations_table, symbols, base, sites);
         } break;
         case DT_RELA: {
             JmpRelaTable jmp_relocations_table(base, dyn_info_struct);
-            overwrite_elf_table(jmp_relocations_table, symbols, base, restore_original);
+            find_patch_sites(jmp_relocations_table, symbols, base, sites);
         } break;
         default: {
             LOG(DEBUG) << "Unknown JMPRELS relocation table type";
@@ -151,19 +232,47 @@ patch_symbols(const Dyn* dyn_info_struct, const Addr base, bool restore_original
     }
 }
 
+static void
+patch_sites(const SymbolPatcher::patch_sites_t& sites, bool restore_original) noexcept
+{
+    static size_t page_len = getpagesize();
+    bool page_unprotected = false;
+    Addr unprotected_page = 0;
+
+    for (const auto& site : sites) {
+        // Make sure that we can read and write to the page where the address that we are trying
+        // to patch is. Relocations are usually packed together, so avoid doing this once per site.
+        const Addr page = site.address & ~(page_len - 1);
+        if (!page_unprotected || page != unprotected_page) {
+            if (unprotect_page(site.address) < 0) {
+                LOG(WARNING) << "Could not prepare the memory page for symbol "
+                             << HOOKED_SYMBOLS[site.hook_index] << " for patching";
+            }
+            page_unprotected = true;
+            unprotected_page = page;
+        }
+        HOOK_PATCHERS[site.hook_index](site.address, restore_original);
+    }
+}
+
 static int
 phdrs_callback(dl_phdr_info* info, [[maybe_unused]] size_t size, void* data) noexcept
 {
-    elf_patcher_context_t context = *reinterpret_cast<elf_patcher_context_t*>(data);
-    std::set<std::string> patched = context.patched;
-
-    if (context.restore_original) {
-        patched.clear();
-    } else {
-        if (patched.find(info->dlpi_name) != patched.end()) {
-            return 0;
+    auto& context = *reinterpret_cast<elf_patcher_context_t*>(data);
+
+    auto key = std::make_pair(std::string(info->dlpi_name), static_cast<uintptr_t>(info->dlpi_addr));
+    if (!context.seen.insert(key).second) {
+        return 0;
+    }
+
+    auto it = context.patched->find(key);
+    if (it != context.patched->end()) {
+        // We already know where this object needs to be patched. When patching, there's
+        // nothing to do: only objects loaded since the previous pass need work.
+        if (context.restore_original) {
+            patch_sites(it->second, true);
         }
-        patched.insert(info->dlpi_name);
+        return 0;
     }
 
     if (strstr(info->dlpi_name, "/ld-linux") || strstr(info->dlpi_name, "linux-vdso.so.1")) {
@@ -174,6 +283,7 @@ phdrs_callback(dl_phdr_info* info, [[maybe_unused]] size_t size, void* data) noe
 
     LOG(INFO) << "Patching symbols for " << info->dlpi_name;
 
+    SymbolPatcher::patch_sites_t sites;
     for (auto phdr = info->dlpi_phdr, end = phdr + info->dlpi_phnum; phdr != end; ++phdr) {
         // The information of all the symbols that we want to overwrite are in the PT_DYNAMIC program
         // header, that contains the dynamic linking information.
@@ -181,7 +291,12 @@ phdrs_callback(dl_phdr_info* info, [[maybe_unused]] size_t size, void* data) noe
             continue;
         }
         const auto* dyn_info_struct = reinterpret_cast<const Dyn*>(phdr->p_vaddr + info->dlpi_addr);
-        patch_symbols(dyn_info_struct, info->dlpi_addr, context.restore_original);
+        find_symbols_to_patch(dyn_info_struct, info->dlpi_addr, sites);
+    }
+    patch_sites(sites, context.restore_original);
+
+    if (!context.restore_original) {
+        context.patched->emplace(std::move(key), std::move(sites));
     }
     return 0;
 }
@@ -191,15 +306,28 @@ phdrs_callback(dl_phdr_info* info, [[maybe_unused]] size_t size, void* data) noe
 void
 SymbolPatcher::overwrite_symbols() noexcept
 {
-    elf_patcher_context_t context{false, symbols};
+    std::lock_guard<std::mutex> lock(d_mutex);
+    elf_patcher_context_t context{false, &d_patched, {}};
     dl_iterate_phdr(&phdrs_callback, (void*)&context);
+
+    // Forget the objects that were unloaded since the last pass, so they get
+    // patched again if they are loaded back.
+    for (auto it = d_patched.begin(); it != d_patched.end();) {
+        if (context.seen.find(it->first) == context.seen.end()) {
+            it = d_patched.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void
 SymbolPatcher::restore_symbols() noexcept
 {
-    elf_patcher_context_t context{true, symbols};
+    std::lock_guard<std::mutex> lock(d_mutex);
+    elf_patcher_context_t context{true, &d_patched, {}};
     dl_iterate_phdr(&phdrs_callback, (void*)&context);
+    d_patched.clear();
 }
 
 }  // namespace memray::elf
@@ -1,14 +1,30 @@
 #pragma once
 
-#include <set>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace memray::elf {
 
 class SymbolPatcher
 {
+  public:
+    // A relocation that points to one of the hooked symbols
+    struct PatchSite
+    {
+        uintptr_t address;
+        size_t hook_index;
+    };
+    using patch_sites_t = std::vector<PatchSite>;
+    using patched_objects_t = std::map<std::pair<std::string, uintptr_t>, patch_sites_t>;
+
   private:
-    std::set<std::string> symbols;
+    // Patch sites of the objects (by name and load address) whose symbols are currently patched
+    patched_objects_t d_patched;
+    std::mutex d_mutex;
 
   public:
     void overwrite_symbols() noexcept;
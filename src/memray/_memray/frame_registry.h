@@ -0,0 +1,245 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "records.h"
+
+namespace memray::tracking_api {
+
+/**
+ * Concurrent, append-only mapping of raw frames to frame ids.
+ *
+ * Frames are stored in open addressing tables that are never resized: when
+ * the newest table gets too full, a table twice its size is added after it.
+ * Looking up a frame that is already registered doesn't take any lock, and
+ * registering a new one only needs a compare-and-swap on a free slot.
+ *
+ * The thread that registers a frame reports it through a callback before the
+ * frame's id is published to any other thread, so that the frame index record
+ * is always written before any record that refers to it. Threads that need
+ * the id meanwhile sleep until it's published.
+ *
+ * A frame only gets one id, even while a new table is being added: a thread
+ * that finds a table full seals the empty slot where its probe ended, so no
+ * other thread can register the frame in that table anymore.
+ **/
+class FrameRegistry
+{
+  public:
+    explicit FrameRegistry(frame_id_t starting_index, unsigned int index_increment)
+    : d_index_increment{index_increment}
+    , d_next_frame_id{starting_index}
+    {
+        d_tables[0].store(new Table(INITIAL_CAPACITY), std::memory_order_relaxed);
+    }
+
+    ~FrameRegistry()
+    {
+        for (auto& table : d_tables) {
+            delete table.load(std::memory_order_relaxed);
+        }
+    }
+
+    FrameRegistry(const FrameRegistry&) = delete;
+    FrameRegistry& operator=(const FrameRegistry&) = delete;
+
+    template<typename Callback>
+    frame_id_t getIndex(const RawFrame& frame, const Callback& on_new_frame)
+    {
+        // Frame hashes are XORs of pointers and line numbers, so their low bits
+        // are far from uniform: mix them into the high bits, which pick the slot.
+        const uint64_t hash = static_cast<uint64_t>(RawFrame::Hash{}(frame)) * 0x9E3779B97F4A7C15ULL;
+        frame_id_t frame_id;
+        for (size_t level = 0; level < MAX_TABLES; ++level) {
+            Table* table = d_tables[level].load(std::memory_order_acquire);
+            if (!table) {
+                break;
+            }
+            if (table->find(frame, hash, &frame_id)) {
+                return frame_id;
+            }
+        }
+
+        auto registerNewFrame = [&]() {
+            frame_id_t new_frame_id =
+                    d_next_frame_id.fetch_add(d_index_increment, std::memory_order_relaxed);
+            on_new_frame(new_frame_id);
+            return new_frame_id;
+        };
+        // Go through every table again, so that the frame is either found or
+        // sealed out of each older one before it's registered in a newer one.
+        for (size_t level = 0; level < MAX_TABLES; ++level) {
+            Table* table = d_tables[level].load(std::memory_order_acquire);
+            if (table->insert(frame, hash, &frame_id, registerNewFrame) != Table::Insertion::FULL) {
+                return frame_id;
+            }
+            if (level + 1 < MAX_TABLES) {
+                addTable(level + 1, table->capacity() * 2);
+            }
+        }
+        // Every table is full: hand out an id without remembering it.
+        return registerNewFrame();
+    }
+
+  private:
+    class Table
+    {
+      public:
+        enum class Insertion { FOUND, INSERTED, FULL };
+
+        explicit Table(size_t capacity)
+        : d_mask(capacity - 1)
+        , d_shift(64 - __builtin_ctzll(capacity))
+        , d_slots(new Slot[capacity])
+        {
+        }
+
+        size_t capacity() const
+        {
+            return d_mask + 1;
+        }
+
+        bool find(const RawFrame& frame, uint64_t hash, frame_id_t* frame_id) const
+        {
+            size_t i = hash >> d_shift;
+            for (size_t probes = 0; probes <= d_mask; i = (i + 1) & d_mask, ++probes) {
+                const Slot& slot = d_slots[i];
+                State state = waitUntilSettled(slot);
+                if (state == State::EMPTY || state == State::SEALED) {
+                    return false;
+                }
+                if (slot.frame == frame) {
+                    *frame_id = slot.frame_id;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template<typename Register>
+        Insertion insert(const RawFrame& frame, uint64_t hash, frame_id_t* frame_id, const Register& reg)
+        {
+            // Keep probe sequences short: past 3/4 of the capacity, new frames
+            // go to the next table instead.
+            bool full = d_used.load(std::memory_order_relaxed) >= capacity() / 4 * 3;
+            size_t i = hash >> d_shift;
+            for (size_t probes = 0; probes <= d_mask; i = (i + 1) & d_mask, ++probes) {
+                Slot& slot = d_slots[i];
+                State state = waitUntilSettled(slot);
+                if (state == State::SEALED) {
+                    return Insertion::FULL;
+                }
+                if (state == State::EMPTY) {
+                    // A full table can't take the frame, and must not take it
+                    // later either, or it would get a second id once this
+                    // thread registers it in the next table: seal the slot
+                    // where the frame would have gone.
+                    State claimed = full ? State::SEALED : State::WRITING;
+                    if (!slot.state.compare_exchange_strong(
+                                state,
+                                claimed,
+                                std::memory_order_acquire,
+                                std::memory_order_relaxed))
+                    {
+                        // Somebody else claimed this slot first: check what they put in it.
+                        state = waitUntilSettled(slot);
+                        if (state == State::SEALED) {
+                            return Insertion::FULL;
+                        }
+                        if (slot.frame == frame) {
+                            *frame_id = slot.frame_id;
+                            return Insertion::FOUND;
+                        }
+                        continue;
+                    }
+                    if (full) {
+                        return Insertion::FULL;
+                    }
+                    d_used.fetch_add(1, std::memory_order_relaxed);
+                    slot.frame = frame;
+                    slot.frame_id = *frame_id = reg();
+                    publish(slot);
+                    return Insertion::INSERTED;
+                }
+                if (slot.frame == frame) {
+                    *frame_id = slot.frame_id;
+                    return Insertion::FOUND;
+                }
+            }
+            return Insertion::FULL;
+        }
+
+      private:
+        enum class State : uint8_t { EMPTY, WRITING, READY, SEALED };
+
+        struct Slot
+        {
+            std::atomic<State> state{State::EMPTY};
+            frame_id_t frame_id{};
+            RawFrame frame{};
+        };
+
+        State waitUntilSettled(const Slot& slot) const
+        {
+            State state = slot.state.load(std::memory_order_acquire);
+            if (state != State::WRITING) {
+                return state;
+            }
+            // The registering thread is writing the frame's index record, which
+            // can mean waiting for I/O, so sleep rather than spin until it's done.
+            std::unique_lock<std::mutex> lock(d_settled_mutex);
+            d_settled.wait(lock, [&] {
+                state = slot.state.load(std::memory_order_acquire);
+                return state != State::WRITING;
+            });
+            return state;
+        }
+
+        void publish(Slot& slot)
+        {
+            slot.state.store(State::READY, std::memory_order_release);
+            // Taking the lock orders the store with any waiter checking it, so
+            // none of them can miss the notification.
+            { std::lock_guard<std::mutex> lock(d_settled_mutex); }
+            d_settled.notify_all();
+        }
+
+        const size_t d_mask;
+        const unsigned int d_shift;
+        std::unique_ptr<Slot[]> d_slots;
+        std::atomic<size_t> d_used{0};
+        mutable std::mutex d_settled_mutex;
+        mutable std::condition_variable d_settled;
+    };
+
+    void addTable(size_t level, size_t capacity)
+    {
+        if (d_tables[level].load(std::memory_order_acquire)) {
+            return;
+        }
+        Table* expected = nullptr;
+        auto* table = new Table(capacity);
+        if (!d_tables[level].compare_exchange_strong(
+                    expected,
+                    table,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+        {
+            delete table;
+        }
+    }
+
+    static constexpr size_t INITIAL_CAPACITY = 1024;
+    static constexpr size_t MAX_TABLES = 24;
+
+    const unsigned int d_index_increment;
+    std::atomic<frame_id_t> d_next_frame_id;
+    std::array<std::atomic<Table*>, MAX_TABLES> d_tables{};
+};
+
+}  // namespace memray::tracking_api
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <cstdio>
+#include <iterator>
 
 #include "hooks.h"
 #include "tracking_api.h"
@@ -29,16 +30,23 @@ phdr_symfind_callback(dl_phdr_info* info, [[maybe_unused]] size_t size, void* da
         const auto* dyn = reinterpret_cast<const Dyn*>(phdr->p_vaddr + info->dlpi_addr);
         SymbolTable symbols(info->dlpi_addr, dyn);
 
-        const auto offset = symbols.getSymbolAddress(result->symbol_name);
-        if (offset == 0) {
-            continue;
+        // Every symbol is resolved to the first object that defines it, as the
+        // dynamic linker would do, so only look for the ones not found yet.
+        for (size_t i = 0; i < result->num_symbols; ++i) {
+            if (result->addresses[i] != nullptr) {
+                continue;
+            }
+            const auto offset = symbols.getSymbolAddress(result->symbol_names[i]);
+            if (offset == 0) {
+                continue;
+            }
+            result->addresses[i] = reinterpret_cast<void*>(offset);
+            result->num_found++;
         }
-
-        result->address = reinterpret_cast<void*>(offset);
-        return 1;
     }
 
-    return 0;
+    // Stop iterating as soon as every symbol has been found
+    return result->num_found == result->num_symbols;
 }
 
 AllocatorKind
@@ -55,17 +63,21 @@ allocatorKind(const Allocator& allocator)
         case Allocator::VALLOC:
         case Allocator::PYMALLOC_MALLOC:
         case Allocator::PYMALLOC_CALLOC:
-        case Allocator::PYMALLOC_REALLOC: {
+        case Allocator::PYMALLOC_REALLOC:
+        case Allocator::POOL_ALLOC: {
             return AllocatorKind::SIMPLE_ALLOCATOR;
         }
         case Allocator::FREE:
-        case Allocator::PYMALLOC_FREE: {
+        case Allocator::PYMALLOC_FREE:
+        case Allocator::POOL_FREE: {
             return AllocatorKind::SIMPLE_DEALLOCATOR;
         }
-        case Allocator::MMAP: {
+        case Allocator::MMAP:
+        case Allocator::MREMAP: {
             return AllocatorKind::RANGED_ALLOCATOR;
         }
-        case Allocator::MUNMAP: {
+        case Allocator::MUNMAP:
+        case Allocator::MADVISE: {
             return AllocatorKind::RANGED_DEALLOCATOR;
         }
     }
@@ -93,7 +105,21 @@ MEMRAY_HOOKED_FUNCTIONS
 void
 ensureAllHooksAreValid()
 {
-#define FOR_EACH_HOOKED_FUNCTION(f) f.ensureValidOriginalSymbol();
+    // Resolve all the hooked symbols with a single pass over the loaded objects
+    // instead of iterating over all of them once per symbol.
+    const char* const symbol_names[] = {
+#define FOR_EACH_HOOKED_FUNCTION(f) f.d_symbol,
+            MEMRAY_HOOKED_FUNCTIONS
+#undef FOR_EACH_HOOKED_FUNCTION
+    };
+    constexpr size_t num_symbols = std::size(symbol_names);
+    void* addresses[num_symbols] = {};
+
+    symbol_query query{0, symbol_names, addresses, num_symbols, 0};
+    dl_iterate_phdr(&phdr_symfind_callback, (void*)&query);
+
+    size_t index = 0;
+#define FOR_EACH_HOOKED_FUNCTION(f) f.ensureValidOriginalSymbol(addresses[index++]);
     MEMRAY_HOOKED_FUNCTIONS
 #undef FOR_EACH_HOOKED_FUNCTION
 }
@@ -126,10 +152,7 @@ pymalloc_realloc(void* ctx, void* ptr, size_t size) noexcept
     }
     if (ret) {
         if (ptr) {
-            tracking_api::Tracker::getTracker()->trackDeallocation(
-                    ptr,
-                    0,
-                    hooks::Allocator::PYMALLOC_FREE);
+            tracking_api::Tracker::trackDeallocation(ptr, 0, hooks::Allocator::PYMALLOC_FREE);
         }
         tracking_api::Tracker::trackAllocation(ret, size, hooks::Allocator::PYMALLOC_REALLOC);
     }
@@ -190,6 +213,50 @@ munmap(void* addr, size_t length) noexcept
     return hooks::munmap(addr, length);
 }
 
+void*
+mremap(void* old_address, size_t old_size, size_t new_size, int flags, ...) noexcept
+{
+    assert(hooks::mremap);
+    void* new_address = nullptr;
+    if (flags & MREMAP_FIXED) {
+        va_list arguments;
+        va_start(arguments, flags);
+        new_address = va_arg(arguments, void*);
+        va_end(arguments);
+    }
+
+    void* ret = hooks::mremap(old_address, old_size, new_size, flags, new_address);
+    if (ret != MAP_FAILED) {
+        // Like realloc, report the release of the old range and the creation
+        // of the new one, which can overlap it if the mapping didn't move.
+        tracking_api::Tracker::trackDeallocation(old_address, old_size, hooks::Allocator::MUNMAP);
+        tracking_api::Tracker::trackAllocation(ret, new_size, hooks::Allocator::MREMAP);
+    }
+    return ret;
+}
+
+int
+madvise(void* addr, size_t length, int advice) noexcept
+{
+    assert(hooks::madvise);
+    int ret = hooks::madvise(addr, length, advice);
+    if (ret == 0) {
+        switch (advice) {
+            case MADV_DONTNEED:
+#ifdef MADV_FREE
+            case MADV_FREE:
+#endif
+                // The pages are given back to the system, even though the
+                // range stays mapped.
+                tracking_api::Tracker::trackDeallocation(addr, length, hooks::Allocator::MADVISE);
+                break;
+            default:
+                break;
+        }
+    }
+    return ret;
+}
+
 void*
 malloc(size_t size) noexcept
 {
@@ -218,15 +285,7 @@ void*
 realloc(void* ptr, size_t size) noexcept
 {
     assert(hooks::realloc);
-
-    void* ret = hooks::realloc(ptr, size);
-    if (ret) {
-        if (ptr != nullptr) {
-            tracking_api::Tracker::trackDeallocation(ptr, 0, hooks::Allocator::FREE);
-        }
-        tracking_api::Tracker::trackAllocation(ret, size, hooks::Allocator::REALLOC);
-    }
-    return ret;
+    return tracking_api::Tracker::trackReallocation(ptr, size, hooks::realloc);
 }
 
 void*
@@ -38,6 +38,8 @@
     FOR_EACH_HOOKED_FUNCTION(dlclose)                                                                   \
     FOR_EACH_HOOKED_FUNCTION(mmap)                                                                      \
     FOR_EACH_HOOKED_FUNCTION(munmap)                                                                    \
+    FOR_EACH_HOOKED_FUNCTION(mremap)                                                                    \
+    FOR_EACH_HOOKED_FUNCTION(madvise)                                                                   \
     FOR_EACH_HOOKED_FUNCTION(prctl)                                                                     \
     FOR_EACH_HOOKED_FUNCTION(PyGILState_Ensure)                                                         \
     MEMRAY_PLATFORM_HOOKED_FUNCTIONS
@@ -47,8 +49,10 @@ namespace memray::hooks {
 struct symbol_query
 {
     size_t maps_visited;
-    const char* symbol_name;
-    void* address;
+    const char* const* symbol_names;
+    void** addresses;
+    size_t num_symbols;
+    size_t num_found;
 };
 
 int
@@ -67,11 +71,9 @@ struct SymbolHook
     {
     }
 
-    void ensureValidOriginalSymbol()
+    void ensureValidOriginalSymbol(void* address)
     {
-        symbol_query query{0, d_symbol, nullptr};
-        dl_iterate_phdr(&phdr_symfind_callback, (void*)&query);
-        auto symbol_addr = reinterpret_cast<signature_t>(query.address);
+        auto symbol_addr = reinterpret_cast<signature_t>(address);
         if (symbol_addr != nullptr) {
             if (symbol_addr != d_original) {
                 LOG(WARNING) << "Correcting symbol for " << d_symbol << " from " << std::hex
@@ -113,6 +115,10 @@ enum class Allocator : unsigned char {
     PYMALLOC_CALLOC = 13,
     PYMALLOC_REALLOC = 14,
     PYMALLOC_FREE = 15,
+    MREMAP = 16,
+    MADVISE = 17,
+    POOL_ALLOC = 18,
+    POOL_FREE = 19,
 };
 
 enum class AllocatorKind {
@@ -128,6 +134,12 @@ allocatorKind(const Allocator& allocator);
 bool
 isDeallocator(const Allocator& allocator);
 
+inline bool
+isPoolAllocator(const Allocator& allocator)
+{
+    return allocator == Allocator::POOL_ALLOC || allocator == Allocator::POOL_FREE;
+}
+
 #define FOR_EACH_HOOKED_FUNCTION(f) extern SymbolHook<decltype(&::f)> f;
 MEMRAY_HOOKED_FUNCTIONS
 #undef FOR_EACH_HOOKED_FUNCTION
@@ -179,6 +191,12 @@ mmap64(void* addr, size_t length, int prot, int flags, int fd, off64_t offset) n
 int
 munmap(void* addr, size_t length) noexcept;
 
+void*
+mremap(void* old_address, size_t old_size, size_t new_size, int flags, ...) noexcept;
+
+int
+madvise(void* addr, size_t length, int advice) noexcept;
+
 int
 prctl(int option, ...) noexcept;
 
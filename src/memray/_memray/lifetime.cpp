@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cmath>
+
+#include "lifetime.h"
+
+namespace memray::api {
+
+size_t
+LogHistogram::bucketIndex(uint64_t value) noexcept
+{
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    // The position of the highest bit set picks the power of two, and the
+    // bits right after it pick the bucket inside of it.
+    const size_t exponent = 63 - __builtin_clzll(value);
+    const size_t sub_bucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t
+LogHistogram::bucketLowerBound(size_t index) noexcept
+{
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    const size_t exponent = (index - SUB_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS;
+    const uint64_t sub_bucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub_bucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+void
+LogHistogram::add(uint64_t value)
+{
+    const size_t index = bucketIndex(value);
+    if (index >= d_counts.size()) {
+        d_counts.resize(index + 1);
+    }
+    ++d_counts[index];
+    ++d_count;
+}
+
+uint64_t
+LogHistogram::count() const noexcept
+{
+    return d_count;
+}
+
+uint64_t
+LogHistogram::quantile(double q) const noexcept
+{
+    if (d_count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * d_count)));
+    uint64_t seen = 0;
+    for (size_t index = 0; index < d_counts.size(); ++index) {
+        seen += d_counts[index];
+        if (seen >= rank) {
+            // Report the middle of the bucket, to halve the worst error.
+            const uint64_t lower = bucketLowerBound(index);
+            return lower + (bucketLowerBound(index + 1) - lower) / 2;
+        }
+    }
+    return bucketLowerBound(d_counts.size() - 1);
+}
+
+std::vector<std::pair<uint64_t, uint64_t>>
+LogHistogram::buckets() const
+{
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    for (size_t index = 0; index < d_counts.size(); ++index) {
+        if (d_counts[index] != 0) {
+            result.emplace_back(bucketLowerBound(index), d_counts[index]);
+        }
+    }
+    return result;
+}
+
+AllocationLifetimeAggregator::AllocationLifetimeAggregator(bool merge_threads)
+: d_merge_threads(merge_threads)
+{
+}
+
+void
+AllocationLifetimeAggregator::addAllocation(const Allocation& allocation)
+{
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
+            const thread_id_t thread_id = d_merge_threads ? NO_THREAD_INFO : allocation.tid;
+            auto loc_key = LocationKey{allocation.frame_index, allocation.native_frame_id, thread_id};
+            auto [it, inserted] = d_sites.try_emplace(loc_key, SiteLifetimes{allocation});
+            if (!inserted) {
+                it->second.allocation.size += allocation.size;
+                it->second.allocation.n_allocations += 1;
+            }
+            d_live_allocations[AllocationKey(allocation)] = LiveAllocation{loc_key, d_index};
+            break;
+        }
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
+            auto it = d_live_allocations.find(AllocationKey(allocation));
+            if (it == d_live_allocations.end()) {
+                break;
+            }
+            SiteLifetimes& site = d_sites.at(it->second.location);
+            ++site.n_freed;
+            site.lifetimes.add(d_index - it->second.index);
+            d_live_allocations.erase(it);
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_ALLOCATOR:
+        case hooks::AllocatorKind::RANGED_DEALLOCATOR:
+            break;
+    }
+    d_index++;
+}
+
+std::vector<SiteLifetimes>
+AllocationLifetimeAggregator::getSiteLifetimes() const
+{
+    std::vector<SiteLifetimes> result;
+    result.reserve(d_sites.size());
+    for (const auto& [location, site] : d_sites) {
+        result.push_back(site);
+    }
+    return result;
+}
+
+}  // namespace memray::api
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+/**
+ * A streaming sketch of the distribution of a set of values, which keeps one
+ * counter for each of a fixed set of buckets whose width grows with the
+ * values that they hold. Every power of two is split in SUB_BUCKETS buckets,
+ * so any quantile is reported with a relative error below 1 / SUB_BUCKETS,
+ * using at most 2 KiB no matter how many values are added.
+ **/
+class LogHistogram
+{
+  public:
+    static constexpr size_t SUB_BUCKET_BITS = 2;
+    static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+    void add(uint64_t value);
+    uint64_t count() const noexcept;
+    // Estimate the value below which a fraction q of the values fall.
+    uint64_t quantile(double q) const noexcept;
+    // The lower bound of each bucket that isn't empty, with its count.
+    std::vector<std::pair<uint64_t, uint64_t>> buckets() const;
+
+    static size_t bucketIndex(uint64_t value) noexcept;
+    static uint64_t bucketLowerBound(size_t index) noexcept;
+
+  private:
+    std::vector<uint64_t> d_counts;
+    uint64_t d_count{0};
+};
+
+struct SiteLifetimes
+{
+    // The first allocation made at the site, with the total size and number
+    // of the allocations made there.
+    Allocation allocation;
+    size_t n_freed{0};
+    // Lifetimes of the freed allocations, measured in allocation records.
+    LogHistogram lifetimes{};
+};
+
+/**
+ * Joins every allocation of a capture with its deallocation, and keeps a
+ * histogram of how long the allocations made at each location lived.
+ *
+ * Lifetimes are measured in records of the capture: an allocation freed by
+ * the record right after the one that allocated it lived for 1 record. This
+ * is independent of how fast the tracked process ran under the tracker, and
+ * tells how much churn each location causes relative to the others.
+ *
+ * Memory mappings are not considered, because they can be released piece by
+ * piece, so they don't have a single lifetime.
+ **/
+class AllocationLifetimeAggregator
+{
+  public:
+    explicit AllocationLifetimeAggregator(bool merge_threads);
+
+    void addAllocation(const Allocation& allocation);
+    std::vector<SiteLifetimes> getSiteLifetimes() const;
+
+  private:
+    struct LiveAllocation
+    {
+        LocationKey location;
+        size_t index;
+    };
+
+    bool d_merge_threads;
+    size_t d_index{0};
+    std::unordered_map<AllocationKey, LiveAllocation, AllocationKey::Hash> d_live_allocations;
+    std::unordered_map<LocationKey, SiteLifetimes, index_thread_pair_hash> d_sites;
+};
+
+}  // namespace memray::api
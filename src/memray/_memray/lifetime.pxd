@@ -0,0 +1,22 @@
+from _memray.records cimport Allocation
+from libc.stdint cimport uint64_t
+from libcpp cimport bool
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
+
+
+cdef extern from "lifetime.h" namespace "memray::api":
+    cdef cppclass LogHistogram:
+        uint64_t count()
+        uint64_t quantile(double q)
+        vector[pair[uint64_t, uint64_t]] buckets() except+
+
+    cdef cppclass SiteLifetimes:
+        Allocation allocation
+        size_t n_freed
+        LogHistogram lifetimes
+
+    cdef cppclass AllocationLifetimeAggregator:
+        AllocationLifetimeAggregator(bool merge_threads) except+
+        void addAllocation(const Allocation&) except+
+        vector[SiteLifetimes] getSiteLifetimes() except+
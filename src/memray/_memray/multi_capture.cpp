@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "multi_capture.h"
+#include "parallel.h"
+#include "record_reader.h"
+#include "source.h"
+
+namespace memray::api {
+
+MultiCaptureReader::MultiCaptureReader(std::vector<std::string> paths)
+: d_paths(std::move(paths))
+{
+}
+
+void
+MultiCaptureReader::readSummaries()
+{
+    d_summaries.assign(d_paths.size(), {});
+    parallelFor(d_paths.size(), [&](size_t index) {
+        RecordReader reader(std::make_unique<io::FileSource>(d_paths[index]), false);
+        CaptureSummary& summary = d_summaries[index];
+        summary.header = reader.getHeader();
+
+        HighWatermarkFinder finder;
+        bool done = false;
+        while (!done) {
+            switch (reader.nextRecord()) {
+                case RecordReader::RecordResult::ALLOCATION_RECORD:
+                    finder.processAllocation(reader.getLatestAllocation());
+                    break;
+                case RecordReader::RecordResult::MEMORY_RECORD:
+                    summary.memory_records.push_back(reader.getLatestMemoryRecord());
+                    break;
+                case RecordReader::RecordResult::ERROR:
+                case RecordReader::RecordResult::END_OF_FILE:
+                    done = true;
+                    break;
+            }
+        }
+        summary.high_watermark = finder.getHighWatermark();
+    });
+}
+
+const std::vector<CaptureSummary>&
+MultiCaptureReader::getSummaries() const noexcept
+{
+    return d_summaries;
+}
+
+std::vector<MemoryRecord>
+MultiCaptureReader::getMergedMemoryRecords() const
+{
+    struct Sample
+    {
+        unsigned long int ms_since_epoch;
+        size_t capture;
+        size_t rss;
+    };
+
+    millis_t last_end_time = 0;
+    for (const auto& summary : d_summaries) {
+        last_end_time = std::max(last_end_time, summary.header.stats.end_time);
+    }
+
+    std::vector<Sample> samples;
+    for (size_t capture = 0; capture < d_summaries.size(); ++capture) {
+        const CaptureSummary& summary = d_summaries[capture];
+        for (const auto& record : summary.memory_records) {
+            samples.push_back({record.ms_since_epoch, capture, record.rss});
+        }
+        // A process that exited before the others stops adding to the total.
+        millis_t end_time = summary.header.stats.end_time;
+        if (end_time != 0 && end_time < last_end_time) {
+            samples.push_back({static_cast<unsigned long int>(end_time), capture, 0});
+        }
+    }
+    std::stable_sort(samples.begin(), samples.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.ms_since_epoch < rhs.ms_since_epoch;
+    });
+
+    std::vector<MemoryRecord> result;
+    std::vector<size_t> current_rss(d_summaries.size(), 0);
+    size_t total_rss = 0;
+    for (const auto& sample : samples) {
+        total_rss = total_rss - current_rss[sample.capture] + sample.rss;
+        current_rss[sample.capture] = sample.rss;
+        if (!result.empty() && result.back().ms_since_epoch == sample.ms_since_epoch) {
+            result.back().rss = total_rss;
+        } else {
+            result.push_back({sample.ms_since_epoch, total_rss});
+        }
+    }
+    return result;
+}
+
+std::vector<ProcessLocation>
+MultiCaptureReader::getSnapshotLocations(bool leaks, bool merge_processes) const
+{
+    std::vector<std::vector<ProcessLocation>> locations_by_capture(d_paths.size());
+    parallelFor(d_paths.size(), [&](size_t index) {
+        const CaptureSummary& summary = d_summaries[index];
+        // If allocation 0 caused the peak, we need to process 1 record, etc.
+        size_t records_to_process = leaks ? std::numeric_limits<size_t>::max()
+                                          : summary.high_watermark.index + 1;
+
+        RecordReader reader(std::make_unique<io::FileSource>(d_paths[index]));
+        SnapshotAllocationAggregator aggregator;
+        while (records_to_process > 0) {
+            auto ret = reader.nextRecord();
+            if (ret == RecordReader::RecordResult::ALLOCATION_RECORD) {
+                aggregator.addAllocation(reader.getLatestAllocation());
+                --records_to_process;
+            } else if (ret != RecordReader::RecordResult::MEMORY_RECORD) {
+                break;
+            }
+        }
+
+        const int pid = merge_processes ? -1 : summary.header.pid;
+        for (const auto& [location, allocation] : aggregator.getSnapshotAllocations(true)) {
+            locations_by_capture[index].push_back(
+                    {pid,
+                     reader.getStackFrames(allocation.frame_index),
+                     allocation.size,
+                     allocation.n_allocations});
+        }
+    });
+
+    // Intern the frames of every capture, so that the same stack gets the
+    // same key no matter which capture it was read from.
+    std::unordered_map<Frame, size_t, Frame::Hash> frame_ids;
+    std::vector<Frame> frames;
+    std::map<std::pair<int, std::vector<size_t>>, std::pair<size_t, size_t>> totals;
+    for (auto& locations : locations_by_capture) {
+        for (const auto& location : locations) {
+            std::vector<size_t> key;
+            key.reserve(location.stack.size());
+            for (const Frame& frame : location.stack) {
+                auto [it, inserted] = frame_ids.try_emplace(frame, frames.size());
+                if (inserted) {
+                    frames.push_back(frame);
+                }
+                key.push_back(it->second);
+            }
+            auto& [size, n_allocations] = totals[{location.pid, std::move(key)}];
+            size += location.size;
+            n_allocations += location.n_allocations;
+        }
+        locations.clear();
+        locations.shrink_to_fit();
+    }
+
+    std::vector<ProcessLocation> result;
+    result.reserve(totals.size());
+    for (const auto& [key, sizes] : totals) {
+        ProcessLocation location;
+        location.pid = key.first;
+        location.stack.reserve(key.second.size());
+        for (size_t frame_id : key.second) {
+            location.stack.push_back(frames[frame_id]);
+        }
+        location.size = sizes.first;
+        location.n_allocations = sizes.second;
+        result.push_back(std::move(location));
+    }
+    std::stable_sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.size > rhs.size;
+    });
+    return result;
+}
+
+}  // namespace memray::api
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+struct CaptureSummary
+{
+    HeaderRecord header;
+    HighWatermark high_watermark;
+    std::vector<MemoryRecord> memory_records;
+};
+
+struct ProcessLocation
+{
+    // The pid of the process that allocated the memory, or -1 if the
+    // processes were merged.
+    int pid{-1};
+    // The Python frames of the location, from the innermost to the outermost.
+    std::vector<Frame> stack;
+    size_t size{0};
+    size_t n_allocations{0};
+};
+
+/**
+ * Reads the captures of several processes, like the ones that are written
+ * for each process that the tracked one forks when following forks.
+ *
+ * Every capture is decoded by its own reader, on as many threads as there are
+ * CPUs, and only the results are combined. Frame ids are only meaningful
+ * within the capture that they were read from, so the locations of the
+ * snapshots of every process are matched on the function, file and line of
+ * every frame of their Python stacks.
+ **/
+class MultiCaptureReader
+{
+  public:
+    explicit MultiCaptureReader(std::vector<std::string> paths);
+
+    // Read the header, the high watermark and the memory records of every
+    // capture. This needs to be called before anything else.
+    void readSummaries();
+    const std::vector<CaptureSummary>& getSummaries() const noexcept;
+
+    // The resident set size of all the processes, added up at every point
+    // in time in which any of them was sampled.
+    std::vector<MemoryRecord> getMergedMemoryRecords() const;
+
+    // Every location that had memory at the peak memory usage of each
+    // process, or that leaked, sorted by size from the biggest.
+    std::vector<ProcessLocation> getSnapshotLocations(bool leaks, bool merge_processes) const;
+
+  private:
+    const std::vector<std::string> d_paths;
+    std::vector<CaptureSummary> d_summaries;
+};
+
+}  // namespace memray::api
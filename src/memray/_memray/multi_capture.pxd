@@ -0,0 +1,27 @@
+from _memray.records cimport Frame
+from _memray.records cimport HeaderRecord
+from _memray.records cimport MemoryRecord
+from _memray.snapshot cimport HighWatermark
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+
+cdef extern from "multi_capture.h" namespace "memray::api":
+    cdef cppclass CaptureSummary:
+        HeaderRecord header
+        HighWatermark high_watermark
+        vector[MemoryRecord] memory_records
+
+    cdef cppclass ProcessLocation:
+        int pid
+        vector[Frame] stack
+        size_t size
+        size_t n_allocations
+
+    cdef cppclass MultiCaptureReader:
+        MultiCaptureReader(vector[string] paths) except+
+        void readSummaries() except+ nogil
+        const vector[CaptureSummary]& getSummaries()
+        vector[MemoryRecord] getMergedMemoryRecords() except+
+        vector[ProcessLocation] getSnapshotLocations(bool leaks, bool merge_processes) except+ nogil
@@ -47,11 +47,13 @@ StringStorage::resolveString(size_t index) const
 
 MemorySegment::MemorySegment(
         std::string filename,
+        uintptr_t load_address,
         uintptr_t start,
         uintptr_t end,
         backtrace_state* state,
         size_t filename_index)
 : d_filename(std::move(filename))
+, d_load_address(load_address)
 , d_start(start)
 , d_end(end)
 , d_index(filename_index)
@@ -140,7 +142,9 @@ MemorySegment::resolveIp(uintptr_t address) const
     // libunwind (and any other unwinder that I tested). This is because libbacktrace's native
     // unwinder does indeed produce program counters with one byte less for some reason and
     // libbacktrace's symbolizer is prepared to work with libbacktrace's machinery convention.
-    uintptr_t corrected_address = address - 1;
+    // The backtrace state was created for a load address of 0, so it works with addresses
+    // relative to where the object was loaded.
+    uintptr_t corrected_address = address - 1 - d_load_address;
     resolveFromDebugInfo(corrected_address, expanded_frame);
     if (expanded_frame.empty()) {
         resolveFromSymbolTable(corrected_address, expanded_frame);
@@ -258,9 +262,78 @@ ResolvedFrames::frames() const
     return d_frames;
 }
 
-SymbolResolver::SymbolResolver()
+BacktraceStateCache::BacktraceStateCache()
 {
     d_backtrace_states.reserve(PREALLOCATED_BACKTRACE_STATES);
+}
+
+backtrace_state*
+BacktraceStateCache::findBacktraceState(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto [it, inserted] = d_backtrace_states.try_emplace(filename, nullptr);
+    if (!inserted) {
+        return it->second;
+    }
+
+    struct CallbackData
+    {
+        const char* fileName;
+    };
+    CallbackData data = {it->first.c_str()};
+
+    auto errorHandler = [](void* rawData, const char* msg, int errnum) {
+        auto data = reinterpret_cast<const CallbackData*>(rawData);
+        LOG(WARNING) << "Error creating backtrace state for segment " << data->fileName << "(errno "
+                     << errnum << "): " << msg;
+    };
+
+    // The state is threaded because it may be shared by resolvers running in different threads.
+    auto state = backtrace_create_state(data.fileName, true, errorHandler, &data);
+
+    if (!state) {
+        return nullptr;
+    }
+
+    const int descriptor = backtrace_open(data.fileName, errorHandler, &data, nullptr);
+    if (descriptor >= 1) {
+        int foundSym = 0;
+        int foundDwarf = 0;
+
+        auto ret =
+                elf_add(state,
+                        data.fileName,
+                        descriptor,
+                        nullptr,
+                        0,
+                        0,
+                        errorHandler,
+                        &data,
+                        &state->fileline_fn,
+                        &foundSym,
+                        &foundDwarf,
+                        nullptr,
+                        false,
+                        false,
+                        nullptr,
+                        0);
+        state->syminfo_fn = (ret && foundSym) ? &elf_syminfo : &elf_nosyms;
+    }
+    it->second = state;
+    return state;
+}
+
+size_t
+BacktraceStateCache::size() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_backtrace_states.size();
+}
+
+SymbolResolver::SymbolResolver(std::shared_ptr<BacktraceStateCache> backtrace_states)
+: d_backtrace_states(
+        backtrace_states ? std::move(backtrace_states) : std::make_shared<BacktraceStateCache>())
+{
     d_resolved_ips_cache.reserve(PREALLOCATED_IPS_CACHE_ITEMS);
 }
 
@@ -325,11 +398,17 @@ SymbolResolver::addSegment(
         const std::string& filename,
         backtrace_state* backtrace_state,
         const size_t filename_index,
+        const uintptr_t load_address,
         const uintptr_t address_start,
         const uintptr_t address_end)
 {
-    currentSegments()
-            .emplace_back(filename, address_start, address_end, backtrace_state, filename_index);
+    currentSegments().emplace_back(
+            filename,
+            load_address,
+            address_start,
+            address_end,
+            backtrace_state,
+            filename_index);
     d_are_segments_dirty = true;
 }
 
@@ -339,11 +418,8 @@ SymbolResolver::addSegments(
         uintptr_t addr,
         const std::vector<tracking_api::Segment>& segments)
 {
-    // We use a char* for the filename to reduce the memory footprint and
-    // because the libbacktrace callback in findBacktraceState operates on char*
-    const char* interned_filename = nullptr;
-    auto filename_index = d_string_storage->internString(filename, &interned_filename);
-    auto state = findBacktraceState(interned_filename, addr);
+    auto filename_index = d_string_storage->internString(filename);
+    auto state = d_backtrace_states->findBacktraceState(filename);
     if (state == nullptr) {
         LOG(ERROR) << "Failed to prepare a backtrace state for " << filename;
         return;
@@ -352,79 +428,56 @@ SymbolResolver::addSegments(
     for (const auto& segment : segments) {
         const uintptr_t segment_start = addr + segment.vaddr;
         const uintptr_t segment_end = addr + segment.vaddr + segment.memsz;
-        addSegment(filename, state, filename_index, segment_start, segment_end);
+        addSegment(filename, state, filename_index, addr, segment_start, segment_end);
     }
 }
 
 void
-SymbolResolver::clearSegments()
+SymbolResolver::removeSegments(
+        const std::string& filename,
+        uintptr_t addr,
+        const std::vector<tracking_api::Segment>& segments)
 {
-    if (d_are_segments_dirty) {
-        // Sort the segments so the binary search in resolve() works
-        sort(currentSegments().begin(), currentSegments().end());
+    if (currentSegmentGeneration() == 0) {
+        return;
     }
-    size_t reserve_size = 256;
-    if (currentSegmentGeneration() > 0) {
-        reserve_size = currentSegments().size();
+    auto filename_index = d_string_storage->internString(filename);
+    auto& current_segments = currentSegments();
+    for (const auto& segment : segments) {
+        const uintptr_t segment_start = addr + segment.vaddr;
+        const uintptr_t segment_end = addr + segment.vaddr + segment.memsz;
+        current_segments.erase(
+                std::remove_if(
+                        current_segments.begin(),
+                        current_segments.end(),
+                        [&](const MemorySegment& memory_segment) {
+                            return memory_segment.start() == segment_start
+                                   && memory_segment.end() == segment_end
+                                   && memory_segment.filenameIndex() == filename_index;
+                        }),
+                current_segments.end());
     }
-    d_segments[currentSegmentGeneration() + 1].reserve(reserve_size);
 }
 
-backtrace_state*
-SymbolResolver::findBacktraceState(const char* filename, uintptr_t address_start)
+void
+SymbolResolver::startNewSegmentGeneration()
 {
-    // We hash into "d_backtrace_states" using a char* as it's safe on the condition that every
-    // const char* used as a key in the map is one that was returned by "d_string_storage",
-    // and it's safe because no pointer that's returned by "d_string_storage" is ever invalidated.
-    auto it = d_backtrace_states.find(filename);
-    if (it != d_backtrace_states.end()) {
-        return it->second;
+    if (currentSegmentGeneration() == 0) {
+        d_segments[1].reserve(256);
+        return;
     }
 
-    struct CallbackData
-    {
-        const char* fileName;
-    };
-    CallbackData data = {filename};
-
-    auto errorHandler = [](void* rawData, const char* msg, int errnum) {
-        auto data = reinterpret_cast<const CallbackData*>(rawData);
-        LOG(WARNING) << "Error creating backtrace state for segment " << data->fileName << "(errno "
-                     << errnum << "): " << msg;
-    };
-
-    auto state = backtrace_create_state(data.fileName, false, errorHandler, &data);
-
-    if (!state) {
-        return nullptr;
+    if (d_are_segments_dirty) {
+        // Sort the segments so the binary search in resolve() works
+        sort(currentSegments().begin(), currentSegments().end());
+        d_are_segments_dirty = false;
     }
 
-    const int descriptor = backtrace_open(data.fileName, errorHandler, &data, nullptr);
-    if (descriptor >= 1) {
-        int foundSym = 0;
-        int foundDwarf = 0;
-
-        auto ret =
-                elf_add(state,
-                        data.fileName,
-                        descriptor,
-                        nullptr,
-                        0,
-                        address_start,
-                        errorHandler,
-                        &data,
-                        &state->fileline_fn,
-                        &foundSym,
-                        &foundDwarf,
-                        nullptr,
-                        false,
-                        false,
-                        nullptr,
-                        0);
-        state->syminfo_fn = (ret && foundSym) ? &elf_syminfo : &elf_nosyms;
-    }
-    d_backtrace_states.insert(it, {filename, state});
-    return state;
+    // Memory maps are written incrementally: every new generation starts with
+    // the segments of the previous one and only receives the objects that were
+    // loaded or unloaded since then.
+    std::vector<MemorySegment> segments = currentSegments();
+    d_segments.emplace(currentSegmentGeneration() + 1, std::move(segments));
 }
 
 std::vector<MemorySegment>&
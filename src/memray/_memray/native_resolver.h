@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unistd.h>
@@ -59,6 +60,7 @@ class MemorySegment
     // Constructors
     MemorySegment(
             std::string filename,
+            uintptr_t load_address,
             uintptr_t start,
             uintptr_t end,
             backtrace_state* state,
@@ -81,6 +83,7 @@ class MemorySegment
 
     // Data members
     std::string d_filename;
+    uintptr_t d_load_address;
     uintptr_t d_start;
     uintptr_t d_end;
     size_t d_index;
@@ -132,13 +135,45 @@ class ResolvedFrames
     std::shared_ptr<StringStorage> d_string_storage{nullptr};
 };
 
+/**
+ * The libbacktrace states of the object files that the tracked process had
+ * mapped, by file name.
+ *
+ * Creating a state reads the symbols and debug information of its file, which
+ * is by far the slowest part of resolving native stacks. The states are
+ * created for a load address of 0, so the same state can resolve the
+ * addresses of every capture that mapped the file, wherever it was loaded, and
+ * a cache can be shared by any number of resolvers, even from several threads.
+ **/
+class BacktraceStateCache
+{
+  public:
+    // Constructors
+    BacktraceStateCache();
+    BacktraceStateCache(const BacktraceStateCache&) = delete;
+    BacktraceStateCache& operator=(const BacktraceStateCache&) = delete;
+
+    // Methods
+    backtrace_state* findBacktraceState(const std::string& filename);
+
+    // Getters
+    size_t size() const;
+
+  private:
+    // Data members
+    mutable std::mutex d_mutex;
+    // The file name that libbacktrace is given must outlive the state, and the
+    // keys of an unordered_map are never moved.
+    std::unordered_map<std::string, backtrace_state*> d_backtrace_states;
+};
+
 class SymbolResolver
 {
   public:
     using resolved_frames_t = std::shared_ptr<const ResolvedFrames>;
 
     // Constructors
-    SymbolResolver();
+    explicit SymbolResolver(std::shared_ptr<BacktraceStateCache> backtrace_states = nullptr);
 
     // Methods
     resolved_frames_t resolve(uintptr_t ip, size_t generation);
@@ -146,8 +181,11 @@ class SymbolResolver
             const std::string& filename,
             uintptr_t addr,
             const std::vector<tracking_api::Segment>& segments);
-    void clearSegments();
-    backtrace_state* findBacktraceState(const char* filename, uintptr_t address_start);
+    void removeSegments(
+            const std::string& filename,
+            uintptr_t addr,
+            const std::vector<tracking_api::Segment>& segments);
+    void startNewSegmentGeneration();
 
     // Getters
     size_t currentSegmentGeneration() const;
@@ -169,6 +207,7 @@ class SymbolResolver
             const std::string& filename,
             backtrace_state* backtrace_state,
             size_t filename_index,
+            uintptr_t load_address,
             uintptr_t address_start,
             uintptr_t address_end);
     std::vector<MemorySegment>& currentSegments();
@@ -177,7 +216,7 @@ class SymbolResolver
     // Data members
     std::unordered_map<size_t, std::vector<MemorySegment>> d_segments;
     bool d_are_segments_dirty = false;
-    std::unordered_map<const char*, backtrace_state*> d_backtrace_states;
+    std::shared_ptr<BacktraceStateCache> d_backtrace_states;
     std::shared_ptr<StringStorage> d_string_storage{std::make_shared<StringStorage>()};
     mutable std::unordered_map<ips_cache_pair_t, resolved_frames_t, ips_cache_pair_hash>
             d_resolved_ips_cache;
@@ -0,0 +1,4 @@
+cdef extern from "native_resolver.h" namespace "memray::native_resolver":
+    cdef cppclass BacktraceStateCache:
+        BacktraceStateCache() except+
+        size_t size()
@@ -0,0 +1,202 @@
+#include <algorithm>
+
+#include "page_occupancy.h"
+
+namespace memray::api {
+
+PageOccupancyAggregator::PageOccupancyAggregator(size_t page_size, double sparse_threshold)
+: d_page_size(page_size)
+, d_sparse_bytes(static_cast<size_t>(sparse_threshold * page_size))
+{
+}
+
+PageOccupancyAggregator::PageSpan
+PageOccupancyAggregator::spanPages(uintptr_t address, size_t size) const noexcept
+{
+    PageSpan span;
+    if (size == 0) {
+        return span;
+    }
+
+    const uintptr_t end = address + size;
+    const uintptr_t first_page = address / d_page_size;
+    const uintptr_t last_page = (end - 1) / d_page_size;
+    auto addPage = [&](uintptr_t page, size_t bytes) {
+        if (bytes == d_page_size) {
+            ++span.full_pages;
+        } else {
+            span.edge_pages[span.n_edge_pages++] = {page, bytes};
+        }
+    };
+
+    if (first_page == last_page) {
+        addPage(first_page, size);
+        return span;
+    }
+    addPage(first_page, (first_page + 1) * d_page_size - address);
+    addPage(last_page, end - last_page * d_page_size);
+    span.full_pages += last_page - first_page - 1;
+    return span;
+}
+
+bool
+PageOccupancyAggregator::isSparse(const PageUsage& usage) const noexcept
+{
+    return usage.live_bytes < d_sparse_bytes;
+}
+
+void
+PageOccupancyAggregator::updatePage(uintptr_t page, size_t bytes, bool adding)
+{
+    auto [it, inserted] = d_edge_pages.try_emplace(page, PageUsage{0, 0});
+    PageUsage& usage = it->second;
+    if (inserted) {
+        if (!adding) {
+            d_edge_pages.erase(it);
+            return;
+        }
+        ++d_occupancy.occupied_pages;
+    } else {
+        d_occupancy.partially_used_pages -= usage.live_bytes < d_page_size;
+        d_occupancy.sparse_pages -= isSparse(usage);
+    }
+
+    if (adding) {
+        usage.live_bytes += bytes;
+        ++usage.allocations;
+    } else {
+        usage.live_bytes -= std::min<size_t>(bytes, usage.live_bytes);
+        --usage.allocations;
+    }
+
+    if (usage.allocations == 0) {
+        d_edge_pages.erase(it);
+        --d_occupancy.occupied_pages;
+        return;
+    }
+    d_occupancy.partially_used_pages += usage.live_bytes < d_page_size;
+    d_occupancy.sparse_pages += isSparse(usage);
+}
+
+void
+PageOccupancyAggregator::updatePages(uintptr_t address, size_t size, bool adding)
+{
+    const PageSpan span = spanPages(address, size);
+    if (adding) {
+        d_occupancy.occupied_pages += span.full_pages;
+    } else {
+        d_occupancy.occupied_pages -= span.full_pages;
+    }
+    for (size_t i = 0; i < span.n_edge_pages; ++i) {
+        updatePage(span.edge_pages[i].first, span.edge_pages[i].second, adding);
+    }
+}
+
+void
+PageOccupancyAggregator::updateRegions(uintptr_t address, size_t size, bool adding)
+{
+    if (size == 0) {
+        return;
+    }
+    const uintptr_t last_region = (address + size - 1) / REGION_SIZE;
+    for (uintptr_t region = address / REGION_SIZE; region <= last_region; ++region) {
+        if (adding) {
+            if (d_region_allocations[region]++ == 0) {
+                ++d_occupancy.regions;
+            }
+            continue;
+        }
+        auto it = d_region_allocations.find(region);
+        if (it != d_region_allocations.end() && --it->second == 0) {
+            d_region_allocations.erase(it);
+            --d_occupancy.regions;
+        }
+    }
+}
+
+void
+PageOccupancyAggregator::addAllocation(const Allocation& allocation)
+{
+    if (hooks::isPoolAllocator(allocation.allocator)) {
+        return;
+    }
+
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
+            auto [it, inserted] = d_live_allocations.try_emplace(AllocationKey(allocation), allocation);
+            if (!inserted) {
+                // The deallocation of the previous allocation at this address
+                // wasn't captured, so replace it.
+                const Allocation& previous = it->second;
+                updatePages(previous.address, previous.size, false);
+                updateRegions(previous.address, previous.size, false);
+                d_occupancy.heap_size -= previous.size;
+                it->second = allocation;
+            }
+            updatePages(allocation.address, allocation.size, true);
+            updateRegions(allocation.address, allocation.size, true);
+            d_occupancy.heap_size += allocation.size;
+            break;
+        }
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
+            auto it = d_live_allocations.find(AllocationKey(allocation));
+            if (it == d_live_allocations.end()) {
+                break;
+            }
+            const Allocation& freed = it->second;
+            updatePages(freed.address, freed.size, false);
+            updateRegions(freed.address, freed.size, false);
+            d_occupancy.heap_size -= freed.size;
+            d_live_allocations.erase(it);
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_ALLOCATOR:
+        case hooks::AllocatorKind::RANGED_DEALLOCATOR:
+            break;
+    }
+}
+
+const PageOccupancy&
+PageOccupancyAggregator::getOccupancy() const noexcept
+{
+    return d_occupancy;
+}
+
+reduced_snapshot_map_t
+PageOccupancyAggregator::getSparsePageAllocations(bool merge_threads) const
+{
+    reduced_snapshot_map_t stack_to_allocation{};
+
+    for (const auto& [key, allocation] : d_live_allocations) {
+        const PageSpan span = spanPages(allocation.address, allocation.size);
+        size_t unused_bytes = 0;
+        bool on_sparse_page = false;
+        for (size_t i = 0; i < span.n_edge_pages; ++i) {
+            const PageUsage& usage = d_edge_pages.at(span.edge_pages[i].first);
+            if (!isSparse(usage)) {
+                continue;
+            }
+            on_sparse_page = true;
+            unused_bytes += (d_page_size - usage.live_bytes) / usage.allocations;
+        }
+        if (!on_sparse_page) {
+            continue;
+        }
+
+        const thread_id_t thread_id = merge_threads ? NO_THREAD_INFO : allocation.tid;
+        auto loc_key = LocationKey{allocation.frame_index, allocation.native_frame_id, thread_id};
+        auto alloc_it = stack_to_allocation.find(loc_key);
+        if (alloc_it == stack_to_allocation.end()) {
+            Allocation new_alloc = allocation;
+            new_alloc.size = unused_bytes;
+            stack_to_allocation.insert(alloc_it, std::pair(loc_key, new_alloc));
+        } else {
+            alloc_it->second.size += unused_bytes;
+            alloc_it->second.n_allocations += 1;
+        }
+    }
+
+    return stack_to_allocation;
+}
+
+}  // namespace memray::api
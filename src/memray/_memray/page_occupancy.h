@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+struct PageOccupancy
+{
+    // Bytes requested by the heap allocations that are alive.
+    size_t heap_size{0};
+    // Pages that contain at least one byte of a live heap allocation.
+    size_t occupied_pages{0};
+    // Occupied pages that are not completely used by live allocations.
+    size_t partially_used_pages{0};
+    // Occupied pages whose used fraction is below the sparse threshold.
+    size_t sparse_pages{0};
+    // Aligned regions of REGION_SIZE bytes that contain occupied pages.
+    size_t regions{0};
+};
+
+/**
+ * Models which pages of the address space are kept occupied by the heap
+ * allocations that are alive at each point of a capture.
+ *
+ * Every allocation made through malloc and friends (including pymalloc's)
+ * adds the bytes that it requested to the pages that it spans. Pages that an
+ * allocation covers completely can't hold anything else, so they are only
+ * counted; just the pages at the edges of each allocation are tracked one by
+ * one, with the number of live bytes and allocations that they hold. A page
+ * with a single small allocation still needs a whole page of physical
+ * memory, which is why the resident set size of a process can be much bigger
+ * than its heap.
+ *
+ * Memory mappings are ignored because they always span whole pages, and so
+ * are memory pool blocks, which live inside other tracked allocations.
+ **/
+class PageOccupancyAggregator
+{
+  public:
+    static constexpr size_t REGION_SIZE = 2 * 1024 * 1024;
+
+    PageOccupancyAggregator(size_t page_size, double sparse_threshold);
+
+    void addAllocation(const Allocation& allocation);
+    const PageOccupancy& getOccupancy() const noexcept;
+
+    // Aggregate, by location, the allocations that are alive on sparse pages.
+    // The size of each location is the unused part of the sparse pages that
+    // its allocations keep occupied, split evenly between the allocations
+    // that share each page.
+    reduced_snapshot_map_t getSparsePageAllocations(bool merge_threads) const;
+
+  private:
+    struct PageUsage
+    {
+        uint32_t live_bytes;
+        uint32_t allocations;
+    };
+
+    struct PageSpan
+    {
+        // Pages that the allocation covers completely.
+        size_t full_pages{0};
+        // Pages that it covers partially, with the bytes that it uses of each.
+        size_t n_edge_pages{0};
+        std::pair<uintptr_t, size_t> edge_pages[2];
+    };
+
+    PageSpan spanPages(uintptr_t address, size_t size) const noexcept;
+    void updatePages(uintptr_t address, size_t size, bool adding);
+    void updatePage(uintptr_t page, size_t bytes, bool adding);
+    void updateRegions(uintptr_t address, size_t size, bool adding);
+    bool isSparse(const PageUsage& usage) const noexcept;
+
+    const size_t d_page_size;
+    const size_t d_sparse_bytes;
+    PageOccupancy d_occupancy;
+    std::unordered_map<uintptr_t, PageUsage> d_edge_pages;
+    std::unordered_map<uintptr_t, size_t> d_region_allocations;
+    std::unordered_map<AllocationKey, Allocation, AllocationKey::Hash> d_live_allocations;
+};
+
+}  // namespace memray::api
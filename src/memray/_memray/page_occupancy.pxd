@@ -0,0 +1,18 @@
+from _memray.records cimport Allocation
+from _memray.snapshot cimport reduced_snapshot_map_t
+from libcpp cimport bool
+
+
+cdef extern from "page_occupancy.h" namespace "memray::api":
+    cdef struct PageOccupancy:
+        size_t heap_size
+        size_t occupied_pages
+        size_t partially_used_pages
+        size_t sparse_pages
+        size_t regions
+
+    cdef cppclass PageOccupancyAggregator:
+        PageOccupancyAggregator(size_t page_size, double sparse_threshold) except+
+        void addAllocation(const Allocation&) except+
+        const PageOccupancy& getOccupancy()
+        reduced_snapshot_map_t getSparsePageAllocations(bool merge_threads) except+
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace memray::api {
+
+/**
+ * Call a function with every index from 0 to n_tasks - 1, spreading the calls
+ * over as many threads as there are CPUs, and wait until all of them finish.
+ *
+ * The calling thread takes tasks too, instead of just waiting. If any call
+ * throws, the exception of the task with the lowest index is rethrown once
+ * every task has finished.
+ **/
+template<typename Function>
+void
+parallelFor(size_t n_tasks, const Function& function)
+{
+    const size_t n_threads =
+            std::min<size_t>(n_tasks, std::max(1U, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next_task{0};
+    std::vector<std::exception_ptr> errors(n_tasks);
+
+    auto worker = [&]() {
+        for (size_t index = next_task++; index < n_tasks; index = next_task++) {
+            try {
+                function(index);
+            } catch (...) {
+                errors[index] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < n_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace memray::api
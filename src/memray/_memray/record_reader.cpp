@@ -56,6 +56,14 @@ allocatorName(hooks::Allocator allocator)
             return "pymalloc_realloc";
         case hooks::Allocator::PYMALLOC_FREE:
             return "pymalloc_free";
+        case hooks::Allocator::MREMAP:
+            return "mremap";
+        case hooks::Allocator::MADVISE:
+            return "madvise";
+        case hooks::Allocator::POOL_ALLOC:
+            return "pool_alloc";
+        case hooks::Allocator::POOL_FREE:
+            return "pool_free";
     }
 
     return nullptr;
@@ -78,6 +86,7 @@ RecordReader::readHeader(HeaderRecord& header)
     }
     header.command_line.reserve(4096);
     if (!d_input->read(reinterpret_cast<char*>(&header.native_traces), sizeof(header.native_traces))
+        || !d_input->read(reinterpret_cast<char*>(&header.timestamps), sizeof(header.timestamps))
         || !d_input->read(reinterpret_cast<char*>(&header.stats), sizeof(header.stats))
         || !d_input->getline(header.command_line, '\0'))
     {
@@ -130,9 +139,13 @@ RecordReader::readSignedVarint(ssize_t* val)
     return true;
 }
 
-RecordReader::RecordReader(std::unique_ptr<Source> source, bool track_stacks)
+RecordReader::RecordReader(
+        std::unique_ptr<Source> source,
+        bool track_stacks,
+        std::shared_ptr<native_resolver::BacktraceStateCache> backtrace_states)
 : d_input(std::move(source))
 , d_track_stacks(track_stacks)
+, d_symbol_resolver(std::move(backtrace_states))
 {
     readHeader(d_header);
 
@@ -247,10 +260,34 @@ RecordReader::processNativeFrameIndex(const UnresolvedNativeFrame& frame)
     return true;
 }
 
+bool
+RecordReader::parseAllocator(hooks::Allocator* allocator, unsigned int* pool_id, unsigned int flags)
+{
+    if (flags != EXTENDED_ALLOCATOR_FLAGS) {
+        *allocator = static_cast<hooks::Allocator>(flags);
+        return true;
+    }
+    unsigned char value;
+    if (!d_input->read(reinterpret_cast<char*>(&value), sizeof(value))) {
+        return false;
+    }
+    *allocator = static_cast<hooks::Allocator>(value);
+    if (hooks::isPoolAllocator(*allocator)) {
+        size_t pool;
+        if (!readVarint(&pool)) {
+            return false;
+        }
+        *pool_id = static_cast<unsigned int>(pool);
+    }
+    return true;
+}
+
 bool
 RecordReader::parseAllocationRecord(AllocationRecord* record, unsigned int flags)
 {
-    record->allocator = static_cast<hooks::Allocator>(flags);
+    if (!parseAllocator(&record->allocator, &record->pool_id, flags)) {
+        return false;
+    }
 
     if (!readIntegralDelta(&d_last.data_pointer, &record->address)) {
         return false;
@@ -272,6 +309,7 @@ RecordReader::processAllocationRecord(const AllocationRecord& record)
     d_latest_allocation.address = record.address;
     d_latest_allocation.size = record.size;
     d_latest_allocation.allocator = record.allocator;
+    d_latest_allocation.pool_id = record.pool_id;
     d_latest_allocation.native_frame_id = 0;
     if (d_track_stacks && !hooks::isDeallocator(record.allocator)) {
         auto& stack = d_stack_traces[d_latest_allocation.tid];
@@ -281,15 +319,15 @@ RecordReader::processAllocationRecord(const AllocationRecord& record)
     }
     d_latest_allocation.native_segment_generation = 0;
     d_latest_allocation.n_allocations = 1;
+    d_latest_allocation.timestamp = allocationTimestamp();
     return true;
 }
 
 bool
 RecordReader::parseNativeAllocationRecord(NativeAllocationRecord* record, unsigned int flags)
 {
-    record->allocator = static_cast<hooks::Allocator>(flags);
-
-    return readIntegralDelta(&d_last.data_pointer, &record->address) && readVarint(&record->size)
+    return parseAllocator(&record->allocator, &record->pool_id, flags)
+           && readIntegralDelta(&d_last.data_pointer, &record->address) && readVarint(&record->size)
            && readIntegralDelta(&d_last.native_frame_id, &record->native_frame_id);
 }
 
@@ -300,6 +338,7 @@ RecordReader::processNativeAllocationRecord(const NativeAllocationRecord& record
     d_latest_allocation.address = record.address;
     d_latest_allocation.size = record.size;
     d_latest_allocation.allocator = record.allocator;
+    d_latest_allocation.pool_id = record.pool_id;
     if (d_track_stacks) {
         d_latest_allocation.native_frame_id = record.native_frame_id;
         auto& stack = d_stack_traces[d_latest_allocation.tid];
@@ -311,6 +350,7 @@ RecordReader::processNativeAllocationRecord(const NativeAllocationRecord& record
         d_latest_allocation.native_segment_generation = 0;
     }
     d_latest_allocation.n_allocations = 1;
+    d_latest_allocation.timestamp = allocationTimestamp();
     return true;
 }
 
@@ -325,7 +365,10 @@ bool
 RecordReader::processMemoryMapStart()
 {
     std::lock_guard<std::mutex> lock(d_mutex);
-    d_symbol_resolver.clearSegments();
+    d_symbol_resolver.startNewSegmentGeneration();
+    if (d_track_stacks) {
+        d_memory_maps.emplace_back();
+    }
     return true;
 }
 
@@ -337,9 +380,14 @@ RecordReader::parseSegmentHeader(std::string* filename, size_t* num_segments, ui
 }
 
 bool
-RecordReader::processSegmentHeader(const std::string& filename, size_t num_segments, uintptr_t addr)
-{
-    std::vector<Segment> segments(num_segments);
+RecordReader::processSegmentHeader(
+        const std::string& filename,
+        size_t num_segments,
+        uintptr_t addr,
+        bool removed)
+{
+    std::vector<Segment> segments;
+    segments.reserve(num_segments);
     for (size_t i = 0; i < num_segments; i++) {
         RecordType record_type;
         if (!d_input->read(reinterpret_cast<char*>(&record_type), sizeof(record_type))
@@ -359,7 +407,12 @@ RecordReader::processSegmentHeader(const std::string& filename, size_t num_segme
 
     if (d_track_stacks) {
         std::lock_guard<std::mutex> lock(d_mutex);
-        d_symbol_resolver.addSegments(filename, addr, segments);
+        if (removed) {
+            d_symbol_resolver.removeSegments(filename, addr, segments);
+        } else {
+            d_symbol_resolver.addSegments(filename, addr, segments);
+        }
+        d_memory_maps.back().push_back({filename, addr, removed, std::move(segments)});
     }
     return true;
 }
@@ -418,6 +471,30 @@ RecordReader::processContextSwitch(thread_id_t tid)
     return true;
 }
 
+millis_t
+RecordReader::allocationTimestamp() const noexcept
+{
+    return d_header.timestamps ? d_header.stats.start_time + d_last.timestamp : 0;
+}
+
+bool
+RecordReader::parseTimestamp(Timestamp* record)
+{
+    millis_t delta;
+    if (!readSignedVarint(&delta)) {
+        return false;
+    }
+    record->ms_since_start = d_last.timestamp + delta;
+    return true;
+}
+
+bool
+RecordReader::processTimestamp(const Timestamp& record)
+{
+    d_last.timestamp = record.ms_since_start;
+    return true;
+}
+
 RecordReader::RecordResult
 RecordReader::nextRecord()
 {
@@ -469,6 +546,13 @@ RecordReader::nextRecord()
                     return RecordResult::ERROR;
                 }
             } break;
+            case RecordType::TIMESTAMP: {
+                Timestamp record;
+                if (!parseTimestamp(&record) || !processTimestamp(record)) {
+                    if (d_input->is_open()) LOG(ERROR) << "Failed to process timestamp";
+                    return RecordResult::ERROR;
+                }
+            } break;
             case RecordType::FRAME_PUSH: {
                 FramePush record;
                 if (!parseFramePush(&record) || !processFramePush(record)) {
@@ -508,7 +592,11 @@ RecordReader::nextRecord()
                 size_t num_segments;
                 uintptr_t addr;
                 if (!parseSegmentHeader(&filename, &num_segments, &addr)
-                    || !processSegmentHeader(filename, num_segments, addr))
+                    || !processSegmentHeader(
+                            filename,
+                            num_segments,
+                            addr,
+                            record_type_and_flags.flags))
                 {
                     if (d_input->is_open()) LOG(ERROR) << "Failed to process segment header";
                     return RecordResult::ERROR;
@@ -566,6 +654,59 @@ error:
     return nullptr;
 }
 
+std::vector<Frame>
+RecordReader::getStackFrames(FrameTree::index_t index, size_t max_stacks)
+{
+    if (!d_track_stacks) {
+        throw std::runtime_error("Stack tracking is disabled");
+    }
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    std::vector<Frame> frames;
+    size_t stacks_obtained = 0;
+    FrameTree::index_t current_index = index;
+    while (current_index != 0 && stacks_obtained++ != max_stacks) {
+        auto [frame_id, next_index] = d_tree.nextNode(current_index);
+        frames.push_back(d_frame_map.at(frame_id));
+        current_index = next_index;
+    }
+    return frames;
+}
+
+std::vector<frame_id_t>
+RecordReader::getStackFrameIds(FrameTree::index_t index)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::vector<frame_id_t> frame_ids;
+    while (index != 0) {
+        auto [frame_id, next_index] = d_tree.nextNode(index);
+        frame_ids.push_back(frame_id);
+        index = next_index;
+    }
+    return frame_ids;
+}
+
+Frame
+RecordReader::getFrame(frame_id_t frame_id)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_frame_map.at(frame_id);
+}
+
+UnresolvedNativeFrame
+RecordReader::getNativeFrame(size_t index)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_native_frames.at(index - 1);
+}
+
+std::vector<ImageSegments>
+RecordReader::getMemoryMap(size_t generation)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_memory_maps.at(generation);
+}
+
 PyObject*
 RecordReader::Py_GetNativeStackFrame(FrameTree::index_t index, size_t generation, size_t max_stacks)
 {
@@ -653,17 +794,22 @@ RecordReader::dumpAllRecords()
             python_allocator = "other";
             break;
     }
-    printf("HEADER magic=%.*s version=%d native_traces=%s"
+    printf("HEADER magic=%.*s version=%d native_traces=%s timestamps=%s"
            " n_allocations=%zd n_frames=%zd start_time=%lld end_time=%lld"
+           " n_dropped_by_size=%zd n_dropped_by_allocator=%zd n_dropped_by_thread=%zd"
            " pid=%d command_line=%s python_allocator=%s\n",
            (int)sizeof(d_header.magic),
            d_header.magic,
            d_header.version,
            d_header.native_traces ? "true" : "false",
+           d_header.timestamps ? "true" : "false",
            d_header.stats.n_allocations,
            d_header.stats.n_frames,
            d_header.stats.start_time,
            d_header.stats.end_time,
+           d_header.stats.n_dropped_by_size,
+           d_header.stats.n_dropped_by_allocator,
+           d_header.stats.n_dropped_by_thread,
            d_header.pid,
            d_header.command_line.c_str(),
            python_allocator.c_str());
@@ -701,11 +847,15 @@ RecordReader::dumpAllRecords()
                     allocator = unknownAllocator.c_str();
                 }
 
-                printf("address=%p size=%zd allocator=%s native_frame_id=%zd\n",
+                printf("address=%p size=%zd allocator=%s native_frame_id=%zd",
                        (void*)record.address,
                        record.size,
                        allocator,
                        record.native_frame_id);
+                if (hooks::isPoolAllocator(record.allocator)) {
+                    printf(" pool_id=%u", record.pool_id);
+                }
+                printf("\n");
             } break;
             case RecordType::ALLOCATION: {
                 printf("ALLOCATION ");
@@ -723,10 +873,14 @@ RecordReader::dumpAllRecords()
                             "<unknown allocator " + std::to_string((int)record.allocator) + ">";
                     allocator = unknownAllocator.c_str();
                 }
-                printf("address=%p size=%zd allocator=%s\n",
+                printf("address=%p size=%zd allocator=%s",
                        (void*)record.address,
                        record.size,
                        allocator);
+                if (hooks::isPoolAllocator(record.allocator)) {
+                    printf(" pool_id=%u", record.pool_id);
+                }
+                printf("\n");
             } break;
             case RecordType::FRAME_PUSH: {
                 printf("FRAME_PUSH ");
@@ -788,10 +942,11 @@ RecordReader::dumpAllRecords()
                     Py_RETURN_NONE;
                 }
 
-                printf("filename=%s num_segments=%zd addr=%p\n",
+                printf("filename=%s num_segments=%zd addr=%p%s\n",
                        filename.c_str(),
                        num_segments,
-                       (void*)addr);
+                       (void*)addr,
+                       record_type_and_flags.flags ? " removed" : "");
             } break;
             case RecordType::SEGMENT: {
                 printf("SEGMENT ");
@@ -823,6 +978,16 @@ RecordReader::dumpAllRecords()
 
                 printf("time=%ld memory=%" PRIxPTR "\n", record.ms_since_epoch, record.rss);
             } break;
+            case RecordType::TIMESTAMP: {
+                printf("TIMESTAMP ");
+
+                Timestamp record;
+                if (!parseTimestamp(&record) || !processTimestamp(record)) {
+                    Py_RETURN_NONE;
+                }
+
+                printf("time=%lld\n", d_header.stats.start_time + record.ms_since_start);
+            } break;
             case RecordType::CONTEXT_SWITCH: {
                 printf("CONTEXT_SWITCH ");
 
@@ -25,6 +25,15 @@ using namespace tracking_api;
 
 using allocations_t = std::vector<Allocation>;
 
+// The segments of an object file, as they appear in a memory map of a capture.
+struct ImageSegments
+{
+    std::string filename;
+    uintptr_t addr;
+    bool removed;
+    std::vector<Segment> segments;
+};
+
 class RecordReader
 {
   public:
@@ -34,7 +43,10 @@ class RecordReader
         ERROR,
         END_OF_FILE,
     };
-    explicit RecordReader(std::unique_ptr<memray::io::Source> source, bool track_stacks = true);
+    explicit RecordReader(
+            std::unique_ptr<memray::io::Source> source,
+            bool track_stacks = true,
+            std::shared_ptr<native_resolver::BacktraceStateCache> backtrace_states = nullptr);
     void close() noexcept;
     bool isOpen() const noexcept;
     PyObject*
@@ -44,6 +56,17 @@ class RecordReader
             size_t generation,
             size_t max_stacks = std::numeric_limits<size_t>::max());
 
+    // The Python frames of a stack, from the innermost to the outermost one.
+    std::vector<Frame>
+    getStackFrames(FrameTree::index_t index, size_t max_stacks = std::numeric_limits<size_t>::max());
+
+    // The pieces of the capture that the allocations read so far refer to,
+    // for writing them out again.
+    std::vector<frame_id_t> getStackFrameIds(FrameTree::index_t index);
+    Frame getFrame(frame_id_t frame_id);
+    UnresolvedNativeFrame getNativeFrame(size_t index);
+    std::vector<ImageSegments> getMemoryMap(size_t generation);
+
     RecordResult nextRecord();
     HeaderRecord getHeader() const noexcept;
     PyObject* dumpAllRecords();
@@ -79,6 +102,8 @@ class RecordReader
     mutable python_helpers::PyUnicode_Cache d_pystring_cache{};
     native_resolver::SymbolResolver d_symbol_resolver;
     std::vector<UnresolvedNativeFrame> d_native_frames{};
+    // The objects added or removed by each generation of the memory map.
+    std::vector<std::vector<ImageSegments>> d_memory_maps{1};
     DeltaEncodedFields d_last;
     std::unordered_map<thread_id_t, std::string> d_thread_names;
     Allocation d_latest_allocation;
@@ -97,6 +122,7 @@ class RecordReader
     [[nodiscard]] bool parseNativeFrameIndex(UnresolvedNativeFrame* frame);
     [[nodiscard]] bool processNativeFrameIndex(const UnresolvedNativeFrame& frame);
 
+    [[nodiscard]] bool parseAllocator(hooks::Allocator* allocator, unsigned int* pool_id, unsigned int flags);
     [[nodiscard]] bool parseAllocationRecord(AllocationRecord* record, unsigned int flags);
     [[nodiscard]] bool processAllocationRecord(const AllocationRecord& record);
 
@@ -107,8 +133,11 @@ class RecordReader
     [[nodiscard]] bool processMemoryMapStart();
 
     [[nodiscard]] bool parseSegmentHeader(std::string* filename, size_t* num_segments, uintptr_t* addr);
-    [[nodiscard]] bool
-    processSegmentHeader(const std::string& filename, size_t num_segments, uintptr_t addr);
+    [[nodiscard]] bool processSegmentHeader(
+            const std::string& filename,
+            size_t num_segments,
+            uintptr_t addr,
+            bool removed);
 
     [[nodiscard]] bool parseSegment(Segment* segment);
 
@@ -121,7 +150,11 @@ class RecordReader
     [[nodiscard]] bool parseContextSwitch(thread_id_t* tid);
     [[nodiscard]] bool processContextSwitch(thread_id_t tid);
 
+    [[nodiscard]] bool parseTimestamp(Timestamp* record);
+    [[nodiscard]] bool processTimestamp(const Timestamp& record);
+
     size_t getAllocationFrameIndex(const AllocationRecord& record);
+    millis_t allocationTimestamp() const noexcept;
 };
 
 template<typename T>
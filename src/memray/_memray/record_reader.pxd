@@ -1,8 +1,10 @@
+from _memray.native_resolver cimport BacktraceStateCache
 from _memray.records cimport Allocation
 from _memray.records cimport HeaderRecord
 from _memray.records cimport MemoryRecord
 from _memray.source cimport Source
 from libcpp cimport bool
+from libcpp.memory cimport shared_ptr
 from libcpp.memory cimport unique_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
@@ -18,6 +20,8 @@ cdef extern from "record_reader.h" namespace "memray::api":
     cdef cppclass RecordReader:
         RecordReader(unique_ptr[Source]) except+
         RecordReader(unique_ptr[Source], bool track_stacks) except+
+        RecordReader(unique_ptr[Source], bool track_stacks,
+                     shared_ptr[BacktraceStateCache] backtrace_states) except+
         void close()
         bool isOpen() const
         RecordResult nextRecord() except+
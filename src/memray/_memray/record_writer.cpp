@@ -34,14 +34,17 @@ getPythonAllocator()
 RecordWriter::RecordWriter(
         std::unique_ptr<memray::io::Sink> sink,
         const std::string& command_line,
-        bool native_traces)
+        bool native_traces,
+        bool timestamps)
 : d_sink(std::move(sink))
 , d_stats({0, 0, duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()})
+, d_monotonic_start(coarseMonotonicMillis())
 {
     d_header = HeaderRecord{
             "",
             d_version,
             native_traces,
+            timestamps,
             d_stats,
             command_line,
             ::getpid(),
@@ -49,6 +52,18 @@ RecordWriter::RecordWriter(
     strncpy(d_header.magic, MAGIC, sizeof(d_header.magic));
 }
 
+RecordWriter::RecordWriter(std::unique_ptr<memray::io::Sink> sink, const HeaderRecord& header)
+: d_sink(std::move(sink))
+, d_header(header)
+, d_stats(header.stats)
+, d_copying(true)
+{
+    strncpy(d_header.magic, MAGIC, sizeof(d_header.magic));
+    d_header.version = d_version;
+    d_stats.n_allocations = 0;
+    d_stats.n_frames = 0;
+}
+
 bool
 RecordWriter::writeHeader(bool seek_to_start)
 {
@@ -61,10 +76,13 @@ RecordWriter::writeHeader(bool seek_to_start)
         }
     }
 
-    d_stats.end_time = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    if (!d_copying) {
+        d_stats.end_time = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }
     d_header.stats = d_stats;
     if (!writeSimpleType(d_header.magic) or !writeSimpleType(d_header.version)
-        or !writeSimpleType(d_header.native_traces) or !writeSimpleType(d_header.stats)
+        or !writeSimpleType(d_header.native_traces) or !writeSimpleType(d_header.timestamps)
+        or !writeSimpleType(d_header.stats)
         or !writeString(d_header.command_line.c_str()) or !writeSimpleType(d_header.pid)
         or !writeSimpleType(d_header.python_allocator))
     {
@@ -73,6 +91,22 @@ RecordWriter::writeHeader(bool seek_to_start)
     return true;
 }
 
+void
+RecordWriter::setDroppedAllocations(size_t by_size, size_t by_allocator, size_t by_thread)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stats.n_dropped_by_size = by_size;
+    d_stats.n_dropped_by_allocator = by_allocator;
+    d_stats.n_dropped_by_thread = by_thread;
+}
+
+void
+RecordWriter::setEndTime(millis_t end_time)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stats.end_time = end_time;
+}
+
 std::unique_lock<std::mutex>
 RecordWriter::acquireLock()
 {
@@ -89,7 +123,8 @@ RecordWriter::cloneInChildProcess()
     return std::make_unique<RecordWriter>(
             std::move(new_sink),
             d_header.command_line,
-            d_header.native_traces);
+            d_header.native_traces,
+            d_header.timestamps);
 }
 
 }  // namespace memray::tracking_api
@@ -6,6 +6,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <time.h>
 #include <type_traits>
 #include <unistd.h>
 
@@ -19,7 +20,12 @@ class RecordWriter
     explicit RecordWriter(
             std::unique_ptr<memray::io::Sink> sink,
             const std::string& command_line,
-            bool native_traces);
+            bool native_traces,
+            bool timestamps = false);
+    // Write a copy of another capture: its metadata is kept as is, and the
+    // timestamps of the allocations come from its Timestamp records instead
+    // of from the clock.
+    RecordWriter(std::unique_ptr<memray::io::Sink> sink, const HeaderRecord& header);
 
     RecordWriter(RecordWriter& other) = delete;
     RecordWriter(RecordWriter&& other) = delete;
@@ -31,6 +37,10 @@ class RecordWriter
     bool inline writeString(const char* the_string);
     bool inline writeVarint(size_t val);
     bool inline writeSignedVarint(ssize_t val);
+    bool inline writeAllocationToken(
+            RecordType record_type,
+            hooks::Allocator allocator,
+            unsigned int pool_id);
     template<typename T>
     bool inline writeIntegralDelta(T* prev, T new_val);
     template<typename T>
@@ -41,6 +51,7 @@ class RecordWriter
     bool inline writeRecordUnsafe(const FramePush& record);
     bool inline writeRecordUnsafe(const MemoryRecord& record);
     bool inline writeRecordUnsafe(const ContextSwitch& record);
+    bool inline writeRecordUnsafe(const Timestamp& record);
     bool inline writeRecordUnsafe(const Segment& record);
     bool inline writeRecordUnsafe(const AllocationRecord& record);
     bool inline writeRecordUnsafe(const NativeAllocationRecord& record);
@@ -50,11 +61,15 @@ class RecordWriter
     bool inline writeRecordUnsafe(const UnresolvedNativeFrame& record);
     bool inline writeRecordUnsafe(const MemoryMapStart&);
     bool writeHeader(bool seek_to_start);
+    void setDroppedAllocations(size_t by_size, size_t by_allocator, size_t by_thread);
+    void setEndTime(millis_t end_time);
 
     std::unique_lock<std::mutex> acquireLock();
     std::unique_ptr<RecordWriter> cloneInChildProcess();
 
   private:
+    bool inline writeTimestampIfChanged();
+
     // Data members
     int d_version{CURRENT_HEADER_VERSION};
     std::unique_ptr<memray::io::Sink> d_sink;
@@ -62,8 +77,20 @@ class RecordWriter
     HeaderRecord d_header{};
     TrackerStats d_stats{};
     DeltaEncodedFields d_last;
+    millis_t d_monotonic_start{0};
+    bool d_copying{false};
 };
 
+inline millis_t
+coarseMonotonicMillis()
+{
+    // The coarse clock is only as precise as the kernel's tick, but reading it
+    // is much cheaper than reading the precise one.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return static_cast<millis_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
 template<typename T>
 bool inline RecordWriter::writeSimpleType(const T& item)
 {
@@ -105,6 +132,19 @@ bool inline RecordWriter::writeSignedVarint(ssize_t val)
     return writeVarint(zigzag_val);
 }
 
+bool inline RecordWriter::writeAllocationToken(
+        RecordType record_type,
+        hooks::Allocator allocator,
+        unsigned int pool_id)
+{
+    auto value = static_cast<unsigned char>(allocator);
+    if (value <= MAX_FLAGS_ALLOCATOR) {
+        return writeSimpleType(RecordTypeAndFlags{record_type, value});
+    }
+    return writeSimpleType(RecordTypeAndFlags{record_type, EXTENDED_ALLOCATOR_FLAGS})
+           && writeSimpleType(value) && (!hooks::isPoolAllocator(allocator) || writeVarint(pool_id));
+}
+
 template<typename T>
 bool inline RecordWriter::writeIntegralDelta(T* prev, T new_val)
 {
@@ -170,6 +210,21 @@ bool inline RecordWriter::writeRecordUnsafe(const ContextSwitch& record)
     return writeSimpleType(token) && writeSimpleType(record);
 }
 
+bool inline RecordWriter::writeRecordUnsafe(const Timestamp& record)
+{
+    RecordTypeAndFlags token{RecordType::TIMESTAMP, 0};
+    return writeSimpleType(token) && writeIntegralDelta(&d_last.timestamp, record.ms_since_start);
+}
+
+bool inline RecordWriter::writeTimestampIfChanged()
+{
+    if (!d_header.timestamps || d_copying) {
+        return true;
+    }
+    millis_t ms_since_start = coarseMonotonicMillis() - d_monotonic_start;
+    return ms_since_start == d_last.timestamp || writeRecordUnsafe(Timestamp{ms_since_start});
+}
+
 bool inline RecordWriter::writeRecordUnsafe(const Segment& record)
 {
     RecordTypeAndFlags token{RecordType::SEGMENT, 0};
@@ -179,8 +234,9 @@ bool inline RecordWriter::writeRecordUnsafe(const Segment& record)
 bool inline RecordWriter::writeRecordUnsafe(const AllocationRecord& record)
 {
     d_stats.n_allocations += 1;
-    RecordTypeAndFlags token{RecordType::ALLOCATION, static_cast<unsigned char>(record.allocator)};
-    return writeSimpleType(token) && writeIntegralDelta(&d_last.data_pointer, record.address)
+    return writeTimestampIfChanged()
+           && writeAllocationToken(RecordType::ALLOCATION, record.allocator, record.pool_id)
+           && writeIntegralDelta(&d_last.data_pointer, record.address)
            && (hooks::allocatorKind(record.allocator) == hooks::AllocatorKind::SIMPLE_DEALLOCATOR
                || writeVarint(record.size));
 }
@@ -188,10 +244,9 @@ bool inline RecordWriter::writeRecordUnsafe(const AllocationRecord& record)
 bool inline RecordWriter::writeRecordUnsafe(const NativeAllocationRecord& record)
 {
     d_stats.n_allocations += 1;
-    RecordTypeAndFlags token{
-            RecordType::ALLOCATION_WITH_NATIVE,
-            static_cast<unsigned char>(record.allocator)};
-    return writeSimpleType(token) && writeIntegralDelta(&d_last.data_pointer, record.address)
+    return writeTimestampIfChanged()
+           && writeAllocationToken(RecordType::ALLOCATION_WITH_NATIVE, record.allocator, record.pool_id)
+           && writeIntegralDelta(&d_last.data_pointer, record.address)
            && writeVarint(record.size)
            && writeIntegralDelta(&d_last.native_frame_id, record.native_frame_id);
 }
@@ -207,7 +262,7 @@ bool inline RecordWriter::writeRecordUnsafe(const pyrawframe_map_val_t& item)
 
 bool inline RecordWriter::writeRecordUnsafe(const SegmentHeader& item)
 {
-    RecordTypeAndFlags token{RecordType::SEGMENT_HEADER, 0};
+    RecordTypeAndFlags token{RecordType::SEGMENT_HEADER, static_cast<unsigned char>(item.removed)};
     return writeSimpleType(token) && writeString(item.filename) && writeVarint(item.num_segments)
            && writeSimpleType(item.addr);
 }
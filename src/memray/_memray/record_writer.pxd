@@ -6,4 +6,4 @@ from libcpp.string cimport string
 
 cdef extern from "record_writer.h" namespace "memray::api":
     cdef cppclass RecordWriter:
-        RecordWriter(unique_ptr[Sink], string command_line, bool native_trace) except+
+        RecordWriter(unique_ptr[Sink], string command_line, bool native_trace, bool timestamps) except+
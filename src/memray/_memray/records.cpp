@@ -11,7 +11,7 @@ Allocation::toPythonObject() const
     // operations speeds up the parsing moderately. Additionally, some of
     // the types we need to convert from are not supported by PyBuildValue
     // natively.
-    PyObject* tuple = PyTuple_New(8);
+    PyObject* tuple = PyTuple_New(10);
     if (tuple == nullptr) {
         return nullptr;
     }
@@ -47,6 +47,12 @@ Allocation::toPythonObject() const
     elem = PyLong_FromSize_t(native_segment_generation);
     __CHECK_ERROR(elem);
     PyTuple_SET_ITEM(tuple, 7, elem);
+    elem = PyLong_FromUnsignedLong(pool_id);
+    __CHECK_ERROR(elem);
+    PyTuple_SET_ITEM(tuple, 8, elem);
+    elem = PyLong_FromLongLong(timestamp);
+    __CHECK_ERROR(elem);
+    PyTuple_SET_ITEM(tuple, 9, elem);
 #undef __CHECK_ERROR
     return tuple;
 }
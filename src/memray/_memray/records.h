@@ -14,7 +14,7 @@
 namespace memray::tracking_api {
 
 const char MAGIC[] = "memray";
-const int CURRENT_HEADER_VERSION = 7;
+const int CURRENT_HEADER_VERSION = 12;
 
 using frame_id_t = size_t;
 using thread_id_t = unsigned long;
@@ -34,6 +34,7 @@ enum class RecordType : unsigned char {
     THREAD_RECORD = 10,
     MEMORY_RECORD = 11,
     CONTEXT_SWITCH = 12,
+    TIMESTAMP = 13,
 };
 
 struct RecordTypeAndFlags
@@ -59,12 +60,22 @@ struct RecordTypeAndFlags
 
 static_assert(sizeof(RecordTypeAndFlags) == 1);
 
+// Allocators are normally stored in the flags of allocation records. Those
+// whose value doesn't fit in 4 bits are stored with flags set to this value,
+// and in a byte that follows the record type. The allocators of the public C
+// API are followed by the id of the pool that the block belongs to.
+const unsigned char EXTENDED_ALLOCATOR_FLAGS = 0;
+const unsigned char MAX_FLAGS_ALLOCATOR = 0x0f;
+
 struct TrackerStats
 {
     size_t n_allocations{0};
     size_t n_frames{0};
     millis_t start_time{};
     millis_t end_time{};
+    size_t n_dropped_by_size{0};
+    size_t n_dropped_by_allocator{0};
+    size_t n_dropped_by_thread{0};
 };
 
 enum PythonAllocatorType {
@@ -79,6 +90,7 @@ struct HeaderRecord
     char magic[sizeof(MAGIC)];
     int version{};
     bool native_traces{false};
+    bool timestamps{false};
     TrackerStats stats{};
     std::string command_line;
     int pid{-1};
@@ -91,11 +103,20 @@ struct MemoryRecord
     size_t rss;
 };
 
+// Written before an allocation record when the coarse monotonic clock has
+// advanced since the last one, so readers know when each allocation happened
+// to within a few milliseconds.
+struct Timestamp
+{
+    millis_t ms_since_start;
+};
+
 struct AllocationRecord
 {
     uintptr_t address;
     size_t size;
     hooks::Allocator allocator;
+    unsigned int pool_id{0};
 };
 
 struct NativeAllocationRecord
@@ -104,6 +125,7 @@ struct NativeAllocationRecord
     size_t size;
     hooks::Allocator allocator;
     frame_id_t native_frame_id{0};
+    unsigned int pool_id{0};
 };
 
 struct Allocation
@@ -112,10 +134,13 @@ struct Allocation
     uintptr_t address;
     size_t size;
     hooks::Allocator allocator;
+    unsigned int pool_id{0};
     frame_id_t native_frame_id{0};
     size_t frame_index{0};
     size_t native_segment_generation{0};
     size_t n_allocations{1};
+    // Milliseconds since the epoch, or 0 if the capture has no timestamps.
+    millis_t timestamp{0};
 
     PyObject* toPythonObject() const;
 };
@@ -129,6 +154,7 @@ struct SegmentHeader
     const char* filename;
     size_t num_segments;
     uintptr_t addr;
+    bool removed{false};
 };
 
 struct Segment
@@ -234,6 +260,7 @@ struct DeltaEncodedFields
     frame_id_t native_frame_id{};
     frame_id_t python_frame_id{};
     int python_line_number{};
+    millis_t timestamp{};
 };
 
 template<typename FrameType>
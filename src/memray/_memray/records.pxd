@@ -23,10 +23,14 @@ cdef extern from "records.h" namespace "memray::tracking_api":
        size_t n_frames
        long long start_time
        long long end_time
+       size_t n_dropped_by_size
+       size_t n_dropped_by_allocator
+       size_t n_dropped_by_thread
 
    struct HeaderRecord:
        int version
        bool native_traces
+       bool timestamps
        TrackerStats stats
        string command_line
        int pid
@@ -36,6 +40,7 @@ cdef extern from "records.h" namespace "memray::tracking_api":
        AllocationRecord record
        size_t frame_index
        size_t n_allocations
+       long long timestamp
        object toPythonObject()
 
    struct MemoryRecord:
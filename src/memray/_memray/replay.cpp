@@ -0,0 +1,453 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+#include "replay.h"
+
+namespace memray::api {
+
+namespace {  // unnamed
+
+// Alignment of the replayed aligned allocations, which the capture doesn't record.
+const size_t ALIGNMENT = 64;
+void* const FAILED_ALLOCATION = reinterpret_cast<void*>(1);
+
+size_t
+pageSize()
+{
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+size_t
+residentBytes()
+{
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    if (fscanf(statm, "%zu %zu", &total_pages, &resident_pages) != 2) {
+        resident_pages = 0;
+    }
+    fclose(statm);
+    return resident_pages * pageSize();
+}
+
+size_t
+peakResidentBytes()
+{
+    size_t peak_kb = 0;
+    FILE* status = fopen("/proc/self/status", "r");
+    if (!status) {
+        return 0;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), status)) {
+        if (sscanf(line, "VmHWM: %zu kB", &peak_kb) == 1) {
+            break;
+        }
+    }
+    fclose(status);
+    return peak_kb * 1024;
+}
+
+void
+resetPeakResidentBytes()
+{
+    // Writing 5 to clear_refs resets the peak RSS of the process.
+    FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (clear_refs) {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+}
+
+// Write to every page of the allocation, so that it becomes resident like
+// the memory that the captured program used.
+void
+touch(void* ptr, size_t size)
+{
+    auto bytes = static_cast<volatile char*>(ptr);
+    for (size_t offset = 0; offset < size; offset += pageSize()) {
+        bytes[offset] = 0;
+    }
+}
+
+}  // unnamed namespace
+
+AllocationReplayer::AllocationReplayer(bool preserve_order)
+: d_preserve_order(preserve_order)
+{
+}
+
+bool
+AllocationReplayer::loadCapture(RecordReader& reader)
+{
+    while (true) {
+        switch (reader.nextRecord()) {
+            case RecordReader::RecordResult::ALLOCATION_RECORD:
+                processAllocation(reader.getLatestAllocation());
+                break;
+            case RecordReader::RecordResult::MEMORY_RECORD:
+                break;
+            case RecordReader::RecordResult::ERROR:
+                return false;
+            case RecordReader::RecordResult::END_OF_FILE: {
+                while (!d_pending_frees.empty()) {
+                    flushPendingFree(d_pending_frees.begin()->first);
+                }
+                d_pointers = std::make_unique<std::atomic<void*>[]>(d_next_id);
+                for (size_t id = 0; id < d_next_id; ++id) {
+                    d_pointers[id].store(nullptr, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+    }
+}
+
+size_t
+AllocationReplayer::newId(size_t size, bool mapping)
+{
+    d_sizes.push_back(size);
+    d_is_mapping.push_back(mapping);
+    return d_next_id++;
+}
+
+void
+AllocationReplayer::addOperation(thread_id_t tid, const Operation& operation)
+{
+    auto& operations = d_operations[tid];
+    operations.push_back(operation);
+    operations.back().sequence = d_next_sequence++;
+}
+
+void
+AllocationReplayer::flushPendingFree(thread_id_t tid)
+{
+    auto it = d_pending_frees.find(tid);
+    if (it != d_pending_frees.end()) {
+        Operation operation = it->second;
+        d_pending_frees.erase(it);
+        addOperation(tid, operation);
+    }
+}
+
+void
+AllocationReplayer::processAllocation(const Allocation& allocation)
+{
+    const thread_id_t tid = allocation.tid;
+    switch (allocation.allocator) {
+        case hooks::Allocator::PYMALLOC_MALLOC:
+        case hooks::Allocator::PYMALLOC_CALLOC:
+        case hooks::Allocator::PYMALLOC_REALLOC:
+        case hooks::Allocator::PYMALLOC_FREE:
+        case hooks::Allocator::POOL_ALLOC:
+        case hooks::Allocator::POOL_FREE:
+            ++d_skipped_records;
+            return;
+        case hooks::Allocator::FREE: {
+            // Memory allocated before tracking started can't be freed.
+            auto it = d_live_allocations.find(allocation.address);
+            if (it == d_live_allocations.end()) {
+                ++d_skipped_records;
+                return;
+            }
+            // Hold the free back: if the thread's next record is a REALLOC,
+            // both records come from a single call to realloc.
+            flushPendingFree(tid);
+            d_pending_frees[tid] =
+                    Operation{OperationKind::FREE, allocation.allocator, false, it->second};
+            d_live_allocations.erase(it);
+            return;
+        }
+        case hooks::Allocator::MUNMAP:
+        case hooks::Allocator::MADVISE:
+            flushPendingFree(tid);
+            processRangedDeallocation(allocation);
+            return;
+        case hooks::Allocator::MMAP:
+        case hooks::Allocator::MREMAP: {
+            flushPendingFree(tid);
+            size_t id = newId(allocation.size, true);
+            uintptr_t end = allocation.address + allocation.size;
+            d_live_mappings[allocation.address] = LiveMapping{end, allocation.address, id};
+            d_mapped_bytes_left[id] = allocation.size;
+            addOperation(
+                    tid,
+                    Operation{OperationKind::MAP, allocation.allocator, false, id, 0, allocation.size});
+            return;
+        }
+        default:
+            break;
+    }
+
+    size_t id = newId(allocation.size, false);
+    Operation operation{OperationKind::ALLOCATE, allocation.allocator, false, id, 0, allocation.size};
+    auto pending = d_pending_frees.find(tid);
+    if (allocation.allocator == hooks::Allocator::REALLOC && pending != d_pending_frees.end()) {
+        operation.kind = OperationKind::REALLOCATE;
+        operation.argument = pending->second.id;
+        d_pending_frees.erase(pending);
+    } else {
+        flushPendingFree(tid);
+    }
+    d_live_allocations[allocation.address] = id;
+    addOperation(tid, operation);
+}
+
+void
+AllocationReplayer::processRangedDeallocation(const Allocation& allocation)
+{
+    const uintptr_t start = allocation.address;
+    const uintptr_t end = allocation.address + allocation.size;
+    const bool unmap = allocation.allocator == hooks::Allocator::MUNMAP;
+
+    auto it = d_live_mappings.upper_bound(start);
+    if (it != d_live_mappings.begin() && std::prev(it)->second.end > start) {
+        --it;
+    }
+    bool found = false;
+    while (it != d_live_mappings.end() && it->first < end) {
+        found = true;
+        const uintptr_t part_start = it->first;
+        const LiveMapping part = it->second;
+        const uintptr_t overlap_start = std::max(start, part_start);
+        const uintptr_t overlap_end = std::min(end, part.end);
+        const size_t length = overlap_end - overlap_start;
+
+        Operation operation{
+                unmap ? OperationKind::UNMAP : OperationKind::ADVISE,
+                allocation.allocator,
+                false,
+                part.id,
+                overlap_start - part.mapping_start,
+                length};
+        if (!unmap) {
+            addOperation(allocation.tid, operation);
+            ++it;
+            continue;
+        }
+
+        size_t& mapped_bytes_left = d_mapped_bytes_left[part.id];
+        mapped_bytes_left -= std::min(mapped_bytes_left, length);
+        operation.last = mapped_bytes_left == 0;
+        if (operation.last) {
+            d_mapped_bytes_left.erase(part.id);
+        }
+        addOperation(allocation.tid, operation);
+
+        it = d_live_mappings.erase(it);
+        if (part_start < overlap_start) {
+            d_live_mappings[part_start] = LiveMapping{overlap_start, part.mapping_start, part.id};
+        }
+        if (overlap_end < part.end) {
+            it = d_live_mappings.emplace(overlap_end, LiveMapping{part.end, part.mapping_start, part.id})
+                         .first;
+            ++it;
+        }
+    }
+    if (!found) {
+        ++d_skipped_records;
+    }
+}
+
+void*
+AllocationReplayer::waitForPointer(size_t id) const
+{
+    // Another thread may not have made the allocation yet. It's earlier in
+    // the capture than the operation that's waiting for it, so it can't be
+    // waiting for this thread.
+    void* ptr;
+    while (!(ptr = d_pointers[id].load(std::memory_order_acquire))) {
+        std::this_thread::yield();
+    }
+    return ptr;
+}
+
+void
+AllocationReplayer::addLiveBytes(size_t size)
+{
+    size_t live = d_live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = d_peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !d_peak_live_bytes.compare_exchange_weak(peak, live)) {
+    }
+}
+
+void
+AllocationReplayer::execute(const Operation& operation)
+{
+    void* ptr = nullptr;
+    switch (operation.kind) {
+        case OperationKind::ALLOCATE: {
+            const size_t size = operation.size;
+            switch (operation.allocator) {
+                case hooks::Allocator::CALLOC:
+                    ptr = calloc(1, size);
+                    break;
+                case hooks::Allocator::REALLOC:
+                    ptr = realloc(nullptr, size);
+                    break;
+                case hooks::Allocator::POSIX_MEMALIGN:
+                    if (posix_memalign(&ptr, ALIGNMENT, size) != 0) {
+                        ptr = nullptr;
+                    }
+                    break;
+                case hooks::Allocator::ALIGNED_ALLOC:
+                    ptr = aligned_alloc(ALIGNMENT, (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+                    break;
+                case hooks::Allocator::MEMALIGN:
+                    ptr = memalign(ALIGNMENT, size);
+                    break;
+                case hooks::Allocator::VALLOC:
+                    ptr = valloc(size);
+                    break;
+                case hooks::Allocator::PVALLOC:
+                    // Not every allocator provides pvalloc, which rounds the
+                    // size up to whole pages.
+                    ptr = valloc((size + pageSize() - 1) & ~(pageSize() - 1));
+                    break;
+                default:
+                    ptr = malloc(size);
+                    break;
+            }
+            break;
+        }
+        case OperationKind::REALLOCATE: {
+            void* old_ptr = waitForPointer(operation.argument);
+            d_pointers[operation.argument].store(nullptr, std::memory_order_relaxed);
+            if (old_ptr == FAILED_ALLOCATION) {
+                old_ptr = nullptr;
+            } else {
+                d_live_bytes.fetch_sub(d_sizes[operation.argument], std::memory_order_relaxed);
+            }
+            ptr = realloc(old_ptr, operation.size);
+            break;
+        }
+        case OperationKind::FREE: {
+            void* old_ptr = waitForPointer(operation.id);
+            d_pointers[operation.id].store(nullptr, std::memory_order_relaxed);
+            if (old_ptr != FAILED_ALLOCATION) {
+                free(old_ptr);
+                d_live_bytes.fetch_sub(d_sizes[operation.id], std::memory_order_relaxed);
+            }
+            return;
+        }
+        case OperationKind::MAP: {
+            ptr = mmap(nullptr,
+                       operation.size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+            if (ptr == MAP_FAILED) {
+                ptr = nullptr;
+            }
+            break;
+        }
+        case OperationKind::UNMAP:
+        case OperationKind::ADVISE: {
+            auto base = static_cast<char*>(waitForPointer(operation.id));
+            if (base != FAILED_ALLOCATION) {
+                if (operation.kind == OperationKind::UNMAP) {
+                    munmap(base + operation.argument, operation.size);
+                } else {
+                    madvise(base + operation.argument, operation.size, MADV_DONTNEED);
+                }
+            }
+            if (operation.last) {
+                d_pointers[operation.id].store(nullptr, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+
+    if (!ptr) {
+        d_failed_allocations.fetch_add(1, std::memory_order_relaxed);
+        ptr = FAILED_ALLOCATION;
+    } else if (operation.kind != OperationKind::MAP) {
+        touch(ptr, operation.size);
+        addLiveBytes(operation.size);
+    }
+    d_pointers[operation.id].store(ptr, std::memory_order_release);
+}
+
+void
+AllocationReplayer::replayThread(const std::vector<Operation>& operations)
+{
+    for (const auto& operation : operations) {
+        if (d_preserve_order) {
+            while (d_sequence.load(std::memory_order_acquire) != operation.sequence) {
+                std::this_thread::yield();
+            }
+        }
+        execute(operation);
+        if (d_preserve_order) {
+            d_sequence.store(operation.sequence + 1, std::memory_order_release);
+        }
+    }
+}
+
+void
+AllocationReplayer::releaseRemaining()
+{
+    // Only unmap what was still mapped at the end of the capture: the
+    // allocator may be using the pages that were unmapped before.
+    for (const auto& [start, part] : d_live_mappings) {
+        auto base = static_cast<char*>(d_pointers[part.id].load());
+        if (base && base != FAILED_ALLOCATION) {
+            munmap(base + (start - part.mapping_start), part.end - start);
+        }
+    }
+    for (size_t id = 0; id < d_next_id; ++id) {
+        void* ptr = d_pointers[id].exchange(nullptr);
+        if (ptr && ptr != FAILED_ALLOCATION && !d_is_mapping[id]) {
+            free(ptr);
+        }
+    }
+    d_live_bytes = 0;
+}
+
+ReplayStats
+AllocationReplayer::replay()
+{
+    ReplayStats stats;
+    stats.threads = d_operations.size();
+    stats.skipped_records = d_skipped_records;
+    stats.operations = d_next_sequence;
+
+    resetPeakResidentBytes();
+    const size_t baseline_rss = residentBytes();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(d_operations.size());
+    for (const auto& [tid, operations] : d_operations) {
+        threads.emplace_back(&AllocationReplayer::replayThread, this, std::cref(operations));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const size_t peak_rss = peakResidentBytes();
+    const size_t final_rss = residentBytes();
+    stats.peak_rss = peak_rss > baseline_rss ? peak_rss - baseline_rss : 0;
+    stats.final_rss = final_rss > baseline_rss ? final_rss - baseline_rss : 0;
+    stats.peak_live_bytes = d_peak_live_bytes;
+    stats.final_live_bytes = d_live_bytes;
+    stats.failed_allocations = d_failed_allocations;
+
+    releaseRemaining();
+    return stats;
+}
+
+}  // namespace memray::api
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "record_reader.h"
+#include "records.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+struct ReplayStats
+{
+    size_t threads{0};
+    size_t operations{0};
+    size_t skipped_records{0};
+    size_t failed_allocations{0};
+    double seconds{0};
+    // Bytes requested by the replayed allocations that were alive at once.
+    size_t peak_live_bytes{0};
+    size_t final_live_bytes{0};
+    // Growth of the resident set size over what it was before replaying.
+    size_t peak_rss{0};
+    size_t final_rss{0};
+};
+
+/**
+ * Re-issues the allocations of a capture against the allocator that this
+ * process is using, to compare allocators on the traffic of real programs.
+ *
+ * The capture is first converted into a list of operations for each thread,
+ * so that decoding it isn't part of the measurements. Then every thread of
+ * the capture gets its own thread, which repeats the calls to malloc, free,
+ * realloc, mmap, munmap, etc. that the captured thread made, and writes to
+ * every page that it gets so that it becomes resident. The pointers that the
+ * allocator returns replace the addresses in the capture.
+ *
+ * Threads only wait for each other when they free memory that another thread
+ * hasn't allocated yet, unless the order of the capture is preserved: then
+ * every operation waits for the previous one in the capture to finish.
+ *
+ * Allocations made by pymalloc or by memory pools are skipped, because the
+ * memory that they hand out comes from allocations that are also replayed.
+ **/
+class AllocationReplayer
+{
+  public:
+    explicit AllocationReplayer(bool preserve_order);
+
+    // Stream the records of the capture. Returns false if it couldn't be read.
+    bool loadCapture(RecordReader& reader);
+
+    ReplayStats replay();
+
+  private:
+    enum class OperationKind : unsigned char {
+        ALLOCATE,
+        REALLOCATE,
+        FREE,
+        MAP,
+        UNMAP,
+        ADVISE,
+    };
+
+    struct Operation
+    {
+        OperationKind kind{};
+        hooks::Allocator allocator{};
+        // Whether an UNMAP releases what was left of the mapping.
+        bool last{false};
+        // Index of the allocation or mapping, and of the old allocation for
+        // REALLOCATE or the offset into the mapping for UNMAP and ADVISE.
+        size_t id{0};
+        size_t argument{0};
+        size_t size{0};
+        size_t sequence{0};
+    };
+
+    // Part of a mapping that is still mapped, keyed by its start address.
+    // Unmapping the middle of a mapping splits it in two.
+    struct LiveMapping
+    {
+        uintptr_t end;
+        uintptr_t mapping_start;
+        size_t id;
+    };
+
+    void addOperation(thread_id_t tid, const Operation& operation);
+    void flushPendingFree(thread_id_t tid);
+    void processAllocation(const Allocation& allocation);
+    void processRangedDeallocation(const Allocation& allocation);
+    size_t newId(size_t size, bool mapping);
+    void replayThread(const std::vector<Operation>& operations);
+    void execute(const Operation& operation);
+    void* waitForPointer(size_t id) const;
+    void addLiveBytes(size_t size);
+    void releaseRemaining();
+
+    bool d_preserve_order;
+    size_t d_skipped_records{0};
+    size_t d_next_id{0};
+    size_t d_next_sequence{0};
+
+    // Conversion state: what was alive at the current point of the capture.
+    std::unordered_map<uintptr_t, size_t> d_live_allocations;
+    std::map<uintptr_t, LiveMapping> d_live_mappings;
+    std::unordered_map<thread_id_t, std::vector<Operation>> d_operations;
+    std::unordered_map<thread_id_t, Operation> d_pending_frees;
+    std::unordered_map<size_t, size_t> d_mapped_bytes_left;
+
+    // Size of each allocation or mapping, and whether it is a mapping.
+    std::vector<size_t> d_sizes;
+    std::vector<bool> d_is_mapping;
+
+    // Replay state, shared by all the threads.
+    std::unique_ptr<std::atomic<void*>[]> d_pointers;
+    std::atomic<size_t> d_sequence{0};
+    std::atomic<size_t> d_live_bytes{0};
+    std::atomic<size_t> d_peak_live_bytes{0};
+    std::atomic<size_t> d_failed_allocations{0};
+};
+
+}  // namespace memray::api
@@ -0,0 +1,20 @@
+from _memray.record_reader cimport RecordReader
+from libcpp cimport bool
+
+
+cdef extern from "replay.h" namespace "memray::api":
+    cdef struct ReplayStats:
+        size_t threads
+        size_t operations
+        size_t skipped_records
+        size_t failed_allocations
+        double seconds
+        size_t peak_live_bytes
+        size_t final_live_bytes
+        size_t peak_rss
+        size_t final_rss
+
+    cdef cppclass AllocationReplayer:
+        AllocationReplayer(bool preserve_order) except+
+        bool loadCapture(RecordReader& reader) except+
+        ReplayStats replay() except+ nogil
@@ -62,11 +62,11 @@ SnapshotAllocationAggregator::addAllocation(const Allocation& allocation)
 {
     switch (hooks::allocatorKind(allocation.allocator)) {
         case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
-            d_ptr_to_allocation[allocation.address] = allocation;
+            d_ptr_to_allocation[AllocationKey(allocation)] = allocation;
             break;
         }
         case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
-            auto it = d_ptr_to_allocation.find(allocation.address);
+            auto it = d_ptr_to_allocation.find(AllocationKey(allocation));
             if (it != d_ptr_to_allocation.end()) {
                 d_ptr_to_allocation.erase(it);
             }
@@ -122,6 +122,22 @@ SnapshotAllocationAggregator::getSnapshotAllocations(bool merge_threads)
     return stack_to_allocation;
 }
 
+std::vector<Allocation>
+SnapshotAllocationAggregator::getLiveAllocations()
+{
+    std::vector<Allocation> allocations;
+    allocations.reserve(d_ptr_to_allocation.size());
+    for (const auto& it : d_ptr_to_allocation) {
+        allocations.push_back(it.second);
+    }
+    for (const auto& [range, allocation] : d_interval_tree) {
+        Allocation& mapping = allocations.emplace_back(allocation);
+        mapping.address = range.begin;
+        mapping.size = range.size();
+    }
+    return allocations;
+}
+
 /**
  * Produce an aggregated snapshot from a vector of allocations and a index in that vector
  *
@@ -163,11 +179,11 @@ HighWatermarkFinder::processAllocation(const Allocation& allocation)
         case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
             d_current_memory += allocation.size;
             updatePeak(index);
-            d_ptr_to_allocation_size[allocation.address] = allocation.size;
+            d_ptr_to_allocation_size[AllocationKey(allocation)] = allocation.size;
             break;
         }
         case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
-            auto it = d_ptr_to_allocation_size.find(allocation.address);
+            auto it = d_ptr_to_allocation_size.find(AllocationKey(allocation));
             if (it != d_ptr_to_allocation_size.end()) {
                 d_current_memory -= it->second;
                 d_ptr_to_allocation_size.erase(it);
@@ -191,7 +207,7 @@ HighWatermarkFinder::processAllocation(const Allocation& allocation)
             size_t removed_size = std::accumulate(
                     removed.value().begin(),
                     removed.value().cend(),
-                    0,
+                    size_t{0},
                     [](size_t sum, const std::pair<Interval, Allocation>& range) {
                         return sum + range.first.size();
                     });
@@ -39,6 +39,44 @@ struct index_thread_pair_hash
     }
 };
 
+// Memory pools reported through the public C API usually carve their blocks
+// out of memory that is itself tracked, so a block can start at the same
+// address as the allocation that contains it. Keying the blocks of each pool
+// separately keeps them from replacing each other.
+struct AllocationKey
+{
+    uintptr_t address;
+    unsigned int pool_id;
+    bool pooled;
+
+    explicit AllocationKey(const Allocation& allocation)
+    : address(allocation.address)
+    , pool_id(allocation.pool_id)
+    , pooled(hooks::isPoolAllocator(allocation.allocator))
+    {
+    }
+
+    AllocationKey(uintptr_t address, unsigned int pool_id, bool pooled)
+    : address(address)
+    , pool_id(pool_id)
+    , pooled(pooled)
+    {
+    }
+
+    bool operator==(const AllocationKey& rhs) const
+    {
+        return address == rhs.address && pool_id == rhs.pool_id && pooled == rhs.pooled;
+    }
+
+    struct Hash
+    {
+        std::size_t operator()(const AllocationKey& key) const
+        {
+            return std::hash<uintptr_t>{}(key.address) xor std::hash<unsigned int>{}(key.pool_id);
+        }
+    };
+};
+
 using allocations_t = std::vector<Allocation>;
 using reduced_snapshot_map_t = std::unordered_map<LocationKey, Allocation, index_thread_pair_hash>;
 
@@ -166,11 +204,14 @@ class SnapshotAllocationAggregator
   private:
     size_t d_index{0};
     IntervalTree<Allocation> d_interval_tree;
-    std::unordered_map<uintptr_t, Allocation> d_ptr_to_allocation{};
+    std::unordered_map<AllocationKey, Allocation, AllocationKey::Hash> d_ptr_to_allocation{};
 
   public:
     void addAllocation(const Allocation& allocation);
     reduced_snapshot_map_t getSnapshotAllocations(bool merge_threads);
+    // Every allocation that is still alive, with the ranges that are still
+    // mapped of each memory mapping as separate allocations.
+    std::vector<Allocation> getLiveAllocations();
 };
 
 PyObject*
@@ -198,7 +239,7 @@ class HighWatermarkFinder
     HighWatermark d_last_high_water_mark;
     size_t d_current_memory{0};
     size_t d_allocations_seen{0};
-    std::unordered_map<uintptr_t, size_t> d_ptr_to_allocation_size{};
+    std::unordered_map<AllocationKey, size_t, AllocationKey::Hash> d_ptr_to_allocation_size{};
     IntervalTree<Allocation> d_mmap_intervals;
 };
 
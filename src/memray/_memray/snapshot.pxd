@@ -18,6 +18,7 @@ cdef extern from "snapshot.h" namespace "memray::api":
     cdef cppclass SnapshotAllocationAggregator:
         void addAllocation(const Allocation&) except+
         reduced_snapshot_map_t getSnapshotAllocations(bool merge_threads) except+
+        vector[Allocation] getLiveAllocations() except+
 
     object Py_ListFromSnapshotAllocationRecords(const reduced_snapshot_map_t&) except+
     object Py_GetSnapshotAllocationRecords(const vector[Allocation]& all_records, size_t record_index, bool merge_threads) except+
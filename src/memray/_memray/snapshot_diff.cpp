@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "snapshot_diff.h"
+
+namespace memray::api {
+
+std::size_t
+SnapshotDiffAggregator::StackKeyHash::operator()(const stack_key_t& stack) const
+{
+    std::size_t result = stack.size();
+    for (size_t frame_id : stack) {
+        result ^= std::hash<size_t>{}(frame_id) + 0x9e3779b9 + (result << 6) + (result >> 2);
+    }
+    return result;
+}
+
+size_t
+SnapshotDiffAggregator::internFrame(const Frame& frame)
+{
+    auto [it, inserted] = d_frame_ids.try_emplace(frame, d_frames.size());
+    if (inserted) {
+        d_frames.push_back(frame);
+    }
+    return it->second;
+}
+
+void
+SnapshotDiffAggregator::addSnapshot(
+        RecordReader& reader,
+        const reduced_snapshot_map_t& snapshot,
+        bool baseline)
+{
+    stack_key_t key;
+    for (const auto& [location, allocation] : snapshot) {
+        key.clear();
+        for (const Frame& frame : reader.getStackFrames(allocation.frame_index)) {
+            key.push_back(internFrame(frame));
+        }
+
+        // Locations that only differ in their native stacks or threads end
+        // up with the same key, so their totals are added together.
+        Totals& totals = d_totals[key];
+        if (baseline) {
+            totals.size_before += allocation.size;
+            totals.n_allocations_before += allocation.n_allocations;
+        } else {
+            totals.size_after += allocation.size;
+            totals.n_allocations_after += allocation.n_allocations;
+        }
+    }
+}
+
+void
+SnapshotDiffAggregator::addBaseline(RecordReader& reader, const reduced_snapshot_map_t& snapshot)
+{
+    addSnapshot(reader, snapshot, true);
+}
+
+void
+SnapshotDiffAggregator::addCandidate(RecordReader& reader, const reduced_snapshot_map_t& snapshot)
+{
+    addSnapshot(reader, snapshot, false);
+}
+
+std::vector<LocationDelta>
+SnapshotDiffAggregator::getLocationDeltas() const
+{
+    std::vector<LocationDelta> result;
+    result.reserve(d_totals.size());
+    for (const auto& [key, totals] : d_totals) {
+        LocationDelta delta;
+        delta.stack.reserve(key.size());
+        for (size_t frame_id : key) {
+            delta.stack.push_back(d_frames[frame_id]);
+        }
+        delta.size_before = totals.size_before;
+        delta.n_allocations_before = totals.n_allocations_before;
+        delta.size_after = totals.size_after;
+        delta.n_allocations_after = totals.n_allocations_after;
+        result.push_back(std::move(delta));
+    }
+
+    auto change = [](const LocationDelta& delta) {
+        return std::max(delta.size_before, delta.size_after)
+               - std::min(delta.size_before, delta.size_after);
+    };
+    std::stable_sort(result.begin(), result.end(), [&](const auto& lhs, const auto& rhs) {
+        return change(lhs) > change(rhs);
+    });
+    return result;
+}
+
+}  // namespace memray::api
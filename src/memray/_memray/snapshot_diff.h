@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "record_reader.h"
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+struct LocationDelta
+{
+    // The Python frames of the location, from the innermost to the outermost.
+    std::vector<Frame> stack;
+    size_t size_before{0};
+    size_t n_allocations_before{0};
+    size_t size_after{0};
+    size_t n_allocations_after{0};
+};
+
+/**
+ * Joins the snapshots of two captures by allocation site.
+ *
+ * Frame ids are only meaningful within the capture that they were read from,
+ * so the locations of each snapshot are matched on the function, file and
+ * line of every frame of their Python stacks instead. Frames are interned, so
+ * the memory used is proportional to the number of distinct locations in the
+ * two snapshots, and each snapshot can be discarded as soon as it's added.
+ **/
+class SnapshotDiffAggregator
+{
+  public:
+    void addBaseline(RecordReader& reader, const reduced_snapshot_map_t& snapshot);
+    void addCandidate(RecordReader& reader, const reduced_snapshot_map_t& snapshot);
+
+    // Every location that had memory in either snapshot, sorted by how much
+    // its size changed, from the biggest change to the smallest.
+    std::vector<LocationDelta> getLocationDeltas() const;
+
+  private:
+    using stack_key_t = std::vector<size_t>;
+
+    struct StackKeyHash
+    {
+        std::size_t operator()(const stack_key_t& stack) const;
+    };
+
+    struct Totals
+    {
+        size_t size_before{0};
+        size_t n_allocations_before{0};
+        size_t size_after{0};
+        size_t n_allocations_after{0};
+    };
+
+    void addSnapshot(RecordReader& reader, const reduced_snapshot_map_t& snapshot, bool baseline);
+    size_t internFrame(const Frame& frame);
+
+    std::unordered_map<Frame, size_t, Frame::Hash> d_frame_ids;
+    std::vector<Frame> d_frames;
+    std::unordered_map<stack_key_t, Totals, StackKeyHash> d_totals;
+};
+
+}  // namespace memray::api
@@ -0,0 +1,18 @@
+from _memray.record_reader cimport RecordReader
+from _memray.records cimport Frame
+from _memray.snapshot cimport reduced_snapshot_map_t
+from libcpp.vector cimport vector
+
+
+cdef extern from "snapshot_diff.h" namespace "memray::api":
+    cdef cppclass LocationDelta:
+        vector[Frame] stack
+        size_t size_before
+        size_t n_allocations_before
+        size_t size_after
+        size_t n_allocations_after
+
+    cdef cppclass SnapshotDiffAggregator:
+        void addBaseline(RecordReader&, const reduced_snapshot_map_t&) except+
+        void addCandidate(RecordReader&, const reduced_snapshot_map_t&) except+
+        vector[LocationDelta] getLocationDeltas() except+
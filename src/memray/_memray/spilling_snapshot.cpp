@@ -0,0 +1,270 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+#include <unistd.h>
+
+#include "parallel.h"
+#include "spilling_snapshot.h"
+
+namespace memray::api {
+
+SpillFile::SpillFile(const std::string& directory)
+{
+    std::string path = directory + "/memray-spill-XXXXXX";
+    int fd = ::mkstemp(path.data());
+    if (fd == -1) {
+        throw std::ios_base::failure(
+                "Failed to create a spill file in " + directory + ": " + std::strerror(errno));
+    }
+    ::unlink(path.c_str());
+    d_file = ::fdopen(fd, "w+b");
+    if (d_file == nullptr) {
+        ::close(fd);
+        throw std::ios_base::failure("Failed to open a spill file in " + directory);
+    }
+}
+
+SpillFile::~SpillFile()
+{
+    if (d_file != nullptr) {
+        std::fclose(d_file);
+    }
+}
+
+void
+SpillFile::rewind()
+{
+    if (std::fflush(d_file) != 0 || std::fseek(d_file, 0, SEEK_SET) != 0) {
+        throw std::ios_base::failure("Failed to rewind a spill file");
+    }
+}
+
+void
+SpillFile::clear()
+{
+    if (std::fflush(d_file) != 0 || ::ftruncate(::fileno(d_file), 0) != 0
+        || std::fseek(d_file, 0, SEEK_SET) != 0)
+    {
+        throw std::ios_base::failure("Failed to truncate a spill file");
+    }
+}
+
+SpillPartitions::SpillPartitions(const std::string& directory, size_t n_partitions)
+{
+    d_files.reserve(n_partitions);
+    for (size_t i = 0; i < n_partitions; ++i) {
+        d_files.push_back(std::make_unique<SpillFile>(directory));
+    }
+}
+
+size_t
+SpillPartitions::size() const noexcept
+{
+    return d_files.size();
+}
+
+SpillFile&
+SpillPartitions::operator[](size_t partition)
+{
+    return *d_files[partition];
+}
+
+SpillFile&
+SpillPartitions::forKey(const AllocationKey& key)
+{
+    // Addresses are aligned, so the low bits of their hashes are often the
+    // same: mix them into the high bits before picking a partition.
+    uint64_t hash = static_cast<uint64_t>(AllocationKey::Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+    return *d_files[(hash >> 32) % d_files.size()];
+}
+
+SpillingHighWatermarkFinder::SpillingHighWatermarkFinder(
+        const std::string& directory,
+        size_t n_partitions)
+: d_directory(directory)
+, d_partitions(directory, n_partitions)
+, d_mmap_changes(directory)
+{
+}
+
+void
+SpillingHighWatermarkFinder::processAllocation(const Allocation& allocation)
+{
+    size_t index = d_allocations_seen++;
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR:
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
+            AllocationKey key(allocation);
+            bool freed = hooks::isDeallocator(allocation.allocator);
+            d_partitions.forKey(key).write(SpilledRecord{
+                    index,
+                    key.address,
+                    freed ? 0 : allocation.size,
+                    key.pool_id,
+                    key.pooled,
+                    freed});
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_ALLOCATOR: {
+            d_mmap_intervals.addInterval(allocation.address, allocation.size, allocation);
+            d_mmap_changes.write(MemoryChange{index, allocation.size, false, true});
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_DEALLOCATOR: {
+            const auto removed = d_mmap_intervals.removeInterval(allocation.address, allocation.size);
+            if (!removed.has_value()) {
+                break;
+            }
+            size_t removed_size = std::accumulate(
+                    removed.value().begin(),
+                    removed.value().cend(),
+                    size_t{0},
+                    [](size_t sum, const std::pair<Interval, Allocation>& range) {
+                        return sum + range.first.size();
+                    });
+            d_mmap_changes.write(MemoryChange{index, removed_size, true, true});
+            break;
+        }
+    }
+}
+
+void
+SpillingHighWatermarkFinder::findMemoryChanges(SpillFile& records, SpillFile& changes) const
+{
+    std::unordered_map<AllocationKey, size_t, AllocationKey::Hash> sizes;
+    records.rewind();
+    SpilledRecord record;
+    while (records.read(record)) {
+        AllocationKey key(record.address, record.pool_id, record.pooled);
+        if (!record.freed) {
+            sizes[key] = record.size;
+            changes.write(MemoryChange{record.index, record.size, false, true});
+            continue;
+        }
+        auto it = sizes.find(key);
+        if (it != sizes.end()) {
+            changes.write(MemoryChange{record.index, it->second, true, false});
+            sizes.erase(it);
+        }
+    }
+    records.clear();
+}
+
+HighWatermark
+SpillingHighWatermarkFinder::getHighWatermark()
+{
+    if (d_high_watermark) {
+        return *d_high_watermark;
+    }
+
+    std::vector<std::unique_ptr<SpillFile>> changes;
+    changes.reserve(d_partitions.size());
+    for (size_t i = 0; i < d_partitions.size(); ++i) {
+        changes.push_back(std::make_unique<SpillFile>(d_directory));
+    }
+    parallelFor(d_partitions.size(), [&](size_t partition) {
+        findMemoryChanges(d_partitions[partition], *changes[partition]);
+    });
+
+    // Every stream of changes is sorted by record index, so merging them
+    // replays the changes in the order in which they happened.
+    std::vector<SpillFile*> streams;
+    for (auto& stream : changes) {
+        streams.push_back(stream.get());
+    }
+    streams.push_back(&d_mmap_changes);
+
+    struct Head
+    {
+        MemoryChange change;
+        size_t stream;
+    };
+    auto later = [](const Head& lhs, const Head& rhs) { return lhs.change.index > rhs.change.index; };
+    std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+    for (size_t stream = 0; stream < streams.size(); ++stream) {
+        Head head{{}, stream};
+        streams[stream]->rewind();
+        if (streams[stream]->read(head.change)) {
+            heads.push(head);
+        }
+    }
+
+    HighWatermark result;
+    size_t current_memory = 0;
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        if (head.change.freed) {
+            current_memory -= head.change.size;
+        } else {
+            current_memory += head.change.size;
+        }
+        if (head.change.can_be_peak && current_memory >= result.peak_memory) {
+            result.index = head.change.index;
+            result.peak_memory = current_memory;
+        }
+        if (streams[head.stream]->read(head.change)) {
+            heads.push(head);
+        }
+    }
+
+    d_high_watermark = result;
+    return result;
+}
+
+SpillingSnapshotAggregator::SpillingSnapshotAggregator(
+        const std::string& directory,
+        size_t n_partitions)
+: d_partitions(directory, n_partitions)
+{
+}
+
+void
+SpillingSnapshotAggregator::addAllocation(const Allocation& allocation)
+{
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR:
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR:
+            d_partitions.forKey(AllocationKey(allocation)).write(allocation);
+            break;
+        case hooks::AllocatorKind::RANGED_ALLOCATOR:
+        case hooks::AllocatorKind::RANGED_DEALLOCATOR:
+            d_mmaps.addAllocation(allocation);
+            break;
+    }
+}
+
+reduced_snapshot_map_t
+SpillingSnapshotAggregator::getSnapshotAllocations(bool merge_threads)
+{
+    std::vector<reduced_snapshot_map_t> snapshots(d_partitions.size());
+    parallelFor(d_partitions.size(), [&](size_t partition) {
+        SpillFile& file = d_partitions[partition];
+        file.rewind();
+        SnapshotAllocationAggregator aggregator;
+        Allocation allocation;
+        while (file.read(allocation)) {
+            aggregator.addAllocation(allocation);
+        }
+        snapshots[partition] = aggregator.getSnapshotAllocations(merge_threads);
+    });
+
+    reduced_snapshot_map_t result = d_mmaps.getSnapshotAllocations(merge_threads);
+    for (auto& snapshot : snapshots) {
+        for (const auto& [location, allocation] : snapshot) {
+            auto [it, inserted] = result.try_emplace(location, allocation);
+            if (!inserted) {
+                it->second.size += allocation.size;
+                it->second.n_allocations += allocation.n_allocations;
+            }
+        }
+        snapshot = {};
+    }
+    return result;
+}
+
+}  // namespace memray::api
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+/**
+ * A temporary file of fixed size records, deleted as soon as it's created so
+ * that nothing is left behind if the process dies.
+ **/
+class SpillFile
+{
+  public:
+    explicit SpillFile(const std::string& directory);
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    template<typename T>
+    void write(const T& record)
+    {
+        if (std::fwrite(&record, sizeof(T), 1, d_file) != 1) {
+            throw std::ios_base::failure("Failed to write to a spill file");
+        }
+    }
+
+    template<typename T>
+    bool read(T& record)
+    {
+        if (std::fread(&record, sizeof(T), 1, d_file) == 1) {
+            return true;
+        }
+        if (std::ferror(d_file)) {
+            throw std::ios_base::failure("Failed to read from a spill file");
+        }
+        return false;
+    }
+
+    // Go back to the start of the file, to read what was written.
+    void rewind();
+    // Throw away the contents of the file, giving back its disk space.
+    void clear();
+
+  private:
+    std::FILE* d_file{nullptr};
+};
+
+/**
+ * Spreads allocation records over a number of spill files, according to the
+ * hash of the address that they allocate or free, so that every allocation
+ * lands in the same file as its deallocation and each file can be replayed on
+ * its own.
+ **/
+class SpillPartitions
+{
+  public:
+    SpillPartitions(const std::string& directory, size_t n_partitions);
+
+    size_t size() const noexcept;
+    SpillFile& operator[](size_t partition);
+    SpillFile& forKey(const AllocationKey& key);
+
+  private:
+    std::vector<std::unique_ptr<SpillFile>> d_files;
+};
+
+// Enough partitions that a few of them fit in memory at once even for huge
+// captures, while keeping the number of open files reasonable.
+const size_t DEFAULT_SPILL_PARTITIONS = 256;
+
+/**
+ * Finds the high watermark like HighWatermarkFinder, without keeping the
+ * size of every live allocation in memory.
+ *
+ * The allocations and deallocations are written to spill files while the
+ * capture is read. Once it has been read, every file is replayed on its own,
+ * in parallel, to find out how much memory each record allocated or freed,
+ * and the resulting changes are merged back in the order of the records to
+ * find the peak. Memory mappings are few, so they are still tracked in memory.
+ **/
+class SpillingHighWatermarkFinder
+{
+  public:
+    SpillingHighWatermarkFinder(
+            const std::string& directory,
+            size_t n_partitions = DEFAULT_SPILL_PARTITIONS);
+    void processAllocation(const Allocation& allocation);
+    HighWatermark getHighWatermark();
+
+  private:
+    struct SpilledRecord
+    {
+        size_t index;
+        uintptr_t address;
+        size_t size;
+        unsigned int pool_id;
+        bool pooled;
+        bool freed;
+    };
+
+    struct MemoryChange
+    {
+        size_t index;
+        size_t size;
+        bool freed;
+        bool can_be_peak;
+    };
+
+    void findMemoryChanges(SpillFile& records, SpillFile& changes) const;
+
+    const std::string d_directory;
+    SpillPartitions d_partitions;
+    SpillFile d_mmap_changes;
+    IntervalTree<Allocation> d_mmap_intervals;
+    size_t d_allocations_seen{0};
+    std::optional<HighWatermark> d_high_watermark;
+};
+
+/**
+ * Aggregates the allocations alive at a point of a capture like
+ * SnapshotAllocationAggregator, without keeping them all in memory.
+ *
+ * The allocation records are written to spill files as they are read, and
+ * each file is replayed on its own, in parallel, when the snapshot is asked
+ * for. Only the files that are being replayed and the aggregated locations
+ * are held in memory, besides the memory mappings, which are handed to a
+ * regular SnapshotAllocationAggregator.
+ **/
+class SpillingSnapshotAggregator
+{
+  public:
+    SpillingSnapshotAggregator(
+            const std::string& directory,
+            size_t n_partitions = DEFAULT_SPILL_PARTITIONS);
+    void addAllocation(const Allocation& allocation);
+    reduced_snapshot_map_t getSnapshotAllocations(bool merge_threads);
+
+  private:
+    SpillPartitions d_partitions;
+    SnapshotAllocationAggregator d_mmaps;
+};
+
+}  // namespace memray::api
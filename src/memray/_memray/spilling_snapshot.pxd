@@ -0,0 +1,17 @@
+from _memray.records cimport Allocation
+from _memray.snapshot cimport HighWatermark
+from _memray.snapshot cimport reduced_snapshot_map_t
+from libcpp cimport bool
+from libcpp.string cimport string
+
+
+cdef extern from "spilling_snapshot.h" namespace "memray::api":
+    cdef cppclass SpillingHighWatermarkFinder:
+        SpillingHighWatermarkFinder(const string& directory) except+
+        void processAllocation(const Allocation&) except+
+        HighWatermark getHighWatermark() except+ nogil
+
+    cdef cppclass SpillingSnapshotAggregator:
+        SpillingSnapshotAggregator(const string& directory) except+
+        void addAllocation(const Allocation&) except+
+        reduced_snapshot_map_t getSnapshotAllocations(bool merge_threads) except+ nogil
@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <link.h>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+#include "record_writer.h"
+#include "records.h"
+#include "sink.h"
+#include "synthetic_capture.h"
+
+namespace memray::tracking_api {
+
+namespace {  // unnamed
+
+const uintptr_t HEAP_START = 0x10000000;
+const uintptr_t MMAP_START = 0x7f0000000000;
+const size_t PAGE_SIZE = 4096;
+const size_t NATIVE_STACKS = 4096;
+const size_t ALLOCATIONS_PER_MEMORY_RECORD = 1000;
+const size_t BASELINE_RSS = 16 << 20;
+
+struct LiveAllocation
+{
+    uintptr_t address;
+    size_t size;
+    hooks::Allocator allocator;
+};
+
+struct PendingDeallocation
+{
+    size_t when;
+    LiveAllocation allocation;
+
+    bool operator>(const PendingDeallocation& other) const
+    {
+        return when > other.when;
+    }
+};
+
+struct ThreadState
+{
+    thread_id_t tid;
+    std::vector<frame_id_t> stack;
+};
+
+struct LoadedObject
+{
+    std::string filename;
+    uintptr_t addr;
+    std::vector<Segment> segments;
+    std::vector<Segment> executable_segments;
+};
+
+std::string
+executablePath()
+{
+    char path[4096];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    return length > 0 ? std::string(path, length) : std::string();
+}
+
+int
+collectLoadedObject(struct dl_phdr_info* info, size_t, void* data)
+{
+    auto objects = reinterpret_cast<std::vector<LoadedObject>*>(data);
+    std::string filename = info->dlpi_name[0] ? info->dlpi_name : executablePath();
+    if (filename.empty() || filename.rfind("linux-vdso.so", 0) == 0) {
+        return 0;
+    }
+
+    LoadedObject object{filename, info->dlpi_addr, {}, {}};
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type == PT_LOAD) {
+            object.segments.push_back(Segment{phdr.p_vaddr, phdr.p_memsz});
+            if (phdr.p_flags & PF_X) {
+                object.executable_segments.push_back(Segment{phdr.p_vaddr, phdr.p_memsz});
+            }
+        }
+    }
+    objects->push_back(std::move(object));
+    return 0;
+}
+
+void
+validate(const SyntheticWorkload& workload)
+{
+    if (workload.threads == 0 || workload.functions == 0 || workload.max_stack_depth == 0) {
+        throw std::invalid_argument("threads, functions and max_stack_depth must be positive");
+    }
+    if (workload.min_size == 0 || workload.min_size > workload.max_size) {
+        throw std::invalid_argument("sizes must satisfy 0 < min_size <= max_size");
+    }
+    if (!(workload.mean_lifetime > 0)) {
+        throw std::invalid_argument("mean_lifetime must be positive");
+    }
+    if (!(workload.leak_fraction >= 0 && workload.leak_fraction <= 1)
+        || !(workload.mmap_fraction >= 0 && workload.mmap_fraction <= 1))
+    {
+        throw std::invalid_argument("leak_fraction and mmap_fraction must be between 0 and 1");
+    }
+}
+
+class SyntheticWriter
+{
+  public:
+    SyntheticWriter(const std::string& file_name, const SyntheticWorkload& workload)
+    : d_workload(workload)
+    , d_random(workload.seed)
+    , d_writer(
+              std::make_unique<io::FileSink>(file_name, true, false),
+              "synthetic",
+              workload.native_traces)
+    {
+    }
+
+    size_t write()
+    {
+        if (!d_writer.writeHeader(false) || !writeFrames() || !writeNativeStacks()) {
+            return 0;
+        }
+
+        std::vector<ThreadState> threads(d_workload.threads);
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].tid = i + 1;
+            auto name = "thread-" + std::to_string(i);
+            if (!d_writer.writeThreadSpecificRecord(threads[i].tid, ThreadRecord{name.c_str()})) {
+                return 0;
+            }
+        }
+
+        std::uniform_int_distribution<size_t> pick_thread(0, threads.size() - 1);
+        size_t churn_interval = d_workload.allocations / (d_workload.dlopen_churn + 1);
+        for (size_t i = 0; i < d_workload.allocations; ++i) {
+            if (d_workload.native_traces && d_workload.dlopen_churn && i && churn_interval
+                && i % churn_interval == 0 && !reloadObject())
+            {
+                return 0;
+            }
+            if (i % ALLOCATIONS_PER_MEMORY_RECORD == 0 && !writeMemoryRecord()) {
+                return 0;
+            }
+
+            // Deallocations are written by whichever thread runs when they're
+            // due, so some memory is freed by a different thread than the one
+            // that allocated it, like in real programs.
+            ThreadState& thread = threads[pick_thread(d_random)];
+            while (!d_pending.empty() && d_pending.top().when <= i) {
+                if (!deallocate(thread, d_pending.top().allocation)) {
+                    return 0;
+                }
+                d_pending.pop();
+            }
+            if (!moveStack(thread) || !allocate(thread, i)) {
+                return 0;
+            }
+        }
+
+        // Only the leaked allocations are still alive when the process exits.
+        while (!d_pending.empty()) {
+            if (!deallocate(threads[pick_thread(d_random)], d_pending.top().allocation)) {
+                return 0;
+            }
+            d_pending.pop();
+        }
+
+        d_writer.setDroppedAllocations(0, 0, 0);
+        return d_writer.writeHeader(true) ? d_records : 0;
+    }
+
+  private:
+    bool writeFrames()
+    {
+        d_function_names.reserve(d_workload.functions);
+        for (unsigned int i = 0; i < d_workload.functions; ++i) {
+            d_function_names.push_back("function_" + std::to_string(i));
+        }
+        for (unsigned int i = 0; i < d_workload.functions; ++i) {
+            RawFrame frame{d_function_names[i].c_str(), "synthetic.py", static_cast<int>(i + 1)};
+            if (!d_writer.writeRecord(pyrawframe_map_val_t{i, frame})) {
+                return false;
+            }
+            ++d_records;
+        }
+        return true;
+    }
+
+    bool writeObject(const LoadedObject& object, bool removed)
+    {
+        SegmentHeader header{object.filename.c_str(), object.segments.size(), object.addr, removed};
+        if (!d_writer.writeRecord(header)) {
+            return false;
+        }
+        for (const auto& segment : object.segments) {
+            if (!d_writer.writeRecord(segment)) {
+                return false;
+            }
+        }
+        d_records += 1 + object.segments.size();
+        return true;
+    }
+
+    bool writeNativeStacks()
+    {
+        if (!d_workload.native_traces) {
+            return true;
+        }
+
+        // Use the memory map of this process, so that the native frames can
+        // be resolved to real symbols when the capture is read.
+        dl_iterate_phdr(&collectLoadedObject, &d_objects);
+        std::vector<const LoadedObject*> code;
+        for (const auto& object : d_objects) {
+            if (!object.executable_segments.empty()) {
+                code.push_back(&object);
+            }
+        }
+        if (code.empty()) {
+            return false;
+        }
+
+        if (!d_writer.writeRecord(MemoryMapStart{})) {
+            return false;
+        }
+        for (const auto& object : d_objects) {
+            if (!writeObject(object, false)) {
+                return false;
+            }
+        }
+
+        // Build a tree of native frames: each new node extends a random
+        // earlier one, so stacks share their outermost frames.
+        std::uniform_int_distribution<size_t> pick_object(0, code.size() - 1);
+        for (size_t index = 1; index <= NATIVE_STACKS; ++index) {
+            const LoadedObject& object = *code[pick_object(d_random)];
+            const auto& segments = object.executable_segments;
+            const Segment& segment =
+                    segments[std::uniform_int_distribution<size_t>(0, segments.size() - 1)(d_random)];
+            uintptr_t offset = std::uniform_int_distribution<uintptr_t>(1, segment.memsz)(d_random);
+            uintptr_t ip = object.addr + segment.vaddr + offset;
+            size_t parent = std::uniform_int_distribution<size_t>(0, index - 1)(d_random);
+            if (!d_writer.writeRecord(UnresolvedNativeFrame{ip, parent})) {
+                return false;
+            }
+            ++d_records;
+        }
+        return true;
+    }
+
+    bool reloadObject()
+    {
+        // The object comes back at the same address: the reader looks up the
+        // symbols of each file relative to the first address it was seen at.
+        const LoadedObject& object =
+                d_objects[std::uniform_int_distribution<size_t>(0, d_objects.size() - 1)(d_random)];
+        return d_writer.writeRecord(MemoryMapStart{}) && writeObject(object, true)
+               && writeObject(object, false);
+    }
+
+    bool writeMemoryRecord()
+    {
+        using namespace std::chrono;
+        auto now = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+        ++d_records;
+        MemoryRecord record{static_cast<unsigned long>(now), BASELINE_RSS + d_live_bytes};
+        return d_writer.writeRecord(record);
+    }
+
+    bool moveStack(ThreadState& thread)
+    {
+        // Random walk around a target depth, like a program calling into and
+        // returning from functions between allocations.
+        size_t target = 1;
+        if (d_workload.mean_stack_depth > 1) {
+            target += std::poisson_distribution<size_t>(d_workload.mean_stack_depth - 1)(d_random);
+        }
+        target = std::min<size_t>(target, d_workload.max_stack_depth);
+        if (thread.stack.size() > target) {
+            size_t count = thread.stack.size() - target;
+            thread.stack.resize(target);
+            ++d_records;
+            return d_writer.writeThreadSpecificRecord(thread.tid, FramePop{count});
+        }
+        std::uniform_int_distribution<frame_id_t> pick_frame(0, d_workload.functions - 1);
+        while (thread.stack.size() < target) {
+            frame_id_t frame_id = pick_frame(d_random);
+            thread.stack.push_back(frame_id);
+            ++d_records;
+            if (!d_writer.writeThreadSpecificRecord(thread.tid, FramePush{frame_id})) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool allocate(ThreadState& thread, size_t now)
+    {
+        LiveAllocation allocation;
+        if (std::bernoulli_distribution(d_workload.mmap_fraction)(d_random)) {
+            size_t pages = std::uniform_int_distribution<size_t>(16, 4096)(d_random);
+            allocation = {d_next_mmap, pages * PAGE_SIZE, hooks::Allocator::MMAP};
+            d_next_mmap += allocation.size;
+        } else {
+            double exponent = std::uniform_real_distribution<double>(
+                    std::log2(d_workload.min_size),
+                    std::log2(d_workload.max_size))(d_random);
+            auto size = static_cast<size_t>(std::exp2(exponent));
+            allocation = {d_next_heap, size, hooks::Allocator::MALLOC};
+            d_next_heap += (allocation.size + 15) & ~size_t{15};
+        }
+        d_live_bytes += allocation.size;
+
+        if (!std::bernoulli_distribution(d_workload.leak_fraction)(d_random)) {
+            std::exponential_distribution<double> lifetimes(1 / d_workload.mean_lifetime);
+            double lifetime = lifetimes(d_random);
+            d_pending.push({now + 1 + static_cast<size_t>(lifetime), allocation});
+        }
+
+        ++d_records;
+        if (d_workload.native_traces) {
+            frame_id_t native_index = std::uniform_int_distribution<size_t>(1, NATIVE_STACKS)(d_random);
+            NativeAllocationRecord record{
+                    allocation.address,
+                    allocation.size,
+                    allocation.allocator,
+                    native_index};
+            return d_writer.writeThreadSpecificRecord(thread.tid, record);
+        }
+        AllocationRecord record{allocation.address, allocation.size, allocation.allocator};
+        return d_writer.writeThreadSpecificRecord(thread.tid, record);
+    }
+
+    bool deallocate(const ThreadState& thread, const LiveAllocation& allocation)
+    {
+        d_live_bytes -= allocation.size;
+        ++d_records;
+        if (allocation.allocator == hooks::Allocator::MMAP) {
+            AllocationRecord record{allocation.address, allocation.size, hooks::Allocator::MUNMAP};
+            return d_writer.writeThreadSpecificRecord(thread.tid, record);
+        }
+        AllocationRecord record{allocation.address, 0, hooks::Allocator::FREE};
+        return d_writer.writeThreadSpecificRecord(thread.tid, record);
+    }
+
+    const SyntheticWorkload d_workload;
+    std::mt19937_64 d_random;
+    RecordWriter d_writer;
+    std::vector<std::string> d_function_names;
+    std::vector<LoadedObject> d_objects;
+    std::priority_queue<PendingDeallocation, std::vector<PendingDeallocation>, std::greater<>>
+            d_pending;
+    uintptr_t d_next_heap{HEAP_START};
+    uintptr_t d_next_mmap{MMAP_START};
+    size_t d_live_bytes{0};
+    size_t d_records{0};
+};
+
+}  // unnamed namespace
+
+size_t
+writeSyntheticCapture(const std::string& file_name, const SyntheticWorkload& workload)
+{
+    validate(workload);
+    return SyntheticWriter(file_name, workload).write();
+}
+
+}  // namespace memray::tracking_api
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace memray::tracking_api {
+
+/**
+ * Parametric model of a tracked process, used to write captures of any size
+ * for the benchmarks without having to run a program that big.
+ *
+ * Every thread walks up and down its own Python stack, reaching depths that
+ * follow a Poisson distribution around the mean. Allocation sizes are spread
+ * evenly over the orders of magnitude between the minimum and the maximum, and
+ * every allocation that isn't leaked is freed after an exponentially
+ * distributed number of later allocations. With native traces, the native
+ * stacks point into the objects loaded in the current process, so they can be
+ * resolved, and each dlopen churn event unloads one of these objects and loads
+ * it back.
+ **/
+struct SyntheticWorkload
+{
+    size_t allocations{1000000};
+    unsigned int threads{4};
+    unsigned int functions{500};
+    double mean_stack_depth{15};
+    unsigned int max_stack_depth{30};
+    size_t min_size{16};
+    size_t max_size{65536};
+    double mean_lifetime{10000};
+    double leak_fraction{0};
+    double mmap_fraction{0.01};
+    bool native_traces{false};
+    size_t dlopen_churn{0};
+    uint64_t seed{42};
+};
+
+// Returns the number of records written, or 0 if the capture couldn't be written.
+size_t
+writeSyntheticCapture(const std::string& file_name, const SyntheticWorkload& workload);
+
+}  // namespace memray::tracking_api
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <limits>
+
+#include "temporal_snapshot.h"
+
+namespace memray::api {
+
+namespace {  // unnamed
+
+const size_t OPEN_INTERVAL = std::numeric_limits<size_t>::max();
+
+}  // unnamed namespace
+
+TemporalAllocationAggregator::TemporalAllocationAggregator(bool merge_threads)
+: d_merge_threads(merge_threads)
+{
+}
+
+size_t
+TemporalAllocationAggregator::locationIndex(const Allocation& allocation)
+{
+    const thread_id_t thread_id = d_merge_threads ? NO_THREAD_INFO : allocation.tid;
+    auto loc_key = LocationKey{allocation.frame_index, allocation.native_frame_id, thread_id};
+    auto [it, inserted] = d_location_indices.try_emplace(loc_key, d_locations.size());
+    if (inserted) {
+        d_locations.push_back(TemporalLocation{allocation, {}});
+        d_usage.emplace_back();
+    }
+    return it->second;
+}
+
+void
+TemporalAllocationAggregator::updateUsage(size_t location, ptrdiff_t n_allocations, ptrdiff_t n_bytes)
+{
+    LocationUsage& usage = d_usage[location];
+    usage.n_allocations += n_allocations;
+    usage.n_bytes += n_bytes;
+    d_changed_locations.insert(location);
+}
+
+void
+TemporalAllocationAggregator::addAllocation(const Allocation& allocation)
+{
+    switch (hooks::allocatorKind(allocation.allocator)) {
+        case hooks::AllocatorKind::SIMPLE_ALLOCATOR: {
+            const size_t location = locationIndex(allocation);
+            auto [it, inserted] = d_live_allocations.try_emplace(
+                    AllocationKey(allocation),
+                    LiveAllocation{location, allocation.size});
+            if (!inserted) {
+                // The deallocation of the previous allocation at this address
+                // wasn't captured, so replace it.
+                const LiveAllocation& previous = it->second;
+                updateUsage(previous.location, -1, -static_cast<ptrdiff_t>(previous.size));
+                it->second = LiveAllocation{location, allocation.size};
+            }
+            updateUsage(location, 1, allocation.size);
+            break;
+        }
+        case hooks::AllocatorKind::SIMPLE_DEALLOCATOR: {
+            auto it = d_live_allocations.find(AllocationKey(allocation));
+            if (it == d_live_allocations.end()) {
+                break;
+            }
+            updateUsage(it->second.location, -1, -static_cast<ptrdiff_t>(it->second.size));
+            d_live_allocations.erase(it);
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_ALLOCATOR: {
+            if (allocation.size == 0) {
+                break;
+            }
+            const size_t location = locationIndex(allocation);
+            const size_t mapping_id = d_next_mapping_id++;
+            d_mmap_intervals.addInterval(
+                    allocation.address,
+                    allocation.size,
+                    MappingPart{location, mapping_id});
+            d_mapped_bytes_left[mapping_id] = allocation.size;
+            updateUsage(location, 1, allocation.size);
+            break;
+        }
+        case hooks::AllocatorKind::RANGED_DEALLOCATOR: {
+            // A mapping stops counting as an allocation only once all of it
+            // has been released, even if it was released in several pieces,
+            // but every released byte counts right away.
+            auto removed = d_mmap_intervals.removeInterval(allocation.address, allocation.size);
+            if (!removed) {
+                break;
+            }
+            for (const auto& [interval, part] : removed.value()) {
+                size_t& bytes_left = d_mapped_bytes_left[part.mapping_id];
+                bytes_left -= std::min(bytes_left, interval.size());
+                const bool last_piece = bytes_left == 0;
+                if (last_piece) {
+                    d_mapped_bytes_left.erase(part.mapping_id);
+                }
+                updateUsage(
+                        part.location,
+                        last_piece ? -1 : 0,
+                        -static_cast<ptrdiff_t>(interval.size()));
+            }
+            break;
+        }
+    }
+}
+
+void
+TemporalAllocationAggregator::captureSnapshot()
+{
+    for (size_t location : d_changed_locations) {
+        const LocationUsage& usage = d_usage[location];
+        auto& intervals = d_locations[location].intervals;
+        if (!intervals.empty() && intervals.back().end == OPEN_INTERVAL) {
+            AllocationInterval& last = intervals.back();
+            if (last.n_allocations == usage.n_allocations && last.n_bytes == usage.n_bytes) {
+                continue;
+            }
+            last.end = d_snapshots;
+        }
+        if (usage.n_allocations != 0 || usage.n_bytes != 0) {
+            intervals.push_back({d_snapshots, OPEN_INTERVAL, usage.n_allocations, usage.n_bytes});
+        }
+    }
+    d_changed_locations.clear();
+    ++d_snapshots;
+}
+
+size_t
+TemporalAllocationAggregator::snapshotCount() const noexcept
+{
+    return d_snapshots;
+}
+
+std::vector<TemporalLocation>
+TemporalAllocationAggregator::getTemporalLocations() const
+{
+    std::vector<TemporalLocation> result;
+    for (const auto& location : d_locations) {
+        if (location.intervals.empty()) {
+            continue;
+        }
+        result.push_back(location);
+        AllocationInterval& last = result.back().intervals.back();
+        if (last.end == OPEN_INTERVAL) {
+            last.end = d_snapshots;
+        }
+    }
+    return result;
+}
+
+}  // namespace memray::api
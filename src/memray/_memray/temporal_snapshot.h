@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "records.h"
+#include "snapshot.h"
+
+namespace memray::api {
+
+using namespace tracking_api;
+
+// The allocations made at a location that stayed alive, without changing,
+// from snapshot `begin` up to (but not including) snapshot `end`.
+struct AllocationInterval
+{
+    size_t begin;
+    size_t end;
+    size_t n_allocations;
+    size_t n_bytes;
+};
+
+struct TemporalLocation
+{
+    // The first allocation made at the location, used to find its stack.
+    Allocation allocation;
+    std::vector<AllocationInterval> intervals;
+};
+
+/**
+ * Aggregates the allocations of a capture into the heap usage of each
+ * location at many points in time, in a single pass over the records.
+ *
+ * The bytes and allocations that each location has alive are updated as the
+ * records are added. Every call to captureSnapshot() checkpoints only the
+ * locations that changed since the previous snapshot, closing the interval in
+ * which they had their old usage and opening one with the new usage. The
+ * heap at any snapshot can then be rebuilt from the intervals that contain
+ * it, and the growth between two snapshots from the ones that contain each,
+ * without reading the capture again.
+ **/
+class TemporalAllocationAggregator
+{
+  public:
+    explicit TemporalAllocationAggregator(bool merge_threads);
+
+    void addAllocation(const Allocation& allocation);
+    void captureSnapshot();
+    size_t snapshotCount() const noexcept;
+
+    // Locations that were using memory in at least one snapshot. Intervals
+    // that are still open end at snapshotCount().
+    std::vector<TemporalLocation> getTemporalLocations() const;
+
+  private:
+    struct LocationUsage
+    {
+        size_t n_allocations{0};
+        size_t n_bytes{0};
+    };
+
+    struct LiveAllocation
+    {
+        size_t location;
+        size_t size;
+    };
+
+    // A piece of a memory mapping that is still mapped. Partial munmaps split
+    // a mapping into several pieces, that all share its id.
+    struct MappingPart
+    {
+        size_t location;
+        size_t mapping_id;
+    };
+
+    size_t locationIndex(const Allocation& allocation);
+    void updateUsage(size_t location, ptrdiff_t n_allocations, ptrdiff_t n_bytes);
+
+    bool d_merge_threads;
+    size_t d_snapshots{0};
+    std::unordered_map<LocationKey, size_t, index_thread_pair_hash> d_location_indices;
+    std::vector<TemporalLocation> d_locations;
+    std::vector<LocationUsage> d_usage;
+    std::unordered_set<size_t> d_changed_locations;
+    std::unordered_map<AllocationKey, LiveAllocation, AllocationKey::Hash> d_live_allocations;
+    IntervalTree<MappingPart> d_mmap_intervals;
+    // The bytes of each memory mapping that haven't been unmapped yet.
+    std::unordered_map<size_t, size_t> d_mapped_bytes_left;
+    size_t d_next_mapping_id{0};
+};
+
+}  // namespace memray::api
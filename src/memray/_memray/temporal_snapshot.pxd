@@ -0,0 +1,22 @@
+from _memray.records cimport Allocation
+from libcpp cimport bool
+from libcpp.vector cimport vector
+
+
+cdef extern from "temporal_snapshot.h" namespace "memray::api":
+    cdef struct AllocationInterval:
+        size_t begin
+        size_t end
+        size_t n_allocations
+        size_t n_bytes
+
+    cdef cppclass TemporalLocation:
+        Allocation allocation
+        vector[AllocationInterval] intervals
+
+    cdef cppclass TemporalAllocationAggregator:
+        TemporalAllocationAggregator(bool merge_threads) except+
+        void addAllocation(const Allocation&) except+
+        void captureSnapshot() except+
+        size_t snapshotCount()
+        vector[TemporalLocation] getTemporalLocations() except+
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "frame_registry.h"
+#include "records.h"
+
+namespace memray::test_utils {
+
+// Registers the same frames in a FrameRegistry from several native threads at
+// once, all in the same order so that they keep racing on the same frame, and
+// returns how many ids were handed out. Enough frames make the registry add
+// tables while the threads race. Throws if two threads got different ids for
+// the same frame.
+inline size_t
+registerFramesConcurrently(unsigned int n_threads, unsigned int n_frames)
+{
+    // Frames are compared by address, so one byte per frame is a distinct name.
+    std::vector<char> function_names(n_frames);
+    tracking_api::FrameRegistry registry{0, 1};
+    std::atomic<size_t> registered{0};
+    std::atomic<unsigned int> waiting{n_threads};
+    std::vector<std::vector<tracking_api::frame_id_t>> ids(
+            n_threads,
+            std::vector<tracking_api::frame_id_t>(n_frames));
+
+    std::vector<std::thread> threads;
+    for (unsigned int thread = 0; thread < n_threads; ++thread) {
+        threads.emplace_back([&, thread] {
+            waiting.fetch_sub(1);
+            while (waiting.load() != 0) {
+                std::this_thread::yield();
+            }
+            for (unsigned int i = 0; i < n_frames; ++i) {
+                tracking_api::RawFrame frame{&function_names[i], "file.py", static_cast<int>(i)};
+                ids[thread][i] = registry.getIndex(frame, [&](tracking_api::frame_id_t) {
+                    registered.fetch_add(1);
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned int thread = 1; thread < n_threads; ++thread) {
+        if (ids[thread] != ids[0]) {
+            throw std::runtime_error("Threads got different ids for the same frame");
+        }
+    }
+    return registered.load();
+}
+
+}  // namespace memray::test_utils
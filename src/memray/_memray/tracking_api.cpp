@@ -1,4 +1,6 @@
 #include <cassert>
+#include <dlfcn.h>
+#include <fnmatch.h>
 #include <limits.h>
 #include <link.h>
 #include <mutex>
@@ -38,21 +40,241 @@ starts_with(const std::string& haystack, const std::string_view& needle)
     return haystack.compare(0, needle.size(), needle) == 0;
 }
 
+// Find the code range of the interpreter's frame evaluation function, so that
+// native unwinding can stop as soon as it reaches the first Python frame.
+static bool
+findPythonEvalFrame(uintptr_t* begin, uintptr_t* end)
+{
+#ifdef __GLIBC__
+    void* address = dlsym(RTLD_DEFAULT, "_PyEval_EvalFrameDefault");
+    Dl_info info;
+    ElfW(Sym)* symbol = nullptr;
+    if (!address || !dladdr1(address, &info, reinterpret_cast<void**>(&symbol), RTLD_DL_SYMENT)
+        || !symbol || symbol->st_size == 0)
+    {
+        return false;
+    }
+    *begin = reinterpret_cast<uintptr_t>(address);
+    *end = *begin + symbol->st_size;
+    return true;
+#else
+    return false;
+#endif
+}
+
 // Track how many times a new Tracker has been created
 std::atomic<unsigned int> g_tracker_generation;
 
+constexpr unsigned int
+allocatorBit(memray::hooks::Allocator allocator)
+{
+    return 1u << static_cast<unsigned int>(allocator);
+}
+
+// Allocators whose blocks can be released by each deallocator
+using memray::hooks::Allocator;
+constexpr unsigned int MALLOC_FAMILY =
+        allocatorBit(Allocator::MALLOC) | allocatorBit(Allocator::CALLOC)
+        | allocatorBit(Allocator::REALLOC) | allocatorBit(Allocator::POSIX_MEMALIGN)
+        | allocatorBit(Allocator::ALIGNED_ALLOC) | allocatorBit(Allocator::MEMALIGN)
+        | allocatorBit(Allocator::VALLOC) | allocatorBit(Allocator::PVALLOC);
+constexpr unsigned int MMAP_FAMILY = allocatorBit(Allocator::MMAP) | allocatorBit(Allocator::MREMAP);
+constexpr unsigned int PYMALLOC_FAMILY = allocatorBit(Allocator::PYMALLOC_MALLOC)
+                                         | allocatorBit(Allocator::PYMALLOC_CALLOC)
+                                         | allocatorBit(Allocator::PYMALLOC_REALLOC);
+constexpr unsigned int POOL_FAMILY = allocatorBit(Allocator::POOL_ALLOC);
+
 }  // namespace
 
 namespace memray::tracking_api {
 
 MEMRAY_FAST_TLS thread_local bool RecursionGuard::isActive = false;
 
+// Whether the thread name filter excludes the current thread. Only meaningful while
+// t_thread_filter_generation matches the generation of the active tracker.
+MEMRAY_FAST_TLS static thread_local unsigned int t_thread_filter_generation = 0;
+MEMRAY_FAST_TLS static thread_local bool t_thread_excluded = false;
+
 static inline thread_id_t
 thread_id()
 {
     return reinterpret_cast<thread_id_t>(pthread_self());
 };
 
+// Frame information cached in an extra slot of each code object that runs
+// while a tracker is active. Pushing a frame only needs a pointer load to get
+// the function and file names, and the tracker's frame collection is only
+// consulted the first time each line of the code object is emitted in the
+// current capture.
+class CodeObjectFrames
+{
+  public:
+    // Must be called with the GIL held.
+    static void setup();
+    static CodeObjectFrames* get(PyCodeObject* code);
+
+    const char* functionName() const
+    {
+        return d_function_name;
+    }
+    const char* filename() const
+    {
+        return d_filename;
+    }
+    inline bool lookup(int lineno, frame_id_t* frame_id) const;
+    inline void store(int lineno, frame_id_t frame_id);
+
+  private:
+    CodeObjectFrames(const char* function_name, const char* filename, int first_lineno, size_t num_lines);
+    static void destroy(void* code_frames);
+    static size_t countLines(PyCodeObject* code);
+    inline std::atomic<frame_id_t>* slot(int lineno) const;
+
+    static constexpr size_t MAX_CACHED_LINES = 1 << 16;
+    static Py_ssize_t s_extra_index;
+
+    const char* d_function_name;
+    const char* d_filename;
+    int d_first_lineno;
+    size_t d_num_lines;
+    std::atomic<unsigned int> d_tracker_generation{0};
+    // One plus the id of the frame registered for each line, or 0 if the line
+    // hasn't been registered in the current capture yet.
+    std::unique_ptr<std::atomic<frame_id_t>[]> d_frame_ids;
+};
+
+Py_ssize_t CodeObjectFrames::s_extra_index = -1;
+
+CodeObjectFrames::CodeObjectFrames(
+        const char* function_name,
+        const char* filename,
+        int first_lineno,
+        size_t num_lines)
+: d_function_name(function_name)
+, d_filename(filename)
+, d_first_lineno(first_lineno)
+, d_num_lines(num_lines)
+, d_frame_ids(new std::atomic<frame_id_t>[num_lines]())
+{
+}
+
+void
+CodeObjectFrames::setup()
+{
+    assert(PyGILState_Check());
+    s_extra_index = _PyEval_RequestCodeExtraIndex(&CodeObjectFrames::destroy);
+}
+
+void
+CodeObjectFrames::destroy(void* code_frames)
+{
+    RecursionGuard guard;
+    delete static_cast<CodeObjectFrames*>(code_frames);
+}
+
+size_t
+CodeObjectFrames::countLines(PyCodeObject* code)
+{
+    // The line number table is made of (bytecode offset delta, line delta)
+    // byte pairs, starting from the first line of the code object.
+#if PY_VERSION_HEX >= 0x030A0000
+    PyObject* table = code->co_linetable;
+#else
+    PyObject* table = code->co_lnotab;
+#endif
+    if (!table || !PyBytes_Check(table)) {
+        return 1;
+    }
+    const auto* entries = reinterpret_cast<const signed char*>(PyBytes_AS_STRING(table));
+    Py_ssize_t size = PyBytes_GET_SIZE(table);
+    int line = 0;
+    int last_line = 0;
+    for (Py_ssize_t i = 1; i < size; i += 2) {
+#if PY_VERSION_HEX >= 0x030A0000
+        if (entries[i] == -128) {
+            // No line number for these instructions
+            continue;
+        }
+#endif
+        line += entries[i];
+        last_line = std::max(last_line, line);
+    }
+    return std::min(static_cast<size_t>(last_line) + 1, MAX_CACHED_LINES);
+}
+
+CodeObjectFrames*
+CodeObjectFrames::get(PyCodeObject* code)
+{
+    if (s_extra_index < 0) {
+        return nullptr;
+    }
+
+    void* extra = nullptr;
+    if (_PyCode_GetExtra(reinterpret_cast<PyObject*>(code), s_extra_index, &extra) < 0) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    auto* code_frames = static_cast<CodeObjectFrames*>(extra);
+    if (!code_frames) {
+        const char* function = PyUnicode_AsUTF8(code->co_name);
+        const char* filename = function ? PyUnicode_AsUTF8(code->co_filename) : nullptr;
+        if (!filename) {
+            PyErr_Clear();
+            return nullptr;
+        }
+        code_frames = new CodeObjectFrames(function, filename, code->co_firstlineno, countLines(code));
+        if (_PyCode_SetExtra(reinterpret_cast<PyObject*>(code), s_extra_index, code_frames) < 0) {
+            PyErr_Clear();
+            delete code_frames;
+            return nullptr;
+        }
+    }
+
+    // Frame ids are only valid for the capture they were registered in. The
+    // GIL serializes this with every other reset of the same code object.
+    unsigned int generation = g_tracker_generation.load(std::memory_order_relaxed);
+    if (code_frames->d_tracker_generation.load(std::memory_order_relaxed) != generation) {
+        for (size_t i = 0; i < code_frames->d_num_lines; ++i) {
+            code_frames->d_frame_ids[i].store(0, std::memory_order_relaxed);
+        }
+        code_frames->d_tracker_generation.store(generation, std::memory_order_release);
+    }
+    return code_frames;
+}
+
+inline std::atomic<frame_id_t>*
+CodeObjectFrames::slot(int lineno) const
+{
+    if (lineno < d_first_lineno || static_cast<size_t>(lineno - d_first_lineno) >= d_num_lines
+        || d_tracker_generation.load(std::memory_order_acquire)
+                   != g_tracker_generation.load(std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return &d_frame_ids[lineno - d_first_lineno];
+}
+
+inline bool
+CodeObjectFrames::lookup(int lineno, frame_id_t* frame_id) const
+{
+    auto* cached = slot(lineno);
+    frame_id_t value = cached ? cached->load(std::memory_order_relaxed) : 0;
+    if (!value) {
+        return false;
+    }
+    *frame_id = value - 1;
+    return true;
+}
+
+inline void
+CodeObjectFrames::store(int lineno, frame_id_t frame_id)
+{
+    if (auto* cached = slot(lineno)) {
+        cached->store(frame_id + 1, std::memory_order_relaxed);
+    }
+}
+
 // Tracker interface
 
 // If a TLS variable has not been constructed, accessing it will cause it to be
@@ -88,8 +310,15 @@ class PythonStackTracker
     struct LazilyEmittedFrame
     {
         PyFrameObject* frame;
+        CodeObjectFrames* code_frames;
         RawFrame raw_frame_record;
         bool emitted;
+        // Whether the frame filters allow this frame to be written at all
+        bool eligible;
+        // How many eligible frames there are up to and including this one
+        uint32_t depth;
+        // One past the index of the last eligible frame up to and including this one
+        uint32_t eligible_end;
     };
 
   public:
@@ -102,6 +331,8 @@ class PythonStackTracker
     void popPythonFrame();
 
   private:
+    static bool isFrameExcluded(const PythonFrameFilter& filter, PyFrameObject* frame);
+
     uint32_t d_num_pending_pops{};
     uint32_t d_tracker_generation{};
     std::vector<LazilyEmittedFrame>* d_stack{};
@@ -152,11 +383,17 @@ PythonStackTracker::emitPendingPushes()
         return;
     }
 
-    auto last_emitted_rit =
-            std::find_if(d_stack->rbegin(), d_stack->rend(), [](auto& f) { return f.emitted; });
+    // Frames past the last eligible one are never emitted, so don't look at them.
+    auto end = d_stack->empty() ? d_stack->end() : d_stack->begin() + d_stack->back().eligible_end;
+    auto last_emitted_rit = std::find_if(std::make_reverse_iterator(end), d_stack->rend(), [](auto& f) {
+        return f.emitted;
+    });
 
-    for (auto to_emit = last_emitted_rit.base(); to_emit != d_stack->end(); to_emit++) {
-        if (!Tracker::getTracker()->pushFrame(to_emit->raw_frame_record)) {
+    for (auto to_emit = last_emitted_rit.base(); to_emit != end; to_emit++) {
+        if (!to_emit->eligible) {
+            continue;
+        }
+        if (!Tracker::getTracker()->pushFrame(to_emit->raw_frame_record, to_emit->code_frames)) {
             break;
         }
         to_emit->emitted = true;
@@ -188,17 +425,54 @@ PythonStackTracker::setMostRecentFrameLineNumber(int lineno)
     }
 }
 
+bool
+PythonStackTracker::isFrameExcluded(const PythonFrameFilter& filter, PyFrameObject* frame)
+{
+    if (filter.excluded_modules.empty() || !frame->f_globals) {
+        return false;
+    }
+
+    PyObject* module = PyDict_GetItemString(frame->f_globals, "__name__");
+    if (!module || !PyUnicode_Check(module)) {
+        return false;
+    }
+    Py_ssize_t size;
+    const char* name = PyUnicode_AsUTF8AndSize(module, &size);
+    if (!name) {
+        PyErr_Clear();
+        return false;
+    }
+
+    std::string_view module_name(name, size);
+    for (const auto& excluded : filter.excluded_modules) {
+        if (module_name.compare(0, excluded.size(), excluded) == 0
+            && (module_name.size() == excluded.size() || module_name[excluded.size()] == '.'))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 int
 PythonStackTracker::pushPythonFrame(PyFrameObject* frame)
 {
-    const char* function = PyUnicode_AsUTF8(frame->f_code->co_name);
-    if (function == nullptr) {
-        return -1;
-    }
+    const char* function;
+    const char* filename;
+    CodeObjectFrames* code_frames = CodeObjectFrames::get(frame->f_code);
+    if (code_frames) {
+        function = code_frames->functionName();
+        filename = code_frames->filename();
+    } else {
+        function = PyUnicode_AsUTF8(frame->f_code->co_name);
+        if (function == nullptr) {
+            return -1;
+        }
 
-    const char* filename = PyUnicode_AsUTF8(frame->f_code->co_filename);
-    if (filename == nullptr) {
-        return -1;
+        filename = PyUnicode_AsUTF8(frame->f_code->co_filename);
+        if (filename == nullptr) {
+            return -1;
+        }
     }
 
     int parent_lineno = getCurrentPythonLineNumber();
@@ -221,7 +495,23 @@ PythonStackTracker::pushPythonFrame(PyFrameObject* frame)
 
     setMostRecentFrameLineNumber(parent_lineno);
     MEMRAY_FAST_TLS static thread_local StackCreator t_stack_creator;
-    t_stack_creator.stack.push_back({frame, {function, filename, 0}, false});
+    auto& stack = t_stack_creator.stack;
+
+    uint32_t depth = stack.empty() ? 0 : stack.back().depth;
+    uint32_t eligible_end = stack.empty() ? 0 : stack.back().eligible_end;
+    bool eligible = true;
+    // Eligibility is decided once, with the GIL held. Frames that outlive the
+    // tracker keep the filters of the tracker that was active when they were
+    // pushed.
+    if (Tracker* tracker = Tracker::getTracker()) {
+        const PythonFrameFilter& filter = tracker->d_frame_filter;
+        eligible = (!filter.max_depth || depth < filter.max_depth) && !isFrameExcluded(filter, frame);
+    }
+    if (eligible) {
+        depth += 1;
+        eligible_end = stack.size() + 1;
+    }
+    stack.push_back({frame, code_frames, {function, filename, 0}, false, eligible, depth, eligible_end});
     assert(d_stack);  // The above call sets d_stack if it wasn't already set.
     return 0;
 }
@@ -247,6 +537,53 @@ PythonStackTracker::popPythonFrame()
 std::atomic<bool> Tracker::d_active = false;
 std::unique_ptr<Tracker> Tracker::d_instance_owner;
 std::atomic<Tracker*> Tracker::d_instance = nullptr;
+
+static void
+ignoreAllocation(void*, size_t, hooks::Allocator, unsigned int)
+{
+}
+
+const Tracker::AllocationDispatch Tracker::d_inactive_dispatch{
+        &ignoreAllocation,
+        &ignoreAllocation,
+        false};
+const Tracker::AllocationDispatch Tracker::d_python_stacks_dispatch{
+        &Tracker::trackAllocationHook<false, false>,
+        &Tracker::trackDeallocationHook<false>,
+        false};
+const Tracker::AllocationDispatch Tracker::d_native_stacks_dispatch{
+        &Tracker::trackAllocationHook<true, false>,
+        &Tracker::trackDeallocationHook<false>,
+        false};
+const Tracker::AllocationDispatch Tracker::d_filtered_python_stacks_dispatch{
+        &Tracker::trackAllocationHook<false, true>,
+        &Tracker::trackDeallocationHook<true>,
+        true};
+const Tracker::AllocationDispatch Tracker::d_filtered_native_stacks_dispatch{
+        &Tracker::trackAllocationHook<true, true>,
+        &Tracker::trackDeallocationHook<true>,
+        true};
+std::atomic<const Tracker::AllocationDispatch*> Tracker::d_dispatch{&Tracker::d_inactive_dispatch};
+
+// The flag that the public C API tests before calling into the tracker. It's
+// only a shortcut for when tracking is off: the dispatch table still decides
+// what happens to the allocations that are reported while it changes.
+static volatile unsigned char g_c_api_tracking = 0;
+
+static void
+cApiTrackAlloc(void* ptr, size_t size, unsigned int pool_id)
+{
+    Tracker::trackAllocation(ptr, size, hooks::Allocator::POOL_ALLOC, pool_id);
+}
+
+static void
+cApiTrackFree(void* ptr, unsigned int pool_id)
+{
+    Tracker::trackDeallocation(ptr, 0, hooks::Allocator::POOL_FREE, pool_id);
+}
+
+static const MemrayCAPI g_c_api{MEMRAY_C_API_VERSION, &g_c_api_tracking, &cApiTrackAlloc, &cApiTrackFree};
+
 MEMRAY_FAST_TLS thread_local size_t NativeTrace::MAX_SIZE{64};
 
 Tracker::Tracker(
@@ -254,12 +591,20 @@ Tracker::Tracker(
         bool native_traces,
         unsigned int memory_interval,
         bool follow_fork,
-        bool trace_python_allocators)
+        bool trace_python_allocators,
+        AllocationFilter filter,
+        PythonFrameFilter frame_filter,
+        size_t max_native_depth,
+        bool native_stop_at_python)
 : d_writer(std::move(record_writer))
 , d_unwind_native_frames(native_traces)
+, d_native_unwind_limits{max_native_depth}
+, d_native_stop_at_python(native_stop_at_python)
 , d_memory_interval(memory_interval)
 , d_follow_fork(follow_fork)
 , d_trace_python_allocators(trace_python_allocators)
+, d_filter(std::move(filter))
+, d_frame_filter(std::move(frame_filter))
 {
     g_tracker_generation++;
 
@@ -270,12 +615,21 @@ Tracker::Tracker(
     call_once(once, [] {
         hooks::ensureAllHooksAreValid();
         NativeTrace::setup();
+        CodeObjectFrames::setup();
 
         // We must do this last so that a child can't inherit an environment
         // where only half of our one-time setup is done.
         pthread_atfork(&prepareFork, &parentFork, &childFork);
     });
 
+    if (d_unwind_native_frames && d_native_stop_at_python
+        && !findPythonEvalFrame(&d_native_unwind_limits.stop_ip_begin, &d_native_unwind_limits.stop_ip_end))
+    {
+        std::cerr << "memray: Unable to locate the Python evaluation loop, "
+                     "native stacks will not stop at the first Python frame"
+                  << std::endl;
+    }
+
     if (!d_writer->writeHeader(false)) {
         throw IoError{"Failed to write output header"};
     }
@@ -304,6 +658,7 @@ Tracker::~Tracker()
     if (d_trace_python_allocators) {
         unregisterPymallocHooks();
     }
+    d_writer->setDroppedAllocations(d_dropped_by_size, d_dropped_by_allocator, d_dropped_by_thread);
     d_writer->writeHeader(true);
     d_writer.reset();
 
@@ -434,8 +789,9 @@ Tracker::childFork()
         // We either have no tracker, or a deactivated tracker, or a tracker
         // with a sink that can't be cloned. Unset our singleton and bail out.
         // Note that the old tracker's hooks may still be installed. This is
-        // OK, as long as they always check the (static) isActive() flag before
-        // calling any methods on the now null tracker singleton.
+        // OK, as long as tracking is deactivated so that they never call any
+        // methods on the now null tracker singleton.
+        deactivate();
         d_instance = nullptr;
         RecursionGuard::isActive = false;
         return;
@@ -447,16 +803,18 @@ Tracker::childFork()
             old_tracker->d_unwind_native_frames,
             old_tracker->d_memory_interval,
             old_tracker->d_follow_fork,
-            old_tracker->d_trace_python_allocators));
+            old_tracker->d_trace_python_allocators,
+            old_tracker->d_filter,
+            old_tracker->d_frame_filter,
+            old_tracker->d_native_unwind_limits.max_depth,
+            old_tracker->d_native_stop_at_python));
     RecursionGuard::isActive = false;
 }
 
+template<bool UNWIND_NATIVE_FRAMES>
 void
-Tracker::trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func)
+Tracker::trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id)
 {
-    if (RecursionGuard::isActive || !Tracker::isActive()) {
-        return;
-    }
     RecursionGuard guard;
 
     // Grab a reference to the TLS variable to guarantee it's only resolved once.
@@ -467,23 +825,23 @@ Tracker::trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func)
     python_stack_tracker.emitPendingPops();
     python_stack_tracker.emitPendingPushes();
 
-    if (d_unwind_native_frames) {
+    if constexpr (UNWIND_NATIVE_FRAMES) {
         NativeTrace trace;
         frame_id_t native_index = 0;
         // Skip the internal frames so we don't need to filter them later.
-        if (trace.fill(2)) {
+        if (trace.fill(2, d_native_unwind_limits)) {
             native_index = d_native_trace_tree.getTraceIndex(trace, [&](frame_id_t ip, uint32_t index) {
                 return d_writer->writeRecord(UnresolvedNativeFrame{ip, index});
             });
         }
-        NativeAllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func, native_index};
+        NativeAllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func, native_index, pool_id};
         if (!d_writer->writeThreadSpecificRecord(thread_id(), record)) {
             std::cerr << "Failed to write output, deactivating tracking" << std::endl;
             deactivate();
         }
 
     } else {
-        AllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func};
+        AllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func, pool_id};
         if (!d_writer->writeThreadSpecificRecord(thread_id(), record)) {
             std::cerr << "Failed to write output, deactivating tracking" << std::endl;
             deactivate();
@@ -492,20 +850,137 @@ Tracker::trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func)
 }
 
 void
-Tracker::trackDeallocationImpl(void* ptr, size_t size, hooks::Allocator func)
+Tracker::trackDeallocationImpl(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id)
 {
-    if (RecursionGuard::isActive || !Tracker::isActive()) {
-        return;
-    }
     RecursionGuard guard;
 
-    AllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func};
+    AllocationRecord record{reinterpret_cast<uintptr_t>(ptr), size, func, pool_id};
     if (!d_writer->writeThreadSpecificRecord(thread_id(), record)) {
         std::cerr << "Failed to write output, deactivating tracking" << std::endl;
         deactivate();
     }
 }
 
+bool
+Tracker::isThreadExcluded(const char* name) const
+{
+    for (const auto& pattern : d_filter.thread_name_patterns) {
+        if (::fnmatch(pattern.c_str(), name, 0) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+Tracker::shouldDropAllocation(size_t size, hooks::Allocator func)
+{
+    if (!(d_filter.allocators & allocatorBit(func))) {
+        d_dropped_by_allocator.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (size < d_filter.min_size) {
+        d_dropped_by_size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (!d_filter.thread_name_patterns.empty()) {
+        unsigned int generation = g_tracker_generation.load(std::memory_order_relaxed);
+        if (t_thread_filter_generation != generation) {
+            // The thread hasn't registered a name since this tracker was
+            // created, so match the name that the kernel knows it by.
+            RecursionGuard guard;
+            char name[16] = {};
+            ::pthread_getname_np(pthread_self(), name, sizeof(name));
+            t_thread_excluded = isThreadExcluded(name);
+            t_thread_filter_generation = generation;
+        }
+        if (t_thread_excluded) {
+            d_dropped_by_thread.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+Tracker::shouldDropDeallocation(void* ptr, size_t size, hooks::Allocator func) const
+{
+    unsigned int family;
+    switch (func) {
+        case hooks::Allocator::FREE:
+            family = MALLOC_FAMILY;
+            break;
+        case hooks::Allocator::MUNMAP:
+        case hooks::Allocator::MADVISE:
+            family = MMAP_FAMILY;
+            break;
+        case hooks::Allocator::PYMALLOC_FREE:
+            family = PYMALLOC_FAMILY;
+            break;
+        case hooks::Allocator::POOL_FREE:
+            family = POOL_FAMILY;
+            break;
+        default:
+            return false;
+    }
+    if (!(d_filter.allocators & family)) {
+        return true;
+    }
+
+    // The usable size of a block is never smaller than the size that was
+    // requested for it, so anything below the minimum was never captured.
+    // munmap can release part of a bigger mapping, and blocks owned by the
+    // Python allocators can't be inspected, so those are always kept.
+    if (func == hooks::Allocator::FREE && d_filter.min_size > 0) {
+        size_t usable_size = size ? size : ::malloc_usable_size(ptr);
+        if (usable_size < d_filter.min_size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<bool UNWIND_NATIVE_FRAMES, bool FILTER_ALLOCATIONS>
+void
+Tracker::trackAllocationHook(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id)
+{
+    if (RecursionGuard::isActive) {
+        return;
+    }
+    Tracker* tracker = d_instance.load(std::memory_order_relaxed);
+    if (!tracker) {
+        return;
+    }
+    if constexpr (FILTER_ALLOCATIONS) {
+        if (tracker->shouldDropAllocation(size, func)) {
+            return;
+        }
+    }
+    tracker->trackAllocationImpl<UNWIND_NATIVE_FRAMES>(ptr, size, func, pool_id);
+}
+
+template<bool FILTER_ALLOCATIONS>
+void
+Tracker::trackDeallocationHook(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id)
+{
+    if (RecursionGuard::isActive) {
+        return;
+    }
+    Tracker* tracker = d_instance.load(std::memory_order_relaxed);
+    if (!tracker) {
+        return;
+    }
+    if constexpr (FILTER_ALLOCATIONS) {
+        if (tracker->shouldDropDeallocation(ptr, size, func)) {
+            return;
+        }
+    }
+    tracker->trackDeallocationImpl(ptr, size, func, pool_id);
+}
+
 void
 Tracker::invalidate_module_cache_impl()
 {
@@ -517,15 +992,9 @@ Tracker::invalidate_module_cache_impl()
 static int
 dl_iterate_phdr_callback(struct dl_phdr_info* info, [[maybe_unused]] size_t size, void* data)
 {
-    auto writer = reinterpret_cast<RecordWriter*>(data);
-    const char* filename = info->dlpi_name;
-    std::string executable;
-    assert(filename != nullptr);
-    if (!filename[0]) {
-        executable = get_executable();
-        filename = executable.c_str();
-    }
-    if (::starts_with(filename, "linux-vdso.so")) {
+    auto loaded_objects = reinterpret_cast<loaded_objects_t*>(data);
+    assert(info->dlpi_name != nullptr);
+    if (::starts_with(info->dlpi_name, "linux-vdso.so")) {
         // This cannot be resolved to anything, so don't write it to the file
         return 0;
     }
@@ -538,21 +1007,30 @@ dl_iterate_phdr_callback(struct dl_phdr_info* info, [[maybe_unused]] size_t size
         }
     }
 
-    if (!writer->writeRecordUnsafe(SegmentHeader{filename, segments.size(), info->dlpi_addr})) {
-        std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
-        Tracker::deactivate();
-        return 1;
+    loaded_objects->emplace(std::make_pair(info->dlpi_name, info->dlpi_addr), std::move(segments));
+    return 0;
+}
+
+static bool
+writeLoadedObject(
+        RecordWriter* writer,
+        const loaded_objects_t::value_type& loaded_object,
+        bool removed)
+{
+    const auto& [name, addr] = loaded_object.first;
+    const auto& segments = loaded_object.second;
+    std::string filename = name.empty() ? get_executable() : name;
+
+    if (!writer->writeRecordUnsafe(SegmentHeader{filename.c_str(), segments.size(), addr, removed})) {
+        return false;
     }
 
     for (const auto& segment : segments) {
         if (!writer->writeRecordUnsafe(segment)) {
-            std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
-            Tracker::deactivate();
-            return 1;
+            return false;
         }
     }
-
-    return 0;
+    return true;
 }
 
 void
@@ -561,18 +1039,62 @@ Tracker::updateModuleCacheImpl()
     if (!d_unwind_native_frames) {
         return;
     }
-    auto writer_lock = d_writer->acquireLock();
-    if (!d_writer->writeRecordUnsafe(MemoryMapStart{})) {
-        std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
-        deactivate();
+
+    // Only the objects that were loaded or unloaded since the last update are
+    // written: the reader starts every memory map from the previous one. The
+    // lock serializes concurrent updates so that every diff is computed
+    // against the state that the previous update wrote.
+    std::lock_guard<std::mutex> lock(d_loaded_objects_mutex);
+    loaded_objects_t loaded_objects;
+    dl_iterate_phdr(&dl_iterate_phdr_callback, &loaded_objects);
+
+    std::vector<const loaded_objects_t::value_type*> added;
+    std::vector<const loaded_objects_t::value_type*> removed;
+    auto old_it = d_loaded_objects.cbegin();
+    auto new_it = loaded_objects.cbegin();
+    while (old_it != d_loaded_objects.cend() || new_it != loaded_objects.cend()) {
+        if (new_it == loaded_objects.cend()
+            || (old_it != d_loaded_objects.cend() && old_it->first < new_it->first))
+        {
+            removed.push_back(&*old_it++);
+        } else if (old_it == d_loaded_objects.cend() || new_it->first < old_it->first) {
+            added.push_back(&*new_it++);
+        } else {
+            ++old_it;
+            ++new_it;
+        }
+    }
+
+    if (added.empty() && removed.empty()) {
+        return;
+    }
+
+    {
+        auto writer_lock = d_writer->acquireLock();
+        bool ok = d_writer->writeRecordUnsafe(MemoryMapStart{});
+        for (auto it = removed.cbegin(); ok && it != removed.cend(); ++it) {
+            ok = writeLoadedObject(d_writer.get(), **it, true);
+        }
+        for (auto it = added.cbegin(); ok && it != added.cend(); ++it) {
+            ok = writeLoadedObject(d_writer.get(), **it, false);
+        }
+        if (!ok) {
+            std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
+            deactivate();
+        }
     }
 
-    dl_iterate_phdr(&dl_iterate_phdr_callback, d_writer.get());
+    d_loaded_objects = std::move(loaded_objects);
 }
 
 void
 Tracker::registerThreadNameImpl(const char* name)
 {
+    if (!d_filter.thread_name_patterns.empty()) {
+        RecursionGuard guard;
+        t_thread_excluded = isThreadExcluded(name);
+        t_thread_filter_generation = g_tracker_generation.load(std::memory_order_relaxed);
+    }
     if (!d_writer->writeThreadSpecificRecord(thread_id(), ThreadRecord{name})) {
         std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
         deactivate();
@@ -582,15 +1104,13 @@ Tracker::registerThreadNameImpl(const char* name)
 frame_id_t
 Tracker::registerFrame(const RawFrame& frame)
 {
-    const auto [frame_id, is_new_frame] = d_frames.getIndex(frame);
-    if (is_new_frame) {
+    return d_frames.getIndex(frame, [&](frame_id_t frame_id) {
         pyrawframe_map_val_t frame_index{frame_id, frame};
         if (!d_writer->writeRecord(frame_index)) {
             std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
             deactivate();
         }
-    }
-    return frame_id;
+    });
 }
 
 bool
@@ -606,9 +1126,15 @@ Tracker::popFrames(uint32_t count)
 }
 
 bool
-Tracker::pushFrame(const RawFrame& frame)
+Tracker::pushFrame(const RawFrame& frame, CodeObjectFrames* code_frames)
 {
-    const frame_id_t frame_id = registerFrame(frame);
+    frame_id_t frame_id;
+    if (!code_frames || !code_frames->lookup(frame.lineno, &frame_id)) {
+        frame_id = registerFrame(frame);
+        if (code_frames) {
+            code_frames->store(frame.lineno, frame_id);
+        }
+    }
     const FramePush entry{frame_id};
     if (!d_writer->writeThreadSpecificRecord(thread_id(), entry)) {
         std::cerr << "memray: Failed to write output, deactivating tracking" << std::endl;
@@ -621,13 +1147,25 @@ Tracker::pushFrame(const RawFrame& frame)
 void
 Tracker::activate()
 {
+    Tracker* tracker = d_instance;
+    assert(tracker != nullptr);
     d_active = true;
+    g_c_api_tracking = 1;
+    if (tracker->d_filter.isActive()) {
+        d_dispatch = tracker->d_unwind_native_frames ? &d_filtered_native_stacks_dispatch
+                                                     : &d_filtered_python_stacks_dispatch;
+    } else {
+        d_dispatch = tracker->d_unwind_native_frames ? &d_native_stacks_dispatch
+                                                     : &d_python_stacks_dispatch;
+    }
 }
 
 void
 Tracker::deactivate()
 {
+    d_dispatch = &d_inactive_dispatch;
     d_active = false;
+    g_c_api_tracking = 0;
 }
 
 const std::atomic<bool>&
@@ -636,6 +1174,12 @@ Tracker::isActive()
     return Tracker::d_active;
 }
 
+const MemrayCAPI*
+Tracker::getCAPI()
+{
+    return &g_c_api;
+}
+
 // Static methods managing the singleton
 
 PyObject*
@@ -644,7 +1188,11 @@ Tracker::createTracker(
         bool native_traces,
         unsigned int memory_interval,
         bool follow_fork,
-        bool trace_python_allocators)
+        bool trace_python_allocators,
+        AllocationFilter filter,
+        PythonFrameFilter frame_filter,
+        size_t max_native_depth,
+        bool native_stop_at_python)
 {
     // Note: the GIL is used for synchronization of the singleton
     d_instance_owner.reset(new Tracker(
@@ -652,7 +1200,11 @@ Tracker::createTracker(
             native_traces,
             memory_interval,
             follow_fork,
-            trace_python_allocators));
+            trace_python_allocators,
+            std::move(filter),
+            std::move(frame_filter),
+            max_native_depth,
+            native_stop_at_python));
     Py_RETURN_NONE;
 }
 
@@ -1,14 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <fstream>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <unwind.h>
 
@@ -18,8 +23,10 @@
 #include <libunwind.h>
 
 #include "elf_shenanigans.h"
+#include "frame_registry.h"
 #include "frame_tree.h"
 #include "hooks.h"
+#include "memray/include/memray.h"
 #include "record_writer.h"
 #include "records.h"
 
@@ -78,6 +85,20 @@ PyTraceFunction(PyObject* obj, PyFrameObject* frame, int what, PyObject* arg);
 void
 install_trace_function();
 
+/**
+ * Limits on how much of the native stack is unwound for each allocation.
+ **/
+struct NativeUnwindLimits
+{
+    // If not zero, at most this many native frames are captured
+    size_t max_depth{0};
+    // If not empty, unwinding stops at the first frame whose instruction
+    // pointer is in [stop_ip_begin, stop_ip_end), which is kept as the
+    // outermost captured frame
+    uintptr_t stop_ip_begin{0};
+    uintptr_t stop_ip_end{0};
+};
+
 class NativeTrace
 {
   public:
@@ -104,15 +125,33 @@ class NativeTrace
     {
         return d_size;
     }
-    __attribute__((always_inline)) inline bool fill(size_t skip)
+    __attribute__((always_inline)) inline bool fill(size_t skip, const NativeUnwindLimits& limits)
     {
-        size_t size = unwind(d_data.data());
-        if (size == MAX_SIZE) {
-            d_data.resize(0);
-            size = exact_unwind();
-            MAX_SIZE = MAX_SIZE * 2 > size ? MAX_SIZE * 2 : size;
-            d_data.resize(MAX_SIZE);
+        size_t max_size = limits.max_depth ? limits.max_depth + skip : SIZE_MAX;
+        size_t size = 0;
+        bool complete = false;
+        if (limits.stop_ip_end) {
+            // Allocations are usually only a few native frames away from the
+            // eval loop, so try a short unwind before falling back to a full one.
+            size_t capacity = std::min({MAX_SIZE, SHORT_UNWIND_SIZE, max_size});
+            size = unwind(d_data.data(), capacity);
+            complete = truncateAtStopFrame(&size, skip, limits) || size < capacity || size == max_size;
+        }
+
+        if (!complete) {
+            size = unwind(d_data.data(), std::min(MAX_SIZE, max_size));
+            if (size == MAX_SIZE && size < max_size) {
+                d_data.resize(0);
+                size = exact_unwind();
+                MAX_SIZE = MAX_SIZE * 2 > size ? MAX_SIZE * 2 : size;
+                d_data.resize(MAX_SIZE);
+                size = std::min(size, max_size);
+            }
+            if (limits.stop_ip_end) {
+                truncateAtStopFrame(&size, skip, limits);
+            }
         }
+
         d_size = size > skip ? size - skip : 0;
         d_skip = skip;
         return d_size > 0;
@@ -137,10 +176,23 @@ class NativeTrace
     }
 
   private:
+    static constexpr size_t SHORT_UNWIND_SIZE = 32;
     MEMRAY_FAST_TLS static thread_local size_t MAX_SIZE;
-    __attribute__((always_inline)) static inline int unwind(frame_id_t* data)
+    __attribute__((always_inline)) static inline int unwind(frame_id_t* data, size_t capacity)
     {
-        return unw_backtrace((void**)data, MAX_SIZE);
+        return unw_backtrace((void**)data, capacity);
+    }
+
+    __attribute__((always_inline)) inline bool
+    truncateAtStopFrame(size_t* size, size_t skip, const NativeUnwindLimits& limits) const
+    {
+        for (size_t i = skip; i < *size; ++i) {
+            if (d_data[i] >= limits.stop_ip_begin && d_data[i] < limits.stop_ip_end) {
+                *size = i + 1;
+                return true;
+            }
+        }
+        return false;
     }
 
     __attribute__((always_inline)) size_t inline exact_unwind()
@@ -174,6 +226,48 @@ class NativeTrace
     std::vector<ip_t> d_data;
 };
 
+/**
+ * Capture-time filters, applied to every allocation before any stack information is gathered.
+ *
+ * Deallocations are only dropped when they can't possibly match an allocation that was kept: by
+ * size only for blocks whose usable size is below the minimum, and by allocator only when every
+ * allocator that could have produced the block is excluded. They are never dropped by thread, as
+ * memory can be freed by a different thread than the one that allocated it.
+ **/
+struct AllocationFilter
+{
+    // Allocations smaller than this many bytes are dropped
+    size_t min_size{0};
+    // Bit N is set if allocations made with the hooks::Allocator with value N are captured
+    unsigned int allocators{~0u};
+    // If not empty, only allocations made by threads whose name matches one of these
+    // fnmatch(3) patterns are captured
+    std::vector<std::string> thread_name_patterns;
+
+    bool isActive() const
+    {
+        return min_size > 0 || allocators != ~0u || !thread_name_patterns.empty();
+    }
+};
+
+/**
+ * Capture-time filters for the Python frames that make up the stack of each allocation.
+ *
+ * Frames that are filtered out are still tracked, so that line numbers and frame pops stay
+ * correct, but they're never written to the output. Allocations made while they're on the stack
+ * are attributed to the closest frame below them that was written.
+ **/
+struct PythonFrameFilter
+{
+    // If not zero, only the outermost this many frames of each stack are written
+    unsigned int max_depth{0};
+    // Frames of code in these modules, or in submodules of them, are not written
+    std::vector<std::string> excluded_modules;
+};
+
+// Segments of every object reported by dl_iterate_phdr, keyed by name and load address
+using loaded_objects_t = std::map<std::pair<std::string, uintptr_t>, std::vector<Segment>>;
+
 /**
  * Singleton managing all the global state and functionality of the tracing mechanism
  *
@@ -183,6 +277,8 @@ class NativeTrace
  * temporarily stop the tracking as desired. The singleton manages a mirror copy of the Python stack
  * so it can be accessed synchronized by its the allocation tracking interfaces.
  * */
+class CodeObjectFrames;
+
 class Tracker
 {
   public:
@@ -200,27 +296,49 @@ class Tracker
             bool native_traces,
             unsigned int memory_interval,
             bool follow_fork,
-            bool trace_python_allocators);
+            bool trace_python_allocators,
+            AllocationFilter filter,
+            PythonFrameFilter frame_filter,
+            size_t max_native_depth,
+            bool native_stop_at_python);
     static PyObject* destroyTracker();
     static Tracker* getTracker();
 
     // Allocation tracking interface
     __attribute__((always_inline)) inline static void
-    trackAllocation(void* ptr, size_t size, hooks::Allocator func)
+    trackAllocation(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id = 0)
     {
-        Tracker* tracker = getTracker();
-        if (tracker) {
-            tracker->trackAllocationImpl(ptr, size, func);
-        }
+        d_dispatch.load(std::memory_order_acquire)->trackAllocation(ptr, size, func, pool_id);
     }
 
     __attribute__((always_inline)) inline static void
-    trackDeallocation(void* ptr, size_t size, hooks::Allocator func)
+    trackDeallocation(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id = 0)
     {
-        Tracker* tracker = getTracker();
-        if (tracker) {
-            tracker->trackDeallocationImpl(ptr, size, func);
+        d_dispatch.load(std::memory_order_acquire)->trackDeallocation(ptr, size, func, pool_id);
+    }
+
+    // realloc releases the old block, so it can't be inspected afterwards. The size
+    // filter needs its usable size to tell whether it was captured, so that's read up
+    // front, but only when the installed dispatch filters. The release is reported
+    // through that same dispatch, so a concurrent activation can't make a filtering
+    // hook look up the size of a block that's already gone.
+    template<typename Reallocator>
+    __attribute__((always_inline)) inline static void*
+    trackReallocation(void* ptr, size_t size, Reallocator&& reallocate)
+    {
+        const AllocationDispatch* dispatch = d_dispatch.load(std::memory_order_acquire);
+        size_t old_size = 0;
+        if (ptr != nullptr && dispatch->filters_allocations) {
+            old_size = ::malloc_usable_size(ptr);
         }
+        void* ret = reallocate(ptr, size);
+        if (ret) {
+            if (ptr != nullptr) {
+                dispatch->trackDeallocation(ptr, old_size, hooks::Allocator::FREE, 0);
+            }
+            trackAllocation(ret, size, hooks::Allocator::REALLOC);
+        }
+        return ret;
     }
 
     __attribute__((always_inline)) inline static void invalidate_module_cache()
@@ -248,7 +366,7 @@ class Tracker
     }
 
     // RawFrame stack interface
-    bool pushFrame(const RawFrame& frame);
+    bool pushFrame(const RawFrame& frame, CodeObjectFrames* code_frames);
     bool popFrames(uint32_t count);
 
     // Interface to activate/deactivate the tracking
@@ -256,7 +374,24 @@ class Tracker
     static void activate();
     static void deactivate();
 
+    // Public C API, see include/memray.h
+    static const MemrayCAPI* getCAPI();
+
   private:
+    friend class PythonStackTracker;
+
+    // Entry points of the allocation tracking hot path. Activating the tracker
+    // installs the ones specialized for its configuration and deactivating it
+    // installs no-ops, so the hooks never need to check the configuration at
+    // runtime. A thread can still be running a hook from a table it loaded just
+    // before deactivation, so the hooks do check that the instance still exists.
+    struct AllocationDispatch
+    {
+        void (*trackAllocation)(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
+        void (*trackDeallocation)(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
+        bool filters_allocations;
+    };
+
     class BackgroundThread
     {
       public:
@@ -283,25 +418,52 @@ class Tracker
     };
 
     // Data members
-    FrameCollection<RawFrame> d_frames{0, 2};
+    FrameRegistry d_frames{0, 2};
     static std::atomic<bool> d_active;
     static std::unique_ptr<Tracker> d_instance_owner;
     static std::atomic<Tracker*> d_instance;
+    static const AllocationDispatch d_inactive_dispatch;
+    static const AllocationDispatch d_python_stacks_dispatch;
+    static const AllocationDispatch d_native_stacks_dispatch;
+    static const AllocationDispatch d_filtered_python_stacks_dispatch;
+    static const AllocationDispatch d_filtered_native_stacks_dispatch;
+    static std::atomic<const AllocationDispatch*> d_dispatch;
 
     std::shared_ptr<RecordWriter> d_writer;
     FrameTree d_native_trace_tree;
     bool d_unwind_native_frames;
+    NativeUnwindLimits d_native_unwind_limits;
+    bool d_native_stop_at_python;
     unsigned int d_memory_interval;
     bool d_follow_fork;
     bool d_trace_python_allocators;
+    AllocationFilter d_filter;
+    PythonFrameFilter d_frame_filter;
+    std::atomic<size_t> d_dropped_by_size{0};
+    std::atomic<size_t> d_dropped_by_allocator{0};
+    std::atomic<size_t> d_dropped_by_thread{0};
     elf::SymbolPatcher d_patcher;
+    std::mutex d_loaded_objects_mutex;
+    loaded_objects_t d_loaded_objects;
     std::unique_ptr<BackgroundThread> d_background_thread;
 
     // Methods
     frame_id_t registerFrame(const RawFrame& frame);
 
-    void trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func);
-    void trackDeallocationImpl(void* ptr, size_t size, hooks::Allocator func);
+    template<bool UNWIND_NATIVE_FRAMES, bool FILTER_ALLOCATIONS>
+    static void
+    trackAllocationHook(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
+    template<bool FILTER_ALLOCATIONS>
+    static void
+    trackDeallocationHook(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
+    bool shouldDropAllocation(size_t size, hooks::Allocator func);
+    bool shouldDropDeallocation(void* ptr, size_t size, hooks::Allocator func) const;
+    bool isThreadExcluded(const char* name) const;
+    template<bool UNWIND_NATIVE_FRAMES>
+    __attribute__((always_inline)) inline void
+    trackAllocationImpl(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
+    __attribute__((always_inline)) inline void
+    trackDeallocationImpl(void* ptr, size_t size, hooks::Allocator func, unsigned int pool_id);
     void invalidate_module_cache_impl();
     void updateModuleCacheImpl();
     void registerThreadNameImpl(const char* name);
@@ -313,7 +475,11 @@ class Tracker
             bool native_traces,
             unsigned int memory_interval,
             bool follow_fork,
-            bool trace_python_allocators);
+            bool trace_python_allocators,
+            AllocationFilter filter,
+            PythonFrameFilter frame_filter,
+            size_t max_native_depth,
+            bool native_stop_at_python);
 
     static void prepareFork();
     static void parentFork();
@@ -2,11 +2,21 @@ from _memray.record_writer cimport RecordWriter
 from libcpp cimport bool
 from libcpp.memory cimport unique_ptr
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 
 cdef extern from "tracking_api.h" namespace "memray::tracking_api":
     void install_trace_function() except*
 
+    cdef cppclass AllocationFilter:
+        size_t min_size
+        unsigned int allocators
+        vector[string] thread_name_patterns
+
+    cdef cppclass PythonFrameFilter:
+        unsigned int max_depth
+        vector[string] excluded_modules
+
     cdef cppclass Tracker:
         @staticmethod
         object createTracker(
@@ -15,6 +25,10 @@ cdef extern from "tracking_api.h" namespace "memray::tracking_api":
             unsigned int memory_interval,
             bool follow_fork,
             bool trace_pymalloc,
+            AllocationFilter filter,
+            PythonFrameFilter frame_filter,
+            size_t max_native_depth,
+            bool native_stop_at_python,
         ) except+
 
         @staticmethod
@@ -22,3 +36,6 @@ cdef extern from "tracking_api.h" namespace "memray::tracking_api":
 
         @staticmethod
         Tracker* getTracker()
+
+        @staticmethod
+        const void* getCAPI()
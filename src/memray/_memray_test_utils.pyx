@@ -40,6 +40,13 @@ from libc.stdint cimport uintptr_t
 from ._destination import Destination
 
 
+cdef extern from "sys/mman.h":
+    int MADV_DONTNEED
+    int MREMAP_MAYMOVE
+    int madvise(void* addr, size_t length, int advice)
+    void* mremap(void* old_address, size_t old_size, size_t new_size, int flags, ...)
+
+
 cdef extern from "sys/prctl.h":
     int prctl(int, char*, char*, char*, char*)
 
@@ -208,6 +215,20 @@ cdef class MmapAllocator:
         if ret != 0:
             raise MemoryError(f"munmap rcode: {ret} errno: {errno}")
 
+    @cython.profile(True)
+    def mremap(self, old_size, new_size):
+        cdef void* ret = mremap(<void *>self._address, old_size, new_size, MREMAP_MAYMOVE)
+        if ret == MAP_FAILED:
+            raise MemoryError(f"mremap errno: {errno}")
+        self._address = <uintptr_t>ret
+
+    @cython.profile(True)
+    def madvise_dontneed(self, length, offset=0):
+        cdef uintptr_t addr = self._address + <uintptr_t> offset
+        cdef int ret = madvise(<void *>addr, length, MADV_DONTNEED)
+        if ret != 0:
+            raise MemoryError(f"madvise rcode: {ret} errno: {errno}")
+
 @cython.profile(True)
 cdef void* _pthread_worker(void* arg) with gil:
     (<object> arg)()
@@ -227,3 +248,138 @@ cdef void* allocation_place_a(size_t size):
 cdef void* allocation_place_b(size_t size):
     return valloc(size)
  
+
+@cython.profile(False)
+def _cython_malloc_free_loop(size_t size, size_t iterations):
+    cdef size_t i
+    cdef void* ptr
+    cdef uintptr_t checksum = 0
+    with nogil:
+        for i in range(iterations):
+            ptr = malloc(size)
+            # Use the address so the compiler can't elide the allocation
+            checksum ^= <uintptr_t>ptr
+            free(ptr)
+    return checksum
+
+
+cdef extern from "memray/include/memray.h":
+    int memray_import() except -1
+    void memray_track_alloc(void* ptr, size_t size, unsigned int pool_id)
+    void memray_track_free(void* ptr, unsigned int pool_id)
+
+
+cdef class PoolAllocator:
+    """A bump allocator that reports its blocks through the public C API."""
+    cdef char* _buffer
+    cdef size_t _size
+    cdef size_t _used
+    cdef unsigned int _pool_id
+
+    def __cinit__(self, size_t size, unsigned int pool_id=0):
+        memray_import()
+        self._buffer = <char*>malloc(size)
+        if self._buffer == NULL:
+            raise MemoryError
+        self._size = size
+        self._used = 0
+        self._pool_id = pool_id
+
+    def __dealloc__(self):
+        free(self._buffer)
+
+    @cython.profile(True)
+    def alloc(self, size_t size):
+        if self._used + size > self._size:
+            raise MemoryError
+        cdef void* ptr = self._buffer + self._used
+        self._used += size
+        memray_track_alloc(ptr, size, self._pool_id)
+        return <uintptr_t>ptr
+
+    @cython.profile(True)
+    def free(self, uintptr_t address):
+        memray_track_free(<void*>address, self._pool_id)
+
+
+cdef extern from "synthetic_capture.h" namespace "memray::tracking_api":
+    cdef struct SyntheticWorkload:
+        size_t allocations
+        unsigned int threads
+        unsigned int functions
+        double mean_stack_depth
+        unsigned int max_stack_depth
+        size_t min_size
+        size_t max_size
+        double mean_lifetime
+        double leak_fraction
+        double mmap_fraction
+        bool native_traces
+        size_t dlopen_churn
+        unsigned long long seed
+
+    size_t writeSyntheticCapture(const cppstring& file_name, const SyntheticWorkload& workload) nogil except+
+
+
+def write_synthetic_capture(
+    object path,
+    *,
+    size_t allocations=1_000_000,
+    unsigned int threads=4,
+    unsigned int functions=500,
+    double mean_stack_depth=15,
+    unsigned int max_stack_depth=30,
+    size_t min_size=16,
+    size_t max_size=65536,
+    double mean_lifetime=10_000,
+    double leak_fraction=0,
+    double mmap_fraction=0.01,
+    bool native_traces=False,
+    size_t dlopen_churn=0,
+    unsigned long long seed=42,
+):
+    """Write a capture of a synthetic workload, and return its number of records.
+
+    See SyntheticWorkload in synthetic_capture.h for the model behind the
+    parameters. Sizes are in bytes, and lifetimes are measured in number of
+    allocations made by the whole process.
+    """
+    cdef SyntheticWorkload workload
+    workload.allocations = allocations
+    workload.threads = threads
+    workload.functions = functions
+    workload.mean_stack_depth = mean_stack_depth
+    workload.max_stack_depth = max_stack_depth
+    workload.min_size = min_size
+    workload.max_size = max_size
+    workload.mean_lifetime = mean_lifetime
+    workload.leak_fraction = leak_fraction
+    workload.mmap_fraction = mmap_fraction
+    workload.native_traces = native_traces
+    workload.dlopen_churn = dlopen_churn
+    workload.seed = seed
+
+    cdef cppstring file_name = os.fsencode(path)
+    cdef size_t records
+    with nogil:
+        records = writeSyntheticCapture(file_name, workload)
+    if records == 0:
+        raise IOError(f"Could not write the synthetic capture to {path}")
+    return records
+
+
+cdef extern from "test_utils.h" namespace "memray::test_utils":
+    size_t registerFramesConcurrently(unsigned int n_threads, unsigned int n_frames) nogil except+
+
+
+def register_frames_concurrently(unsigned int n_threads, unsigned int n_frames):
+    """Register the same frames from several native threads at once.
+
+    The threads race through the frame registry of the tracker without the
+    GIL, and this returns how many frame ids were handed out. Raises
+    RuntimeError if two threads got different ids for the same frame.
+    """
+    cdef size_t registered
+    with nogil:
+        registered = registerFramesConcurrently(n_threads, n_frames)
+    return registered
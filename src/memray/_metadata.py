@@ -13,3 +13,11 @@ class Metadata:
     pid: int
     python_allocator: str
     has_native_traces: bool
+    dropped_by_size: int = 0
+    dropped_by_allocator: int = 0
+    dropped_by_thread: int = 0
+    has_timestamps: bool = False
+
+    @property
+    def dropped_allocations(self) -> int:
+        return self.dropped_by_size + self.dropped_by_allocator + self.dropped_by_thread
@@ -1,10 +1,14 @@
 from ._memray import MemoryAllocator
 from ._memray import MmapAllocator
+from ._memray import PoolAllocator
 from ._memray import PymallocDomain
 from ._memray import PymallocMemoryAllocator
 from ._memray import _cython_allocate_in_two_places
+from ._memray import _cython_malloc_free_loop
 from ._memray import _cython_nested_allocation
+from ._memray import register_frames_concurrently
 from ._memray import set_thread_name
+from ._memray import write_synthetic_capture
 
 __all__ = [
     "MemoryAllocator",
@@ -12,6 +16,10 @@ __all__ = [
     "PymallocDomain",
     "_cython_nested_allocation",
     "_cython_allocate_in_two_places",
+    "_cython_malloc_free_loop",
     "MmapAllocator",
+    "PoolAllocator",
+    "register_frames_concurrently",
     "set_thread_name",
+    "write_synthetic_capture",
 ]
@@ -14,9 +14,15 @@ from memray._errors import MemrayCommandError
 from memray._errors import MemrayError
 from memray._memray import set_log_level
 
+from . import batch
+from . import churn
+from . import diff
 from . import flamegraph
+from . import fragmentation
 from . import live
 from . import parse
+from . import replay
+from . import rewrite
 from . import run
 from . import stats
 from . import summary
@@ -56,12 +62,19 @@ class Command(Protocol):
 _COMMANDS: List[Command] = [
     run.RunCommand(),
     flamegraph.FlamegraphCommand(),
+    diff.DiffCommand(),
     table.TableCommand(),
     live.LiveCommand(),
     tree.TreeCommand(),
     parse.ParseCommand(),
     summary.SummaryCommand(),
     stats.StatsCommand(),
+    batch.BatchCommand(),
+    fragmentation.FragmentationCommand(),
+    churn.ChurnCommand(),
+    replay.ReplayCommand(),
+    rewrite.SliceCommand(),
+    rewrite.CompactCommand(),
 ]
 
 
@@ -0,0 +1,181 @@
+import argparse
+import heapq
+import itertools
+import json
+import os
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Any
+from typing import Dict
+from typing import List
+from typing import Optional
+from typing import Tuple
+
+from memray import FileReader
+from memray import SymbolCache
+from memray._errors import MemrayCommandError
+
+from .common import add_spill_directory_argument
+
+# Every worker process reads the symbols of each shared object only once,
+# no matter how many of the captures that it analyzes mapped it.
+_symbol_cache: Optional[SymbolCache] = None
+
+
+def _init_worker() -> None:
+    global _symbol_cache
+    _symbol_cache = SymbolCache()
+
+
+def summarize_capture(
+    path: str, num_largest: int, spill_directory: Optional[str] = None
+) -> Dict[str, Any]:
+    """Summarize the peak memory usage of a capture file as a JSON object.
+
+    Failing to read the capture doesn't raise, so that a single corrupt file
+    doesn't stop a batch: the error is reported in the summary instead. A
+    corrupt file can fail in many ways besides an OSError, so every error is
+    caught, and reported with its type.
+    """
+    try:
+        reader = FileReader(
+            path, spill_directory=spill_directory, symbol_cache=_symbol_cache
+        )
+        snapshot = list(
+            reader.get_high_watermark_allocation_records(merge_threads=True)
+        )
+    except Exception as e:
+        return {"path": path, "error": f"{type(e).__name__}: {e}"}
+
+    metadata = reader.metadata
+    # Group the memory by the innermost frame of each stack, like the
+    # "Own Memory" column of `memray summary`.
+    sites: Dict[Tuple[str, str, int], List[int]] = {}
+    for record in snapshot:
+        stack_trace = (
+            record.hybrid_stack_trace(max_stacks=1)
+            if metadata.has_native_traces
+            else record.stack_trace(max_stacks=1)
+        )
+        location = next(iter(stack_trace), ("<unknown>", "<unknown>", 0))
+        totals = sites.setdefault(location, [0, 0])
+        totals[0] += record.size
+        totals[1] += record.n_allocations
+
+    top_sites = heapq.nlargest(num_largest, sites.items(), key=lambda item: item[1][0])
+    return {
+        "path": path,
+        "pid": metadata.pid,
+        "command_line": metadata.command_line,
+        "start_time": metadata.start_time.isoformat(),
+        "end_time": metadata.end_time.isoformat(),
+        "peak_memory": metadata.peak_memory,
+        "total_allocations": metadata.total_allocations,
+        "total_frames": metadata.total_frames,
+        "dropped_allocations": metadata.dropped_allocations,
+        "has_native_traces": metadata.has_native_traces,
+        "top_sites": [
+            {
+                "function": function,
+                "file": file,
+                "line": line,
+                "size": size,
+                "allocations": n_allocations,
+            }
+            for (function, file, line), (size, n_allocations) in top_sites
+        ],
+    }
+
+
+class BatchCommand:
+    """Summarize many capture files at once, as JSON"""
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument(
+            "-j",
+            "--jobs",
+            help="Number of captures to analyze at the same time, each one in its "
+            "own process (default: the number of CPUs)",
+            type=int,
+            default=os.cpu_count() or 1,
+        )
+        parser.add_argument(
+            "-n",
+            "--num-largest",
+            help="Number of allocation sites to report for each capture, from "
+            "the one that had the most memory at the peak (default: %(default)s)",
+            type=int,
+            default=5,
+        )
+        parser.add_argument(
+            "--pattern",
+            help="The capture files to analyze in the directories that are given "
+            "(default: %(default)s)",
+            default="*.bin*",
+        )
+        parser.add_argument(
+            "-o",
+            "--output",
+            help="Write the summaries to this file instead of the standard output",
+            default=None,
+        )
+        add_spill_directory_argument(parser)
+        parser.add_argument(
+            "paths",
+            help="Capture files, or directories containing them",
+            nargs="+",
+        )
+
+    def find_captures(self, paths: List[str], pattern: str) -> List[Path]:
+        captures: List[Path] = []
+        for name in paths:
+            path = Path(name)
+            if path.is_dir():
+                captures.extend(
+                    sorted(child for child in path.glob(pattern) if child.is_file())
+                )
+            elif path.is_file():
+                captures.append(path)
+            else:
+                raise MemrayCommandError(
+                    f"No such file or directory: {name}", exit_code=1
+                )
+        return captures
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        if args.jobs < 1:
+            parser.error("--jobs must be at least 1")
+        if args.num_largest < 0:
+            parser.error("--num-largest can't be negative")
+
+        captures = self.find_captures(args.paths, args.pattern)
+        if not captures:
+            raise MemrayCommandError("No capture files found", exit_code=1)
+
+        output = open(args.output, "w") if args.output is not None else sys.stdout
+        failed = 0
+        try:
+            with ProcessPoolExecutor(
+                max_workers=min(args.jobs, len(captures)), initializer=_init_worker
+            ) as executor:
+                # One JSON object per line, in the order of the files, each
+                # written as soon as it and all the ones before it are done.
+                for summary in executor.map(
+                    summarize_capture,
+                    map(os.fspath, captures),
+                    itertools.repeat(args.num_largest),
+                    itertools.repeat(args.spill_directory),
+                ):
+                    failed += "error" in summary
+                    print(json.dumps(summary), file=output, flush=True)
+        finally:
+            if output is not sys.stdout:
+                output.close()
+
+        if args.output is not None:
+            print(f"Wrote the summaries of {len(captures)} captures to {args.output}")
+        if failed:
+            raise MemrayCommandError(
+                f"Failed to analyze {failed} of {len(captures)} captures", exit_code=1
+            )
@@ -0,0 +1,53 @@
+import argparse
+import os
+from pathlib import Path
+
+from memray import FileReader
+from memray._errors import MemrayCommandError
+from memray.commands.common import valid_positive_int
+from memray.reporters.churn import ChurnReporter
+
+
+class ChurnCommand:
+    """Rank the locations that allocate the most short-lived memory"""
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument("results", help="Results of the tracker run")
+
+        parser.add_argument(
+            "-n",
+            "--num-largest",
+            help="Displays the top 'n' locations by allocation rate. Default is 10",
+            type=valid_positive_int,
+            default=10,
+        )
+        parser.add_argument(
+            "--split-threads",
+            help="Show the locations of each thread separately",
+            action="store_true",
+            default=False,
+        )
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        result_path = Path(args.results)
+        if not result_path.exists() or not result_path.is_file():
+            raise MemrayCommandError(f"No such file: {args.results}", exit_code=1)
+        reader = FileReader(os.fspath(args.results))
+        try:
+            records = list(
+                reader.get_allocation_lifetime_records(
+                    merge_threads=not args.split_threads
+                )
+            )
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to parse allocation records in {result_path}\nReason: {e}",
+                exit_code=1,
+            )
+
+        metadata = reader.metadata
+        duration = (metadata.end_time - metadata.start_time).total_seconds()
+        reporter = ChurnReporter(
+            records, duration=duration, num_largest=args.num_largest
+        )
+        reporter.render()
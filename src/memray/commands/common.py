@@ -1,10 +1,17 @@
 import argparse
+import glob
 import os
 import pathlib
+import re
+from datetime import timedelta
 from pathlib import Path
+from typing import Any
+from typing import Dict
 from typing import Iterable
+from typing import List
 from typing import Optional
 from typing import Tuple
+from typing import Union
 
 try:
     from typing import Protocol
@@ -29,6 +36,95 @@ class ReporterFactory(Protocol):
         ...
 
 
+SnapshotPoint = Union[int, timedelta]
+
+_DURATION_PART = re.compile(r"(\d+(?:\.\d+)?)(ms|h|m|s)")
+_DURATION_UNITS = {
+    "h": timedelta(hours=1),
+    "m": timedelta(minutes=1),
+    "s": timedelta(seconds=1),
+    "ms": timedelta(milliseconds=1),
+}
+
+
+def parse_snapshot_point(value: str) -> SnapshotPoint:
+    """Parse the argument of ``--at``.
+
+    A plain integer is a number of allocation records, and a duration like
+    ``90s``, ``1.5m`` or ``1h2m3s`` is the time since the tracking started.
+    """
+    if value.isdigit():
+        return int(value)
+    parts = _DURATION_PART.findall(value)
+    if not parts or "".join(number + unit for number, unit in parts) != value:
+        raise argparse.ArgumentTypeError(
+            f"expected a number of allocation records or a duration like 37m, "
+            f"90s or 1h2m3s, not {value!r}"
+        )
+    return sum(
+        (float(number) * _DURATION_UNITS[unit] for number, unit in parts),
+        timedelta(),
+    )
+
+
+def describe_snapshot_point(snapshot_at: SnapshotPoint) -> str:
+    if isinstance(snapshot_at, timedelta):
+        return f"{snapshot_at.total_seconds():g} seconds after tracking started"
+    return f"after {snapshot_at} allocation records"
+
+
+def find_forked_captures(result_path: Path) -> List[Path]:
+    """Find the captures of the processes forked by the one that wrote a capture.
+
+    With ``--follow-fork``, every forked process writes its capture next to
+    the one of the tracked process, with its pid appended to the file name.
+    """
+    prefix = result_path.name + "."
+    captures = [
+        path
+        for path in result_path.parent.glob(glob.escape(prefix) + "*")
+        if path.name[len(prefix) :].isdigit() and path.is_file()
+    ]
+    return sorted(captures, key=lambda path: int(path.name[len(prefix) :]))
+
+
+def valid_positive_int(value: str) -> int:
+    """Parse an argument that must be a positive integer."""
+    try:
+        ivalue = int(value)
+        if ivalue <= 0:
+            raise ValueError
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"{value} is an invalid positive int value")
+    return ivalue
+
+
+def add_at_argument(parser: argparse._ActionsContainer) -> None:
+    """Add ``--at``, to a parser or to a group of options that exclude it."""
+    parser.add_argument(
+        "--at",
+        help="Show the memory in use at a point of the tracking, given as a "
+        "duration since tracking started (like 37m, 90s or 1h2m3s) or as a "
+        "number of allocation records, instead of peak memory usage",
+        metavar="TIME_OR_INDEX",
+        type=parse_snapshot_point,
+        dest="snapshot_at",
+        default=None,
+    )
+
+
+def add_spill_directory_argument(parser: argparse.ArgumentParser) -> None:
+    parser.add_argument(
+        "--spill-dir",
+        help="Keep the allocations that are alive while the capture is read in "
+        "temporary files in this directory, instead of in memory, to analyze "
+        "captures whose snapshots don't fit in memory",
+        metavar="DIRECTORY",
+        dest="spill_directory",
+        default=None,
+    )
+
+
 class HighWatermarkCommand:
     def __init__(
         self,
@@ -71,10 +167,20 @@ class HighWatermarkCommand:
         output_file: Path,
         show_memory_leaks: bool,
         merge_threads: Optional[bool] = None,
+        snapshot_at: Optional[SnapshotPoint] = None,
+        spill_directory: Optional[str] = None,
     ) -> None:
         try:
-            reader = FileReader(os.fspath(result_path))
-            if show_memory_leaks:
+            reader_kwargs: Dict[str, Any] = {}
+            if spill_directory is not None:
+                reader_kwargs["spill_directory"] = spill_directory
+            reader = FileReader(os.fspath(result_path), **reader_kwargs)
+            if snapshot_at is not None:
+                snapshot = reader.get_snapshot_at(
+                    snapshot_at,
+                    merge_threads=merge_threads if merge_threads is not None else True,
+                )
+            elif show_memory_leaks:
                 snapshot = reader.get_leaked_allocation_records(
                     merge_threads=merge_threads if merge_threads is not None else True
                 )
@@ -95,9 +201,11 @@ class HighWatermarkCommand:
             )
 
         with open(os.fspath(output_file.expanduser()), "w") as f:
-            kwargs = {}
+            kwargs: Dict[str, Any] = {}
             if merge_threads is not None:
                 kwargs["merge_threads"] = merge_threads
+            if snapshot_at is not None:
+                kwargs["snapshot_at"] = describe_snapshot_point(snapshot_at)
             reporter.render(
                 outfile=f,
                 metadata=reader.metadata,
@@ -111,9 +219,13 @@ class HighWatermarkCommand:
             results=args.results,
             overwrite=args.force,
         )
-        kwargs = {}
+        kwargs: Dict[str, Any] = {}
         if hasattr(args, "split_threads"):
             kwargs["merge_threads"] = not args.split_threads
+        if getattr(args, "snapshot_at", None) is not None:
+            kwargs["snapshot_at"] = args.snapshot_at
+        if getattr(args, "spill_directory", None) is not None:
+            kwargs["spill_directory"] = args.spill_directory
         self.write_report(result_path, output_file, args.show_memory_leaks, **kwargs)
 
         print(f"Wrote {output_file}")
@@ -0,0 +1,105 @@
+import argparse
+import os
+from pathlib import Path
+from typing import cast
+
+from memray import FileReader
+from memray import compute_snapshot_diff
+from memray._errors import MemrayCommandError
+from memray._memray import size_fmt
+
+from ..reporters.flamegraph import DiffFlameGraphReporter
+from .common import HighWatermarkCommand
+from .common import ReporterFactory
+
+
+class DiffCommand(HighWatermarkCommand):
+    """Generate an HTML flame graph of the memory usage differences between two runs"""
+
+    def __init__(self) -> None:
+        super().__init__(
+            reporter_factory=cast(
+                ReporterFactory, DiffFlameGraphReporter.from_snapshot
+            ),
+            reporter_name="diff",
+        )
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument(
+            "-o",
+            "--output",
+            help="Output file name",
+            default=None,
+        )
+        parser.add_argument(
+            "-f",
+            "--force",
+            help="If the output file already exists, overwrite it",
+            action="store_true",
+            default=False,
+        )
+        parser.add_argument(
+            "--leaks",
+            help="Compare memory leaks, instead of peak memory usage",
+            action="store_true",
+            dest="show_memory_leaks",
+            default=False,
+        )
+        parser.add_argument("baseline", help="Results of the baseline tracker run")
+        parser.add_argument("results", help="Results of the tracker run to compare")
+
+    def write_diff_report(
+        self,
+        baseline_path: Path,
+        result_path: Path,
+        output_file: Path,
+        show_memory_leaks: bool,
+    ) -> str:
+        try:
+            baseline = FileReader(os.fspath(baseline_path))
+            reader = FileReader(os.fspath(result_path))
+            records = compute_snapshot_diff(baseline, reader, leaks=show_memory_leaks)
+            reporter = DiffFlameGraphReporter.from_diff_records(
+                records,
+                memory_records=tuple(reader.get_memory_records()),
+            )
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to parse allocation records in {baseline_path} "
+                f"or {result_path}\nReason: {e}",
+                exit_code=1,
+            )
+
+        with open(os.fspath(output_file.expanduser()), "w") as f:
+            reporter.render(
+                outfile=f,
+                metadata=reader.metadata,
+                show_memory_leaks=show_memory_leaks,
+                merge_threads=True,
+            )
+
+        size_before = sum(record.size_before for record in records)
+        size_after = sum(record.size_after for record in records)
+        change = size_after - size_before
+        sign = "+" if change >= 0 else "-"
+        return (
+            f"{size_fmt(size_before).strip()} -> {size_fmt(size_after).strip()} "
+            f"({sign}{size_fmt(abs(change)).strip()})"
+        )
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        baseline_path = Path(args.baseline)
+        if not baseline_path.exists() or not baseline_path.is_file():
+            raise MemrayCommandError(f"No such file: {args.baseline}", exit_code=1)
+        result_path, output_file = self.validate_filenames(
+            output=args.output,
+            results=args.results,
+            overwrite=args.force,
+        )
+        summary = self.write_diff_report(
+            baseline_path, result_path, output_file, args.show_memory_leaks
+        )
+
+        kind = "Leaked memory" if args.show_memory_leaks else "Peak memory"
+        print(f"{kind}: {summary}")
+        print(f"Wrote {output_file}")
@@ -1,9 +1,20 @@
 import argparse
+import os
+from pathlib import Path
+from typing import List
 from typing import cast
 
+from memray import FileReader
+from memray import MultiFileReader
+from memray._errors import MemrayCommandError
+
 from ..reporters.flamegraph import FlameGraphReporter
+from ..reporters.flamegraph import TemporalFlameGraphReporter
 from .common import HighWatermarkCommand
 from .common import ReporterFactory
+from .common import add_at_argument
+from .common import add_spill_directory_argument
+from .common import find_forked_captures
 
 
 class FlamegraphCommand(HighWatermarkCommand):
@@ -29,17 +40,153 @@ class FlamegraphCommand(HighWatermarkCommand):
             action="store_true",
             default=False,
         )
-        parser.add_argument(
+        snapshot_group = parser.add_mutually_exclusive_group()
+        snapshot_group.add_argument(
             "--leaks",
             help="Show memory leaks, instead of peak memory usage",
             action="store_true",
             dest="show_memory_leaks",
             default=False,
         )
+        add_at_argument(snapshot_group)
+        snapshot_group.add_argument(
+            "--temporal",
+            help="Show the memory usage at any point in time, picked with a "
+            "slider in the report, instead of peak memory usage",
+            action="store_true",
+            default=False,
+        )
         parser.add_argument(
             "--split-threads",
             help="Do not merge allocations across threads",
             action="store_true",
             default=False,
         )
+        parser.add_argument(
+            "--follow-fork",
+            help="Also read the results of the processes forked by the tracked "
+            "one, as written by 'memray run --follow-fork', and show the memory "
+            "used by all of them together",
+            action="store_true",
+            default=False,
+        )
+        parser.add_argument(
+            "--split-processes",
+            help="With --follow-fork, do not merge allocations across processes",
+            action="store_true",
+            default=False,
+        )
+        add_spill_directory_argument(parser)
         parser.add_argument("results", help="Results of the tracker run")
+
+    def write_temporal_report(
+        self, result_path: Path, output_file: Path, merge_threads: bool
+    ) -> None:
+        try:
+            reader = FileReader(os.fspath(result_path))
+            reporter = TemporalFlameGraphReporter.from_temporal_records(
+                reader.get_temporal_allocation_records(merge_threads=merge_threads),
+                memory_records=tuple(reader.get_memory_records()),
+                native_traces=reader.metadata.has_native_traces,
+            )
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to parse allocation records in {result_path}\nReason: {e}",
+                exit_code=1,
+            )
+
+        with open(os.fspath(output_file.expanduser()), "w") as f:
+            reporter.render(
+                outfile=f,
+                metadata=reader.metadata,
+                show_memory_leaks=False,
+                merge_threads=merge_threads,
+            )
+
+    def write_processes_report(
+        self,
+        result_paths: List[Path],
+        output_file: Path,
+        show_memory_leaks: bool,
+        merge_processes: bool,
+    ) -> None:
+        try:
+            reader = MultiFileReader([os.fspath(path) for path in result_paths])
+            if show_memory_leaks:
+                snapshot = reader.get_leaked_allocation_records(
+                    merge_processes=merge_processes
+                )
+            else:
+                snapshot = reader.get_high_watermark_allocation_records(
+                    merge_processes=merge_processes
+                )
+            reporter = FlameGraphReporter.from_process_records(
+                snapshot,
+                memory_records=tuple(reader.get_memory_records()),
+            )
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to parse allocation records in {result_paths[0]} "
+                f"or in the results of its forked processes\nReason: {e}",
+                exit_code=1,
+            )
+
+        with open(os.fspath(output_file.expanduser()), "w") as f:
+            reporter.render(
+                outfile=f,
+                metadata=reader.metadata,
+                show_memory_leaks=show_memory_leaks,
+                merge_threads=merge_processes,
+            )
+
+    def run_following_forks(
+        self, args: argparse.Namespace, parser: argparse.ArgumentParser
+    ) -> None:
+        if args.temporal or args.snapshot_at is not None:
+            parser.error("--follow-fork can't be used with --temporal or --at")
+        if args.split_threads:
+            parser.error("--follow-fork can't be used with --split-threads")
+        if args.spill_directory is not None:
+            parser.error("--follow-fork can't be used with --spill-dir")
+
+        # Don't overwrite the flame graph of the tracked process alone.
+        self.reporter_name = "processes-flamegraph"
+        result_path, output_file = self.validate_filenames(
+            output=args.output,
+            results=args.results,
+            overwrite=args.force,
+        )
+        result_paths = [result_path, *find_forked_captures(result_path)]
+        self.write_processes_report(
+            result_paths,
+            output_file,
+            args.show_memory_leaks,
+            merge_processes=not args.split_processes,
+        )
+        print(f"Read the results of {len(result_paths)} processes")
+        print(f"Wrote {output_file}")
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        if args.follow_fork:
+            self.run_following_forks(args, parser)
+            return
+        if args.split_processes:
+            parser.error("--split-processes can only be used with --follow-fork")
+        if args.temporal and args.spill_directory is not None:
+            parser.error("--spill-dir can't be used with --temporal")
+
+        if not args.temporal:
+            super().run(args, parser)
+            return
+
+        # Don't overwrite the regular flame graph of the same capture.
+        self.reporter_name = "temporal-flamegraph"
+        result_path, output_file = self.validate_filenames(
+            output=args.output,
+            results=args.results,
+            overwrite=args.force,
+        )
+        self.write_temporal_report(
+            result_path, output_file, merge_threads=not args.split_threads
+        )
+        print(f"Wrote {output_file}")
@@ -0,0 +1,92 @@
+import argparse
+import os
+from pathlib import Path
+
+from memray import FileReader
+from memray._errors import MemrayCommandError
+from memray.commands.common import valid_positive_int
+from memray.reporters.fragmentation import FragmentationReporter
+
+
+def _valid_fraction(value: str) -> float:
+    try:
+        fvalue = float(value)
+        if not 0 < fvalue <= 1:
+            raise ValueError
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"{value} is not between 0 and 1")
+    return fvalue
+
+
+class FragmentationCommand:
+    """Show how the heap occupies memory pages and who keeps sparse pages alive"""
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument("results", help="Results of the tracker run")
+        parser.add_argument(
+            "--leaks",
+            help="Find the allocations on sparse pages at the end of the "
+            "capture, instead of at the peak memory usage",
+            action="store_true",
+            default=False,
+        )
+        parser.add_argument(
+            "--page-size",
+            help="Size of the memory pages of the tracked process. Default is 4096",
+            type=valid_positive_int,
+            default=4096,
+        )
+        parser.add_argument(
+            "--sparse-threshold",
+            help="Pages that live allocations use less than this fraction of "
+            "are sparse. Default is 0.5",
+            type=_valid_fraction,
+            default=0.5,
+        )
+        parser.add_argument(
+            "-n",
+            "--num-largest",
+            help="Displays the top 'n' locations keeping sparse pages occupied. "
+            "Default is 5",
+            type=valid_positive_int,
+            default=5,
+        )
+        parser.add_argument(
+            "--samples",
+            help="Number of points in time to display. Default is 10",
+            type=valid_positive_int,
+            default=10,
+        )
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        result_path = Path(args.results)
+        if not result_path.exists() or not result_path.is_file():
+            raise MemrayCommandError(f"No such file: {args.results}", exit_code=1)
+        reader = FileReader(os.fspath(args.results))
+        try:
+            occupancy_records = list(
+                reader.get_page_occupancy_records(
+                    page_size=args.page_size, sparse_threshold=args.sparse_threshold
+                )
+            )
+            sparse_page_allocations = list(
+                reader.get_sparse_page_allocation_records(
+                    leaks=args.leaks,
+                    page_size=args.page_size,
+                    sparse_threshold=args.sparse_threshold,
+                )
+            )
+        except (OSError, ValueError) as e:
+            raise MemrayCommandError(
+                f"Failed to analyze the pages used in {result_path}\nReason: {e}",
+                exit_code=1,
+            )
+
+        reporter = FragmentationReporter(
+            occupancy_records,
+            sparse_page_allocations,
+            page_size=args.page_size,
+            num_largest=args.num_largest,
+            num_samples=args.samples,
+        )
+        reporter.render()
@@ -0,0 +1,60 @@
+import argparse
+import json
+
+from memray._errors import MemrayCommandError
+from memray._memray import replay_allocations
+from memray._memray import size_fmt
+
+
+class ReplayCommand:
+    """Replay the allocations of a capture file against the current allocator"""
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument("results", help="Results of the tracker run")
+        parser.add_argument(
+            "--preserve-order",
+            help="Make every operation wait for the previous one in the capture, "
+            "even if a different thread made it",
+            action="store_true",
+            default=False,
+        )
+        parser.add_argument(
+            "--json",
+            help="Print the results as JSON",
+            action="store_true",
+            default=False,
+        )
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        try:
+            stats = replay_allocations(args.results, preserve_order=args.preserve_order)
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to replay allocation records in {args.results}\n"
+                f"Reason: {e}",
+                exit_code=1,
+            )
+
+        # Memory that the process holds but isn't being used by the live
+        # allocations is lost to fragmentation or kept cached by the allocator.
+        final_rss = stats["final_rss"]
+        stats["fragmentation"] = (
+            max(0.0, 1 - stats["final_live_bytes"] / final_rss) if final_rss else 0.0
+        )
+
+        if args.json:
+            print(json.dumps(stats, indent=2))
+            return
+
+        print(
+            f"Replayed {stats['operations']} operations "
+            f"in {stats['threads']} threads"
+        )
+        print(f"  Time: {stats['seconds']:.3f}s")
+        print(f"  Skipped records: {stats['skipped_records']}")
+        print(f"  Failed allocations: {stats['failed_allocations']}")
+        print(f"  Peak live memory: {size_fmt(stats['peak_live_bytes'])}")
+        print(f"  Peak RSS growth: {size_fmt(stats['peak_rss'])}")
+        print(f"  Live memory at the end: {size_fmt(stats['final_live_bytes'])}")
+        print(f"  RSS growth at the end: {size_fmt(final_rss)}")
+        print(f"  Fragmentation at the end: {stats['fragmentation']:.1%}")
@@ -0,0 +1,155 @@
+import argparse
+import os
+from pathlib import Path
+from typing import Optional
+
+from memray import FileReader
+from memray._errors import MemrayCommandError
+
+from .common import SnapshotPoint
+from .common import parse_snapshot_point
+
+
+class _RewriteCommand:
+    """Base class of the commands that write a new capture file from another one"""
+
+    name: str
+
+    def prepare_output_arguments(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument(
+            "-o",
+            "--output",
+            help="Output file name",
+            default=None,
+        )
+        parser.add_argument(
+            "-f",
+            "--force",
+            help="If the output file already exists, overwrite it",
+            action="store_true",
+            default=False,
+        )
+        parser.add_argument(
+            "--no-compress",
+            help="Do not compress the resulting file using lz4",
+            dest="compress",
+            action="store_false",
+            default=True,
+        )
+        parser.add_argument("results", help="Results of the tracker run")
+
+    def validate_filenames(self, args: argparse.Namespace) -> Path:
+        result_path = Path(args.results)
+        if not result_path.exists() or not result_path.is_file():
+            raise MemrayCommandError(f"No such file: {args.results}", exit_code=1)
+
+        if args.output is not None:
+            output_file = Path(args.output)
+        else:
+            name = result_path.name
+            if name.startswith("memray-"):
+                name = name[len("memray-") :]
+            output_file = result_path.parent / f"memray-{self.name}-{name}"
+        if not args.force and output_file.exists():
+            raise MemrayCommandError(
+                f"File already exists, will not overwrite: {output_file}",
+                exit_code=1,
+            )
+        return output_file
+
+    def open_reader(self, args: argparse.Namespace) -> FileReader:
+        try:
+            return FileReader(os.fspath(args.results))
+        except OSError as e:
+            raise MemrayCommandError(
+                f"Failed to parse allocation records in {args.results}\nReason: {e}",
+                exit_code=1,
+            )
+
+
+class SliceCommand(_RewriteCommand):
+    """Extract the records between two points of a capture into a new capture file"""
+
+    name = "slice"
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument(
+            "--start",
+            help="Where the slice starts: a number of allocation records or "
+            "a time since the tracking started like 37m, 90s or 1h2m3s",
+            metavar="TIME_OR_INDEX",
+            type=parse_snapshot_point,
+            default=None,
+        )
+        parser.add_argument(
+            "--end",
+            help="Where the slice ends, in the same format as --start",
+            metavar="TIME_OR_INDEX",
+            type=parse_snapshot_point,
+            default=None,
+        )
+        self.prepare_output_arguments(parser)
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        start: Optional[SnapshotPoint] = args.start
+        end: Optional[SnapshotPoint] = args.end
+        if (
+            start is not None
+            and end is not None
+            and type(start) is type(end)
+            and start > end  # type: ignore[operator]
+        ):
+            parser.error("--start must not come after --end")
+
+        output_file = self.validate_filenames(args)
+        reader = self.open_reader(args)
+        try:
+            written = reader.write_slice(
+                os.fspath(output_file),
+                start=start,
+                end=end,
+                overwrite=args.force,
+                compress=args.compress,
+            )
+        except (OSError, ValueError) as e:
+            raise MemrayCommandError(
+                f"Failed to write {output_file}\nReason: {e}", exit_code=1
+            )
+        print(f"Wrote {written} allocation records to {output_file}")
+
+
+class CompactCommand(_RewriteCommand):
+    """Write a smaller copy of a capture file, without its short-lived allocations"""
+
+    name = "compact"
+
+    def prepare_parser(self, parser: argparse.ArgumentParser) -> None:
+        parser.add_argument(
+            "--max-lifetime",
+            help="Drop the allocations that are freed within this many allocation "
+            "records (default: %(default)s)",
+            metavar="RECORDS",
+            type=int,
+            default=1000,
+        )
+        self.prepare_output_arguments(parser)
+
+    def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
+        if args.max_lifetime < 0:
+            parser.error("--max-lifetime can't be negative")
+
+        output_file = self.validate_filenames(args)
+        reader = self.open_reader(args)
+        try:
+            written = reader.write_compacted(
+                os.fspath(output_file),
+                max_lifetime=args.max_lifetime,
+                overwrite=args.force,
+                compress=args.compress,
+            )
+        except (OSError, ValueError) as e:
+            raise MemrayCommandError(
+                f"Failed to write {output_file}\nReason: {e}", exit_code=1
+            )
+        total = reader.metadata.total_allocations
+        print(f"Wrote {written} of {total} allocation records to {output_file}")
@@ -13,6 +13,7 @@ from contextlib import suppress
 from typing import List
 from typing import Optional
 
+from memray import AllocatorType
 from memray import Destination
 from memray import FileDestination
 from memray import SocketDestination
@@ -28,6 +29,30 @@ def _get_free_port() -> int:
         return int(sock.getsockname()[1])
 
 
+_ALLOCATOR_CHOICES = [
+    allocator.name.lower()
+    for allocator in AllocatorType
+    if allocator
+    not in {
+        AllocatorType.FREE,
+        AllocatorType.MUNMAP,
+        AllocatorType.PYMALLOC_FREE,
+        AllocatorType.MADVISE,
+        AllocatorType.POOL_FREE,
+    }
+]
+
+
+def _non_negative_int(value: str) -> int:
+    try:
+        ivalue = int(value)
+        if ivalue < 0:
+            raise ValueError
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"{value} is not a non-negative integer")
+    return ivalue
+
+
 def _run_tracker(
     destination: Destination,
     args: argparse.Namespace,
@@ -41,6 +66,24 @@ def _run_tracker(
             kwargs["follow_fork"] = True
         if trace_python_allocators:
             kwargs["trace_python_allocators"] = True
+        if args.filter_min_size:
+            kwargs["min_allocation_size"] = args.filter_min_size
+        if args.filter_allocators:
+            kwargs["allocators"] = [
+                AllocatorType[name.upper()] for name in args.filter_allocators
+            ]
+        if args.filter_threads:
+            kwargs["thread_names"] = args.filter_threads
+        if args.max_python_stack_depth:
+            kwargs["max_python_stack_depth"] = args.max_python_stack_depth
+        if args.exclude_modules:
+            kwargs["excluded_modules"] = args.exclude_modules
+        if args.max_native_stack_depth:
+            kwargs["max_native_stack_depth"] = args.max_native_stack_depth
+        if args.native_stop_at_python:
+            kwargs["native_stop_at_python"] = True
+        if args.timestamps:
+            kwargs["timestamps"] = True
         tracker = Tracker(destination=destination, native_traces=args.native, **kwargs)
     except OSError as error:
         raise MemrayCommandError(str(error), exit_code=1)
@@ -74,6 +117,14 @@ def _child_process(
     quiet: bool,
     script: str,
     script_args: List[str],
+    filter_min_size: int = 0,
+    filter_allocators: Optional[List[str]] = None,
+    filter_threads: Optional[List[str]] = None,
+    max_python_stack_depth: int = 0,
+    exclude_modules: Optional[List[str]] = None,
+    max_native_stack_depth: int = 0,
+    native_stop_at_python: bool = False,
+    timestamps: bool = False,
 ) -> None:
     args = argparse.Namespace(
         native=native,
@@ -82,6 +133,14 @@ def _child_process(
         quiet=quiet,
         script=script,
         script_args=script_args,
+        filter_min_size=filter_min_size,
+        filter_allocators=filter_allocators,
+        filter_threads=filter_threads,
+        max_python_stack_depth=max_python_stack_depth,
+        exclude_modules=exclude_modules,
+        max_native_stack_depth=max_native_stack_depth,
+        native_stop_at_python=native_stop_at_python,
+        timestamps=timestamps,
     )
     _run_tracker(destination=SocketDestination(server_port=port), args=args)
 
@@ -97,6 +156,18 @@ def _run_child_process_and_attach(args: argparse.Namespace) -> None:
         f"{port},{args.native},{args.run_as_module},{args.run_as_cmd},{args.quiet},"
         f'"{args.script}",{args.script_args}'
     )
+    filters = (
+        args.filter_min_size,
+        args.filter_allocators,
+        args.filter_threads,
+        args.max_python_stack_depth,
+        args.exclude_modules,
+        args.max_native_stack_depth,
+        args.native_stop_at_python,
+        args.timestamps,
+    )
+    if any(filters):
+        arguments += "".join(f",{value}" for value in filters)
     tracked_app_cmd = [
         sys.executable,
         "-c",
@@ -216,6 +287,21 @@ class RunCommand:
             dest="native",
             default=False,
         )
+        parser.add_argument(
+            "--max-native-stack-depth",
+            help="Only record the innermost N native frames of each stack "
+            "(requires --native)",
+            metavar="N",
+            type=_non_negative_int,
+            default=0,
+        )
+        parser.add_argument(
+            "--native-stop-at-python",
+            help="Stop unwinding native stacks at the first Python frame, and use "
+            "the Python stack for the rest (requires --native)",
+            action="store_true",
+            default=False,
+        )
         parser.add_argument(
             "--follow-fork",
             action="store_true",
@@ -228,6 +314,56 @@ class RunCommand:
             help="Record allocations made by the Pymalloc allocator",
             default=False,
         )
+        parser.add_argument(
+            "--timestamps",
+            action="store_true",
+            help="Record when each allocation was made, to within a few milliseconds",
+            default=False,
+        )
+        filter_group = parser.add_argument_group(
+            "capture filters",
+            "Only record some of the allocations or of the frames in their stacks. "
+            "Allocations that are skipped are still counted, so reports can say "
+            "how many they don't show.",
+        )
+        filter_group.add_argument(
+            "--filter-min-size",
+            help="Don't record allocations smaller than this many bytes",
+            metavar="BYTES",
+            type=_non_negative_int,
+            default=0,
+        )
+        filter_group.add_argument(
+            "--filter-allocator",
+            help="Only record allocations made by this allocator "
+            "(can be given multiple times)",
+            action="append",
+            dest="filter_allocators",
+            choices=_ALLOCATOR_CHOICES,
+        )
+        filter_group.add_argument(
+            "--filter-thread",
+            help="Only record allocations made by threads whose name matches "
+            "this shell-style pattern (can be given multiple times)",
+            action="append",
+            dest="filter_threads",
+            metavar="PATTERN",
+        )
+        filter_group.add_argument(
+            "--max-python-stack-depth",
+            help="Only record the outermost N Python frames of each stack",
+            metavar="N",
+            type=_non_negative_int,
+            default=0,
+        )
+        filter_group.add_argument(
+            "--exclude-module",
+            help="Don't record Python frames running code from this module or "
+            "its submodules (can be given multiple times)",
+            action="append",
+            dest="exclude_modules",
+            metavar="MODULE",
+        )
         parser.add_argument(
             "-q",
             "--quiet",
@@ -298,6 +434,10 @@ class RunCommand:
             parser.error("--follow-fork cannot be used with the live TUI")
         if args.run_as_cmd and pathlib.Path(args.script).exists():
             parser.error("remove the option -c to run a file")
+        if (args.max_native_stack_depth or args.native_stop_at_python) and not args.native:
+            parser.error(
+                "--max-native-stack-depth and --native-stop-at-python require --native"
+            )
 
         self.validate_target_file(args)
 
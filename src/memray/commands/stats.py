@@ -4,6 +4,7 @@ from pathlib import Path
 
 from memray import FileReader
 from memray._errors import MemrayCommandError
+from memray.commands.common import valid_positive_int
 from memray.reporters.stats import StatsReporter
 
 
@@ -20,18 +21,6 @@ class StatsCommand:
             action="store_true",
         )
 
-        def valid_positive_int(value: str) -> int:
-            try:
-                ivalue = int(value)
-                if ivalue <= 0:
-                    raise ValueError
-            except ValueError:
-                raise argparse.ArgumentTypeError(
-                    f"{value} is an invalid positive int value"
-                )
-
-            return ivalue
-
         parser.add_argument(
             "-n",
             "--num-largest",
@@ -58,5 +47,7 @@ class StatsCommand:
                 exit_code=1,
             )
 
-        reporter = StatsReporter.from_snapshot(snapshot, args.num_largest)
+        reporter = StatsReporter.from_snapshot(
+            snapshot, args.num_largest, metadata=reader.metadata
+        )
         reporter.render()
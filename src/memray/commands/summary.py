@@ -4,6 +4,8 @@ from pathlib import Path
 
 from memray import FileReader
 from memray._errors import MemrayCommandError
+from memray.commands.common import add_at_argument
+from memray.reporters.stats import describe_dropped_allocations
 from memray.reporters.summary import SummaryReporter
 
 
@@ -26,6 +28,7 @@ class SummaryCommand:
             type=int,
             default=None,
         )
+        add_at_argument(parser)
 
     def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
         max_cols = SummaryReporter.N_COLUMNS
@@ -37,9 +40,14 @@ class SummaryCommand:
             raise MemrayCommandError(f"No such file: {args.results}", exit_code=1)
         reader = FileReader(os.fspath(args.results))
         try:
-            snapshot = iter(
-                reader.get_high_watermark_allocation_records(merge_threads=True)
-            )
+            if args.snapshot_at is not None:
+                snapshot = iter(
+                    reader.get_snapshot_at(args.snapshot_at, merge_threads=True)
+                )
+            else:
+                snapshot = iter(
+                    reader.get_high_watermark_allocation_records(merge_threads=True)
+                )
         except OSError as e:
             raise MemrayCommandError(
                 f"Failed to parse allocation records in {result_path}\nReason: {e}",
@@ -51,3 +59,6 @@ class SummaryCommand:
             native=reader.metadata.has_native_traces,
         )
         reporter.render(sort_column=args.sort_column, max_rows=args.max_rows)
+        dropped = describe_dropped_allocations(reader.metadata)
+        if dropped:
+            print(f"Note: {dropped}")
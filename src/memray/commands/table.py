@@ -4,6 +4,8 @@ from typing import cast
 from ..reporters.table import TableReporter
 from .common import HighWatermarkCommand
 from .common import ReporterFactory
+from .common import add_at_argument
+from .common import add_spill_directory_argument
 
 
 class TableCommand(HighWatermarkCommand):
@@ -29,11 +31,14 @@ class TableCommand(HighWatermarkCommand):
             action="store_true",
             default=False,
         )
-        parser.add_argument(
+        snapshot_group = parser.add_mutually_exclusive_group()
+        snapshot_group.add_argument(
             "--leaks",
             help="Show memory leaks, instead of peak memory usage",
             action="store_true",
             dest="show_memory_leaks",
             default=False,
         )
+        add_at_argument(snapshot_group)
+        add_spill_directory_argument(parser)
         parser.add_argument("results", help="Results of the tracker run")
@@ -7,6 +7,7 @@ from rich import print as rprint
 from memray import FileReader
 from memray._errors import MemrayCommandError
 from memray._memray import size_fmt
+from memray.commands.common import add_at_argument
 from memray.reporters.tree import TreeReporter
 
 
@@ -22,6 +23,7 @@ class TreeCommand:
             type=int,
             default=10,
         )
+        add_at_argument(parser)
 
     def run(self, args: argparse.Namespace, parser: argparse.ArgumentParser) -> None:
         result_path = Path(args.results)
@@ -29,9 +31,14 @@ class TreeCommand:
             raise MemrayCommandError(f"No such file: {args.results}", exit_code=1)
         reader = FileReader(os.fspath(args.results))
         try:
-            snapshot = iter(
-                reader.get_high_watermark_allocation_records(merge_threads=False)
-            )
+            if args.snapshot_at is not None:
+                snapshot = iter(
+                    reader.get_snapshot_at(args.snapshot_at, merge_threads=False)
+                )
+            else:
+                snapshot = iter(
+                    reader.get_high_watermark_allocation_records(merge_threads=False)
+                )
             reporter = TreeReporter.from_snapshot(
                 snapshot,
                 biggest_allocs=args.biggest_allocs,
@@ -0,0 +1,98 @@
+/*
+ * Memray's public C API.
+ *
+ * Extension modules that manage their own memory pools (arenas, slab
+ * allocators, ...) can use this header to report the blocks that they hand
+ * out, so that Memray shows them instead of the big chunks of memory the pools
+ * obtain from the system. Blocks reported through this API appear in reports
+ * with the POOL_ALLOC allocator, and the id of the pool that they came from is
+ * available as the pool_id of the allocation records.
+ *
+ * Call memray_import() once in every source file that uses this API, usually
+ * from the module's initialization function, while holding the GIL. Until it
+ * succeeds, and whenever Memray isn't tracking, the other functions do nothing
+ * but test a flag. The directory containing this header is returned by
+ * memray.get_include().
+ */
+#ifndef MEMRAY_H
+#define MEMRAY_H
+
+#include <Python.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMRAY_C_API_VERSION 1
+#define MEMRAY_C_API_CAPSULE "memray._memray._C_API"
+
+typedef struct
+{
+    /* Version of the API implemented. Newer versions only add fields. */
+    unsigned int version;
+    /* Non-zero while Memray is tracking allocations. */
+    const volatile unsigned char* tracking;
+    void (*track_alloc)(void* ptr, size_t size, unsigned int pool_id);
+    void (*track_free)(void* ptr, unsigned int pool_id);
+} MemrayCAPI;
+
+static const volatile unsigned char memray__not_tracking = 0;
+static const volatile unsigned char* memray__tracking = &memray__not_tracking;
+static const MemrayCAPI* memray__api = NULL;
+
+/*
+ * Load the API from the memray._memray module. Returns 0 on success. On
+ * failure it returns -1 with a Python exception set: if Memray is an optional
+ * dependency, clear the exception and all the other functions stay no-ops.
+ */
+static inline int
+memray_import(void)
+{
+    const MemrayCAPI* api = (const MemrayCAPI*)PyCapsule_Import(MEMRAY_C_API_CAPSULE, 0);
+    if (api == NULL) {
+        return -1;
+    }
+    if (api->version < MEMRAY_C_API_VERSION) {
+        PyErr_Format(
+                PyExc_ImportError,
+                "memray C API version %u is too old, version %d is needed",
+                api->version,
+                MEMRAY_C_API_VERSION);
+        return -1;
+    }
+    memray__api = api;
+    memray__tracking = api->tracking;
+    return 0;
+}
+
+/*
+ * Report that a block of size bytes at ptr was handed out by the pool
+ * identified by pool_id. The ids are only used to tell pools apart, so any
+ * value is valid, as long as each pool uses its own.
+ */
+static inline void
+memray_track_alloc(void* ptr, size_t size, unsigned int pool_id)
+{
+    if (__builtin_expect(*memray__tracking, 0)) {
+        memray__api->track_alloc(ptr, size, pool_id);
+    }
+}
+
+/*
+ * Report that the block at ptr was given back to the pool identified by
+ * pool_id, which must be the same pool that reported its allocation.
+ */
+static inline void
+memray_track_free(void* ptr, unsigned int pool_id)
+{
+    if (__builtin_expect(*memray__tracking, 0)) {
+        memray__api->track_free(ptr, pool_id);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMRAY_H */
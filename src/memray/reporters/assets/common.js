@@ -201,3 +201,173 @@ export function sumAllocations(data) {
 
   return _.reduce(data, sum, initial);
 }
+
+/**
+ * Create the tooltip shown when hovering over a frame of a flame graph.
+ *
+ * @param merge_threads Whether the allocations of all threads were merged.
+ * @returns A d3-tip tooltip.
+ */
+export function getFlamegraphTooltip(merge_threads) {
+  let tip = d3
+    .tip()
+    .attr("class", "d3-flame-graph-tip")
+    .html((d) => {
+      const totalSize = humanFileSize(d.data.value);
+      return makeTooltipString(d.data, totalSize, merge_threads);
+    })
+    .direction((d) => {
+      const midpoint = (d.x1 + d.x0) / 2;
+      // If the midpoint is in a reasonable location, put it below the element.
+      if (0.25 < midpoint && midpoint < 0.75) {
+        return "s";
+      }
+      // We're far from the right
+      if (d.x1 < 0.75) {
+        return "e";
+      }
+      // We're far from the left
+      if (d.x0 > 0.25) {
+        return "w";
+      }
+      // This shouldn't happen reasonably? If it does, just put it above and
+      // we'll deal with it later. :)
+      return "n";
+    });
+  return tip;
+}
+
+function fileExtension(filename) {
+  if (filename === undefined) return filename;
+  return (
+    filename.substring(filename.lastIndexOf(".") + 1, filename.length) ||
+    filename
+  );
+}
+
+function colorByExtension(extension) {
+  if (extension == "py" || extension == "pyx") {
+    return d3.schemePastel1[2];
+  } else if (extension == "c" || extension == "cpp" || extension == "h") {
+    return d3.schemePastel1[5];
+  } else {
+    return d3.schemePastel1[8];
+  }
+}
+
+/**
+ * Color the frames of a flame graph by the language of their source file.
+ */
+export function memrayColorMapper(d, originalColor) {
+  // Highlighted nodes
+  if (d.highlight) {
+    return "orange";
+  }
+  // "builtin" / nodes that we don't want to highlight
+  if (!d.data.name || !d.data.location) {
+    return "#EEE";
+  }
+
+  return colorByExtension(fileExtension(d.data.location[1]));
+}
+
+/**
+ * Find how much memory a location had alive at a snapshot.
+ *
+ * @param intervals The `[begin, end, n_allocations, value]` intervals of the
+ *   location, sorted and not overlapping, each covering the snapshots from
+ *   `begin` up to, but not including, `end`.
+ * @param snapshot Index of the snapshot.
+ * @returns {{n_allocations: number, value: number}}
+ */
+export function usageAtSnapshot(intervals, snapshot) {
+  let low = 0;
+  let high = intervals.length;
+  // Find the first interval that begins after the snapshot.
+  while (low < high) {
+    const middle = (low + high) >> 1;
+    if (intervals[middle][0] <= snapshot) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low > 0 && snapshot < intervals[low - 1][1]) {
+    const [, , n_allocations, value] = intervals[low - 1];
+    return { n_allocations, value };
+  }
+  return { n_allocations: 0, value: 0 };
+}
+
+/**
+ * Compute the value of every node of a frame tree from the usage of the
+ * locations that allocated in each of them.
+ *
+ * @param root Root node. Nodes list the indices of the locations whose
+ *   stacks end in them in their `locations` attribute.
+ * @param usageOf Called with the index of a location, expected to return an
+ *   object with its `n_allocations` and `value`.
+ * @returns {NonNullable<any>} A copy of the tree, without the nodes that
+ *   have no allocations.
+ */
+export function buildSnapshotTree(root, usageOf) {
+  function build(node) {
+    let result = { n_allocations: 0, value: 0 };
+    for (const location of node.locations || []) {
+      const usage = usageOf(location);
+      result.n_allocations += usage.n_allocations;
+      result.value += usage.value;
+    }
+    const children = [];
+    for (const child of node.children) {
+      const built = build(child);
+      if (built.n_allocations > 0 || built.value > 0) {
+        children.push(built);
+        result.n_allocations += built.n_allocations;
+        result.value += built.value;
+      }
+    }
+    result.children = children;
+    return _.defaults(result, node);
+  }
+
+  return build(root);
+}
+
+/**
+ * Describe how the memory of a frame of a differential flame graph changed.
+ *
+ * @param data Node with the `size_before` and `size_after` of the frame, and
+ *   its `n_allocations_before` and `n_allocations` after.
+ * @returns {string}
+ */
+export function makeDiffTooltipString(data) {
+  let location = "unknown location";
+  if (data.location !== undefined) {
+    location = `File ${data.location[1]}, line ${data.location[2]} in ${data.location[0]}`;
+  }
+
+  const delta = data.size_after - data.size_before;
+  const sign = delta > 0 ? "+" : delta < 0 ? "-" : "";
+  const before = `${humanFileSize(data.size_before)} (${data.n_allocations_before})`;
+  const after = `${humanFileSize(data.size_after)} (${data.n_allocations})`;
+  return (
+    `${location}<br>${sign}${humanFileSize(Math.abs(delta))}` +
+    `<br>Before: ${before}<br>After: ${after}`
+  );
+}
+
+/**
+ * Compute how much a frame of a differential flame graph grew or shrank.
+ *
+ * @param data Node with the `size_before` and `size_after` of the frame.
+ * @returns {number} Between -1, when all of its memory went away, and 1,
+ *   when all of it is new, relative to the width of the frame.
+ */
+export function diffRatio(data) {
+  const width = Math.max(data.size_before, data.size_after);
+  if (width === 0) {
+    return 0;
+  }
+  return (data.size_after - data.size_before) / width;
+}
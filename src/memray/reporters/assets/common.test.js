@@ -4,6 +4,10 @@ import {
   filterChildThreads,
   sumAllocations,
   filterUninteresting,
+  usageAtSnapshot,
+  buildSnapshotTree,
+  makeDiffTooltipString,
+  diffRatio,
 } from "./common";
 
 test("handlesSmallValues", () => {
@@ -333,3 +337,128 @@ describe("Filter uninteresting frames", () => {
     expect(copied_data).toStrictEqual(data);
   });
 });
+
+describe("Compute the usage of a location at a snapshot", () => {
+  const intervals = [
+    [0, 2, 1, 10],
+    [2, 5, 3, 30],
+    [7, 9, 2, 20],
+  ];
+
+  test("Snapshots inside of an interval", () => {
+    expect(usageAtSnapshot(intervals, 0)).toStrictEqual({
+      n_allocations: 1,
+      value: 10,
+    });
+    expect(usageAtSnapshot(intervals, 2)).toStrictEqual({
+      n_allocations: 3,
+      value: 30,
+    });
+    expect(usageAtSnapshot(intervals, 8)).toStrictEqual({
+      n_allocations: 2,
+      value: 20,
+    });
+  });
+
+  test("Snapshots outside of every interval", () => {
+    expect(usageAtSnapshot(intervals, 5)).toStrictEqual({
+      n_allocations: 0,
+      value: 0,
+    });
+    expect(usageAtSnapshot(intervals, 9)).toStrictEqual({
+      n_allocations: 0,
+      value: 0,
+    });
+    expect(usageAtSnapshot([], 0)).toStrictEqual({
+      n_allocations: 0,
+      value: 0,
+    });
+  });
+});
+
+describe("Build the frame tree of a snapshot", () => {
+  const data = {
+    name: "<root>",
+    children: [
+      {
+        name: "a",
+        locations: [0],
+        children: [
+          {
+            name: "b",
+            locations: [1],
+            children: [],
+          },
+        ],
+      },
+      {
+        name: "c",
+        locations: [2],
+        children: [],
+      },
+    ],
+  };
+
+  test("Values are summed up to the root", () => {
+    const usage = [
+      { n_allocations: 1, value: 10 },
+      { n_allocations: 2, value: 20 },
+      { n_allocations: 4, value: 40 },
+    ];
+    const result = buildSnapshotTree(data, (location) => usage[location]);
+    expect(result.value).toBe(70);
+    expect(result.n_allocations).toBe(7);
+    expect(result.children[0].value).toBe(30);
+    expect(result.children[0].children[0].value).toBe(20);
+    expect(result.children[1].value).toBe(40);
+  });
+
+  test("Nodes without allocations are removed", () => {
+    const usage = [
+      { n_allocations: 1, value: 10 },
+      { n_allocations: 0, value: 0 },
+      { n_allocations: 0, value: 0 },
+    ];
+    const result = buildSnapshotTree(data, (location) => usage[location]);
+    expect(result.value).toBe(10);
+    expect(result.children.length).toBe(1);
+    expect(result.children[0].name).toBe("a");
+    expect(result.children[0].children).toStrictEqual([]);
+  });
+});
+
+describe("Differential flame graph frames", () => {
+  test("Generate label for a frame that grew", () => {
+    const data = {
+      location: ["foo", "foo.py", "10"],
+      size_before: 1024,
+      n_allocations_before: 1,
+      size_after: 3072,
+      n_allocations: 3,
+    };
+    expect(makeDiffTooltipString(data)).toBe(
+      "File foo.py, line 10 in foo<br>+2.0 KiB<br>Before: 1.0 KiB (1)<br>After: 3.0 KiB (3)"
+    );
+  });
+
+  test("Generate label for a frame that shrank", () => {
+    const data = {
+      location: ["foo", "foo.py", "10"],
+      size_before: 128,
+      n_allocations_before: 2,
+      size_after: 0,
+      n_allocations: 0,
+    };
+    expect(makeDiffTooltipString(data)).toBe(
+      "File foo.py, line 10 in foo<br>-128 B<br>Before: 128 B (2)<br>After: 0 B (0)"
+    );
+  });
+
+  test("Ratio is relative to the width of the frame", () => {
+    expect(diffRatio({ size_before: 0, size_after: 10 })).toBe(1);
+    expect(diffRatio({ size_before: 10, size_after: 0 })).toBe(-1);
+    expect(diffRatio({ size_before: 10, size_after: 15 })).toBeCloseTo(1 / 3);
+    expect(diffRatio({ size_before: 10, size_after: 10 })).toBe(0);
+    expect(diffRatio({ size_before: 0, size_after: 0 })).toBe(0);
+  });
+});
@@ -0,0 +1,134 @@
+import {
+  debounced,
+  diffRatio,
+  initMemoryGraph,
+  filterUninteresting,
+  makeDiffTooltipString,
+  resizeMemoryGraph,
+} from "./common";
+window.resizeMemoryGraph = resizeMemoryGraph;
+
+let hideUninterestingFrames = true;
+
+// For window resizing
+function getChartWidth() {
+  // Figure out the width from window size
+  const rem = parseFloat(getComputedStyle(document.documentElement).fontSize);
+  return window.innerWidth - 2 * rem;
+}
+
+// Frames that grew are red and frames that shrank are blue, darker the more
+// of their memory changed.
+function diffColorMapper(d, originalColor) {
+  // Highlighted nodes
+  if (d.highlight) {
+    return "orange";
+  }
+  const ratio = diffRatio(d.data);
+  if (ratio === 0) {
+    return "#EEE";
+  }
+  const intensity = 0.15 + 0.6 * Math.abs(ratio);
+  return ratio > 0
+    ? d3.interpolateReds(intensity)
+    : d3.interpolateBlues(intensity);
+}
+
+function getDiffTooltip() {
+  return d3
+    .tip()
+    .attr("class", "d3-flame-graph-tip")
+    .html((d) => makeDiffTooltipString(d.data))
+    .direction((d) => {
+      const midpoint = (d.x1 + d.x0) / 2;
+      if (0.25 < midpoint && midpoint < 0.75) {
+        return "s";
+      }
+      if (d.x1 < 0.75) {
+        return "e";
+      }
+      if (d.x0 > 0.25) {
+        return "w";
+      }
+      return "n";
+    });
+}
+
+function redraw() {
+  drawChart(hideUninterestingFrames ? filterUninteresting(data) : data);
+  // Merge 0 additional elements, triggering a redraw
+  chart.merge([]);
+}
+
+function onInvert() {
+  chart.inverted(!chart.inverted());
+  chart.resetZoom();
+}
+
+function onResetZoom() {
+  chart.resetZoom();
+}
+
+function onFilterUninteresting() {
+  hideUninterestingFrames = this.checked;
+  redraw();
+}
+
+function drawChart(chart_data) {
+  chart = flamegraph()
+    .width(getChartWidth())
+    // smooth transitions
+    .transitionDuration(250)
+    .transitionEase(d3.easeCubic)
+    // invert the graph by default
+    .inverted(true)
+    // make each row a little taller
+    .cellHeight(20)
+    // don't show elements that are less than 5px wide
+    .minFrameSize(2)
+    // set our custom handlers
+    .setColorMapper(diffColorMapper)
+    .tooltip(getDiffTooltip());
+
+  // Render the chart
+  d3.select("#chart").datum(chart_data).call(chart);
+}
+
+function onResize() {
+  const width = getChartWidth();
+  // Update element widths
+  const svg = document.getElementById("chart").children[0];
+  svg.setAttribute("width", width);
+  chart.width(width);
+  redraw();
+}
+
+// Main entrypoint
+function main() {
+  initMemoryGraph(memory_records);
+
+  redraw();
+
+  // Setup event handlers
+  document.getElementById("invertButton").onclick = onInvert;
+  document.getElementById("resetZoomButton").onclick = onResetZoom;
+  document.getElementById("hideUninteresting").onclick = onFilterUninteresting;
+
+  document.onkeyup = (event) => {
+    if (event.code == "Escape") {
+      onResetZoom();
+    }
+  };
+  document.getElementById("searchTerm").addEventListener("input", () => {
+    const termElement = document.getElementById("searchTerm");
+    chart.search(termElement.value);
+  });
+
+  window.addEventListener("resize", debounced(onResize));
+
+  // Enable tooltips
+  $('[data-toggle="tooltip"]').tooltip();
+}
+
+var chart = null;
+document.addEventListener("DOMContentLoaded", main);
@@ -3,8 +3,8 @@ import {
   initMemoryGraph,
   filterChildThreads,
   filterUninteresting,
-  humanFileSize,
-  makeTooltipString,
+  getFlamegraphTooltip,
+  memrayColorMapper,
   sumAllocations,
   resizeMemoryGraph,
 } from "./common";
@@ -12,7 +12,6 @@ window.resizeMemoryGraph = resizeMemoryGraph;
 
 const FILTER_UNINTERESTING = "filter_uninteresting";
 const FILTER_THREAD = "filter_thread";
-let filteredChart = new FilteredChart();
 
 // For navigable #[integer] fragments
 function getCurrentId() {
@@ -81,6 +80,7 @@ class FilteredChart {
     chart.merge([]);
   }
 }
+let filteredChart = new FilteredChart();
 
 function onResize() {
   const width = getChartWidth();
@@ -127,37 +127,6 @@ function onFilterUninteresting() {
   filteredChart.drawChart(data);
 }
 
-// For determining values for the graph
-function getTooltip() {
-  let tip = d3
-    .tip()
-    .attr("class", "d3-flame-graph-tip")
-    .html((d) => {
-      const totalSize = humanFileSize(d.data.value);
-      return makeTooltipString(d.data, totalSize, merge_threads);
-    })
-    .direction((d) => {
-      const midpoint = (d.x1 + d.x0) / 2;
-      // If the midpoint is in a reasonable location, put it below the element.
-      if (0.25 < midpoint && midpoint < 0.75) {
-        return "s";
-      }
-      // We're far from the right
-      if (d.x1 < 0.75) {
-        return "e";
-      }
-      // We're far from the left
-      if (d.x0 > 0.25) {
-        return "w";
-      }
-      // This shouldn't happen reasonably? If it does, just put it above and
-      // we'll deal with it later. :)
-      return "n";
-    });
-  return tip;
-}
-
-// Our custom color mapping logic
 function decimalHash(string) {
   let sum = 0;
   for (let i = 0; i < string.length; i++)
@@ -165,37 +134,6 @@ function decimalHash(string) {
   return sum % 1;
 }
 
-function fileExtension(filename) {
-  if (filename === undefined) return filename;
-  return (
-    filename.substring(filename.lastIndexOf(".") + 1, filename.length) ||
-    filename
-  );
-}
-
-function colorByExtension(extension) {
-  if (extension == "py" || extension == "pyx") {
-    return d3.schemePastel1[2];
-  } else if (extension == "c" || extension == "cpp" || extension == "h") {
-    return d3.schemePastel1[5];
-  } else {
-    return d3.schemePastel1[8];
-  }
-}
-
-function memrayColorMapper(d, originalColor) {
-  // Highlighted nodes
-  if (d.highlight) {
-    return "orange";
-  }
-  // "builtin" / nodes that we don't want to highlight
-  if (!d.data.name || !d.data.location) {
-    return "#EEE";
-  }
-
-  return colorByExtension(fileExtension(d.data.location[1]));
-}
-
 // Show the 'Threads' dropdown if we have thread data, and populate it
 function initThreadsDropdown(data, merge_threads) {
   if (merge_threads === true) {
@@ -233,7 +171,7 @@ function drawChart(chart_data) {
     // set our custom handlers
     .setColorMapper(memrayColorMapper)
     .onClick(onClick)
-    .tooltip(getTooltip());
+    .tooltip(getFlamegraphTooltip(merge_threads));
 
   // Render the chart
   d3.select("#chart").datum(chart_data).call(chart);
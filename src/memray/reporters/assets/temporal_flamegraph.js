@@ -0,0 +1,204 @@
+import {
+  buildSnapshotTree,
+  debounced,
+  initMemoryGraph,
+  filterChildThreads,
+  filterUninteresting,
+  getFlamegraphTooltip,
+  memrayColorMapper,
+  sumAllocations,
+  resizeMemoryGraph,
+  usageAtSnapshot,
+} from "./common";
+window.resizeMemoryGraph = resizeMemoryGraph;
+
+let hideUninterestingFrames = true;
+let selectedThread = null;
+
+// For window resizing
+function getChartWidth() {
+  // Figure out the width from window size
+  const rem = parseFloat(getComputedStyle(document.documentElement).fontSize);
+  return window.innerWidth - 2 * rem;
+}
+
+// Snapshot `i` is taken at the `i`-th memory record, and the last one at the
+// end of the capture.
+function snapshotLabel(index) {
+  if (index >= memory_records.length) {
+    return "end of capture";
+  }
+  const elapsed = (memory_records[index][0] - memory_records[0][0]) / 1000;
+  return `${elapsed.toFixed(3)}s`;
+}
+
+function getSelectedSnapshots() {
+  return {
+    start: parseInt(document.getElementById("startSnapshot").value, 10),
+    end: parseInt(document.getElementById("endSnapshot").value, 10),
+    showGrowth: document.getElementById("showGrowth").checked,
+  };
+}
+
+// Rebuild the frame tree for the selected snapshot, or for the memory that
+// each location gained between the two selected snapshots.
+function snapshotData() {
+  const { start, end, showGrowth } = getSelectedSnapshots();
+  let usageOf = (location) => usageAtSnapshot(data.intervals[location], end);
+  if (showGrowth) {
+    usageOf = (location) => {
+      const before = usageAtSnapshot(data.intervals[location], start);
+      const after = usageAtSnapshot(data.intervals[location], end);
+      return {
+        n_allocations: Math.max(0, after.n_allocations - before.n_allocations),
+        value: Math.max(0, after.value - before.value),
+      };
+    };
+  }
+
+  let filtered = buildSnapshotTree(data, usageOf);
+  if (hideUninterestingFrames) {
+    filtered = filterUninteresting(filtered);
+  }
+  if (selectedThread !== null) {
+    filtered = filterChildThreads(filtered, selectedThread);
+    const totalAllocations = sumAllocations(filtered.children);
+    filtered.n_allocations = totalAllocations.n_allocations;
+    filtered.value = totalAllocations.value;
+  }
+  return filtered;
+}
+
+function updateLabels() {
+  const { start, end, showGrowth } = getSelectedSnapshots();
+  document.getElementById("startSnapshot").disabled = !showGrowth;
+  document.getElementById("startSnapshotLabel").textContent = showGrowth
+    ? snapshotLabel(start)
+    : "";
+  document.getElementById("endSnapshotLabel").textContent = snapshotLabel(end);
+}
+
+function redraw() {
+  updateLabels();
+  drawChart(snapshotData());
+  // Merge 0 additional elements, triggering a redraw
+  chart.merge([]);
+}
+
+function onInvert() {
+  chart.inverted(!chart.inverted());
+  chart.resetZoom();
+}
+
+function onResetZoom() {
+  chart.resetZoom();
+}
+
+function onFilterThread() {
+  const thread_id = this.dataset.thread;
+  selectedThread = thread_id === "-0x1" ? null : thread_id;
+  redraw();
+}
+
+function onFilterUninteresting() {
+  hideUninterestingFrames = this.checked;
+  redraw();
+}
+
+// Show the 'Threads' dropdown if we have thread data, and populate it
+function initThreadsDropdown(data, merge_threads) {
+  if (merge_threads === true) {
+    return;
+  }
+  const threads = data.unique_threads;
+  if (!threads || threads.length <= 1) {
+    return;
+  }
+
+  document.getElementById("threadsDropdown").removeAttribute("hidden");
+  const threadsDropdownList = document.getElementById("threadsDropdownList");
+  for (const thread of threads) {
+    let elem = document.createElement("a");
+    elem.className = "dropdown-item";
+    elem.dataset.thread = thread;
+    elem.text = thread;
+    elem.onclick = onFilterThread;
+    threadsDropdownList.appendChild(elem);
+  }
+}
+
+function initSnapshotSliders() {
+  // One snapshot per memory record, plus one at the end of the capture.
+  const lastSnapshot = memory_records.length;
+  for (const id of ["startSnapshot", "endSnapshot"]) {
+    const slider = document.getElementById(id);
+    slider.max = lastSnapshot;
+    slider.addEventListener("input", debounced(redraw));
+  }
+  document.getElementById("startSnapshot").value = 0;
+  document.getElementById("endSnapshot").value = lastSnapshot;
+  document.getElementById("showGrowth").onchange = redraw;
+}
+
+function drawChart(chart_data) {
+  chart = flamegraph()
+    .width(getChartWidth())
+    // smooth transitions
+    .transitionDuration(250)
+    .transitionEase(d3.easeCubic)
+    // invert the graph by default
+    .inverted(true)
+    // make each row a little taller
+    .cellHeight(20)
+    // don't show elements that are less than 5px wide
+    .minFrameSize(2)
+    // set our custom handlers
+    .setColorMapper(memrayColorMapper)
+    .tooltip(getFlamegraphTooltip(merge_threads));
+
+  // Render the chart
+  d3.select("#chart").datum(chart_data).call(chart);
+}
+
+function onResize() {
+  const width = getChartWidth();
+  // Update element widths
+  const svg = document.getElementById("chart").children[0];
+  svg.setAttribute("width", width);
+  chart.width(width);
+  redraw();
+}
+
+// Main entrypoint
+function main() {
+  initMemoryGraph(memory_records);
+  initThreadsDropdown(data, merge_threads);
+  initSnapshotSliders();
+
+  redraw();
+
+  // Setup event handlers
+  document.getElementById("invertButton").onclick = onInvert;
+  document.getElementById("resetZoomButton").onclick = onResetZoom;
+  document.getElementById("resetThreadFilterItem").onclick = onFilterThread;
+  document.getElementById("hideUninteresting").onclick = onFilterUninteresting;
+
+  document.onkeyup = (event) => {
+    if (event.code == "Escape") {
+      onResetZoom();
+    }
+  };
+  document.getElementById("searchTerm").addEventListener("input", () => {
+    const termElement = document.getElementById("searchTerm");
+    chart.search(termElement.value);
+  });
+
+  window.addEventListener("resize", debounced(onResize));
+
+  // Enable tooltips
+  $('[data-toggle-second="tooltip"]').tooltip();
+  $('[data-toggle="tooltip"]').tooltip();
+}
+
+var chart = null;
+document.addEventListener("DOMContentLoaded", main);
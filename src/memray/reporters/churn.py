@@ -0,0 +1,96 @@
+import sys
+from typing import IO
+from typing import Iterable
+from typing import List
+from typing import Optional
+
+from memray._memray import AllocationLifetimeRecord
+from memray._memray import size_fmt
+
+
+def rank_by_churn(
+    records: Iterable[AllocationLifetimeRecord],
+) -> List[AllocationLifetimeRecord]:
+    """Sort the locations by allocation count, then by shortest median lifetime.
+
+    Locations whose allocations were never freed have no lifetime, so they
+    come after those with the same number of allocations that were freed.
+    """
+    return sorted(
+        records,
+        key=lambda record: (
+            -record.allocation.n_allocations,
+            record.n_freed == 0,
+            record.median_lifetime,
+        ),
+    )
+
+
+class ChurnReporter:
+    def __init__(
+        self,
+        data: Iterable[AllocationLifetimeRecord],
+        *,
+        duration: float,
+        num_largest: int,
+    ):
+        self.data = rank_by_churn(data)
+        self.duration = duration
+        self.num_largest = num_largest
+
+    def render(self, *, file: Optional[IO[str]] = None) -> None:
+        if file is None:
+            file = sys.stdout
+
+        print(
+            f"Top {self.num_largest} locations by allocation rate "
+            "(lifetimes are measured in records of the capture):",
+            file=file,
+        )
+        if not self.data:
+            print("\tNo allocations", file=file)
+            return
+
+        row = "\t{:>12} {:>12} {:>7} {:>12} {:>12} {:>12}  {}"
+        print(
+            row.format(
+                "allocs/s",
+                "allocations",
+                "freed",
+                "median life",
+                "p90 life",
+                "total size",
+                "location",
+            ),
+            file=file,
+        )
+        for record in self.data[: self.num_largest]:
+            allocation = record.allocation
+            rate = (
+                f"{allocation.n_allocations / self.duration:.1f}"
+                if self.duration > 0
+                else "-"
+            )
+            freed = record.n_freed / allocation.n_allocations
+            lifetimes = (
+                (str(record.median_lifetime), str(record.p90_lifetime))
+                if record.n_freed
+                else ("-", "-")
+            )
+            stack_trace = allocation.stack_trace()
+            if stack_trace:
+                (function, file_name, line), *_ = stack_trace
+                location = f"{function}:{file_name}:{line}"
+            else:
+                location = "<stack trace unavailable>"
+            print(
+                row.format(
+                    rate,
+                    allocation.n_allocations,
+                    f"{freed:.0%}",
+                    *lifetimes,
+                    size_fmt(allocation.size),
+                    location,
+                ),
+                file=file,
+            )
@@ -5,11 +5,18 @@ from typing import Any
 from typing import Dict
 from typing import Iterable
 from typing import Iterator
+from typing import List
+from typing import Optional
+from typing import Sequence
 from typing import TextIO
+from typing import Tuple
 
 from memray import AllocationRecord
 from memray import MemoryRecord
 from memray import Metadata
+from memray._memray import ProcessAllocationRecord
+from memray._memray import SnapshotDiffRecord
+from memray._memray import TemporalAllocationRecord
 from memray.reporters.frame_tools import StackFrame
 from memray.reporters.frame_tools import is_cpython_internal
 from memray.reporters.frame_tools import is_frame_interesting
@@ -53,6 +60,60 @@ def create_framegraph_node_from_stack_frame(stack_frame: StackFrame) -> Dict[str
     }
 
 
+def create_root_node() -> Dict[str, Any]:
+    return {
+        "name": "<root>",
+        "location": [html.escape("<tracker>"), "<b>memray</b>", 0],
+        "value": 0,
+        "children": {},
+        "n_allocations": 0,
+        "thread_id": "0x0",
+        "interesting": True,
+    }
+
+
+def create_process_node(pid: int) -> Dict[str, Any]:
+    return {
+        "name": f"<process {pid}>",
+        "location": [html.escape("<process>"), f"<b>pid {pid}</b>", 0],
+        "value": 0,
+        "children": {},
+        "n_allocations": 0,
+        "thread_id": f"process {pid}",
+        "interesting": True,
+    }
+
+
+def iter_stack_nodes(
+    root: Dict[str, Any], record: AllocationRecord, native_traces: bool
+) -> Iterator[Dict[str, Any]]:
+    """Yield the nodes along the stack of a record, creating the missing ones."""
+    stack = (
+        tuple(record.hybrid_stack_trace()) if native_traces else record.stack_trace()
+    )
+    yield from iter_frame_nodes(root, stack, record.thread_name)
+
+
+def iter_frame_nodes(
+    root: Dict[str, Any], stack: Sequence[StackFrame], thread_id: str
+) -> Iterator[Dict[str, Any]]:
+    """Yield the nodes along a stack, from its outermost frame to its innermost."""
+    current_frame = root
+    for index, stack_frame in enumerate(reversed(stack)):
+        if is_cpython_internal(stack_frame):
+            continue
+        if (stack_frame, thread_id) not in current_frame["children"]:
+            node = create_framegraph_node_from_stack_frame(stack_frame)
+            current_frame["children"][(stack_frame, thread_id)] = node
+
+        current_frame = current_frame["children"][(stack_frame, thread_id)]
+        yield current_frame
+
+        if index > MAX_STACKS:
+            current_frame.update(MAX_STACKS_NODE)
+            break
+
+
 class FlameGraphReporter:
     def __init__(
         self,
@@ -72,16 +133,7 @@ class FlameGraphReporter:
         memory_records: Iterable[MemoryRecord],
         native_traces: bool,
     ) -> "FlameGraphReporter":
-        data: Dict[str, Any] = {
-            "name": "<root>",
-            "location": [html.escape("<tracker>"), "<b>memray</b>", 0],
-            "value": 0,
-            "children": {},
-            "n_allocations": 0,
-            "thread_id": "0x0",
-            "interesting": True,
-        }
-
+        data = create_root_node()
         unique_threads = set()
         for record in allocations:
             size = record.size
@@ -90,39 +142,63 @@ class FlameGraphReporter:
             data["value"] += size
             data["n_allocations"] += record.n_allocations
 
-            current_frame = data
-            stack = (
-                tuple(record.hybrid_stack_trace())
-                if native_traces
-                else record.stack_trace()
-            )
-            for index, stack_frame in enumerate(reversed(stack)):
-                if is_cpython_internal(stack_frame):
-                    continue
-                if (stack_frame, thread_id) not in current_frame["children"]:
-                    node = create_framegraph_node_from_stack_frame(stack_frame)
-                    current_frame["children"][(stack_frame, thread_id)] = node
-
-                current_frame = current_frame["children"][(stack_frame, thread_id)]
+            for current_frame in iter_stack_nodes(data, record, native_traces):
                 current_frame["value"] += size
                 current_frame["n_allocations"] += record.n_allocations
                 current_frame["thread_id"] = thread_id
                 unique_threads.add(thread_id)
 
-                if index > MAX_STACKS:
-                    current_frame.update(MAX_STACKS_NODE)
-                    break
-
         transformed_data = with_converted_children_dict(data)
         transformed_data["unique_threads"] = sorted(unique_threads)
         return cls(transformed_data, memory_records=memory_records)
 
+    @classmethod
+    def from_process_records(
+        cls,
+        records: Iterable[ProcessAllocationRecord],
+        *,
+        memory_records: Iterable[MemoryRecord],
+    ) -> "FlameGraphReporter":
+        """Build a flame graph of the snapshots of several processes.
+
+        When the records were not merged across processes, the stacks of each
+        process hang from a node of their own, and the processes can be picked
+        with the threads dropdown of the report.
+        """
+        data = create_root_node()
+        pids = set()
+        for record in records:
+            if record.pid is None:
+                process_node = data
+            else:
+                key = (("<process>", record.pid, 0), "")
+                if key not in data["children"]:
+                    data["children"][key] = create_process_node(record.pid)
+                process_node = data["children"][key]
+                pids.add(record.pid)
+
+            ancestors = [data] if process_node is data else [data, process_node]
+            for node in ancestors:
+                node["value"] += record.size
+                node["n_allocations"] += record.n_allocations
+
+            thread_id = process_node["thread_id"]
+            for node in iter_frame_nodes(process_node, record.stack_trace, thread_id):
+                node["value"] += record.size
+                node["n_allocations"] += record.n_allocations
+                node["thread_id"] = thread_id
+
+        transformed_data = with_converted_children_dict(data)
+        transformed_data["unique_threads"] = [f"process {pid}" for pid in sorted(pids)]
+        return cls(transformed_data, memory_records=memory_records)
+
     def render(
         self,
         outfile: TextIO,
         metadata: Metadata,
         show_memory_leaks: bool,
         merge_threads: bool,
+        snapshot_at: Optional[str] = None,
     ) -> None:
         html_code = render_report(
             kind="flamegraph",
@@ -131,5 +207,126 @@ class FlameGraphReporter:
             memory_records=self.memory_records,
             show_memory_leaks=show_memory_leaks,
             merge_threads=merge_threads,
+            snapshot_at=snapshot_at,
+        )
+        print(html_code, file=outfile)
+
+
+class TemporalFlameGraphReporter(FlameGraphReporter):
+    """A flame graph of the heap at any point in time of a capture.
+
+    Each node of the frame tree lists the locations whose stacks end in it,
+    and the intervals of snapshots in which each location had memory alive
+    are stored in the root. The report computes the value of the nodes for
+    the snapshot, or the range of snapshots, that is selected.
+    """
+
+    @classmethod
+    def from_temporal_records(
+        cls,
+        records: Iterable[TemporalAllocationRecord],
+        *,
+        memory_records: Iterable[MemoryRecord],
+        native_traces: bool,
+    ) -> "TemporalFlameGraphReporter":
+        data = create_root_node()
+        intervals: List[List[Tuple[int, int, int, int]]] = []
+
+        unique_threads = set()
+        for record in records:
+            thread_id = record.allocation.thread_name
+
+            current_frame = data
+            for current_frame in iter_stack_nodes(
+                data, record.allocation, native_traces
+            ):
+                current_frame["thread_id"] = thread_id
+                unique_threads.add(thread_id)
+
+            current_frame.setdefault("locations", []).append(len(intervals))
+            intervals.append(record.intervals)
+
+        transformed_data = with_converted_children_dict(data)
+        transformed_data["unique_threads"] = sorted(unique_threads)
+        transformed_data["intervals"] = intervals
+        return cls(transformed_data, memory_records=memory_records)
+
+    def render(
+        self,
+        outfile: TextIO,
+        metadata: Metadata,
+        show_memory_leaks: bool,
+        merge_threads: bool,
+    ) -> None:
+        html_code = render_report(
+            kind="temporal_flamegraph",
+            data=self.data,
+            metadata=metadata,
+            memory_records=self.memory_records,
+            show_memory_leaks=show_memory_leaks,
+            merge_threads=merge_threads,
+        )
+        print(html_code, file=outfile)
+
+
+class DiffFlameGraphReporter(FlameGraphReporter):
+    """A flame graph of how the memory in use changed between two captures.
+
+    The width of each frame is the biggest of the sizes that it allocated
+    directly in the two captures, so that frames that shrank or went away
+    are still shown, plus the widths of its children, so that they always
+    fit in it. The sizes before and after are stored in each node to color
+    it by how much it grew or shrank.
+    """
+
+    @classmethod
+    def from_diff_records(
+        cls,
+        records: Iterable[SnapshotDiffRecord],
+        *,
+        memory_records: Iterable[MemoryRecord],
+    ) -> "DiffFlameGraphReporter":
+        data = create_root_node()
+        # The sizes allocated directly by each node, rather than by its callees.
+        own_sizes: Dict[int, List[int]] = {}
+        for record in records:
+            node = data
+            for node in (data, *iter_frame_nodes(data, record.stack_trace, "0x0")):
+                for attribute in ("size_before", "size_after", "n_allocations_before"):
+                    node.setdefault(attribute, 0)
+                node["size_before"] += record.size_before
+                node["size_after"] += record.size_after
+                node["n_allocations_before"] += record.n_allocations_before
+                node["n_allocations"] += record.n_allocations_after
+            own_size = own_sizes.setdefault(id(node), [0, 0])
+            own_size[0] += record.size_before
+            own_size[1] += record.size_after
+
+        data = with_converted_children_dict(data)
+        # Children are only visited after their parents, so going through the
+        # nodes in reverse computes the value of every child before its parent's.
+        nodes = [data]
+        for node in nodes:
+            nodes.extend(node["children"])
+        for node in reversed(nodes):
+            node["value"] = max(own_sizes.get(id(node), (0, 0))) + sum(
+                child["value"] for child in node["children"]
+            )
+        return cls(data, memory_records=memory_records)
+
+    def render(
+        self,
+        outfile: TextIO,
+        metadata: Metadata,
+        show_memory_leaks: bool,
+        merge_threads: bool,
+    ) -> None:
+        html_code = render_report(
+            kind="diff_flamegraph",
+            data=self.data,
+            metadata=metadata,
+            memory_records=self.memory_records,
+            show_memory_leaks=show_memory_leaks,
+            merge_threads=merge_threads,
         )
         print(html_code, file=outfile)
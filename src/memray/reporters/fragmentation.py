@@ -0,0 +1,125 @@
+import heapq
+import sys
+from typing import IO
+from typing import Iterable
+from typing import List
+from typing import Optional
+
+from memray import AllocationRecord
+from memray._memray import PageOccupancyRecord
+from memray._memray import size_fmt
+
+
+def fragmentation_ratio(record: PageOccupancyRecord, page_size: int) -> float:
+    """Return the fraction of the occupied pages not used by live allocations."""
+    occupied_bytes = record.occupied_pages * page_size
+    if not occupied_bytes:
+        return 0.0
+    return max(0.0, 1 - record.heap_size / occupied_bytes)
+
+
+def sample_records(
+    records: List[PageOccupancyRecord], num_samples: int
+) -> List[PageOccupancyRecord]:
+    """Pick evenly spaced records, always including the first and the last."""
+    if len(records) <= num_samples:
+        return records
+    if num_samples == 1:
+        return records[-1:]
+    step = (len(records) - 1) / (num_samples - 1)
+    return [records[round(i * step)] for i in range(num_samples)]
+
+
+class FragmentationReporter:
+    def __init__(
+        self,
+        occupancy_records: Iterable[PageOccupancyRecord],
+        sparse_page_allocations: Iterable[AllocationRecord],
+        *,
+        page_size: int,
+        num_largest: int,
+        num_samples: int,
+    ):
+        self.occupancy_records = list(occupancy_records)
+        self.sparse_page_allocations = list(sparse_page_allocations)
+        self.page_size = page_size
+        self.num_largest = num_largest
+        self.num_samples = num_samples
+
+    def render(self, *, file: Optional[IO[str]] = None) -> None:
+        if file is None:
+            file = sys.stdout
+
+        print(
+            f"Page occupancy over time (page size: {self.page_size} bytes):",
+            file=file,
+        )
+        if not self.occupancy_records:
+            print("\tNo memory records in the capture", file=file)
+        else:
+            self._render_occupancy(file)
+
+        print(file=file)
+        print(
+            f"Top {self.num_largest} locations keeping sparse pages occupied:",
+            file=file,
+        )
+        if not self.sparse_page_allocations:
+            print("\tNo sparse pages", file=file)
+        for record in heapq.nlargest(
+            self.num_largest, self.sparse_page_allocations, key=lambda rec: rec.size
+        ):
+            stack_trace = record.stack_trace()
+            if stack_trace:
+                (function, file_name, line), *_ = stack_trace
+                location = f"{function}:{file_name}:{line}"
+            else:
+                location = "<stack trace unavailable>"
+            print(
+                f"\t- {location} -> {size_fmt(record.size)} unused "
+                f"({record.n_allocations} allocations)",
+                file=file,
+            )
+
+    def _render_occupancy(self, file: IO[str]) -> None:
+        start = self.occupancy_records[0].time
+        row = "\t{:>9} {:>12} {:>12} {:>12} {:>9} {:>9} {:>8} {:>14}"
+        print(
+            row.format(
+                "time",
+                "RSS",
+                "heap",
+                "occupied",
+                "partial",
+                "sparse",
+                "regions",
+                "fragmentation",
+            ),
+            file=file,
+        )
+        for record in sample_records(self.occupancy_records, self.num_samples):
+            print(
+                row.format(
+                    f"{(record.time - start) / 1000:.3f}s",
+                    size_fmt(record.rss),
+                    size_fmt(record.heap_size),
+                    size_fmt(record.occupied_pages * self.page_size),
+                    record.partially_used_pages,
+                    record.sparse_pages,
+                    record.regions,
+                    f"{fragmentation_ratio(record, self.page_size):.1%}",
+                ),
+                file=file,
+            )
+
+        worst = max(
+            self.occupancy_records,
+            key=lambda record: fragmentation_ratio(record, self.page_size),
+        )
+        print(file=file)
+        print(
+            f"\tHighest fragmentation: "
+            f"{fragmentation_ratio(worst, self.page_size):.1%} "
+            f"at {(worst.time - start) / 1000:.3f}s",
+            file=file,
+        )
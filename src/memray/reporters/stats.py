@@ -15,6 +15,7 @@ import rich
 
 from memray import AllocationRecord
 from memray import AllocatorType
+from memray import Metadata
 from memray._memray import size_fmt
 
 
@@ -35,9 +36,11 @@ def get_stats_data(data: Iterable[AllocationRecord]) -> _StatsData:
         AllocatorType(alloc.allocator).name for alloc in data
     )
 
-    # remove FREE and MUNMAP from allocation_type
+    # remove the deallocators from allocation_type
     shdata.allocation_type_counter.pop("FREE", None)
     shdata.allocation_type_counter.pop("MUNMAP", None)
+    shdata.allocation_type_counter.pop("MADVISE", None)
+    shdata.allocation_type_counter.pop("POOL_FREE", None)
 
     return shdata
 
@@ -95,6 +98,21 @@ def get_histogram_databins(data: List[int], bins: int) -> List[Tuple[int, int]]:
     return [(steps[b], dist[b]) for b in range(bins)]
 
 
+def describe_dropped_allocations(metadata: Metadata) -> Optional[str]:
+    if not metadata.dropped_allocations:
+        return None
+    reasons = [
+        (metadata.dropped_by_size, "below the minimum size"),
+        (metadata.dropped_by_allocator, "from excluded allocators"),
+        (metadata.dropped_by_thread, "from excluded threads"),
+    ]
+    details = ", ".join(f"{count} {reason}" for count, reason in reasons if count)
+    return (
+        f"{metadata.dropped_allocations} allocations were not recorded "
+        f"because of capture filters ({details})"
+    )
+
+
 def draw_histogram(data: List[int], bins: int, *, hist_scale_factor: int = 25) -> str:
     """
     @param data: list of allocation sizes
@@ -146,17 +164,26 @@ def draw_histogram(data: List[int], bins: int, *, hist_scale_factor: int = 25) -
 
 
 class StatsReporter:
-    def __init__(self, data: Iterable[AllocationRecord], num_largest: int):
+    def __init__(
+        self,
+        data: Iterable[AllocationRecord],
+        num_largest: int,
+        metadata: Optional[Metadata] = None,
+    ):
         self.data = list(data)
         if num_largest < 1:
             raise ValueError(f"Invalid input num_largest={num_largest}, should be >=1")
         self.num_largest = num_largest
+        self.metadata = metadata
 
     @classmethod
     def from_snapshot(
-        cls, allocations: Iterable[AllocationRecord], num_largest: int
+        cls,
+        allocations: Iterable[AllocationRecord],
+        num_largest: int,
+        metadata: Optional[Metadata] = None,
     ) -> "StatsReporter":
-        return cls(allocations, num_largest)
+        return cls(allocations, num_largest, metadata)
 
     def render(
         self,
@@ -167,6 +194,9 @@ class StatsReporter:
 
         rich.print("📏 [bold]Total allocations:[/]")
         print(f"\t{shdata.total_num_allocations}")
+        dropped = self.metadata and describe_dropped_allocations(self.metadata)
+        if dropped:
+            print(f"\t({dropped})")
 
         print()
         rich.print("📦 [bold]Total memory allocated:[/]")
@@ -4,6 +4,7 @@ from typing import Dict
 from typing import Iterable
 from typing import Iterator
 from typing import List
+from typing import Optional
 from typing import TextIO
 
 from memray import AllocationRecord
@@ -63,6 +64,7 @@ class TableReporter:
         outfile: TextIO,
         metadata: Metadata,
         show_memory_leaks: bool,
+        snapshot_at: Optional[str] = None,
     ) -> None:
         html_code = render_report(
             kind="table",
@@ -71,5 +73,6 @@ class TableReporter:
             memory_records=self.memory_records,
             show_memory_leaks=show_memory_leaks,
             merge_threads=True,
+            snapshot_at=snapshot_at,
         )
         print(html_code, file=outfile)
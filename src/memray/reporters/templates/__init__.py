@@ -3,6 +3,7 @@ from functools import lru_cache
 from typing import Any
 from typing import Dict
 from typing import Iterable
+from typing import Optional
 from typing import Union
 
 import jinja2
@@ -18,7 +19,12 @@ def get_render_environment() -> jinja2.Environment:
     )
 
 
-def get_report_title(*, kind: str, show_memory_leaks: bool) -> str:
+def get_report_title(
+    *, kind: str, show_memory_leaks: bool, snapshot_at: Optional[str] = None
+) -> str:
+    kind = kind.replace("_", " ")
+    if snapshot_at is not None:
+        return f"{kind} report (memory {snapshot_at})"
     if show_memory_leaks:
         return f"{kind} report (memory leaks)"
     return f"{kind} report"
@@ -32,11 +38,14 @@ def render_report(
     memory_records: Iterable[MemoryRecord],
     show_memory_leaks: bool,
     merge_threads: bool,
+    snapshot_at: Optional[str] = None,
 ) -> str:
     env = get_render_environment()
     template = env.get_template(kind + ".html")
 
-    title = get_report_title(kind=kind, show_memory_leaks=show_memory_leaks)
+    title = get_report_title(
+        kind=kind, show_memory_leaks=show_memory_leaks, snapshot_at=snapshot_at
+    )
     return template.render(
         kind=kind,
         title=title,
@@ -45,4 +54,5 @@ def render_report(
         memory_records=memory_records,
         show_memory_leaks=show_memory_leaks,
         merge_threads=merge_threads,
+        snapshot_at=snapshot_at,
     )
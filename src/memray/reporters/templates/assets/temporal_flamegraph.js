@@ -0,0 +1,70 @@
+(()=>{var n={486:function(n,t,r){var e;
+/**
+ * @license
+ * Lodash <https://lodash.com/>
+ * Copyright OpenJS Foundation and other contributors <https://openjsf.org/>
+ * Released under MIT license <https://lodash.com/license>
+ * Based on Underscore.js 1.8.3 <http://underscorejs.org/LICENSE>
+ * Copyright Jeremy Ashkenas, DocumentCloud and Investigative Reporters & Editors
+ */n=r.nmd(n),function(){var u,i="Expected a function",o="__lodash_hash_undefined__",a="__lodash_placeholder__",f=16,c=32,l=64,s=128,h=256,p=1/0,v=9007199254740991,_=NaN,g=4294967295,d=[["ary",s],["bind",1],["bindKey",2],["curry",8],["curryRight",f],["flip",512],["partial",c],["partialRight",l],["rearg",h]],y="[object Arguments]",m="[object Array]",w="[object Boolean]",b="[object Date]",x="[object Error]",j="[object Function]",A="[object GeneratorFunction]",E="[object Map]",k="[object Number]",I="[object Object]",O="[object Promise]",B="[object RegExp]",z="[object Set]",R="[object String]",S="[object Symbol]",C="[object WeakMap]",L="[object ArrayBuffer]",T="[object DataView]",F="[object Float32Array]",U="[object Float64Array]",W="[object Int8Array]",$="[object Int16Array]",D="[object Int32Array]",M="[object Uint8Array]",P="[object Uint8ClampedArray]",N="[object Uint16Array]",q="[object Uint32Array]",Z=/\b__p \+= '';/g,G=/\b(__p \+=) '' \+/g,K=/(__e\(.*?\)|\b__t\)) \+\n'';/g,V=/&(?:amp|lt|gt|quot|#39);/g,H=/[&<>"']/g,Y=RegExp(V.source),J=RegExp(H.source),Q=/<%-([\s\S]+?)%>/g,X=/<%([\s\S]+?)%>/g,nn=/<%=([\s\S]+?)%>/g,tn=/\.|\[(?:[^[\]]*|(["'])(?:(?!\1)[^\\]|\\.)*?\1)\]/,rn=/^\w*$/,en=/[^.[\]]+|\[(?:(-?\d+(?:\.\d+)?)|(["'])((?:(?!\2)[^\\]|\\.)*?)\2)\]|(?=(?:\.|\[\])(?:\.|\[\]|$))/g,un=/[\\^$.*+?()[\]{}|]/g,on=RegExp(un.source),an=/^\s+/,fn=/\s/,cn=/\{(?:\n\/\* \[wrapped with .+\] \*\/)?\n?/,ln=/\{\n\/\* \[wrapped with (.+)\] \*/,sn=/,? & /,hn=/[^\x00-\x2f\x3a-\x40\x5b-\x60\x7b-\x7f]+/g,pn=/[()=,{}\[\]\/\s]/,vn=/\\(\\)?/g,_n=/\$\{([^\\}]*(?:\\.[^\\}]*)*)\}/g,gn=/\w*$/,dn=/^[-+]0x[0-9a-f]+$/i,yn=/^0b[01]+$/i,mn=/^\[object .+?Constructor\]$/,wn=/^0o[0-7]+$/i,bn=/^(?:0|[1-9]\d*)$/,xn=/[\xc0-\xd6\xd8-\xf6\xf8-\xff\u0100-\u017f]/g,jn=/($^)/,An=/['\n\r\u2028\u2029\\]/g,En="\\u0300-\\u036f\\ufe20-\\ufe2f\\u20d0-\\u20ff",kn="\\u2700-\\u27bf",In="a-z\\xdf-\\xf6\\xf8-\\xff",On="A-Z\\xc0-\\xd6\\xd8-\\xde",Bn="\\ufe0e\\ufe0f",zn="\\xac\\xb1\\xd7\\xf7\\x00-\\x2f\\x3a-\\x40\\x5b-\\x60\\x7b-\\xbf\\u2000-\\u206f \\t\\x0b\\f\\xa0\\ufeff\\n\\r\\u2028\\u2029\\u1680\\u180e\\u2000\\u2001\\u2002\\u2003\\u2004\\u2005\\u2006\\u2007\\u2008\\u2009\\u200a\\u202f\\u205f\\u3000",Rn="['’]",Sn="[\\ud800-\\udfff]",Cn="["+zn+"]",Ln="["+En+"]",Tn="\\d+",Fn="[\\u2700-\\u27bf]",Un="["+In+"]",Wn="[^\\ud800-\\udfff"+zn+Tn+kn+In+On+"]",$n="\\ud83c[\\udffb-\\udfff]",Dn="[^\\ud800-\\udfff]",Mn="(?:\\ud83c[\\udde6-\\uddff]){2}",Pn="[\\ud800-\\udbff][\\udc00-\\udfff]",Nn="["+On+"]",qn="(?:"+Un+"|"+Wn+")",Zn="(?:"+Nn+"|"+Wn+")",Gn="(?:['’](?:d|ll|m|re|s|t|ve))?",Kn="(?:['’](?:D|LL|M|RE|S|T|VE))?",Vn="(?:"+Ln+"|"+$n+")"+"?",Hn="[\\ufe0e\\ufe0f]?",Yn=Hn+Vn+("(?:\\u200d(?:"+[Dn,Mn,Pn].join("|")+")"+Hn+Vn+")*"),Jn="(?:"+[Fn,Mn,Pn].join("|")+")"+Yn,Qn="(?:"+[Dn+Ln+"?",Ln,Mn,Pn,Sn].join("|")+")",Xn=RegExp(Rn,"g"),nt=RegExp(Ln,"g"),tt=RegExp($n+"(?="+$n+")|"+Qn+Yn,"g"),rt=RegExp([Nn+"?"+Un+"+"+Gn+"(?="+[Cn,Nn,"$"].join("|")+")",Zn+"+"+Kn+"(?="+[Cn,Nn+qn,"$"].join("|")+")",Nn+"?"+qn+"+"+Gn,Nn+"+"+Kn,"\\d*(?:1ST|2ND|3RD|(?![123])\\dTH)(?=\\b|[a-z_])","\\d*(?:1st|2nd|3rd|(?![123])\\dth)(?=\\b|[A-Z_])",Tn,Jn].join("|"),"g"),et=RegExp("[\\u200d\\ud800-\\udfff"+En+Bn+"]"),ut=/[a-z][A-Z]|[A-Z]{2}[a-z]|[0-9][a-zA-Z]|[a-zA-Z][0-9]|[^a-zA-Z0-9 ]/,it=["Array","Buffer","DataView","Date","Error","Float32Array","Float64Array","Function","Int8Array","Int16Array","Int32Array","Map","Math","Object","Promise","RegExp","Set","String","Symbol","TypeError","Uint8Array","Uint8ClampedArray","Uint16Array","Uint32Array","WeakMap","_","clearTimeout","isFinite","parseInt","setTimeout"],ot=-1,at={};at[F]=at[U]=at[W]=at[$]=at[D]=at[M]=at[P]=at[N]=at[q]=!0,at[y]=at[m]=at[L]=at[w]=at[T]=at[b]=at[x]=at[j]=at[E]=at[k]=at[I]=at[B]=at[z]=at[R]=at[C]=!1;var ft={};ft[y]=ft[m]=ft[L]=ft[T]=ft[w]=ft[b]=ft[F]=ft[U]=ft[W]=ft[$]=ft[D]=ft[E]=ft[k]=ft[I]=ft[B]=ft[z]=ft[R]=ft[S]=ft[M]=ft[P]=ft[N]=ft[q]=!0,ft[x]=ft[j]=ft[C]=!1;var ct={"\\":"\\","'":"'","\n":"n","\r":"r","\u2028":"u2028","\u2029":"u2029"},lt=parseFloat,st=parseInt,ht="object"==typeof r.g&&r.g&&r.g.Object===Object&&r.g,pt="object"==typeof self&&self&&self.Object===Object&&self,vt=ht||pt||Function("return this")(),_t=t&&!t.nodeType&&t,gt=_t&&n&&!n.nodeType&&n,dt=gt&&gt.exports===_t,yt=dt&&ht.process,mt=function(){try{var n=gt&&gt.require&&gt.require("util").types;return n||yt&&yt.binding&&yt.binding("util")}catch(n){}}(),wt=mt&&mt.isArrayBuffer,bt=mt&&mt.isDate,xt=mt&&mt.isMap,jt=mt&&mt.isRegExp,At=mt&&mt.isSet,Et=mt&&mt.isTypedArray;function kt(n,t,r){switch(r.length){case 0:return n.call(t);case 1:return n.call(t,r[0]);case 2:return n.call(t,r[0],r[1]);case 3:return n.call(t,r[0],r[1],r[2])}return n.apply(t,r)}function It(n,t,r,e){for(var u=-1,i=null==n?0:n.length;++u<i;){var o=n[u];t(e,o,r(o),n)}return e}function Ot(n,t){for(var r=-1,e=null==n?0:n.length;++r<e&&!1!==t(n[r],r,n););return n}function Bt(n,t){for(var r=null==n?0:n.length;r--&&!1!==t(n[r],r,n););return n}function zt(n,t){for(var r=-1,e=null==n?0:n.length;++r<e;)if(!t(n[r],r,n))return!1;return!0}function Rt(n,t){for(var r=-1,e=null==n?0:n.length,u=0,i=[];++r<e;){var o=n[r];t(o,r,n)&&(i[u++]=o)}return i}function St(n,t){return!!(null==n?0:n.length)&&Pt(n,t,0)>-1}function Ct(n,t,r){for(var e=-1,u=null==n?0:n.length;++e<u;)if(r(t,n[e]))return!0;return!1}function Lt(n,t){for(var r=-1,e=null==n?0:n.length,u=Array(e);++r<e;)u[r]=t(n[r],r,n);return u}function Tt(n,t){for(var r=-1,e=t.length,u=n.length;++r<e;)n[u+r]=t[r];return n}function Ft(n,t,r,e){var u=-1,i=null==n?0:n.length;for(e&&i&&(r=n[++u]);++u<i;)r=t(r,n[u],u,n);return r}function Ut(n,t,r,e){var u=null==n?0:n.length;for(e&&u&&(r=n[--u]);u--;)r=t(r,n[u],u,n);return r}function Wt(n,t){for(var r=-1,e=null==n?0:n.length;++r<e;)if(t(n[r],r,n))return!0;return!1}var $t=Gt("length");function Dt(n,t,r){var e;return r(n,(function(n,r,u){if(t(n,r,u))return e=r,!1})),e}function Mt(n,t,r,e){for(var u=n.length,i=r+(e?1:-1);e?i--:++i<u;)if(t(n[i],i,n))return i;return-1}function Pt(n,t,r){return t==t?function(n,t,r){var e=r-1,u=n.length;for(;++e<u;)if(n[e]===t)return e;return-1}(n,t,r):Mt(n,qt,r)}function Nt(n,t,r,e){for(var u=r-1,i=n.length;++u<i;)if(e(n[u],t))return u;return-1}function qt(n){return n!=n}function Zt(n,t){var r=null==n?0:n.length;return r?Ht(n,t)/r:_}function Gt(n){return function(t){return null==t?u:t[n]}}function Kt(n){return function(t){return null==n?u:n[t]}}function Vt(n,t,r,e,u){return u(n,(function(n,u,i){r=e?(e=!1,n):t(r,n,u,i)})),r}function Ht(n,t){for(var r,e=-1,i=n.length;++e<i;){var o=t(n[e]);o!==u&&(r=r===u?o:r+o)}return r}function Yt(n,t){for(var r=-1,e=Array(n);++r<n;)e[r]=t(r);return e}function Jt(n){return n?n.slice(0,_r(n)+1).replace(an,""):n}function Qt(n){return function(t){return n(t)}}function Xt(n,t){return Lt(t,(function(t){return n[t]}))}function nr(n,t){return n.has(t)}function tr(n,t){for(var r=-1,e=n.length;++r<e&&Pt(t,n[r],0)>-1;);return r}function rr(n,t){for(var r=n.length;r--&&Pt(t,n[r],0)>-1;);return r}function er(n,t){for(var r=n.length,e=0;r--;)n[r]===t&&++e;return e}var ur=Kt({À:"A",Á:"A",Â:"A",Ã:"A",Ä:"A",Å:"A",à:"a",á:"a",â:"a",ã:"a",ä:"a",å:"a",Ç:"C",ç:"c",Ð:"D",ð:"d",È:"E",É:"E",Ê:"E",Ë:"E",è:"e",é:"e",ê:"e",ë:"e",Ì:"I",Í:"I",Î:"I",Ï:"I",ì:"i",í:"i",î:"i",ï:"i",Ñ:"N",ñ:"n",Ò:"O",Ó:"O",Ô:"O",Õ:"O",Ö:"O",Ø:"O",ò:"o",ó:"o",ô:"o",õ:"o",ö:"o",ø:"o",Ù:"U",Ú:"U",Û:"U",Ü:"U",ù:"u",ú:"u",û:"u",ü:"u",Ý:"Y",ý:"y",ÿ:"y",Æ:"Ae",æ:"ae",Þ:"Th",þ:"th",ß:"ss",Ā:"A",Ă:"A",Ą:"A",ā:"a",ă:"a",ą:"a",Ć:"C",Ĉ:"C",Ċ:"C",Č:"C",ć:"c",ĉ:"c",ċ:"c",č:"c",Ď:"D",Đ:"D",ď:"d",đ:"d",Ē:"E",Ĕ:"E",Ė:"E",Ę:"E",Ě:"E",ē:"e",ĕ:"e",ė:"e",ę:"e",ě:"e",Ĝ:"G",Ğ:"G",Ġ:"G",Ģ:"G",ĝ:"g",ğ:"g",ġ:"g",ģ:"g",Ĥ:"H",Ħ:"H",ĥ:"h",ħ:"h",Ĩ:"I",Ī:"I",Ĭ:"I",Į:"I",İ:"I",ĩ:"i",ī:"i",ĭ:"i",į:"i",ı:"i",Ĵ:"J",ĵ:"j",Ķ:"K",ķ:"k",ĸ:"k",Ĺ:"L",Ļ:"L",Ľ:"L",Ŀ:"L",Ł:"L",ĺ:"l",ļ:"l",ľ:"l",ŀ:"l",ł:"l",Ń:"N",Ņ:"N",Ň:"N",Ŋ:"N",ń:"n",ņ:"n",ň:"n",ŋ:"n",Ō:"O",Ŏ:"O",Ő:"O",ō:"o",ŏ:"o",ő:"o",Ŕ:"R",Ŗ:"R",Ř:"R",ŕ:"r",ŗ:"r",ř:"r",Ś:"S",Ŝ:"S",Ş:"S",Š:"S",ś:"s",ŝ:"s",ş:"s",š:"s",Ţ:"T",Ť:"T",Ŧ:"T",ţ:"t",ť:"t",ŧ:"t",Ũ:"U",Ū:"U",Ŭ:"U",Ů:"U",Ű:"U",Ų:"U",ũ:"u",ū:"u",ŭ:"u",ů:"u",ű:"u",ų:"u",Ŵ:"W",ŵ:"w",Ŷ:"Y",ŷ:"y",Ÿ:"Y",Ź:"Z",Ż:"Z",Ž:"Z",ź:"z",ż:"z",ž:"z",Ĳ:"IJ",ĳ:"ij",Œ:"Oe",œ:"oe",ŉ:"'n",ſ:"s"}),ir=Kt({"&":"&amp;","<":"&lt;",">":"&gt;",'"':"&quot;","'":"&#39;"});function or(n){return"\\"+ct[n]}function ar(n){return et.test(n)}function fr(n){var t=-1,r=Array(n.size);return n.forEach((function(n,e){r[++t]=[e,n]})),r}function cr(n,t){return function(r){return n(t(r))}}function lr(n,t){for(var r=-1,e=n.length,u=0,i=[];++r<e;){var o=n[r];o!==t&&o!==a||(n[r]=a,i[u++]=r)}return i}function sr(n){var t=-1,r=Array(n.size);return n.forEach((function(n){r[++t]=n})),r}function hr(n){var t=-1,r=Array(n.size);return n.forEach((function(n){r[++t]=[n,n]})),r}function pr(n){return ar(n)?function(n){var t=tt.lastIndex=0;for(;tt.test(n);)++t;return t}(n):$t(n)}function vr(n){return ar(n)?function(n){return n.match(tt)||[]}(n):function(n){return n.split("")}(n)}function _r(n){for(var t=n.length;t--&&fn.test(n.charAt(t)););return t}var gr=Kt({"&amp;":"&","&lt;":"<","&gt;":">","&quot;":'"',"&#39;":"'"});var dr=function n(t){var r,e=(t=null==t?vt:dr.defaults(vt.Object(),t,dr.pick(vt,it))).Array,fn=t.Date,En=t.Error,kn=t.Function,In=t.Math,On=t.Object,Bn=t.RegExp,zn=t.String,Rn=t.TypeError,Sn=e.prototype,Cn=kn.prototype,Ln=On.prototype,Tn=t["__core-js_shared__"],Fn=Cn.toString,Un=Ln.hasOwnProperty,Wn=0,$n=(r=/[^.]+$/.exec(Tn&&Tn.keys&&Tn.keys.IE_PROTO||""))?"Symbol(src)_1."+r:"",Dn=Ln.toString,Mn=Fn.call(On),Pn=vt._,Nn=Bn("^"+Fn.call(Un).replace(un,"\\$&").replace(/hasOwnProperty|(function).*?(?=\\\()| for .+?(?=\\\])/g,"$1.*?")+"$"),qn=dt?t.Buffer:u,Zn=t.Symbol,Gn=t.Uint8Array,Kn=qn?qn.allocUnsafe:u,Vn=cr(On.getPrototypeOf,On),Hn=On.create,Yn=Ln.propertyIsEnumerable,Jn=Sn.splice,Qn=Zn?Zn.isConcatSpreadable:u,tt=Zn?Zn.iterator:u,et=Zn?Zn.toStringTag:u,ct=function(){try{var n=pi(On,"defineProperty");return n({},"",{}),n}catch(n){}}(),ht=t.clearTimeout!==vt.clearTimeout&&t.clearTimeout,pt=fn&&fn.now!==vt.Date.now&&fn.now,_t=t.setTimeout!==vt.setTimeout&&t.setTimeout,gt=In.ceil,yt=In.floor,mt=On.getOwnPropertySymbols,$t=qn?qn.isBuffer:u,Kt=t.isFinite,yr=Sn.join,mr=cr(On.keys,On),wr=In.max,br=In.min,xr=fn.now,jr=t.parseInt,Ar=In.random,Er=Sn.reverse,kr=pi(t,"DataView"),Ir=pi(t,"Map"),Or=pi(t,"Promise"),Br=pi(t,"Set"),zr=pi(t,"WeakMap"),Rr=pi(On,"create"),Sr=zr&&new zr,Cr={},Lr=Di(kr),Tr=Di(Ir),Fr=Di(Or),Ur=Di(Br),Wr=Di(zr),$r=Zn?Zn.prototype:u,Dr=$r?$r.valueOf:u,Mr=$r?$r.toString:u;function Pr(n){if(ua(n)&&!Ko(n)&&!(n instanceof Gr)){if(n instanceof Zr)return n;if(Un.call(n,"__wrapped__"))return Mi(n)}return new Zr(n)}var Nr=function(){function n(){}return function(t){if(!ea(t))return{};if(Hn)return Hn(t);n.prototype=t;var r=new n;return n.prototype=u,r}}();function qr(){}function Zr(n,t){this.__wrapped__=n,this.__actions__=[],this.__chain__=!!t,this.__index__=0,this.__values__=u}function Gr(n){this.__wrapped__=n,this.__actions__=[],this.__dir__=1,this.__filtered__=!1,this.__iteratees__=[],this.__takeCount__=g,this.__views__=[]}function Kr(n){var t=-1,r=null==n?0:n.length;for(this.clear();++t<r;){var e=n[t];this.set(e[0],e[1])}}function Vr(n){var t=-1,r=null==n?0:n.length;for(this.clear();++t<r;){var e=n[t];this.set(e[0],e[1])}}function Hr(n){var t=-1,r=null==n?0:n.length;for(this.clear();++t<r;){var e=n[t];this.set(e[0],e[1])}}function Yr(n){var t=-1,r=null==n?0:n.length;for(this.__data__=new Hr;++t<r;)this.add(n[t])}function Jr(n){var t=this.__data__=new Vr(n);this.size=t.size}function Qr(n,t){var r=Ko(n),e=!r&&Go(n),u=!r&&!e&&Jo(n),i=!r&&!e&&!u&&ha(n),o=r||e||u||i,a=o?Yt(n.length,zn):[],f=a.length;for(var c in n)!t&&!Un.call(n,c)||o&&("length"==c||u&&("offset"==c||"parent"==c)||i&&("buffer"==c||"byteLength"==c||"byteOffset"==c)||wi(c,f))||a.push(c);return a}function Xr(n){var t=n.length;return t?n[Ye(0,t-1)]:u}function ne(n,t){return Ui(Ru(n),ce(t,0,n.length))}function te(n){return Ui(Ru(n))}function re(n,t,r){(r!==u&&!No(n[t],r)||r===u&&!(t in n))&&ae(n,t,r)}function ee(n,t,r){var e=n[t];Un.call(n,t)&&No(e,r)&&(r!==u||t in n)||ae(n,t,r)}function ue(n,t){for(var r=n.length;r--;)if(No(n[r][0],t))return r;return-1}function ie(n,t,r,e){return ve(n,(function(n,u,i){t(e,n,r(n),i)})),e}function oe(n,t){return n&&Su(t,La(t),n)}function ae(n,t,r){"__proto__"==t&&ct?ct(n,t,{configurable:!0,enumerable:!0,value:r,writable:!0}):n[t]=r}function fe(n,t){for(var r=-1,i=t.length,o=e(i),a=null==n;++r<i;)o[r]=a?u:Ba(n,t[r]);return o}function ce(n,t,r){return n==n&&(r!==u&&(n=n<=r?n:r),t!==u&&(n=n>=t?n:t)),n}function le(n,t,r,e,i,o){var a,f=1&t,c=2&t,l=4&t;if(r&&(a=i?r(n,e,i,o):r(n)),a!==u)return a;if(!ea(n))return n;var s=Ko(n);if(s){if(a=function(n){var t=n.length,r=new n.constructor(t);t&&"string"==typeof n[0]&&Un.call(n,"index")&&(r.index=n.index,r.input=n.input);return r}(n),!f)return Ru(n,a)}else{var h=gi(n),p=h==j||h==A;if(Jo(n))return Eu(n,f);if(h==I||h==y||p&&!i){if(a=c||p?{}:yi(n),!f)return c?function(n,t){return Su(n,_i(n),t)}(n,function(n,t){return n&&Su(t,Ta(t),n)}(a,n)):function(n,t){return Su(n,vi(n),t)}(n,oe(a,n))}else{if(!ft[h])return i?n:{};a=function(n,t,r){var e=n.constructor;switch(t){case L:return ku(n);case w:case b:return new e(+n);case T:return function(n,t){var r=t?ku(n.buffer):n.buffer;return new n.constructor(r,n.byteOffset,n.byteLength)}(n,r);case F:case U:case W:case $:case D:case M:case P:case N:case q:return Iu(n,r);case E:return new e;case k:case R:return new e(n);case B:return function(n){var t=new n.constructor(n.source,gn.exec(n));return t.lastIndex=n.lastIndex,t}(n);case z:return new e;case S:return u=n,Dr?On(Dr.call(u)):{}}var u}(n,h,f)}}o||(o=new Jr);var v=o.get(n);if(v)return v;o.set(n,a),ca(n)?n.forEach((function(e){a.add(le(e,t,r,e,n,o))})):ia(n)&&n.forEach((function(e,u){a.set(u,le(e,t,r,u,n,o))}));var _=s?u:(l?c?oi:ii:c?Ta:La)(n);return Ot(_||n,(function(e,u){_&&(e=n[u=e]),ee(a,u,le(e,t,r,u,n,o))})),a}function se(n,t,r){var e=r.length;if(null==n)return!e;for(n=On(n);e--;){var i=r[e],o=t[i],a=n[i];if(a===u&&!(i in n)||!o(a))return!1}return!0}function he(n,t,r){if("function"!=typeof n)throw new Rn(i);return Ci((function(){n.apply(u,r)}),t)}function pe(n,t,r,e){var u=-1,i=St,o=!0,a=n.length,f=[],c=t.length;if(!a)return f;r&&(t=Lt(t,Qt(r))),e?(i=Ct,o=!1):t.length>=200&&(i=nr,o=!1,t=new Yr(t));n:for(;++u<a;){var l=n[u],s=null==r?l:r(l);if(l=e||0!==l?l:0,o&&s==s){for(var h=c;h--;)if(t[h]===s)continue n;f.push(l)}else i(t,s,e)||f.push(l)}return f}Pr.templateSettings={escape:Q,evaluate:X,interpolate:nn,variable:"",imports:{_:Pr}},Pr.prototype=qr.prototype,Pr.prototype.constructor=Pr,Zr.prototype=Nr(qr.prototype),Zr.prototype.constructor=Zr,Gr.prototype=Nr(qr.prototype),Gr.prototype.constructor=Gr,Kr.prototype.clear=function(){this.__data__=Rr?Rr(null):{},this.size=0},Kr.prototype.delete=function(n){var t=this.has(n)&&delete this.__data__[n];return this.size-=t?1:0,t},Kr.prototype.get=function(n){var t=this.__data__;if(Rr){var r=t[n];return r===o?u:r}return Un.call(t,n)?t[n]:u},Kr.prototype.has=function(n){var t=this.__data__;return Rr?t[n]!==u:Un.call(t,n)},Kr.prototype.set=function(n,t){var r=this.__data__;return this.size+=this.has(n)?0:1,r[n]=Rr&&t===u?o:t,this},Vr.prototype.clear=function(){this.__data__=[],this.size=0},Vr.prototype.delete=function(n){var t=this.__data__,r=ue(t,n);return!(r<0)&&(r==t.length-1?t.pop():Jn.call(t,r,1),--this.size,!0)},Vr.prototype.get=function(n){var t=this.__data__,r=ue(t,n);return r<0?u:t[r][1]},Vr.prototype.has=function(n){return ue(this.__data__,n)>-1},Vr.prototype.set=function(n,t){var r=this.__data__,e=ue(r,n);return e<0?(++this.size,r.push([n,t])):r[e][1]=t,this},Hr.prototype.clear=function(){this.size=0,this.__data__={hash:new Kr,map:new(Ir||Vr),string:new Kr}},Hr.prototype.delete=function(n){var t=si(this,n).delete(n);return this.size-=t?1:0,t},Hr.prototype.get=function(n){return si(this,n).get(n)},Hr.prototype.has=function(n){return si(this,n).has(n)},Hr.prototype.set=function(n,t){var r=si(this,n),e=r.size;return r.set(n,t),this.size+=r.size==e?0:1,this},Yr.prototype.add=Yr.prototype.push=function(n){return this.__data__.set(n,o),this},Yr.prototype.has=function(n){return this.__data__.has(n)},Jr.prototype.clear=function(){this.__data__=new Vr,this.size=0},Jr.prototype.delete=function(n){var t=this.__data__,r=t.delete(n);return this.size=t.size,r},Jr.prototype.get=function(n){return this.__data__.get(n)},Jr.prototype.has=function(n){return this.__data__.has(n)},Jr.prototype.set=function(n,t){var r=this.__data__;if(r instanceof Vr){var e=r.__data__;if(!Ir||e.length<199)return e.push([n,t]),this.size=++r.size,this;r=this.__data__=new Hr(e)}return r.set(n,t),this.size=r.size,this};var ve=Tu(xe),_e=Tu(je,!0);function ge(n,t){var r=!0;return ve(n,(function(n,e,u){return r=!!t(n,e,u)})),r}function de(n,t,r){for(var e=-1,i=n.length;++e<i;){var o=n[e],a=t(o);if(null!=a&&(f===u?a==a&&!sa(a):r(a,f)))var f=a,c=o}return c}function ye(n,t){var r=[];return ve(n,(function(n,e,u){t(n,e,u)&&r.push(n)})),r}function me(n,t,r,e,u){var i=-1,o=n.length;for(r||(r=mi),u||(u=[]);++i<o;){var a=n[i];t>0&&r(a)?t>1?me(a,t-1,r,e,u):Tt(u,a):e||(u[u.length]=a)}return u}var we=Fu(),be=Fu(!0);function xe(n,t){return n&&we(n,t,La)}function je(n,t){return n&&be(n,t,La)}function Ae(n,t){return Rt(t,(function(t){return na(n[t])}))}function Ee(n,t){for(var r=0,e=(t=bu(t,n)).length;null!=n&&r<e;)n=n[$i(t[r++])];return r&&r==e?n:u}function ke(n,t,r){var e=t(n);return Ko(n)?e:Tt(e,r(n))}function Ie(n){return null==n?n===u?"[object Undefined]":"[object Null]":et&&et in On(n)?function(n){var t=Un.call(n,et),r=n[et];try{n[et]=u;var e=!0}catch(n){}var i=Dn.call(n);e&&(t?n[et]=r:delete n[et]);return i}(n):function(n){return Dn.call(n)}(n)}function Oe(n,t){return n>t}function Be(n,t){return null!=n&&Un.call(n,t)}function ze(n,t){return null!=n&&t in On(n)}function Re(n,t,r){for(var i=r?Ct:St,o=n[0].length,a=n.length,f=a,c=e(a),l=1/0,s=[];f--;){var h=n[f];f&&t&&(h=Lt(h,Qt(t))),l=br(h.length,l),c[f]=!r&&(t||o>=120&&h.length>=120)?new Yr(f&&h):u}h=n[0];var p=-1,v=c[0];n:for(;++p<o&&s.length<l;){var _=h[p],g=t?t(_):_;if(_=r||0!==_?_:0,!(v?nr(v,g):i(s,g,r))){for(f=a;--f;){var d=c[f];if(!(d?nr(d,g):i(n[f],g,r)))continue n}v&&v.push(g),s.push(_)}}return s}function Se(n,t,r){var e=null==(n=Bi(n,t=bu(t,n)))?n:n[$i(Qi(t))];return null==e?u:kt(e,n,r)}function Ce(n){return ua(n)&&Ie(n)==y}function Le(n,t,r,e,i){return n===t||(null==n||null==t||!ua(n)&&!ua(t)?n!=n&&t!=t:function(n,t,r,e,i,o){var a=Ko(n),f=Ko(t),c=a?m:gi(n),l=f?m:gi(t),s=(c=c==y?I:c)==I,h=(l=l==y?I:l)==I,p=c==l;if(p&&Jo(n)){if(!Jo(t))return!1;a=!0,s=!1}if(p&&!s)return o||(o=new Jr),a||ha(n)?ei(n,t,r,e,i,o):function(n,t,r,e,u,i,o){switch(r){case T:if(n.byteLength!=t.byteLength||n.byteOffset!=t.byteOffset)return!1;n=n.buffer,t=t.buffer;case L:return!(n.byteLength!=t.byteLength||!i(new Gn(n),new Gn(t)));case w:case b:case k:return No(+n,+t);case x:return n.name==t.name&&n.message==t.message;case B:case R:return n==t+"";case E:var a=fr;case z:var f=1&e;if(a||(a=sr),n.size!=t.size&&!f)return!1;var c=o.get(n);if(c)return c==t;e|=2,o.set(n,t);var l=ei(a(n),a(t),e,u,i,o);return o.delete(n),l;case S:if(Dr)return Dr.call(n)==Dr.call(t)}return!1}(n,t,c,r,e,i,o);if(!(1&r)){var v=s&&Un.call(n,"__wrapped__"),_=h&&Un.call(t,"__wrapped__");if(v||_){var g=v?n.value():n,d=_?t.value():t;return o||(o=new Jr),i(g,d,r,e,o)}}if(!p)return!1;return o||(o=new Jr),function(n,t,r,e,i,o){var a=1&r,f=ii(n),c=f.length,l=ii(t).length;if(c!=l&&!a)return!1;var s=c;for(;s--;){var h=f[s];if(!(a?h in t:Un.call(t,h)))return!1}var p=o.get(n),v=o.get(t);if(p&&v)return p==t&&v==n;var _=!0;o.set(n,t),o.set(t,n);var g=a;for(;++s<c;){var d=n[h=f[s]],y=t[h];if(e)var m=a?e(y,d,h,t,n,o):e(d,y,h,n,t,o);if(!(m===u?d===y||i(d,y,r,e,o):m)){_=!1;break}g||(g="constructor"==h)}if(_&&!g){var w=n.constructor,b=t.constructor;w==b||!("constructor"in n)||!("constructor"in t)||"function"==typeof w&&w instanceof w&&"function"==typeof b&&b instanceof b||(_=!1)}return o.delete(n),o.delete(t),_}(n,t,r,e,i,o)}(n,t,r,e,Le,i))}function Te(n,t,r,e){var i=r.length,o=i,a=!e;if(null==n)return!o;for(n=On(n);i--;){var f=r[i];if(a&&f[2]?f[1]!==n[f[0]]:!(f[0]in n))return!1}for(;++i<o;){var c=(f=r[i])[0],l=n[c],s=f[1];if(a&&f[2]){if(l===u&&!(c in n))return!1}else{var h=new Jr;if(e)var p=e(l,s,c,n,t,h);if(!(p===u?Le(s,l,3,e,h):p))return!1}}return!0}function Fe(n){return!(!ea(n)||(t=n,$n&&$n in t))&&(na(n)?Nn:mn).test(Di(n));var t}function Ue(n){return"function"==typeof n?n:null==n?af:"object"==typeof n?Ko(n)?Ne(n[0],n[1]):Pe(n):gf(n)}function We(n){if(!Ei(n))return mr(n);var t=[];for(var r in On(n))Un.call(n,r)&&"constructor"!=r&&t.push(r);return t}function $e(n){if(!ea(n))return function(n){var t=[];if(null!=n)for(var r in On(n))t.push(r);return t}(n);var t=Ei(n),r=[];for(var e in n)("constructor"!=e||!t&&Un.call(n,e))&&r.push(e);return r}function De(n,t){return n<t}function Me(n,t){var r=-1,u=Ho(n)?e(n.length):[];return ve(n,(function(n,e,i){u[++r]=t(n,e,i)})),u}function Pe(n){var t=hi(n);return 1==t.length&&t[0][2]?Ii(t[0][0],t[0][1]):function(r){return r===n||Te(r,n,t)}}function Ne(n,t){return xi(n)&&ki(t)?Ii($i(n),t):function(r){var e=Ba(r,n);return e===u&&e===t?za(r,n):Le(t,e,3)}}function qe(n,t,r,e,i){n!==t&&we(t,(function(o,a){if(i||(i=new Jr),ea(o))!function(n,t,r,e,i,o,a){var f=Ri(n,r),c=Ri(t,r),l=a.get(c);if(l)return void re(n,r,l);var s=o?o(f,c,r+"",n,t,a):u,h=s===u;if(h){var p=Ko(c),v=!p&&Jo(c),_=!p&&!v&&ha(c);s=c,p||v||_?Ko(f)?s=f:Yo(f)?s=Ru(f):v?(h=!1,s=Eu(c,!0)):_?(h=!1,s=Iu(c,!0)):s=[]:aa(c)||Go(c)?(s=f,Go(f)?s=wa(f):ea(f)&&!na(f)||(s=yi(c))):h=!1}h&&(a.set(c,s),i(s,c,e,o,a),a.delete(c));re(n,r,s)}(n,t,a,r,qe,e,i);else{var f=e?e(Ri(n,a),o,a+"",n,t,i):u;f===u&&(f=o),re(n,a,f)}}),Ta)}function Ze(n,t){var r=n.length;if(r)return wi(t+=t<0?r:0,r)?n[t]:u}function Ge(n,t,r){t=t.length?Lt(t,(function(n){return Ko(n)?function(t){return Ee(t,1===n.length?n[0]:n)}:n})):[af];var e=-1;t=Lt(t,Qt(li()));var u=Me(n,(function(n,r,u){var i=Lt(t,(function(t){return t(n)}));return{criteria:i,index:++e,value:n}}));return function(n,t){var r=n.length;for(n.sort(t);r--;)n[r]=n[r].value;return n}(u,(function(n,t){return function(n,t,r){var e=-1,u=n.criteria,i=t.criteria,o=u.length,a=r.length;for(;++e<o;){var f=Ou(u[e],i[e]);if(f)return e>=a?f:f*("desc"==r[e]?-1:1)}return n.index-t.index}(n,t,r)}))}function Ke(n,t,r){for(var e=-1,u=t.length,i={};++e<u;){var o=t[e],a=Ee(n,o);r(a,o)&&tu(i,bu(o,n),a)}return i}function Ve(n,t,r,e){var u=e?Nt:Pt,i=-1,o=t.length,a=n;for(n===t&&(t=Ru(t)),r&&(a=Lt(n,Qt(r)));++i<o;)for(var f=0,c=t[i],l=r?r(c):c;(f=u(a,l,f,e))>-1;)a!==n&&Jn.call(a,f,1),Jn.call(n,f,1);return n}function He(n,t){for(var r=n?t.length:0,e=r-1;r--;){var u=t[r];if(r==e||u!==i){var i=u;wi(u)?Jn.call(n,u,1):pu(n,u)}}return n}function Ye(n,t){return n+yt(Ar()*(t-n+1))}function Je(n,t){var r="";if(!n||t<1||t>v)return r;do{t%2&&(r+=n),(t=yt(t/2))&&(n+=n)}while(t);return r}function Qe(n,t){return Li(Oi(n,t,af),n+"")}function Xe(n){return Xr(Na(n))}function nu(n,t){var r=Na(n);return Ui(r,ce(t,0,r.length))}function tu(n,t,r,e){if(!ea(n))return n;for(var i=-1,o=(t=bu(t,n)).length,a=o-1,f=n;null!=f&&++i<o;){var c=$i(t[i]),l=r;if("__proto__"===c||"constructor"===c||"prototype"===c)return n;if(i!=a){var s=f[c];(l=e?e(s,c,f):u)===u&&(l=ea(s)?s:wi(t[i+1])?[]:{})}ee(f,c,l),f=f[c]}return n}var ru=Sr?function(n,t){return Sr.set(n,t),n}:af,eu=ct?function(n,t){return ct(n,"toString",{configurable:!0,enumerable:!1,value:ef(t),writable:!0})}:af;function uu(n){return Ui(Na(n))}function iu(n,t,r){var u=-1,i=n.length;t<0&&(t=-t>i?0:i+t),(r=r>i?i:r)<0&&(r+=i),i=t>r?0:r-t>>>0,t>>>=0;for(var o=e(i);++u<i;)o[u]=n[u+t];return o}function ou(n,t){var r;return ve(n,(function(n,e,u){return!(r=t(n,e,u))})),!!r}function au(n,t,r){var e=0,u=null==n?e:n.length;if("number"==typeof t&&t==t&&u<=2147483647){for(;e<u;){var i=e+u>>>1,o=n[i];null!==o&&!sa(o)&&(r?o<=t:o<t)?e=i+1:u=i}return u}return fu(n,t,af,r)}function fu(n,t,r,e){var i=0,o=null==n?0:n.length;if(0===o)return 0;for(var a=(t=r(t))!=t,f=null===t,c=sa(t),l=t===u;i<o;){var s=yt((i+o)/2),h=r(n[s]),p=h!==u,v=null===h,_=h==h,g=sa(h);if(a)var d=e||_;else d=l?_&&(e||p):f?_&&p&&(e||!v):c?_&&p&&!v&&(e||!g):!v&&!g&&(e?h<=t:h<t);d?i=s+1:o=s}return br(o,4294967294)}function cu(n,t){for(var r=-1,e=n.length,u=0,i=[];++r<e;){var o=n[r],a=t?t(o):o;if(!r||!No(a,f)){var f=a;i[u++]=0===o?0:o}}return i}function lu(n){return"number"==typeof n?n:sa(n)?_:+n}function su(n){if("string"==typeof n)return n;if(Ko(n))return Lt(n,su)+"";if(sa(n))return Mr?Mr.call(n):"";var t=n+"";return"0"==t&&1/n==-1/0?"-0":t}function hu(n,t,r){var e=-1,u=St,i=n.length,o=!0,a=[],f=a;if(r)o=!1,u=Ct;else if(i>=200){var c=t?null:Ju(n);if(c)return sr(c);o=!1,u=nr,f=new Yr}else f=t?[]:a;n:for(;++e<i;){var l=n[e],s=t?t(l):l;if(l=r||0!==l?l:0,o&&s==s){for(var h=f.length;h--;)if(f[h]===s)continue n;t&&f.push(s),a.push(l)}else u(f,s,r)||(f!==a&&f.push(s),a.push(l))}return a}function pu(n,t){return null==(n=Bi(n,t=bu(t,n)))||delete n[$i(Qi(t))]}function vu(n,t,r,e){return tu(n,t,r(Ee(n,t)),e)}function _u(n,t,r,e){for(var u=n.length,i=e?u:-1;(e?i--:++i<u)&&t(n[i],i,n););return r?iu(n,e?0:i,e?i+1:u):iu(n,e?i+1:0,e?u:i)}function gu(n,t){var r=n;return r instanceof Gr&&(r=r.value()),Ft(t,(function(n,t){return t.func.apply(t.thisArg,Tt([n],t.args))}),r)}function du(n,t,r){var u=n.length;if(u<2)return u?hu(n[0]):[];for(var i=-1,o=e(u);++i<u;)for(var a=n[i],f=-1;++f<u;)f!=i&&(o[i]=pe(o[i]||a,n[f],t,r));return hu(me(o,1),t,r)}function yu(n,t,r){for(var e=-1,i=n.length,o=t.length,a={};++e<i;){var f=e<o?t[e]:u;r(a,n[e],f)}return a}function mu(n){return Yo(n)?n:[]}function wu(n){return"function"==typeof n?n:af}function bu(n,t){return Ko(n)?n:xi(n,t)?[n]:Wi(ba(n))}var xu=Qe;function ju(n,t,r){var e=n.length;return r=r===u?e:r,!t&&r>=e?n:iu(n,t,r)}var Au=ht||function(n){return vt.clearTimeout(n)};function Eu(n,t){if(t)return n.slice();var r=n.length,e=Kn?Kn(r):new n.constructor(r);return n.copy(e),e}function ku(n){var t=new n.constructor(n.byteLength);return new Gn(t).set(new Gn(n)),t}function Iu(n,t){var r=t?ku(n.buffer):n.buffer;return new n.constructor(r,n.byteOffset,n.length)}function Ou(n,t){if(n!==t){var r=n!==u,e=null===n,i=n==n,o=sa(n),a=t!==u,f=null===t,c=t==t,l=sa(t);if(!f&&!l&&!o&&n>t||o&&a&&c&&!f&&!l||e&&a&&c||!r&&c||!i)return 1;if(!e&&!o&&!l&&n<t||l&&r&&i&&!e&&!o||f&&r&&i||!a&&i||!c)return-1}return 0}function Bu(n,t,r,u){for(var i=-1,o=n.length,a=r.length,f=-1,c=t.length,l=wr(o-a,0),s=e(c+l),h=!u;++f<c;)s[f]=t[f];for(;++i<a;)(h||i<o)&&(s[r[i]]=n[i]);for(;l--;)s[f++]=n[i++];return s}function zu(n,t,r,u){for(var i=-1,o=n.length,a=-1,f=r.length,c=-1,l=t.length,s=wr(o-f,0),h=e(s+l),p=!u;++i<s;)h[i]=n[i];for(var v=i;++c<l;)h[v+c]=t[c];for(;++a<f;)(p||i<o)&&(h[v+r[a]]=n[i++]);return h}function Ru(n,t){var r=-1,u=n.length;for(t||(t=e(u));++r<u;)t[r]=n[r];return t}function Su(n,t,r,e){var i=!r;r||(r={});for(var o=-1,a=t.length;++o<a;){var f=t[o],c=e?e(r[f],n[f],f,r,n):u;c===u&&(c=n[f]),i?ae(r,f,c):ee(r,f,c)}return r}function Cu(n,t){return function(r,e){var u=Ko(r)?It:ie,i=t?t():{};return u(r,n,li(e,2),i)}}function Lu(n){return Qe((function(t,r){var e=-1,i=r.length,o=i>1?r[i-1]:u,a=i>2?r[2]:u;for(o=n.length>3&&"function"==typeof o?(i--,o):u,a&&bi(r[0],r[1],a)&&(o=i<3?u:o,i=1),t=On(t);++e<i;){var f=r[e];f&&n(t,f,e,o)}return t}))}function Tu(n,t){return function(r,e){if(null==r)return r;if(!Ho(r))return n(r,e);for(var u=r.length,i=t?u:-1,o=On(r);(t?i--:++i<u)&&!1!==e(o[i],i,o););return r}}function Fu(n){return function(t,r,e){for(var u=-1,i=On(t),o=e(t),a=o.length;a--;){var f=o[n?a:++u];if(!1===r(i[f],f,i))break}return t}}function Uu(n){return function(t){var r=ar(t=ba(t))?vr(t):u,e=r?r[0]:t.charAt(0),i=r?ju(r,1).join(""):t.slice(1);return e[n]()+i}}function Wu(n){return function(t){return Ft(nf(Ga(t).replace(Xn,"")),n,"")}}function $u(n){return function(){var t=arguments;switch(t.length){case 0:return new n;case 1:return new n(t[0]);case 2:return new n(t[0],t[1]);case 3:return new n(t[0],t[1],t[2]);case 4:return new n(t[0],t[1],t[2],t[3]);case 5:return new n(t[0],t[1],t[2],t[3],t[4]);case 6:return new n(t[0],t[1],t[2],t[3],t[4],t[5]);case 7:return new n(t[0],t[1],t[2],t[3],t[4],t[5],t[6])}var r=Nr(n.prototype),e=n.apply(r,t);return ea(e)?e:r}}function Du(n){return function(t,r,e){var i=On(t);if(!Ho(t)){var o=li(r,3);t=La(t),r=function(n){return o(i[n],n,i)}}var a=n(t,r,e);return a>-1?i[o?t[a]:a]:u}}function Mu(n){return ui((function(t){var r=t.length,e=r,o=Zr.prototype.thru;for(n&&t.reverse();e--;){var a=t[e];if("function"!=typeof a)throw new Rn(i);if(o&&!f&&"wrapper"==fi(a))var f=new Zr([],!0)}for(e=f?e:r;++e<r;){var c=fi(a=t[e]),l="wrapper"==c?ai(a):u;f=l&&ji(l[0])&&424==l[1]&&!l[4].length&&1==l[9]?f[fi(l[0])].apply(f,l[3]):1==a.length&&ji(a)?f[c]():f.thru(a)}return function(){var n=arguments,e=n[0];if(f&&1==n.length&&Ko(e))return f.plant(e).value();for(var u=0,i=r?t[u].apply(this,n):e;++u<r;)i=t[u].call(this,i);return i}}))}function Pu(n,t,r,i,o,a,f,c,l,h){var p=t&s,v=1&t,_=2&t,g=24&t,d=512&t,y=_?u:$u(n);return function u(){for(var s=arguments.length,m=e(s),w=s;w--;)m[w]=arguments[w];if(g)var b=ci(u),x=er(m,b);if(i&&(m=Bu(m,i,o,g)),a&&(m=zu(m,a,f,g)),s-=x,g&&s<h){var j=lr(m,b);return Hu(n,t,Pu,u.placeholder,r,m,j,c,l,h-s)}var A=v?r:this,E=_?A[n]:n;return s=m.length,c?m=zi(m,c):d&&s>1&&m.reverse(),p&&l<s&&(m.length=l),this&&this!==vt&&this instanceof u&&(E=y||$u(E)),E.apply(A,m)}}function Nu(n,t){return function(r,e){return function(n,t,r,e){return xe(n,(function(n,u,i){t(e,r(n),u,i)})),e}(r,n,t(e),{})}}function qu(n,t){return function(r,e){var i;if(r===u&&e===u)return t;if(r!==u&&(i=r),e!==u){if(i===u)return e;"string"==typeof r||"string"==typeof e?(r=su(r),e=su(e)):(r=lu(r),e=lu(e)),i=n(r,e)}return i}}function Zu(n){return ui((function(t){return t=Lt(t,Qt(li())),Qe((function(r){var e=this;return n(t,(function(n){return kt(n,e,r)}))}))}))}function Gu(n,t){var r=(t=t===u?" ":su(t)).length;if(r<2)return r?Je(t,n):t;var e=Je(t,gt(n/pr(t)));return ar(t)?ju(vr(e),0,n).join(""):e.slice(0,n)}function Ku(n){return function(t,r,i){return i&&"number"!=typeof i&&bi(t,r,i)&&(r=i=u),t=ga(t),r===u?(r=t,t=0):r=ga(r),function(n,t,r,u){for(var i=-1,o=wr(gt((t-n)/(r||1)),0),a=e(o);o--;)a[u?o:++i]=n,n+=r;return a}(t,r,i=i===u?t<r?1:-1:ga(i),n)}}function Vu(n){return function(t,r){return"string"==typeof t&&"string"==typeof r||(t=ma(t),r=ma(r)),n(t,r)}}function Hu(n,t,r,e,i,o,a,f,s,h){var p=8&t;t|=p?c:l,4&(t&=~(p?l:c))||(t&=-4);var v=[n,t,i,p?o:u,p?a:u,p?u:o,p?u:a,f,s,h],_=r.apply(u,v);return ji(n)&&Si(_,v),_.placeholder=e,Ti(_,n,t)}function Yu(n){var t=In[n];return function(n,r){if(n=ma(n),(r=null==r?0:br(da(r),292))&&Kt(n)){var e=(ba(n)+"e").split("e");return+((e=(ba(t(e[0]+"e"+(+e[1]+r)))+"e").split("e"))[0]+"e"+(+e[1]-r))}return t(n)}}var Ju=Br&&1/sr(new Br([,-0]))[1]==p?function(n){return new Br(n)}:hf;function Qu(n){return function(t){var r=gi(t);return r==E?fr(t):r==z?hr(t):function(n,t){return Lt(t,(function(t){return[t,n[t]]}))}(t,n(t))}}function Xu(n,t,r,o,p,v,_,g){var d=2&t;if(!d&&"function"!=typeof n)throw new Rn(i);var y=o?o.length:0;if(y||(t&=-97,o=p=u),_=_===u?_:wr(da(_),0),g=g===u?g:da(g),y-=p?p.length:0,t&l){var m=o,w=p;o=p=u}var b=d?u:ai(n),x=[n,t,r,o,p,m,w,v,_,g];if(b&&function(n,t){var r=n[1],e=t[1],u=r|e,i=u<131,o=e==s&&8==r||e==s&&r==h&&n[7].length<=t[8]||384==e&&t[7].length<=t[8]&&8==r;if(!i&&!o)return n;1&e&&(n[2]=t[2],u|=1&r?0:4);var f=t[3];if(f){var c=n[3];n[3]=c?Bu(c,f,t[4]):f,n[4]=c?lr(n[3],a):t[4]}(f=t[5])&&(c=n[5],n[5]=c?zu(c,f,t[6]):f,n[6]=c?lr(n[5],a):t[6]);(f=t[7])&&(n[7]=f);e&s&&(n[8]=null==n[8]?t[8]:br(n[8],t[8]));null==n[9]&&(n[9]=t[9]);n[0]=t[0],n[1]=u}(x,b),n=x[0],t=x[1],r=x[2],o=x[3],p=x[4],!(g=x[9]=x[9]===u?d?0:n.length:wr(x[9]-y,0))&&24&t&&(t&=-25),t&&1!=t)j=8==t||t==f?function(n,t,r){var i=$u(n);return function o(){for(var a=arguments.length,f=e(a),c=a,l=ci(o);c--;)f[c]=arguments[c];var s=a<3&&f[0]!==l&&f[a-1]!==l?[]:lr(f,l);return(a-=s.length)<r?Hu(n,t,Pu,o.placeholder,u,f,s,u,u,r-a):kt(this&&this!==vt&&this instanceof o?i:n,this,f)}}(n,t,g):t!=c&&33!=t||p.length?Pu.apply(u,x):function(n,t,r,u){var i=1&t,o=$u(n);return function t(){for(var a=-1,f=arguments.length,c=-1,l=u.length,s=e(l+f),h=this&&this!==vt&&this instanceof t?o:n;++c<l;)s[c]=u[c];for(;f--;)s[c++]=arguments[++a];return kt(h,i?r:this,s)}}(n,t,r,o);else var j=function(n,t,r){var e=1&t,u=$u(n);return function t(){return(this&&this!==vt&&this instanceof t?u:n).apply(e?r:this,arguments)}}(n,t,r);return Ti((b?ru:Si)(j,x),n,t)}function ni(n,t,r,e){return n===u||No(n,Ln[r])&&!Un.call(e,r)?t:n}function ti(n,t,r,e,i,o){return ea(n)&&ea(t)&&(o.set(t,n),qe(n,t,u,ti,o),o.delete(t)),n}function ri(n){return aa(n)?u:n}function ei(n,t,r,e,i,o){var a=1&r,f=n.length,c=t.length;if(f!=c&&!(a&&c>f))return!1;var l=o.get(n),s=o.get(t);if(l&&s)return l==t&&s==n;var h=-1,p=!0,v=2&r?new Yr:u;for(o.set(n,t),o.set(t,n);++h<f;){var _=n[h],g=t[h];if(e)var d=a?e(g,_,h,t,n,o):e(_,g,h,n,t,o);if(d!==u){if(d)continue;p=!1;break}if(v){if(!Wt(t,(function(n,t){if(!nr(v,t)&&(_===n||i(_,n,r,e,o)))return v.push(t)}))){p=!1;break}}else if(_!==g&&!i(_,g,r,e,o)){p=!1;break}}return o.delete(n),o.delete(t),p}function ui(n){return Li(Oi(n,u,Ki),n+"")}function ii(n){return ke(n,La,vi)}function oi(n){return ke(n,Ta,_i)}var ai=Sr?function(n){return Sr.get(n)}:hf;function fi(n){for(var t=n.name+"",r=Cr[t],e=Un.call(Cr,t)?r.length:0;e--;){var u=r[e],i=u.func;if(null==i||i==n)return u.name}return t}function ci(n){return(Un.call(Pr,"placeholder")?Pr:n).placeholder}function li(){var n=Pr.iteratee||ff;return n=n===ff?Ue:n,arguments.length?n(arguments[0],arguments[1]):n}function si(n,t){var r,e,u=n.__data__;return("string"==(e=typeof(r=t))||"number"==e||"symbol"==e||"boolean"==e?"__proto__"!==r:null===r)?u["string"==typeof t?"string":"hash"]:u.map}function hi(n){for(var t=La(n),r=t.length;r--;){var e=t[r],u=n[e];t[r]=[e,u,ki(u)]}return t}function pi(n,t){var r=function(n,t){return null==n?u:n[t]}(n,t);return Fe(r)?r:u}var vi=mt?function(n){return null==n?[]:(n=On(n),Rt(mt(n),(function(t){return Yn.call(n,t)})))}:mf,_i=mt?function(n){for(var t=[];n;)Tt(t,vi(n)),n=Vn(n);return t}:mf,gi=Ie;function di(n,t,r){for(var e=-1,u=(t=bu(t,n)).length,i=!1;++e<u;){var o=$i(t[e]);if(!(i=null!=n&&r(n,o)))break;n=n[o]}return i||++e!=u?i:!!(u=null==n?0:n.length)&&ra(u)&&wi(o,u)&&(Ko(n)||Go(n))}function yi(n){return"function"!=typeof n.constructor||Ei(n)?{}:Nr(Vn(n))}function mi(n){return Ko(n)||Go(n)||!!(Qn&&n&&n[Qn])}function wi(n,t){var r=typeof n;return!!(t=null==t?v:t)&&("number"==r||"symbol"!=r&&bn.test(n))&&n>-1&&n%1==0&&n<t}function bi(n,t,r){if(!ea(r))return!1;var e=typeof t;return!!("number"==e?Ho(r)&&wi(t,r.length):"string"==e&&t in r)&&No(r[t],n)}function xi(n,t){if(Ko(n))return!1;var r=typeof n;return!("number"!=r&&"symbol"!=r&&"boolean"!=r&&null!=n&&!sa(n))||(rn.test(n)||!tn.test(n)||null!=t&&n in On(t))}function ji(n){var t=fi(n),r=Pr[t];if("function"!=typeof r||!(t in Gr.prototype))return!1;if(n===r)return!0;var e=ai(r);return!!e&&n===e[0]}(kr&&gi(new kr(new ArrayBuffer(1)))!=T||Ir&&gi(new Ir)!=E||Or&&gi(Or.resolve())!=O||Br&&gi(new Br)!=z||zr&&gi(new zr)!=C)&&(gi=function(n){var t=Ie(n),r=t==I?n.constructor:u,e=r?Di(r):"";if(e)switch(e){case Lr:return T;case Tr:return E;case Fr:return O;case Ur:return z;case Wr:return C}return t});var Ai=Tn?na:wf;function Ei(n){var t=n&&n.constructor;return n===("function"==typeof t&&t.prototype||Ln)}function ki(n){return n==n&&!ea(n)}function Ii(n,t){return function(r){return null!=r&&(r[n]===t&&(t!==u||n in On(r)))}}function Oi(n,t,r){return t=wr(t===u?n.length-1:t,0),function(){for(var u=arguments,i=-1,o=wr(u.length-t,0),a=e(o);++i<o;)a[i]=u[t+i];i=-1;for(var f=e(t+1);++i<t;)f[i]=u[i];return f[t]=r(a),kt(n,this,f)}}function Bi(n,t){return t.length<2?n:Ee(n,iu(t,0,-1))}function zi(n,t){for(var r=n.length,e=br(t.length,r),i=Ru(n);e--;){var o=t[e];n[e]=wi(o,r)?i[o]:u}return n}function Ri(n,t){if(("constructor"!==t||"function"!=typeof n[t])&&"__proto__"!=t)return n[t]}var Si=Fi(ru),Ci=_t||function(n,t){return vt.setTimeout(n,t)},Li=Fi(eu);function Ti(n,t,r){var e=t+"";return Li(n,function(n,t){var r=t.length;if(!r)return n;var e=r-1;return t[e]=(r>1?"& ":"")+t[e],t=t.join(r>2?", ":" "),n.replace(cn,"{\n/* [wrapped with "+t+"] */\n")}(e,function(n,t){return Ot(d,(function(r){var e="_."+r[0];t&r[1]&&!St(n,e)&&n.push(e)})),n.sort()}(function(n){var t=n.match(ln);return t?t[1].split(sn):[]}(e),r)))}function Fi(n){var t=0,r=0;return function(){var e=xr(),i=16-(e-r);if(r=e,i>0){if(++t>=800)return arguments[0]}else t=0;return n.apply(u,arguments)}}function Ui(n,t){var r=-1,e=n.length,i=e-1;for(t=t===u?e:t;++r<t;){var o=Ye(r,i),a=n[o];n[o]=n[r],n[r]=a}return n.length=t,n}var Wi=function(n){var t=Uo(n,(function(n){return 500===r.size&&r.clear(),n})),r=t.cache;return t}((function(n){var t=[];return 46===n.charCodeAt(0)&&t.push(""),n.replace(en,(function(n,r,e,u){t.push(e?u.replace(vn,"$1"):r||n)})),t}));function $i(n){if("string"==typeof n||sa(n))return n;var t=n+"";return"0"==t&&1/n==-1/0?"-0":t}function Di(n){if(null!=n){try{return Fn.call(n)}catch(n){}try{return n+""}catch(n){}}return""}function Mi(n){if(n instanceof Gr)return n.clone();var t=new Zr(n.__wrapped__,n.__chain__);return t.__actions__=Ru(n.__actions__),t.__index__=n.__index__,t.__values__=n.__values__,t}var Pi=Qe((function(n,t){return Yo(n)?pe(n,me(t,1,Yo,!0)):[]})),Ni=Qe((function(n,t){var r=Qi(t);return Yo(r)&&(r=u),Yo(n)?pe(n,me(t,1,Yo,!0),li(r,2)):[]})),qi=Qe((function(n,t){var r=Qi(t);return Yo(r)&&(r=u),Yo(n)?pe(n,me(t,1,Yo,!0),u,r):[]}));function Zi(n,t,r){var e=null==n?0:n.length;if(!e)return-1;var u=null==r?0:da(r);return u<0&&(u=wr(e+u,0)),Mt(n,li(t,3),u)}function Gi(n,t,r){var e=null==n?0:n.length;if(!e)return-1;var i=e-1;return r!==u&&(i=da(r),i=r<0?wr(e+i,0):br(i,e-1)),Mt(n,li(t,3),i,!0)}function Ki(n){return(null==n?0:n.length)?me(n,1):[]}function Vi(n){return n&&n.length?n[0]:u}var Hi=Qe((function(n){var t=Lt(n,mu);return t.length&&t[0]===n[0]?Re(t):[]})),Yi=Qe((function(n){var t=Qi(n),r=Lt(n,mu);return t===Qi(r)?t=u:r.pop(),r.length&&r[0]===n[0]?Re(r,li(t,2)):[]})),Ji=Qe((function(n){var t=Qi(n),r=Lt(n,mu);return(t="function"==typeof t?t:u)&&r.pop(),r.length&&r[0]===n[0]?Re(r,u,t):[]}));function Qi(n){var t=null==n?0:n.length;return t?n[t-1]:u}var Xi=Qe(no);function no(n,t){return n&&n.length&&t&&t.length?Ve(n,t):n}var to=ui((function(n,t){var r=null==n?0:n.length,e=fe(n,t);return He(n,Lt(t,(function(n){return wi(n,r)?+n:n})).sort(Ou)),e}));function ro(n){return null==n?n:Er.call(n)}var eo=Qe((function(n){return hu(me(n,1,Yo,!0))})),uo=Qe((function(n){var t=Qi(n);return Yo(t)&&(t=u),hu(me(n,1,Yo,!0),li(t,2))})),io=Qe((function(n){var t=Qi(n);return t="function"==typeof t?t:u,hu(me(n,1,Yo,!0),u,t)}));function oo(n){if(!n||!n.length)return[];var t=0;return n=Rt(n,(function(n){if(Yo(n))return t=wr(n.length,t),!0})),Yt(t,(function(t){return Lt(n,Gt(t))}))}function ao(n,t){if(!n||!n.length)return[];var r=oo(n);return null==t?r:Lt(r,(function(n){return kt(t,u,n)}))}var fo=Qe((function(n,t){return Yo(n)?pe(n,t):[]})),co=Qe((function(n){return du(Rt(n,Yo))})),lo=Qe((function(n){var t=Qi(n);return Yo(t)&&(t=u),du(Rt(n,Yo),li(t,2))})),so=Qe((function(n){var t=Qi(n);return t="function"==typeof t?t:u,du(Rt(n,Yo),u,t)})),ho=Qe(oo);var po=Qe((function(n){var t=n.length,r=t>1?n[t-1]:u;return r="function"==typeof r?(n.pop(),r):u,ao(n,r)}));function vo(n){var t=Pr(n);return t.__chain__=!0,t}function _o(n,t){return t(n)}var go=ui((function(n){var t=n.length,r=t?n[0]:0,e=this.__wrapped__,i=function(t){return fe(t,n)};return!(t>1||this.__actions__.length)&&e instanceof Gr&&wi(r)?((e=e.slice(r,+r+(t?1:0))).__actions__.push({func:_o,args:[i],thisArg:u}),new Zr(e,this.__chain__).thru((function(n){return t&&!n.length&&n.push(u),n}))):this.thru(i)}));var yo=Cu((function(n,t,r){Un.call(n,r)?++n[r]:ae(n,r,1)}));var mo=Du(Zi),wo=Du(Gi);function bo(n,t){return(Ko(n)?Ot:ve)(n,li(t,3))}function xo(n,t){return(Ko(n)?Bt:_e)(n,li(t,3))}var jo=Cu((function(n,t,r){Un.call(n,r)?n[r].push(t):ae(n,r,[t])}));var Ao=Qe((function(n,t,r){var u=-1,i="function"==typeof t,o=Ho(n)?e(n.length):[];return ve(n,(function(n){o[++u]=i?kt(t,n,r):Se(n,t,r)})),o})),Eo=Cu((function(n,t,r){ae(n,r,t)}));function ko(n,t){return(Ko(n)?Lt:Me)(n,li(t,3))}var Io=Cu((function(n,t,r){n[r?0:1].push(t)}),(function(){return[[],[]]}));var Oo=Qe((function(n,t){if(null==n)return[];var r=t.length;return r>1&&bi(n,t[0],t[1])?t=[]:r>2&&bi(t[0],t[1],t[2])&&(t=[t[0]]),Ge(n,me(t,1),[])})),Bo=pt||function(){return vt.Date.now()};function zo(n,t,r){return t=r?u:t,t=n&&null==t?n.length:t,Xu(n,s,u,u,u,u,t)}function Ro(n,t){var r;if("function"!=typeof t)throw new Rn(i);return n=da(n),function(){return--n>0&&(r=t.apply(this,arguments)),n<=1&&(t=u),r}}var So=Qe((function(n,t,r){var e=1;if(r.length){var u=lr(r,ci(So));e|=c}return Xu(n,e,t,r,u)})),Co=Qe((function(n,t,r){var e=3;if(r.length){var u=lr(r,ci(Co));e|=c}return Xu(t,e,n,r,u)}));function Lo(n,t,r){var e,o,a,f,c,l,s=0,h=!1,p=!1,v=!0;if("function"!=typeof n)throw new Rn(i);function _(t){var r=e,i=o;return e=o=u,s=t,f=n.apply(i,r)}function g(n){return s=n,c=Ci(y,t),h?_(n):f}function d(n){var r=n-l;return l===u||r>=t||r<0||p&&n-s>=a}function y(){var n=Bo();if(d(n))return m(n);c=Ci(y,function(n){var r=t-(n-l);return p?br(r,a-(n-s)):r}(n))}function m(n){return c=u,v&&e?_(n):(e=o=u,f)}function w(){var n=Bo(),r=d(n);if(e=arguments,o=this,l=n,r){if(c===u)return g(l);if(p)return Au(c),c=Ci(y,t),_(l)}return c===u&&(c=Ci(y,t)),f}return t=ma(t)||0,ea(r)&&(h=!!r.leading,a=(p="maxWait"in r)?wr(ma(r.maxWait)||0,t):a,v="trailing"in r?!!r.trailing:v),w.cancel=function(){c!==u&&Au(c),s=0,e=l=o=c=u},w.flush=function(){return c===u?f:m(Bo())},w}var To=Qe((function(n,t){return he(n,1,t)})),Fo=Qe((function(n,t,r){return he(n,ma(t)||0,r)}));function Uo(n,t){if("function"!=typeof n||null!=t&&"function"!=typeof t)throw new Rn(i);var r=function(){var e=arguments,u=t?t.apply(this,e):e[0],i=r.cache;if(i.has(u))return i.get(u);var o=n.apply(this,e);return r.cache=i.set(u,o)||i,o};return r.cache=new(Uo.Cache||Hr),r}function Wo(n){if("function"!=typeof n)throw new Rn(i);return function(){var t=arguments;switch(t.length){case 0:return!n.call(this);case 1:return!n.call(this,t[0]);case 2:return!n.call(this,t[0],t[1]);case 3:return!n.call(this,t[0],t[1],t[2])}return!n.apply(this,t)}}Uo.Cache=Hr;var $o=xu((function(n,t){var r=(t=1==t.length&&Ko(t[0])?Lt(t[0],Qt(li())):Lt(me(t,1),Qt(li()))).length;return Qe((function(e){for(var u=-1,i=br(e.length,r);++u<i;)e[u]=t[u].call(this,e[u]);return kt(n,this,e)}))})),Do=Qe((function(n,t){var r=lr(t,ci(Do));return Xu(n,c,u,t,r)})),Mo=Qe((function(n,t){var r=lr(t,ci(Mo));return Xu(n,l,u,t,r)})),Po=ui((function(n,t){return Xu(n,h,u,u,u,t)}));function No(n,t){return n===t||n!=n&&t!=t}var qo=Vu(Oe),Zo=Vu((function(n,t){return n>=t})),Go=Ce(function(){return arguments}())?Ce:function(n){return ua(n)&&Un.call(n,"callee")&&!Yn.call(n,"callee")},Ko=e.isArray,Vo=wt?Qt(wt):function(n){return ua(n)&&Ie(n)==L};function Ho(n){return null!=n&&ra(n.length)&&!na(n)}function Yo(n){return ua(n)&&Ho(n)}var Jo=$t||wf,Qo=bt?Qt(bt):function(n){return ua(n)&&Ie(n)==b};function Xo(n){if(!ua(n))return!1;var t=Ie(n);return t==x||"[object DOMException]"==t||"string"==typeof n.message&&"string"==typeof n.name&&!aa(n)}function na(n){if(!ea(n))return!1;var t=Ie(n);return t==j||t==A||"[object AsyncFunction]"==t||"[object Proxy]"==t}function ta(n){return"number"==typeof n&&n==da(n)}function ra(n){return"number"==typeof n&&n>-1&&n%1==0&&n<=v}function ea(n){var t=typeof n;return null!=n&&("object"==t||"function"==t)}function ua(n){return null!=n&&"object"==typeof n}var ia=xt?Qt(xt):function(n){return ua(n)&&gi(n)==E};function oa(n){return"number"==typeof n||ua(n)&&Ie(n)==k}function aa(n){if(!ua(n)||Ie(n)!=I)return!1;var t=Vn(n);if(null===t)return!0;var r=Un.call(t,"constructor")&&t.constructor;return"function"==typeof r&&r instanceof r&&Fn.call(r)==Mn}var fa=jt?Qt(jt):function(n){return ua(n)&&Ie(n)==B};var ca=At?Qt(At):function(n){return ua(n)&&gi(n)==z};function la(n){return"string"==typeof n||!Ko(n)&&ua(n)&&Ie(n)==R}function sa(n){return"symbol"==typeof n||ua(n)&&Ie(n)==S}var ha=Et?Qt(Et):function(n){return ua(n)&&ra(n.length)&&!!at[Ie(n)]};var pa=Vu(De),va=Vu((function(n,t){return n<=t}));function _a(n){if(!n)return[];if(Ho(n))return la(n)?vr(n):Ru(n);if(tt&&n[tt])return function(n){for(var t,r=[];!(t=n.next()).done;)r.push(t.value);return r}(n[tt]());var t=gi(n);return(t==E?fr:t==z?sr:Na)(n)}function ga(n){return n?(n=ma(n))===p||n===-1/0?17976931348623157e292*(n<0?-1:1):n==n?n:0:0===n?n:0}function da(n){var t=ga(n),r=t%1;return t==t?r?t-r:t:0}function ya(n){return n?ce(da(n),0,g):0}function ma(n){if("number"==typeof n)return n;if(sa(n))return _;if(ea(n)){var t="function"==typeof n.valueOf?n.valueOf():n;n=ea(t)?t+"":t}if("string"!=typeof n)return 0===n?n:+n;n=Jt(n);var r=yn.test(n);return r||wn.test(n)?st(n.slice(2),r?2:8):dn.test(n)?_:+n}function wa(n){return Su(n,Ta(n))}function ba(n){return null==n?"":su(n)}var xa=Lu((function(n,t){if(Ei(t)||Ho(t))Su(t,La(t),n);else for(var r in t)Un.call(t,r)&&ee(n,r,t[r])})),ja=Lu((function(n,t){Su(t,Ta(t),n)})),Aa=Lu((function(n,t,r,e){Su(t,Ta(t),n,e)})),Ea=Lu((function(n,t,r,e){Su(t,La(t),n,e)})),ka=ui(fe);var Ia=Qe((function(n,t){n=On(n);var r=-1,e=t.length,i=e>2?t[2]:u;for(i&&bi(t[0],t[1],i)&&(e=1);++r<e;)for(var o=t[r],a=Ta(o),f=-1,c=a.length;++f<c;){var l=a[f],s=n[l];(s===u||No(s,Ln[l])&&!Un.call(n,l))&&(n[l]=o[l])}return n})),Oa=Qe((function(n){return n.push(u,ti),kt(Ua,u,n)}));function Ba(n,t,r){var e=null==n?u:Ee(n,t);return e===u?r:e}function za(n,t){return null!=n&&di(n,t,ze)}var Ra=Nu((function(n,t,r){null!=t&&"function"!=typeof t.toString&&(t=Dn.call(t)),n[t]=r}),ef(af)),Sa=Nu((function(n,t,r){null!=t&&"function"!=typeof t.toString&&(t=Dn.call(t)),Un.call(n,t)?n[t].push(r):n[t]=[r]}),li),Ca=Qe(Se);function La(n){return Ho(n)?Qr(n):We(n)}function Ta(n){return Ho(n)?Qr(n,!0):$e(n)}var Fa=Lu((function(n,t,r){qe(n,t,r)})),Ua=Lu((function(n,t,r,e){qe(n,t,r,e)})),Wa=ui((function(n,t){var r={};if(null==n)return r;var e=!1;t=Lt(t,(function(t){return t=bu(t,n),e||(e=t.length>1),t})),Su(n,oi(n),r),e&&(r=le(r,7,ri));for(var u=t.length;u--;)pu(r,t[u]);return r}));var $a=ui((function(n,t){return null==n?{}:function(n,t){return Ke(n,t,(function(t,r){return za(n,r)}))}(n,t)}));function Da(n,t){if(null==n)return{};var r=Lt(oi(n),(function(n){return[n]}));return t=li(t),Ke(n,r,(function(n,r){return t(n,r[0])}))}var Ma=Qu(La),Pa=Qu(Ta);function Na(n){return null==n?[]:Xt(n,La(n))}var qa=Wu((function(n,t,r){return t=t.toLowerCase(),n+(r?Za(t):t)}));function Za(n){return Xa(ba(n).toLowerCase())}function Ga(n){return(n=ba(n))&&n.replace(xn,ur).replace(nt,"")}var Ka=Wu((function(n,t,r){return n+(r?"-":"")+t.toLowerCase()})),Va=Wu((function(n,t,r){return n+(r?" ":"")+t.toLowerCase()})),Ha=Uu("toLowerCase");var Ya=Wu((function(n,t,r){return n+(r?"_":"")+t.toLowerCase()}));var Ja=Wu((function(n,t,r){return n+(r?" ":"")+Xa(t)}));var Qa=Wu((function(n,t,r){return n+(r?" ":"")+t.toUpperCase()})),Xa=Uu("toUpperCase");function nf(n,t,r){return n=ba(n),(t=r?u:t)===u?function(n){return ut.test(n)}(n)?function(n){return n.match(rt)||[]}(n):function(n){return n.match(hn)||[]}(n):n.match(t)||[]}var tf=Qe((function(n,t){try{return kt(n,u,t)}catch(n){return Xo(n)?n:new En(n)}})),rf=ui((function(n,t){return Ot(t,(function(t){t=$i(t),ae(n,t,So(n[t],n))})),n}));function ef(n){return function(){return n}}var uf=Mu(),of=Mu(!0);function af(n){return n}function ff(n){return Ue("function"==typeof n?n:le(n,1))}var cf=Qe((function(n,t){return function(r){return Se(r,n,t)}})),lf=Qe((function(n,t){return function(r){return Se(n,r,t)}}));function sf(n,t,r){var e=La(t),u=Ae(t,e);null!=r||ea(t)&&(u.length||!e.length)||(r=t,t=n,n=this,u=Ae(t,La(t)));var i=!(ea(r)&&"chain"in r&&!r.chain),o=na(n);return Ot(u,(function(r){var e=t[r];n[r]=e,o&&(n.prototype[r]=function(){var t=this.__chain__;if(i||t){var r=n(this.__wrapped__),u=r.__actions__=Ru(this.__actions__);return u.push({func:e,args:arguments,thisArg:n}),r.__chain__=t,r}return e.apply(n,Tt([this.value()],arguments))})})),n}function hf(){}var pf=Zu(Lt),vf=Zu(zt),_f=Zu(Wt);function gf(n){return xi(n)?Gt($i(n)):function(n){return function(t){return Ee(t,n)}}(n)}var df=Ku(),yf=Ku(!0);function mf(){return[]}function wf(){return!1}var bf=qu((function(n,t){return n+t}),0),xf=Yu("ceil"),jf=qu((function(n,t){return n/t}),1),Af=Yu("floor");var Ef,kf=qu((function(n,t){return n*t}),1),If=Yu("round"),Of=qu((function(n,t){return n-t}),0);return Pr.after=function(n,t){if("function"!=typeof t)throw new Rn(i);return n=da(n),function(){if(--n<1)return t.apply(this,arguments)}},Pr.ary=zo,Pr.assign=xa,Pr.assignIn=ja,Pr.assignInWith=Aa,Pr.assignWith=Ea,Pr.at=ka,Pr.before=Ro,Pr.bind=So,Pr.bindAll=rf,Pr.bindKey=Co,Pr.castArray=function(){if(!arguments.length)return[];var n=arguments[0];return Ko(n)?n:[n]},Pr.chain=vo,Pr.chunk=function(n,t,r){t=(r?bi(n,t,r):t===u)?1:wr(da(t),0);var i=null==n?0:n.length;if(!i||t<1)return[];for(var o=0,a=0,f=e(gt(i/t));o<i;)f[a++]=iu(n,o,o+=t);return f},Pr.compact=function(n){for(var t=-1,r=null==n?0:n.length,e=0,u=[];++t<r;){var i=n[t];i&&(u[e++]=i)}return u},Pr.concat=function(){var n=arguments.length;if(!n)return[];for(var t=e(n-1),r=arguments[0],u=n;u--;)t[u-1]=arguments[u];return Tt(Ko(r)?Ru(r):[r],me(t,1))},Pr.cond=function(n){var t=null==n?0:n.length,r=li();return n=t?Lt(n,(function(n){if("function"!=typeof n[1])throw new Rn(i);return[r(n[0]),n[1]]})):[],Qe((function(r){for(var e=-1;++e<t;){var u=n[e];if(kt(u[0],this,r))return kt(u[1],this,r)}}))},Pr.conforms=function(n){return function(n){var t=La(n);return function(r){return se(r,n,t)}}(le(n,1))},Pr.constant=ef,Pr.countBy=yo,Pr.create=function(n,t){var r=Nr(n);return null==t?r:oe(r,t)},Pr.curry=function n(t,r,e){var i=Xu(t,8,u,u,u,u,u,r=e?u:r);return i.placeholder=n.placeholder,i},Pr.curryRight=function n(t,r,e){var i=Xu(t,f,u,u,u,u,u,r=e?u:r);return i.placeholder=n.placeholder,i},Pr.debounce=Lo,Pr.defaults=Ia,Pr.defaultsDeep=Oa,Pr.defer=To,Pr.delay=Fo,Pr.difference=Pi,Pr.differenceBy=Ni,Pr.differenceWith=qi,Pr.drop=function(n,t,r){var e=null==n?0:n.length;return e?iu(n,(t=r||t===u?1:da(t))<0?0:t,e):[]},Pr.dropRight=function(n,t,r){var e=null==n?0:n.length;return e?iu(n,0,(t=e-(t=r||t===u?1:da(t)))<0?0:t):[]},Pr.dropRightWhile=function(n,t){return n&&n.length?_u(n,li(t,3),!0,!0):[]},Pr.dropWhile=function(n,t){return n&&n.length?_u(n,li(t,3),!0):[]},Pr.fill=function(n,t,r,e){var i=null==n?0:n.length;return i?(r&&"number"!=typeof r&&bi(n,t,r)&&(r=0,e=i),function(n,t,r,e){var i=n.length;for((r=da(r))<0&&(r=-r>i?0:i+r),(e=e===u||e>i?i:da(e))<0&&(e+=i),e=r>e?0:ya(e);r<e;)n[r++]=t;return n}(n,t,r,e)):[]},Pr.filter=function(n,t){return(Ko(n)?Rt:ye)(n,li(t,3))},Pr.flatMap=function(n,t){return me(ko(n,t),1)},Pr.flatMapDeep=function(n,t){return me(ko(n,t),p)},Pr.flatMapDepth=function(n,t,r){return r=r===u?1:da(r),me(ko(n,t),r)},Pr.flatten=Ki,Pr.flattenDeep=function(n){return(null==n?0:n.length)?me(n,p):[]},Pr.flattenDepth=function(n,t){return(null==n?0:n.length)?me(n,t=t===u?1:da(t)):[]},Pr.flip=function(n){return Xu(n,512)},Pr.flow=uf,Pr.flowRight=of,Pr.fromPairs=function(n){for(var t=-1,r=null==n?0:n.length,e={};++t<r;){var u=n[t];e[u[0]]=u[1]}return e},Pr.functions=function(n){return null==n?[]:Ae(n,La(n))},Pr.functionsIn=function(n){return null==n?[]:Ae(n,Ta(n))},Pr.groupBy=jo,Pr.initial=function(n){return(null==n?0:n.length)?iu(n,0,-1):[]},Pr.intersection=Hi,Pr.intersectionBy=Yi,Pr.intersectionWith=Ji,Pr.invert=Ra,Pr.invertBy=Sa,Pr.invokeMap=Ao,Pr.iteratee=ff,Pr.keyBy=Eo,Pr.keys=La,Pr.keysIn=Ta,Pr.map=ko,Pr.mapKeys=function(n,t){var r={};return t=li(t,3),xe(n,(function(n,e,u){ae(r,t(n,e,u),n)})),r},Pr.mapValues=function(n,t){var r={};return t=li(t,3),xe(n,(function(n,e,u){ae(r,e,t(n,e,u))})),r},Pr.matches=function(n){return Pe(le(n,1))},Pr.matchesProperty=function(n,t){return Ne(n,le(t,1))},Pr.memoize=Uo,Pr.merge=Fa,Pr.mergeWith=Ua,Pr.method=cf,Pr.methodOf=lf,Pr.mixin=sf,Pr.negate=Wo,Pr.nthArg=function(n){return n=da(n),Qe((function(t){return Ze(t,n)}))},Pr.omit=Wa,Pr.omitBy=function(n,t){return Da(n,Wo(li(t)))},Pr.once=function(n){return Ro(2,n)},Pr.orderBy=function(n,t,r,e){return null==n?[]:(Ko(t)||(t=null==t?[]:[t]),Ko(r=e?u:r)||(r=null==r?[]:[r]),Ge(n,t,r))},Pr.over=pf,Pr.overArgs=$o,Pr.overEvery=vf,Pr.overSome=_f,Pr.partial=Do,Pr.partialRight=Mo,Pr.partition=Io,Pr.pick=$a,Pr.pickBy=Da,Pr.property=gf,Pr.propertyOf=function(n){return function(t){return null==n?u:Ee(n,t)}},Pr.pull=Xi,Pr.pullAll=no,Pr.pullAllBy=function(n,t,r){return n&&n.length&&t&&t.length?Ve(n,t,li(r,2)):n},Pr.pullAllWith=function(n,t,r){return n&&n.length&&t&&t.length?Ve(n,t,u,r):n},Pr.pullAt=to,Pr.range=df,Pr.rangeRight=yf,Pr.rearg=Po,Pr.reject=function(n,t){return(Ko(n)?Rt:ye)(n,Wo(li(t,3)))},Pr.remove=function(n,t){var r=[];if(!n||!n.length)return r;var e=-1,u=[],i=n.length;for(t=li(t,3);++e<i;){var o=n[e];t(o,e,n)&&(r.push(o),u.push(e))}return He(n,u),r},Pr.rest=function(n,t){if("function"!=typeof n)throw new Rn(i);return Qe(n,t=t===u?t:da(t))},Pr.reverse=ro,Pr.sampleSize=function(n,t,r){return t=(r?bi(n,t,r):t===u)?1:da(t),(Ko(n)?ne:nu)(n,t)},Pr.set=function(n,t,r){return null==n?n:tu(n,t,r)},Pr.setWith=function(n,t,r,e){return e="function"==typeof e?e:u,null==n?n:tu(n,t,r,e)},Pr.shuffle=function(n){return(Ko(n)?te:uu)(n)},Pr.slice=function(n,t,r){var e=null==n?0:n.length;return e?(r&&"number"!=typeof r&&bi(n,t,r)?(t=0,r=e):(t=null==t?0:da(t),r=r===u?e:da(r)),iu(n,t,r)):[]},Pr.sortBy=Oo,Pr.sortedUniq=function(n){return n&&n.length?cu(n):[]},Pr.sortedUniqBy=function(n,t){return n&&n.length?cu(n,li(t,2)):[]},Pr.split=function(n,t,r){return r&&"number"!=typeof r&&bi(n,t,r)&&(t=r=u),(r=r===u?g:r>>>0)?(n=ba(n))&&("string"==typeof t||null!=t&&!fa(t))&&!(t=su(t))&&ar(n)?ju(vr(n),0,r):n.split(t,r):[]},Pr.spread=function(n,t){if("function"!=typeof n)throw new Rn(i);return t=null==t?0:wr(da(t),0),Qe((function(r){var e=r[t],u=ju(r,0,t);return e&&Tt(u,e),kt(n,this,u)}))},Pr.tail=function(n){var t=null==n?0:n.length;return t?iu(n,1,t):[]},Pr.take=function(n,t,r){return n&&n.length?iu(n,0,(t=r||t===u?1:da(t))<0?0:t):[]},Pr.takeRight=function(n,t,r){var e=null==n?0:n.length;return e?iu(n,(t=e-(t=r||t===u?1:da(t)))<0?0:t,e):[]},Pr.takeRightWhile=function(n,t){return n&&n.length?_u(n,li(t,3),!1,!0):[]},Pr.takeWhile=function(n,t){return n&&n.length?_u(n,li(t,3)):[]},Pr.tap=function(n,t){return t(n),n},Pr.throttle=function(n,t,r){var e=!0,u=!0;if("function"!=typeof n)throw new Rn(i);return ea(r)&&(e="leading"in r?!!r.leading:e,u="trailing"in r?!!r.trailing:u),Lo(n,t,{leading:e,maxWait:t,trailing:u})},Pr.thru=_o,Pr.toArray=_a,Pr.toPairs=Ma,Pr.toPairsIn=Pa,Pr.toPath=function(n){return Ko(n)?Lt(n,$i):sa(n)?[n]:Ru(Wi(ba(n)))},Pr.toPlainObject=wa,Pr.transform=function(n,t,r){var e=Ko(n),u=e||Jo(n)||ha(n);if(t=li(t,4),null==r){var i=n&&n.constructor;r=u?e?new i:[]:ea(n)&&na(i)?Nr(Vn(n)):{}}return(u?Ot:xe)(n,(function(n,e,u){return t(r,n,e,u)})),r},Pr.unary=function(n){return zo(n,1)},Pr.union=eo,Pr.unionBy=uo,Pr.unionWith=io,Pr.uniq=function(n){return n&&n.length?hu(n):[]},Pr.uniqBy=function(n,t){return n&&n.length?hu(n,li(t,2)):[]},Pr.uniqWith=function(n,t){return t="function"==typeof t?t:u,n&&n.length?hu(n,u,t):[]},Pr.unset=function(n,t){return null==n||pu(n,t)},Pr.unzip=oo,Pr.unzipWith=ao,Pr.update=function(n,t,r){return null==n?n:vu(n,t,wu(r))},Pr.updateWith=function(n,t,r,e){return e="function"==typeof e?e:u,null==n?n:vu(n,t,wu(r),e)},Pr.values=Na,Pr.valuesIn=function(n){return null==n?[]:Xt(n,Ta(n))},Pr.without=fo,Pr.words=nf,Pr.wrap=function(n,t){return Do(wu(t),n)},Pr.xor=co,Pr.xorBy=lo,Pr.xorWith=so,Pr.zip=ho,Pr.zipObject=function(n,t){return yu(n||[],t||[],ee)},Pr.zipObjectDeep=function(n,t){return yu(n||[],t||[],tu)},Pr.zipWith=po,Pr.entries=Ma,Pr.entriesIn=Pa,Pr.extend=ja,Pr.extendWith=Aa,sf(Pr,Pr),Pr.add=bf,Pr.attempt=tf,Pr.camelCase=qa,Pr.capitalize=Za,Pr.ceil=xf,Pr.clamp=function(n,t,r){return r===u&&(r=t,t=u),r!==u&&(r=(r=ma(r))==r?r:0),t!==u&&(t=(t=ma(t))==t?t:0),ce(ma(n),t,r)},Pr.clone=function(n){return le(n,4)},Pr.cloneDeep=function(n){return le(n,5)},Pr.cloneDeepWith=function(n,t){return le(n,5,t="function"==typeof t?t:u)},Pr.cloneWith=function(n,t){return le(n,4,t="function"==typeof t?t:u)},Pr.conformsTo=function(n,t){return null==t||se(n,t,La(t))},Pr.deburr=Ga,Pr.defaultTo=function(n,t){return null==n||n!=n?t:n},Pr.divide=jf,Pr.endsWith=function(n,t,r){n=ba(n),t=su(t);var e=n.length,i=r=r===u?e:ce(da(r),0,e);return(r-=t.length)>=0&&n.slice(r,i)==t},Pr.eq=No,Pr.escape=function(n){return(n=ba(n))&&J.test(n)?n.replace(H,ir):n},Pr.escapeRegExp=function(n){return(n=ba(n))&&on.test(n)?n.replace(un,"\\$&"):n},Pr.every=function(n,t,r){var e=Ko(n)?zt:ge;return r&&bi(n,t,r)&&(t=u),e(n,li(t,3))},Pr.find=mo,Pr.findIndex=Zi,Pr.findKey=function(n,t){return Dt(n,li(t,3),xe)},Pr.findLast=wo,Pr.findLastIndex=Gi,Pr.findLastKey=function(n,t){return Dt(n,li(t,3),je)},Pr.floor=Af,Pr.forEach=bo,Pr.forEachRight=xo,Pr.forIn=function(n,t){return null==n?n:we(n,li(t,3),Ta)},Pr.forInRight=function(n,t){return null==n?n:be(n,li(t,3),Ta)},Pr.forOwn=function(n,t){return n&&xe(n,li(t,3))},Pr.forOwnRight=function(n,t){return n&&je(n,li(t,3))},Pr.get=Ba,Pr.gt=qo,Pr.gte=Zo,Pr.has=function(n,t){return null!=n&&di(n,t,Be)},Pr.hasIn=za,Pr.head=Vi,Pr.identity=af,Pr.includes=function(n,t,r,e){n=Ho(n)?n:Na(n),r=r&&!e?da(r):0;var u=n.length;return r<0&&(r=wr(u+r,0)),la(n)?r<=u&&n.indexOf(t,r)>-1:!!u&&Pt(n,t,r)>-1},Pr.indexOf=function(n,t,r){var e=null==n?0:n.length;if(!e)return-1;var u=null==r?0:da(r);return u<0&&(u=wr(e+u,0)),Pt(n,t,u)},Pr.inRange=function(n,t,r){return t=ga(t),r===u?(r=t,t=0):r=ga(r),function(n,t,r){return n>=br(t,r)&&n<wr(t,r)}(n=ma(n),t,r)},Pr.invoke=Ca,Pr.isArguments=Go,Pr.isArray=Ko,Pr.isArrayBuffer=Vo,Pr.isArrayLike=Ho,Pr.isArrayLikeObject=Yo,Pr.isBoolean=function(n){return!0===n||!1===n||ua(n)&&Ie(n)==w},Pr.isBuffer=Jo,Pr.isDate=Qo,Pr.isElement=function(n){return ua(n)&&1===n.nodeType&&!aa(n)},Pr.isEmpty=function(n){if(null==n)return!0;if(Ho(n)&&(Ko(n)||"string"==typeof n||"function"==typeof n.splice||Jo(n)||ha(n)||Go(n)))return!n.length;var t=gi(n);if(t==E||t==z)return!n.size;if(Ei(n))return!We(n).length;for(var r in n)if(Un.call(n,r))return!1;return!0},Pr.isEqual=function(n,t){return Le(n,t)},Pr.isEqualWith=function(n,t,r){var e=(r="function"==typeof r?r:u)?r(n,t):u;return e===u?Le(n,t,u,r):!!e},Pr.isError=Xo,Pr.isFinite=function(n){return"number"==typeof n&&Kt(n)},Pr.isFunction=na,Pr.isInteger=ta,Pr.isLength=ra,Pr.isMap=ia,Pr.isMatch=function(n,t){return n===t||Te(n,t,hi(t))},Pr.isMatchWith=function(n,t,r){return r="function"==typeof r?r:u,Te(n,t,hi(t),r)},Pr.isNaN=function(n){return oa(n)&&n!=+n},Pr.isNative=function(n){if(Ai(n))throw new En("Unsupported core-js use. Try https://npms.io/search?q=ponyfill.");return Fe(n)},Pr.isNil=function(n){return null==n},Pr.isNull=function(n){return null===n},Pr.isNumber=oa,Pr.isObject=ea,Pr.isObjectLike=ua,Pr.isPlainObject=aa,Pr.isRegExp=fa,Pr.isSafeInteger=function(n){return ta(n)&&n>=-9007199254740991&&n<=v},Pr.isSet=ca,Pr.isString=la,Pr.isSymbol=sa,Pr.isTypedArray=ha,Pr.isUndefined=function(n){return n===u},Pr.isWeakMap=function(n){return ua(n)&&gi(n)==C},Pr.isWeakSet=function(n){return ua(n)&&"[object WeakSet]"==Ie(n)},Pr.join=function(n,t){return null==n?"":yr.call(n,t)},Pr.kebabCase=Ka,Pr.last=Qi,Pr.lastIndexOf=function(n,t,r){var e=null==n?0:n.length;if(!e)return-1;var i=e;return r!==u&&(i=(i=da(r))<0?wr(e+i,0):br(i,e-1)),t==t?function(n,t,r){for(var e=r+1;e--;)if(n[e]===t)return e;return e}(n,t,i):Mt(n,qt,i,!0)},Pr.lowerCase=Va,Pr.lowerFirst=Ha,Pr.lt=pa,Pr.lte=va,Pr.max=function(n){return n&&n.length?de(n,af,Oe):u},Pr.maxBy=function(n,t){return n&&n.length?de(n,li(t,2),Oe):u},Pr.mean=function(n){return Zt(n,af)},Pr.meanBy=function(n,t){return Zt(n,li(t,2))},Pr.min=function(n){return n&&n.length?de(n,af,De):u},Pr.minBy=function(n,t){return n&&n.length?de(n,li(t,2),De):u},Pr.stubArray=mf,Pr.stubFalse=wf,Pr.stubObject=function(){return{}},Pr.stubString=function(){return""},Pr.stubTrue=function(){return!0},Pr.multiply=kf,Pr.nth=function(n,t){return n&&n.length?Ze(n,da(t)):u},Pr.noConflict=function(){return vt._===this&&(vt._=Pn),this},Pr.noop=hf,Pr.now=Bo,Pr.pad=function(n,t,r){n=ba(n);var e=(t=da(t))?pr(n):0;if(!t||e>=t)return n;var u=(t-e)/2;return Gu(yt(u),r)+n+Gu(gt(u),r)},Pr.padEnd=function(n,t,r){n=ba(n);var e=(t=da(t))?pr(n):0;return t&&e<t?n+Gu(t-e,r):n},Pr.padStart=function(n,t,r){n=ba(n);var e=(t=da(t))?pr(n):0;return t&&e<t?Gu(t-e,r)+n:n},Pr.parseInt=function(n,t,r){return r||null==t?t=0:t&&(t=+t),jr(ba(n).replace(an,""),t||0)},Pr.random=function(n,t,r){if(r&&"boolean"!=typeof r&&bi(n,t,r)&&(t=r=u),r===u&&("boolean"==typeof t?(r=t,t=u):"boolean"==typeof n&&(r=n,n=u)),n===u&&t===u?(n=0,t=1):(n=ga(n),t===u?(t=n,n=0):t=ga(t)),n>t){var e=n;n=t,t=e}if(r||n%1||t%1){var i=Ar();return br(n+i*(t-n+lt("1e-"+((i+"").length-1))),t)}return Ye(n,t)},Pr.reduce=function(n,t,r){var e=Ko(n)?Ft:Vt,u=arguments.length<3;return e(n,li(t,4),r,u,ve)},Pr.reduceRight=function(n,t,r){var e=Ko(n)?Ut:Vt,u=arguments.length<3;return e(n,li(t,4),r,u,_e)},Pr.repeat=function(n,t,r){return t=(r?bi(n,t,r):t===u)?1:da(t),Je(ba(n),t)},Pr.replace=function(){var n=arguments,t=ba(n[0]);return n.length<3?t:t.replace(n[1],n[2])},Pr.result=function(n,t,r){var e=-1,i=(t=bu(t,n)).length;for(i||(i=1,n=u);++e<i;){var o=null==n?u:n[$i(t[e])];o===u&&(e=i,o=r),n=na(o)?o.call(n):o}return n},Pr.round=If,Pr.runInContext=n,Pr.sample=function(n){return(Ko(n)?Xr:Xe)(n)},Pr.size=function(n){if(null==n)return 0;if(Ho(n))return la(n)?pr(n):n.length;var t=gi(n);return t==E||t==z?n.size:We(n).length},Pr.snakeCase=Ya,Pr.some=function(n,t,r){var e=Ko(n)?Wt:ou;return r&&bi(n,t,r)&&(t=u),e(n,li(t,3))},Pr.sortedIndex=function(n,t){return au(n,t)},Pr.sortedIndexBy=function(n,t,r){return fu(n,t,li(r,2))},Pr.sortedIndexOf=function(n,t){var r=null==n?0:n.length;if(r){var e=au(n,t);if(e<r&&No(n[e],t))return e}return-1},Pr.sortedLastIndex=function(n,t){return au(n,t,!0)},Pr.sortedLastIndexBy=function(n,t,r){return fu(n,t,li(r,2),!0)},Pr.sortedLastIndexOf=function(n,t){if(null==n?0:n.length){var r=au(n,t,!0)-1;if(No(n[r],t))return r}return-1},Pr.startCase=Ja,Pr.startsWith=function(n,t,r){return n=ba(n),r=null==r?0:ce(da(r),0,n.length),t=su(t),n.slice(r,r+t.length)==t},Pr.subtract=Of,Pr.sum=function(n){return n&&n.length?Ht(n,af):0},Pr.sumBy=function(n,t){return n&&n.length?Ht(n,li(t,2)):0},Pr.template=function(n,t,r){var e=Pr.templateSettings;r&&bi(n,t,r)&&(t=u),n=ba(n),t=Aa({},t,e,ni);var i,o,a=Aa({},t.imports,e.imports,ni),f=La(a),c=Xt(a,f),l=0,s=t.interpolate||jn,h="__p += '",p=Bn((t.escape||jn).source+"|"+s.source+"|"+(s===nn?_n:jn).source+"|"+(t.evaluate||jn).source+"|$","g"),v="//# sourceURL="+(Un.call(t,"sourceURL")?(t.sourceURL+"").replace(/\s/g," "):"lodash.templateSources["+ ++ot+"]")+"\n";n.replace(p,(function(t,r,e,u,a,f){return e||(e=u),h+=n.slice(l,f).replace(An,or),r&&(i=!0,h+="' +\n__e("+r+") +\n'"),a&&(o=!0,h+="';\n"+a+";\n__p += '"),e&&(h+="' +\n((__t = ("+e+")) == null ? '' : __t) +\n'"),l=f+t.length,t})),h+="';\n";var _=Un.call(t,"variable")&&t.variable;if(_){if(pn.test(_))throw new En("Invalid `variable` option passed into `_.template`")}else h="with (obj) {\n"+h+"\n}\n";h=(o?h.replace(Z,""):h).replace(G,"$1").replace(K,"$1;"),h="function("+(_||"obj")+") {\n"+(_?"":"obj || (obj = {});\n")+"var __t, __p = ''"+(i?", __e = _.escape":"")+(o?", __j = Array.prototype.join;\nfunction print() { __p += __j.call(arguments, '') }\n":";\n")+h+"return __p\n}";var g=tf((function(){return kn(f,v+"return "+h).apply(u,c)}));if(g.source=h,Xo(g))throw g;return g},Pr.times=function(n,t){if((n=da(n))<1||n>v)return[];var r=g,e=br(n,g);t=li(t),n-=g;for(var u=Yt(e,t);++r<n;)t(r);return u},Pr.toFinite=ga,Pr.toInteger=da,Pr.toLength=ya,Pr.toLower=function(n){return ba(n).toLowerCase()},Pr.toNumber=ma,Pr.toSafeInteger=function(n){return n?ce(da(n),-9007199254740991,v):0===n?n:0},Pr.toString=ba,Pr.toUpper=function(n){return ba(n).toUpperCase()},Pr.trim=function(n,t,r){if((n=ba(n))&&(r||t===u))return Jt(n);if(!n||!(t=su(t)))return n;var e=vr(n),i=vr(t);return ju(e,tr(e,i),rr(e,i)+1).join("")},Pr.trimEnd=function(n,t,r){if((n=ba(n))&&(r||t===u))return n.slice(0,_r(n)+1);if(!n||!(t=su(t)))return n;var e=vr(n);return ju(e,0,rr(e,vr(t))+1).join("")},Pr.trimStart=function(n,t,r){if((n=ba(n))&&(r||t===u))return n.replace(an,"");if(!n||!(t=su(t)))return n;var e=vr(n);return ju(e,tr(e,vr(t))).join("")},Pr.truncate=function(n,t){var r=30,e="...";if(ea(t)){var i="separator"in t?t.separator:i;r="length"in t?da(t.length):r,e="omission"in t?su(t.omission):e}var o=(n=ba(n)).length;if(ar(n)){var a=vr(n);o=a.length}if(r>=o)return n;var f=r-pr(e);if(f<1)return e;var c=a?ju(a,0,f).join(""):n.slice(0,f);if(i===u)return c+e;if(a&&(f+=c.length-f),fa(i)){if(n.slice(f).search(i)){var l,s=c;for(i.global||(i=Bn(i.source,ba(gn.exec(i))+"g")),i.lastIndex=0;l=i.exec(s);)var h=l.index;c=c.slice(0,h===u?f:h)}}else if(n.indexOf(su(i),f)!=f){var p=c.lastIndexOf(i);p>-1&&(c=c.slice(0,p))}return c+e},Pr.unescape=function(n){return(n=ba(n))&&Y.test(n)?n.replace(V,gr):n},Pr.uniqueId=function(n){var t=++Wn;return ba(n)+t},Pr.upperCase=Qa,Pr.upperFirst=Xa,Pr.each=bo,Pr.eachRight=xo,Pr.first=Vi,sf(Pr,(Ef={},xe(Pr,(function(n,t){Un.call(Pr.prototype,t)||(Ef[t]=n)})),Ef),{chain:!1}),Pr.VERSION="4.17.21",Ot(["bind","bindKey","curry","curryRight","partial","partialRight"],(function(n){Pr[n].placeholder=Pr})),Ot(["drop","take"],(function(n,t){Gr.prototype[n]=function(r){r=r===u?1:wr(da(r),0);var e=this.__filtered__&&!t?new Gr(this):this.clone();return e.__filtered__?e.__takeCount__=br(r,e.__takeCount__):e.__views__.push({size:br(r,g),type:n+(e.__dir__<0?"Right":"")}),e},Gr.prototype[n+"Right"]=function(t){return this.reverse()[n](t).reverse()}})),Ot(["filter","map","takeWhile"],(function(n,t){var r=t+1,e=1==r||3==r;Gr.prototype[n]=function(n){var t=this.clone();return t.__iteratees__.push({iteratee:li(n,3),type:r}),t.__filtered__=t.__filtered__||e,t}})),Ot(["head","last"],(function(n,t){var r="take"+(t?"Right":"");Gr.prototype[n]=function(){return this[r](1).value()[0]}})),Ot(["initial","tail"],(function(n,t){var r="drop"+(t?"":"Right");Gr.prototype[n]=function(){return this.__filtered__?new Gr(this):this[r](1)}})),Gr.prototype.compact=function(){return this.filter(af)},Gr.prototype.find=function(n){return this.filter(n).head()},Gr.prototype.findLast=function(n){return this.reverse().find(n)},Gr.prototype.invokeMap=Qe((function(n,t){return"function"==typeof n?new Gr(this):this.map((function(r){return Se(r,n,t)}))})),Gr.prototype.reject=function(n){return this.filter(Wo(li(n)))},Gr.prototype.slice=function(n,t){n=da(n);var r=this;return r.__filtered__&&(n>0||t<0)?new Gr(r):(n<0?r=r.takeRight(-n):n&&(r=r.drop(n)),t!==u&&(r=(t=da(t))<0?r.dropRight(-t):r.take(t-n)),r)},Gr.prototype.takeRightWhile=function(n){return this.reverse().takeWhile(n).reverse()},Gr.prototype.toArray=function(){return this.take(g)},xe(Gr.prototype,(function(n,t){var r=/^(?:filter|find|map|reject)|While$/.test(t),e=/^(?:head|last)$/.test(t),i=Pr[e?"take"+("last"==t?"Right":""):t],o=e||/^find/.test(t);i&&(Pr.prototype[t]=function(){var t=this.__wrapped__,a=e?[1]:arguments,f=t instanceof Gr,c=a[0],l=f||Ko(t),s=function(n){var t=i.apply(Pr,Tt([n],a));return e&&h?t[0]:t};l&&r&&"function"==typeof c&&1!=c.length&&(f=l=!1);var h=this.__chain__,p=!!this.__actions__.length,v=o&&!h,_=f&&!p;if(!o&&l){t=_?t:new Gr(this);var g=n.apply(t,a);return g.__actions__.push({func:_o,args:[s],thisArg:u}),new Zr(g,h)}return v&&_?n.apply(this,a):(g=this.thru(s),v?e?g.value()[0]:g.value():g)})})),Ot(["pop","push","shift","sort","splice","unshift"],(function(n){var t=Sn[n],r=/^(?:push|sort|unshift)$/.test(n)?"tap":"thru",e=/^(?:pop|shift)$/.test(n);Pr.prototype[n]=function(){var n=arguments;if(e&&!this.__chain__){var u=this.value();return t.apply(Ko(u)?u:[],n)}return this[r]((function(r){return t.apply(Ko(r)?r:[],n)}))}})),xe(Gr.prototype,(function(n,t){var r=Pr[t];if(r){var e=r.name+"";Un.call(Cr,e)||(Cr[e]=[]),Cr[e].push({name:t,func:r})}})),Cr[Pu(u,2).name]=[{name:"wrapper",func:u}],Gr.prototype.clone=function(){var n=new Gr(this.__wrapped__);return n.__actions__=Ru(this.__actions__),n.__dir__=this.__dir__,n.__filtered__=this.__filtered__,n.__iteratees__=Ru(this.__iteratees__),n.__takeCount__=this.__takeCount__,n.__views__=Ru(this.__views__),n},Gr.prototype.reverse=function(){if(this.__filtered__){var n=new Gr(this);n.__dir__=-1,n.__filtered__=!0}else(n=this.clone()).__dir__*=-1;return n},Gr.prototype.value=function(){var n=this.__wrapped__.value(),t=this.__dir__,r=Ko(n),e=t<0,u=r?n.length:0,i=function(n,t,r){var e=-1,u=r.length;for(;++e<u;){var i=r[e],o=i.size;switch(i.type){case"drop":n+=o;break;case"dropRight":t-=o;break;case"take":t=br(t,n+o);break;case"takeRight":n=wr(n,t-o)}}return{start:n,end:t}}(0,u,this.__views__),o=i.start,a=i.end,f=a-o,c=e?a:o-1,l=this.__iteratees__,s=l.length,h=0,p=br(f,this.__takeCount__);if(!r||!e&&u==f&&p==f)return gu(n,this.__actions__);var v=[];n:for(;f--&&h<p;){for(var _=-1,g=n[c+=t];++_<s;){var d=l[_],y=d.iteratee,m=d.type,w=y(g);if(2==m)g=w;else if(!w){if(1==m)continue n;break n}}v[h++]=g}return v},Pr.prototype.at=go,Pr.prototype.chain=function(){return vo(this)},Pr.prototype.commit=function(){return new Zr(this.value(),this.__chain__)},Pr.prototype.next=function(){this.__values__===u&&(this.__values__=_a(this.value()));var n=this.__index__>=this.__values__.length;return{done:n,value:n?u:this.__values__[this.__index__++]}},Pr.prototype.plant=function(n){for(var t,r=this;r instanceof qr;){var e=Mi(r);e.__index__=0,e.__values__=u,t?i.__wrapped__=e:t=e;var i=e;r=r.__wrapped__}return i.__wrapped__=n,t},Pr.prototype.reverse=function(){var n=this.__wrapped__;if(n instanceof Gr){var t=n;return this.__actions__.length&&(t=new Gr(this)),(t=t.reverse()).__actions__.push({func:_o,args:[ro],thisArg:u}),new Zr(t,this.__chain__)}return this.thru(ro)},Pr.prototype.toJSON=Pr.prototype.valueOf=Pr.prototype.value=function(){return gu(this.__wrapped__,this.__actions__)},Pr.prototype.first=Pr.prototype.head,tt&&(Pr.prototype[tt]=function(){return this}),Pr}();vt._=dr,(e=function(){return dr}.call(t,r,t,n))===u||(n.exports=e)}.call(this)}},t={};function r(e){var u=t[e];if(void 0!==u)return u.exports;var i=t[e]={id:e,loaded:!1,exports:{}};return n[e].call(i.exports,i,i.exports,r),i.loaded=!0,i.exports}r.n=n=>{var t=n&&n.__esModule?()=>n.default:()=>n;return r.d(t,{a:t}),t},r.d=(n,t)=>{for(var e in t)r.o(t,e)&&!r.o(n,e)&&Object.defineProperty(n,e,{enumerable:!0,get:t[e]})},r.g=function(){if("object"==typeof globalThis)return globalThis;try{return this||new Function("return this")()}catch(n){if("object"==typeof window)return window}}(),r.o=(n,t)=>Object.prototype.hasOwnProperty.call(n,t),r.nmd=n=>(n.paths=[],n.children||(n.children=[]),n),(()=>{"use strict";var n=r(486),t=r.n(n);const{buildSnapshotTree,debounced,initMemoryGraph,filterChildThreads,filterUninteresting,getFlamegraphTooltip,memrayColorMapper,sumAllocations,resizeMemoryGraph,usageAtSnapshot}=(()=>{var _=t();function initMemoryGraph(memory_records){const x=memory_records.map((a)=>new Date(a[0]));const y=memory_records.map((a)=>a[1]);var trace={x,y,mode:"lines",};var data=[trace];var layout={xaxis:{title:{text:"Time",},},yaxis:{title:{text:"Resident Size",},tickformat:".4~s",exponentformat:"B",ticksuffix:"B",},};var layout_small={height:40,margin:{l:0,r:0,b:0,t:0,pad:4,},plot_bgcolor:"#343a40",yaxis:{tickformat:".4~s",exponentformat:"B",ticksuffix:"B",},};var config={responsive:true,};var config_small={responsive:true,displayModeBar:false,};Plotly.newPlot("memoryGraph",data,layout,config);Plotly.newPlot("smallMemoryGraph",data,layout_small,config_small);document.getElementById("smallMemoryGraph").onclick(()=>{resizeMemoryGraph();});}
+function resizeMemoryGraph(){setTimeout(()=>{Plotly.Plots.resize("memoryGraph");Plotly.Plots.resize("smallMemoryGraph");},100);}
+function humanFileSize(bytes,dp=1){if(Math.abs(bytes)<1024){return bytes+" B";}
+const units=["KiB","MiB","GiB","TiB","PiB","EiB","ZiB","YiB"];let u=-1;const r=10**dp;do{bytes/=1024;++u;}while(Math.round(Math.abs(bytes)*r)/r>=1024&&u<units.length-1);return bytes.toFixed(dp)+" "+units[u];}
+function debounced(fn){var requestID;return function(){if(requestID){window.cancelAnimationFrame(requestID);}
+const context=this;const args=arguments;requestID=window.requestAnimationFrame(function(){fn.apply(context,args);});};}
+function makeTooltipString(data,totalSize,merge_threads){let location="unknown location";if(data.location!==undefined){location=`File ${data.location[1]}, line ${data.location[2]} in ${data.location[0]}`;}
+const plural=data.n_allocations>1?"s":"";const allocations_label=`${data.n_allocations} allocation${plural}`;let displayString=`${location}<br>${totalSize} total<br>${allocations_label}`;if(merge_threads===false){displayString=displayString.concat(`<br>Thread ID: ${data.thread_id}`);}
+return displayString;}
+function filterFrames(root,compFunction){function _filter(obj){if(obj.children&&obj.children.length>0){obj.children=_.filter(obj.children,_filter);}
+return compFunction(obj);}
+let children=_.cloneDeep(root.children);const filtered_children=_.filter(children,_filter);return _.defaults({children:filtered_children},root);}
+function filterChildThreads(root,threadId){return filterFrames(root,(obj)=>obj.thread_id===threadId);}
+function filterUninteresting(root){function filterChildren(node){let result=[];if(!node.interesting){for(const child of node.children){result.push(...filterChildren(child));}}else{result=[];for(const child of node.children){result.push(...filterChildren(child));}
+let new_node=_.clone(node);new_node.children=result;result=[new_node];}
+return result;}
+let children=[];for(let child of root.children){children.push(...filterChildren(child));}
+return _.defaults({children:children},root);}
+function sumAllocations(data){let initial={n_allocations:0,value:0,};let sum=(result,node)=>{result.n_allocations+=node.n_allocations;result.value+=node.value;return result;};return _.reduce(data,sum,initial);}
+function getFlamegraphTooltip(merge_threads){let tip=d3.tip().attr("class","d3-flame-graph-tip").html((d)=>{const totalSize=humanFileSize(d.data.value);return makeTooltipString(d.data,totalSize,merge_threads);}).direction((d)=>{const midpoint=(d.x1+d.x0)/2;if(0.25<midpoint&&midpoint<0.75){return"s";}
+if(d.x1<0.75){return"e";}
+if(d.x0>0.25){return"w";}
+return"n";});return tip;}
+function fileExtension(filename){if(filename===undefined)return filename;return(filename.substring(filename.lastIndexOf(".")+1,filename.length)||filename);}
+function colorByExtension(extension){if(extension=="py"||extension=="pyx"){return d3.schemePastel1[2];}else if(extension=="c"||extension=="cpp"||extension=="h"){return d3.schemePastel1[5];}else{return d3.schemePastel1[8];}}
+function memrayColorMapper(d,originalColor){if(d.highlight){return"orange";}
+if(!d.data.name||!d.data.location){return"#EEE";}
+return colorByExtension(fileExtension(d.data.location[1]));}
+function usageAtSnapshot(intervals,snapshot){let low=0;let high=intervals.length;while(low<high){const middle=(low+high)>>1;if(intervals[middle][0]<=snapshot){low=middle+1;}else{high=middle;}}
+if(low>0&&snapshot<intervals[low-1][1]){const[,,n_allocations,value]=intervals[low-1];return{n_allocations,value};}
+return{n_allocations:0,value:0};}
+function buildSnapshotTree(root,usageOf){function build(node){let result={n_allocations:0,value:0};for(const location of node.locations||[]){const usage=usageOf(location);result.n_allocations+=usage.n_allocations;result.value+=usage.value;}
+const children=[];for(const child of node.children){const built=build(child);if(built.n_allocations>0||built.value>0){children.push(built);result.n_allocations+=built.n_allocations;result.value+=built.value;}}
+result.children=children;return _.defaults(result,node);}
+return build(root);}
+function makeDiffTooltipString(data){let location="unknown location";if(data.location!==undefined){location=`File ${data.location[1]}, line ${data.location[2]} in ${data.location[0]}`;}
+const delta=data.size_after-data.size_before;const sign=delta>0?"+":delta<0?"-":"";const before=`${humanFileSize(data.size_before)} (${data.n_allocations_before})`;const after=`${humanFileSize(data.size_after)} (${data.n_allocations})`;return(`${location}<br>${sign}${humanFileSize(Math.abs(delta))}`+`<br>Before: ${before}<br>After: ${after}`);}
+function diffRatio(data){const width=Math.max(data.size_before,data.size_after);if(width===0){return 0;}
+return(data.size_after-data.size_before)/width;}
+return{buildSnapshotTree,debounced,initMemoryGraph,filterChildThreads,filterUninteresting,getFlamegraphTooltip,memrayColorMapper,sumAllocations,resizeMemoryGraph,usageAtSnapshot}})();window.resizeMemoryGraph=resizeMemoryGraph;let hideUninterestingFrames=true;let selectedThread=null;function getChartWidth(){const rem=parseFloat(getComputedStyle(document.documentElement).fontSize);return window.innerWidth-2*rem;}
+function snapshotLabel(index){if(index>=memory_records.length){return"end of capture";}
+const elapsed=(memory_records[index][0]-memory_records[0][0])/1000;return`${elapsed.toFixed(3)}s`;}
+function getSelectedSnapshots(){return{start:parseInt(document.getElementById("startSnapshot").value,10),end:parseInt(document.getElementById("endSnapshot").value,10),showGrowth:document.getElementById("showGrowth").checked,};}
+function snapshotData(){const{start,end,showGrowth}=getSelectedSnapshots();let usageOf=(location)=>usageAtSnapshot(data.intervals[location],end);if(showGrowth){usageOf=(location)=>{const before=usageAtSnapshot(data.intervals[location],start);const after=usageAtSnapshot(data.intervals[location],end);return{n_allocations:Math.max(0,after.n_allocations-before.n_allocations),value:Math.max(0,after.value-before.value),};};}
+let filtered=buildSnapshotTree(data,usageOf);if(hideUninterestingFrames){filtered=filterUninteresting(filtered);}
+if(selectedThread!==null){filtered=filterChildThreads(filtered,selectedThread);const totalAllocations=sumAllocations(filtered.children);filtered.n_allocations=totalAllocations.n_allocations;filtered.value=totalAllocations.value;}
+return filtered;}
+function updateLabels(){const{start,end,showGrowth}=getSelectedSnapshots();document.getElementById("startSnapshot").disabled=!showGrowth;document.getElementById("startSnapshotLabel").textContent=showGrowth?snapshotLabel(start):"";document.getElementById("endSnapshotLabel").textContent=snapshotLabel(end);}
+function redraw(){updateLabels();drawChart(snapshotData());chart.merge([]);}
+function onInvert(){chart.inverted(!chart.inverted());chart.resetZoom();}
+function onResetZoom(){chart.resetZoom();}
+function onFilterThread(){const thread_id=this.dataset.thread;selectedThread=thread_id==="-0x1"?null:thread_id;redraw();}
+function onFilterUninteresting(){hideUninterestingFrames=this.checked;redraw();}
+function initThreadsDropdown(data,merge_threads){if(merge_threads===true){return;}
+const threads=data.unique_threads;if(!threads||threads.length<=1){return;}
+document.getElementById("threadsDropdown").removeAttribute("hidden");const threadsDropdownList=document.getElementById("threadsDropdownList");for(const thread of threads){let elem=document.createElement("a");elem.className="dropdown-item";elem.dataset.thread=thread;elem.text=thread;elem.onclick=onFilterThread;threadsDropdownList.appendChild(elem);}}
+function initSnapshotSliders(){const lastSnapshot=memory_records.length;for(const id of["startSnapshot","endSnapshot"]){const slider=document.getElementById(id);slider.max=lastSnapshot;slider.addEventListener("input",debounced(redraw));}
+document.getElementById("startSnapshot").value=0;document.getElementById("endSnapshot").value=lastSnapshot;document.getElementById("showGrowth").onchange=redraw;}
+function drawChart(chart_data){chart=flamegraph().width(getChartWidth()).transitionDuration(250).transitionEase(d3.easeCubic).inverted(true).cellHeight(20).minFrameSize(2).setColorMapper(memrayColorMapper).tooltip(getFlamegraphTooltip(merge_threads));d3.select("#chart").datum(chart_data).call(chart);}
+function onResize(){const width=getChartWidth();const svg=document.getElementById("chart").children[0];svg.setAttribute("width",width);chart.width(width);redraw();}
+function main(){initMemoryGraph(memory_records);initThreadsDropdown(data,merge_threads);initSnapshotSliders();redraw();document.getElementById("invertButton").onclick=onInvert;document.getElementById("resetZoomButton").onclick=onResetZoom;document.getElementById("resetThreadFilterItem").onclick=onFilterThread;document.getElementById("hideUninteresting").onclick=onFilterUninteresting;document.onkeyup=(event)=>{if(event.code=="Escape"){onResetZoom();}};document.getElementById("searchTerm").addEventListener("input",()=>{const termElement=document.getElementById("searchTerm");chart.search(termElement.value);});window.addEventListener("resize",debounced(onResize));$('[data-toggle-second="tooltip"]').tooltip();$('[data-toggle="tooltip"]').tooltip();}
+var chart=null;document.addEventListener("DOMContentLoaded",main);})()})();
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <assert.h>
 #include <pthread.h>
 #include <malloc.h>
+#include <stdlib.h>
+#include <vector>
 
 namespace {  // unnamed
 
@@ -67,6 +69,19 @@ void valloc_on_thread_exit() {
   pthread_join(thread_id, &result);
 }
 
+extern "C" void*
+malloc_free_worker(void* arg)
+{
+    size_t allocations = *static_cast<size_t*>(arg);
+    for (size_t i=0; i < allocations; ++i) {
+        // Write through the pointer so the compiler can't elide the allocation
+        volatile char* ptr = static_cast<volatile char*>(malloc(1234));
+        *ptr = 0;
+        free(const_cast<char*>(ptr));
+    }
+    return NULL;
+}
+
 PyObject*
 run(PyObject*, PyObject*)
 {
@@ -82,11 +97,35 @@ run_valloc_at_exit(PyObject*, PyObject*)
     Py_RETURN_NONE;
 }
 
+PyObject*
+allocate_in_threads(PyObject*, PyObject* args)
+{
+    int num_threads;
+    Py_ssize_t allocations;
+    if (!PyArg_ParseTuple(args, "in", &num_threads, &allocations)) {
+        return NULL;
+    }
+
+    size_t allocations_per_thread = allocations;
+    std::vector<pthread_t> workers(num_threads);
+    Py_BEGIN_ALLOW_THREADS
+    for (int i=0; i<num_threads; ++i) {
+        int ret = pthread_create(&workers[i], NULL, &malloc_free_worker, &allocations_per_thread);
+        assert(0 == ret);
+    }
+    for (int i=0; i<num_threads; ++i) {
+        pthread_join(workers[i], NULL);
+    }
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
+
 }  // unnamed namespace
 
 static PyMethodDef methods[] = {
         {"run", run, METH_NOARGS, "Run a bunch of threads"},
         {"run_valloc_at_exit", run_valloc_at_exit, METH_NOARGS, "Run valloc while exiting a thread"},
+        {"allocate_in_threads", allocate_in_threads, METH_VARARGS, "Run malloc/free loops in threads"},
         {NULL, NULL, 0, NULL},
 };
 
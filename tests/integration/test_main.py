@@ -1,4 +1,5 @@
 import contextlib
+import json
 import os
 import platform
 import pty
@@ -13,6 +14,8 @@ from unittest.mock import patch
 
 import pytest
 
+from memray import FileReader
+from memray._test import write_synthetic_capture
 from memray.commands import main
 
 TIMEOUT = 10
@@ -681,6 +684,230 @@ class TestFlamegraphSubCommand:
         assert output_file.exists()
         assert str(source_file) in output_file.read_text()
 
+    def test_temporal_subcommand(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, source_file = generate_sample_results(
+            tmp_path, simple_test_file, native=True
+        )
+
+        # WHEN
+        subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--temporal",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        output_file = tmp_path / "memray-temporal-flamegraph-result.html"
+        assert output_file.exists()
+        assert not (tmp_path / "memray-flamegraph-result.html").exists()
+        report = output_file.read_text()
+        assert str(source_file) in report
+        assert "endSnapshot" in report
+
+    def test_temporal_and_leaks_are_exclusive(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(
+            tmp_path, simple_test_file, native=True
+        )
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--temporal",
+                "--leaks",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert proc.returncode == 2
+        assert "not allowed with argument" in proc.stderr
+
+    def test_at_subcommand(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, source_file = generate_sample_results(
+            tmp_path, simple_test_file, native=True
+        )
+
+        # WHEN
+        subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--at",
+                "1h",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        output_file = tmp_path / "memray-flamegraph-result.html"
+        assert output_file.exists()
+        assert "3600 seconds after tracking started" in output_file.read_text()
+
+    def test_at_rejects_invalid_points(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(
+            tmp_path, simple_test_file, native=True
+        )
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--at",
+                "3 days",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert proc.returncode == 2
+        assert "expected a number of allocation records" in proc.stderr
+
+    def test_spill_dir_subcommand(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, source_file = generate_sample_results(
+            tmp_path, simple_test_file, native=True
+        )
+        spill_directory = tmp_path / "spill"
+        spill_directory.mkdir()
+
+        # WHEN
+        subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--spill-dir",
+                str(spill_directory),
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        output_file = tmp_path / "memray-flamegraph-result.html"
+        assert output_file.exists()
+        assert str(source_file) in output_file.read_text()
+        assert list(spill_directory.iterdir()) == []
+
+    def test_follow_fork_subcommand(self, tmp_path):
+        # GIVEN
+        code_file = tmp_path / "code.py"
+        code_file.write_text(
+            textwrap.dedent(
+                """\
+                import os
+                from memray._memray import MemoryAllocator
+
+                def allocate_in_child():
+                    MemoryAllocator().valloc(1024)
+
+                pid = os.fork()
+                if pid == 0:
+                    allocate_in_child()
+                else:
+                    os.waitpid(pid, 0)
+                """
+            )
+        )
+        subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "run",
+                "--follow-fork",
+                "--output",
+                str(tmp_path / "result.bin"),
+                str(code_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--follow-fork",
+                "--leaks",
+                str(tmp_path / "result.bin"),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert "Read the results of 2 processes" in proc.stdout
+        output_file = tmp_path / "memray-processes-flamegraph-result.html"
+        assert output_file.exists()
+        assert "valloc(1024)" in output_file.read_text()
+
+    def test_split_processes_requires_follow_fork(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "flamegraph",
+                "--split-processes",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert proc.returncode == 2
+        assert "--split-processes can only be used with --follow-fork" in proc.stderr
+
 
 class TestTableSubCommand:
     def test_reads_from_correct_file(self, tmp_path, simple_test_file):
@@ -728,8 +955,499 @@ class TestTableSubCommand:
             )
 
 
+class TestFragmentationSubCommand:
+    def test_reports_locations_keeping_sparse_pages(self, tmp_path):
+        # GIVEN
+        code_file = tmp_path / "code.py"
+        program = textwrap.dedent(
+            """\
+            import time
+            from memray._memray import MemoryAllocator
+            allocators = [MemoryAllocator() for _ in range(10)]
+            for allocator in allocators:
+                allocator.valloc(64)
+            # Give it time to generate some memory records
+            time.sleep(0.1)
+            """
+        )
+        code_file.write_text(program)
+        results_file, _ = generate_sample_results(tmp_path, code_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "fragmentation",
+                "--leaks",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert "Page occupancy over time" in proc.stdout
+        assert "Highest fragmentation" in proc.stdout
+        assert "valloc" in proc.stdout
+
+    def test_rejects_invalid_page_size(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "fragmentation",
+                "--page-size",
+                "1000",
+                str(results_file),
+            ],
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert proc.returncode == 1
+        assert "page_size must be a power of two" in proc.stderr
+
+
+class TestChurnSubCommand:
+    def test_reports_short_lived_allocations(self, tmp_path):
+        # GIVEN
+        code_file = tmp_path / "code.py"
+        program = textwrap.dedent(
+            """\
+            from memray._memray import MemoryAllocator
+            allocator = MemoryAllocator()
+            for _ in range(1000):
+                allocator.valloc(64)
+                allocator.free()
+            """
+        )
+        code_file.write_text(program)
+        results_file, _ = generate_sample_results(tmp_path, code_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "churn",
+                "-n",
+                "1",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        *_, top_location = proc.stdout.splitlines()
+        assert top_location.split()[1:3] == ["1000", "100%"]
+        assert "valloc" in top_location
+
+
+class TestDiffSubCommand:
+    def test_reports_growth_between_runs(self, tmp_path):
+        # GIVEN
+        def record(name, count):
+            run_dir = tmp_path / name
+            run_dir.mkdir()
+            code_file = run_dir / "code.py"
+            program = textwrap.dedent(
+                f"""\
+                from memray._memray import MemoryAllocator
+                allocators = [MemoryAllocator() for _ in range({count})]
+                for allocator in allocators:
+                    allocator.valloc(1024 * 1024)
+                """
+            )
+            code_file.write_text(program)
+            results_file, _ = generate_sample_results(run_dir, code_file)
+            return results_file
+
+        baseline = record("baseline", 1)
+        candidate = record("candidate", 4)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "diff",
+                "--leaks",
+                str(baseline),
+                str(candidate),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        output_file = candidate.parent / "memray-diff-result.html"
+        assert f"Wrote {output_file}" in proc.stdout
+        assert "Leaked memory:" in proc.stdout
+        report = output_file.read_text()
+        assert "diff flamegraph report" in report
+        assert '"size_before"' in report
+
+    def test_error_when_baseline_does_not_exist(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "diff",
+                str(tmp_path / "missing.bin"),
+                str(results_file),
+            ],
+            capture_output=True,
+            text=True,
+            cwd=str(tmp_path),
+        )
+
+        # THEN
+        assert proc.returncode == 1
+        assert "No such file" in proc.stderr
+
+
+class TestSliceSubCommand:
+    def test_writes_slice(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "slice",
+                "--start",
+                "10",
+                "--end",
+                "1h",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        output_file = tmp_path / "memray-slice-result.bin"
+        assert f"allocation records to {output_file}" in proc.stdout
+        original = FileReader(results_file)
+        assert FileReader(output_file).metadata.pid == original.metadata.pid
+
+    def test_rejects_start_after_end(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "slice",
+                "--start",
+                "2m",
+                "--end",
+                "1m",
+                str(results_file),
+            ],
+            capture_output=True,
+            text=True,
+            cwd=str(tmp_path),
+        )
+
+        # THEN
+        assert proc.returncode == 2
+        assert "--start must not come after --end" in proc.stderr
+
+
+class TestCompactSubCommand:
+    def test_writes_compacted_capture(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+        output_file = tmp_path / "compacted.bin"
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "compact",
+                "--max-lifetime",
+                "10",
+                "-o",
+                str(output_file),
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        total = FileReader(results_file).metadata.total_allocations
+        written = FileReader(output_file).metadata.total_allocations
+        assert f"Wrote {written} of {total} allocation records" in proc.stdout
+        assert written <= total
+
+    def test_refuses_to_overwrite_output(self, tmp_path, simple_test_file):
+        # GIVEN
+        results_file, _ = generate_sample_results(tmp_path, simple_test_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "compact",
+                "-o",
+                str(results_file),
+                str(results_file),
+            ],
+            capture_output=True,
+            text=True,
+            cwd=str(tmp_path),
+        )
+
+        # THEN
+        assert proc.returncode == 1
+        assert "File already exists, will not overwrite" in proc.stderr
+
+
+class TestReplaySubCommand:
+    def test_replays_allocations(self, tmp_path):
+        # GIVEN
+        code_file = tmp_path / "code.py"
+        program = textwrap.dedent(
+            """\
+            from memray._memray import MemoryAllocator
+            allocator = MemoryAllocator()
+            allocator.malloc(1024)
+            allocator.realloc(4096)
+            leaked = MemoryAllocator()
+            leaked.valloc(8192)
+            allocator.free()
+            """
+        )
+        code_file.write_text(program)
+        results_file, _ = generate_sample_results(tmp_path, code_file)
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "replay",
+                "--json",
+                str(results_file),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        stats = json.loads(proc.stdout)
+        assert stats["threads"] >= 1
+        assert stats["operations"] >= 4
+        assert stats["failed_allocations"] == 0
+        assert stats["peak_live_bytes"] >= 4096 + 8192
+        assert stats["final_live_bytes"] >= 8192
+        assert 0 <= stats["fragmentation"] <= 1
+
+    def test_error_when_input_file_does_not_exist(self, tmp_path):
+        # GIVEN
+        results_file = tmp_path / "does/not/exist"
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "replay",
+                str(results_file),
+            ],
+            capture_output=True,
+            text=True,
+            cwd=str(tmp_path),
+        )
+
+        # THEN
+        assert "Reason: No such file" in proc.stderr
+        assert proc.returncode == 1
+
+
+class TestBatchSubCommand:
+    def test_summarizes_every_capture_in_a_directory(self, tmp_path):
+        # GIVEN
+        captures = tmp_path / "captures"
+        captures.mkdir()
+        for seed in range(3):
+            write_synthetic_capture(
+                captures / f"memray-canary.{seed}.bin",
+                allocations=500,
+                functions=8,
+                leak_fraction=0.2,
+                seed=seed,
+            )
+        (captures / "notes.txt").write_text("not a capture")
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "batch",
+                "--jobs",
+                "2",
+                "--num-largest",
+                "3",
+                str(captures),
+            ],
+            cwd=str(tmp_path),
+            check=True,
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        summaries = [json.loads(line) for line in proc.stdout.splitlines()]
+        assert [summary["path"] for summary in summaries] == [
+            str(captures / f"memray-canary.{seed}.bin") for seed in range(3)
+        ]
+        for summary in summaries:
+            metadata = FileReader(summary["path"]).metadata
+            assert summary["peak_memory"] == metadata.peak_memory
+            assert summary["total_allocations"] == metadata.total_allocations
+            assert summary["pid"] == metadata.pid
+            sizes = [site["size"] for site in summary["top_sites"]]
+            assert 0 < len(sizes) <= 3
+            assert sizes == sorted(sizes, reverse=True)
+            assert sum(sizes) <= summary["peak_memory"]
+
+    def test_reports_captures_that_cannot_be_read(self, tmp_path):
+        # GIVEN
+        good = tmp_path / "good.bin"
+        bad = tmp_path / "bad.bin"
+        write_synthetic_capture(good, allocations=100)
+        bad.write_bytes(b"garbage")
+        output = tmp_path / "summaries.jsonl"
+
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "batch",
+                "-o",
+                str(output),
+                str(good),
+                str(bad),
+            ],
+            cwd=str(tmp_path),
+            capture_output=True,
+            text=True,
+        )
+
+        # THEN
+        assert proc.returncode == 1
+        assert "Failed to analyze 1 of 2 captures" in proc.stderr
+        good_summary, bad_summary = map(json.loads, output.read_text().splitlines())
+        assert good_summary["peak_memory"] == FileReader(good).metadata.peak_memory
+        assert bad_summary["path"] == str(bad)
+        assert "does not look like a binary generated by memray" in (
+            bad_summary["error"]
+        )
+
+    def test_keeps_going_after_any_error_reading_a_capture(
+        self, tmp_path, monkeypatch, capsys
+    ):
+        # GIVEN
+        bad = tmp_path / "bad.bin"
+        good = tmp_path / "good.bin"
+        bad.write_bytes(b"garbage")
+        write_synthetic_capture(good, allocations=100)
+        output = tmp_path / "summaries.jsonl"
+
+        real_file_reader = FileReader
+
+        def file_reader(path, **kwargs):
+            if path == str(bad):
+                raise ValueError("header is corrupt")
+            return real_file_reader(path, **kwargs)
+
+        # The workers are forked, so they inherit the patched reader.
+        monkeypatch.setattr("memray.commands.batch.FileReader", file_reader)
+
+        # WHEN
+        ret = main(["batch", "--jobs", "1", "-o", str(output), str(bad), str(good)])
+
+        # THEN
+        assert ret == 1
+        assert "Failed to analyze 1 of 2 captures" in capsys.readouterr().err
+        bad_summary, good_summary = map(json.loads, output.read_text().splitlines())
+        assert bad_summary == {
+            "path": str(bad),
+            "error": "ValueError: header is corrupt",
+        }
+        assert good_summary["peak_memory"] == FileReader(good).metadata.peak_memory
+
+    def test_error_when_path_does_not_exist(self, tmp_path):
+        # WHEN
+        proc = subprocess.run(
+            [
+                sys.executable,
+                "-m",
+                "memray",
+                "batch",
+                str(tmp_path / "missing"),
+            ],
+            capture_output=True,
+            text=True,
+            cwd=str(tmp_path),
+        )
+
+        # THEN
+        assert proc.returncode == 1
+        assert "No such file or directory" in proc.stderr
+
+
 class TestReporterSubCommands:
-    @pytest.mark.parametrize("report", ["flamegraph", "table"])
+    @pytest.mark.parametrize(
+        "report", ["flamegraph", "table", "fragmentation", "churn"]
+    )
     def test_report_detects_missing_input(self, report):
         # GIVEN / WHEN
         proc = subprocess.run(
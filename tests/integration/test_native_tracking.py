@@ -1,12 +1,16 @@
+import ctypes
 import shutil
 import subprocess
 import sys
+import textwrap
 from pathlib import Path
 
+import _ctypes
 import pytest
 
 from memray import AllocatorType
 from memray import FileReader
+from memray import SymbolCache
 from memray import Tracker
 from memray._test import MemoryAllocator
 from tests.utils import filter_relevant_allocations
@@ -245,6 +249,75 @@ def test_hybrid_stack_in_pure_python(tmpdir):
     assert hybrid_stack[-1] == "test_hybrid_stack_in_pure_python"
 
 
+def test_native_stop_at_python(tmpdir):
+    # GIVEN
+    allocator = MemoryAllocator()
+    output = Path(tmpdir) / "test.bin"
+    MAX_RECURSIONS = 4
+
+    def recursive_func(n):
+        if n == 1:
+            return allocator.valloc(1234)
+        return recursive_func(n - 1)
+
+    # WHEN
+    with Tracker(output, native_traces=True, native_stop_at_python=True):
+        recursive_func(MAX_RECURSIONS)
+
+    # THEN
+    records = list(FileReader(output).get_allocation_records())
+    vallocs = [
+        record
+        for record in filter_relevant_allocations(records)
+        if record.allocator == AllocatorType.VALLOC
+    ]
+
+    assert len(vallocs) == 1
+    (valloc,) = vallocs
+
+    # The native stack ends at the first evaluation loop frame...
+    native_stack = [frame[0] for frame in valloc.native_stack_trace()]
+    assert "_PyEval_EvalFrameDefault" in native_stack[-1]
+    assert sum("_PyEval_EvalFrameDefault" in symbol for symbol in native_stack) == 1
+
+    # ... and the hybrid stack is completed by the Python frames
+    hybrid_stack = tuple(frame[0] for frame in valloc.hybrid_stack_trace())
+    assert hybrid_stack.count("recursive_func") == MAX_RECURSIONS
+    assert hybrid_stack[-1] == "test_native_stop_at_python"
+
+
+def test_max_native_stack_depth(tmpdir):
+    # GIVEN
+    allocator = MemoryAllocator()
+    MAX_DEPTH = 5
+
+    def recursive_func(n):
+        if n == 1:
+            return allocator.valloc(1234)
+        return recursive_func(n - 1)
+
+    def native_stack(output, **kwargs):
+        with Tracker(output, native_traces=True, **kwargs):
+            recursive_func(10)
+        records = list(FileReader(output).get_allocation_records())
+        (valloc,) = [
+            record
+            for record in filter_relevant_allocations(records)
+            if record.allocator == AllocatorType.VALLOC
+        ]
+        return [frame[0] for frame in valloc.native_stack_trace()]
+
+    # WHEN
+    full_stack = native_stack(Path(tmpdir) / "full.bin")
+    capped_stack = native_stack(
+        Path(tmpdir) / "capped.bin", max_native_stack_depth=MAX_DEPTH
+    )
+
+    # THEN
+    assert MAX_DEPTH <= len(capped_stack) < len(full_stack)
+    assert capped_stack == full_stack[: len(capped_stack)]
+
+
 def test_hybrid_stack_in_recursive_python_c_call(tmpdir, monkeypatch):
     # GIVEN
     output = Path(tmpdir) / "test.bin"
@@ -352,3 +425,90 @@ def test_native_tracing_header(native_traces, tmpdir):
 
     # THEN
     assert FileReader(output).metadata.has_native_traces is native_traces
+
+
+def test_memory_maps_are_written_incrementally(tmpdir):
+    """Test that loading and unloading a shared object only writes the
+    segments of that object and not the ones of every other loaded object."""
+    # GIVEN
+    allocator = MemoryAllocator()
+    output = Path(tmpdir) / "test.bin"
+    library = Path(tmpdir) / "copied_ctypes_module.so"
+    shutil.copyfile(_ctypes.__file__, library)
+
+    # WHEN
+    with Tracker(output, native_traces=True):
+        handle = ctypes.CDLL(str(library))._handle
+        allocator.valloc(1234)
+        allocator.free()
+        _ctypes.dlclose(handle)
+        allocator.valloc(1234)
+        allocator.free()
+
+    # THEN
+    proc = subprocess.run(
+        [sys.executable, "-m", "memray", "parse", str(output)],
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+    segment_headers = [
+        line for line in proc.stdout.splitlines() if line.startswith("SEGMENT_HEADER")
+    ]
+    added = [line for line in segment_headers if not line.endswith(" removed")]
+    removed = [line for line in segment_headers if line.endswith(" removed")]
+    assert len(added) == len(set(added))
+    assert sum(str(library) in line for line in added) == 1
+    assert len(removed) == 1
+    assert str(library) in removed[0]
+
+    records = list(FileReader(output).get_allocation_records())
+    vallocs = [
+        record
+        for record in filter_relevant_allocations(records)
+        if record.allocator == AllocatorType.VALLOC
+    ]
+    assert len(vallocs) == 2
+    for valloc in vallocs:
+        assert any("valloc" in frame[0] for frame in valloc.native_stack_trace())
+
+
+def test_symbol_cache_shared_by_captures_of_different_processes(tmp_path):
+    """Test that the symbols read for a capture resolve the stacks of another
+    capture of a process that loaded the same objects at other addresses."""
+    # GIVEN
+    program = textwrap.dedent(
+        """\
+        import sys
+        from memray import Tracker
+        from memray._test import MemoryAllocator
+
+        allocator = MemoryAllocator()
+        with Tracker(sys.argv[1], native_traces=True):
+            allocator.valloc(1234)
+        """
+    )
+    outputs = [tmp_path / "first.bin", tmp_path / "second.bin"]
+    for output in outputs:
+        subprocess.run([sys.executable, "-c", program, str(output)], check=True)
+
+    def native_stacks(reader):
+        return [
+            record.native_stack_trace()
+            for record in filter_relevant_allocations(reader.get_allocation_records())
+            if record.allocator == AllocatorType.VALLOC
+        ]
+
+    # WHEN
+    symbol_cache = SymbolCache()
+    shared = [
+        native_stacks(FileReader(output, symbol_cache=symbol_cache))
+        for output in outputs
+    ]
+
+    # THEN
+    assert len(symbol_cache) > 0
+    for output, stacks in zip(outputs, shared):
+        assert stacks == native_stacks(FileReader(output))
+        (stack,) = stacks
+        assert any("valloc" in frame[0] for frame in stack)
@@ -5,6 +5,7 @@ import pytest
 
 from memray import AllocatorType
 from memray import FileReader
+from memray import MultiFileReader
 from memray import Tracker
 from memray._test import MemoryAllocator
 from memray._test import PymallocDomain
@@ -20,6 +21,10 @@ def multiproc_func(repetitions):
         allocator.free()
 
 
+def multiproc_leak_func(size):
+    MemoryAllocator().valloc(size)
+
+
 def pymalloc_multiproc_func():
     allocator = PymallocMemoryAllocator(PymallocDomain.PYMALLOC_RAW)
     allocator.calloc(1234)
@@ -149,3 +154,44 @@ def test_pymalloc_allocations_after_fork(tmpdir):
 
     num_expected = 10
     assert len(child_callocs) == num_expected
+
+
+@pytest.mark.no_cover
+def test_multi_file_reader_following_fork(tmpdir):
+    # GIVEN
+    output = Path(tmpdir) / "test.bin"
+    sizes = [1234, 2345, 3456, 4567]
+    with Tracker(output, follow_fork=True):
+        with Pool(3) as p:
+            p.map(multiproc_leak_func, sizes)
+        multiproc_leak_func(9876)
+    child_files = sorted(Path(tmpdir).glob("test.bin.*"))
+
+    # WHEN
+    with MultiFileReader([output, *child_files]) as reader:
+        merged = reader.get_leaked_allocation_records()
+        split = reader.get_leaked_allocation_records(merge_processes=False)
+        process_metadata = reader.process_metadata
+
+    # THEN
+    def leak_records(records):
+        return [
+            record
+            for record in records
+            if any(frame[0] == "multiproc_leak_func" for frame in record.stack_trace)
+        ]
+
+    # The workers share the same stacks, so they are merged together, and
+    # only the parent's leak has a different one.
+    merged_leaks = leak_records(merged)
+    assert len(merged_leaks) == 2
+    assert all(record.pid is None for record in merged_leaks)
+    assert sum(record.size for record in merged_leaks) == sum(sizes) + 9876
+    assert sum(record.n_allocations for record in merged_leaks) == len(sizes) + 1
+
+    split_leaks = leak_records(split)
+    assert sum(record.size for record in split_leaks) == sum(sizes) + 9876
+    pids = [metadata.pid for metadata in process_metadata]
+    assert {record.pid for record in split_leaks} <= set(pids)
+    (parent_leak,) = [record for record in split_leaks if record.pid == pids[0]]
+    assert parent_leak.size == 9876
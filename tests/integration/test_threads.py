@@ -5,6 +5,7 @@ from memray import AllocatorType
 from memray import FileReader
 from memray import Tracker
 from memray._test import MemoryAllocator
+from memray._test import register_frames_concurrently
 from memray._test import set_thread_name
 from tests.utils import filter_relevant_allocations
 
@@ -92,3 +93,72 @@ def test_thread_name(tmpdir):
     (valloc,) = vallocs
     assert valloc.size == 1234
     assert "my thread name" in valloc.thread_name
+
+
+def test_distinct_frames_registered_concurrently(tmpdir):
+    # GIVEN
+    output = Path(tmpdir) / "test.bin"
+    allocator = MemoryAllocator()
+    n_threads = 8
+    n_functions = 300
+
+    def make_function(name, size):
+        namespace = {"allocator": allocator}
+        exec(
+            f"def {name}():\n"
+            f"    allocator.valloc({size})\n"
+            f"    allocator.free()\n",
+            namespace,
+        )
+        return namespace[name]
+
+    functions = [
+        [
+            make_function(f"func_{thread}_{index}", 4096 + thread * n_functions + index)
+            for index in range(n_functions)
+        ]
+        for thread in range(n_threads)
+    ]
+    start = threading.Barrier(n_threads)
+
+    def call_all(thread_functions):
+        start.wait()
+        for function in thread_functions:
+            function()
+
+    # WHEN
+    with Tracker(output):
+        threads = [
+            threading.Thread(target=call_all, args=(thread_functions,))
+            for thread_functions in functions
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+    # THEN
+    vallocs = [
+        record
+        for record in FileReader(output).get_allocation_records()
+        if record.allocator == AllocatorType.VALLOC and record.size >= 4096
+    ]
+    assert len(vallocs) == n_threads * n_functions
+    for valloc in vallocs:
+        thread, index = divmod(valloc.size - 4096, n_functions)
+        assert valloc.stack_trace()[1][0] == f"func_{thread}_{index}"
+
+
+def test_same_frames_registered_concurrently_from_native_threads():
+    # GIVEN
+    n_threads = 8
+    # Enough frames that the registry adds several tables while the threads
+    # race, which is when a frame could get a second id.
+    n_frames = 5000
+
+    for _ in range(3):
+        # WHEN
+        registered = register_frames_concurrently(n_threads, n_frames)
+
+        # THEN
+        assert registered == n_frames
@@ -142,13 +142,13 @@ def test_cython_traceback(tmpdir):
     traceback = list(alloc1.stack_trace())
     assert traceback[-3:] == [
         ("valloc", ANY, 97),
-        ("_cython_nested_allocation", ANY, 184),
+        ("_cython_nested_allocation", ANY, 191),
         ("test_cython_traceback", __file__, 132),
     ]
 
     traceback = list(alloc2.stack_trace())
     assert traceback[-3:] == [
-        ("_cython_nested_allocation", ANY, 184),
+        ("_cython_nested_allocation", ANY, 191),
         ("test_cython_traceback", __file__, 132),
     ]
 
@@ -529,6 +529,78 @@ def test_thread_surviving_multiple_trackers(tmp_path):
     assert tracker1_vallocs[0].stack_trace() != tracker2_vallocs[0].stack_trace()
 
 
+def test_max_python_stack_depth(tmp_path):
+    # GIVEN
+    allocator = MemoryAllocator()
+    output = tmp_path / "test.bin"
+
+    # WHEN
+    with Tracker(output, max_python_stack_depth=2):
+        alloc_func1(allocator)
+    records = list(FileReader(output).get_allocation_records())
+
+    # THEN
+    (alloc,) = [record for record in records if record.allocator == AllocatorType.VALLOC]
+    (innermost, outermost) = alloc.stack_trace()
+    assert innermost == ("alloc_func1", __file__, 34)
+    assert outermost[0] == "test_max_python_stack_depth"
+
+
+def test_excluded_modules(tmp_path):
+    # GIVEN
+    import json
+
+    allocator = MemoryAllocator()
+    output = tmp_path / "test.bin"
+
+    def object_hook(obj):
+        allocator.valloc(1234)
+        allocator.free()
+        return obj
+
+    # WHEN
+    with Tracker(output, excluded_modules=["json"]):
+        json.loads("{}", object_hook=object_hook)
+    records = list(FileReader(output).get_allocation_records())
+
+    # THEN
+    (alloc,) = [record for record in records if record.allocator == AllocatorType.VALLOC]
+    functions = [function for function, *_ in alloc.stack_trace()]
+    assert functions[-2:] == ["object_hook", "test_excluded_modules"]
+    assert not {"loads", "decode", "raw_decode"} & set(functions)
+
+
+def test_frames_are_registered_again_in_each_capture(tmp_path):
+    # GIVEN
+    allocator = MemoryAllocator()
+    outputs = [tmp_path / "test.bin.1", tmp_path / "test.bin.2"]
+
+    def two_lines():
+        allocator.valloc(1234)
+        allocator.free()
+        allocator.valloc(1234)
+        allocator.free()
+
+    first_line = two_lines.__code__.co_firstlineno + 1
+
+    # WHEN
+    for output in outputs:
+        with Tracker(output):
+            two_lines()
+
+    # THEN
+    for output in outputs:
+        vallocs = [
+            record
+            for record in FileReader(output).get_allocation_records()
+            if record.allocator == AllocatorType.VALLOC
+        ]
+        assert [valloc.stack_trace()[1] for valloc in vallocs] == [
+            ("two_lines", __file__, first_line),
+            ("two_lines", __file__, first_line + 2),
+        ]
+
+
 class TestMmap:
     @classmethod
     def allocating_function(cls):
@@ -16,9 +16,11 @@ from memray import FileReader
 from memray import Tracker
 from memray._memray import MmapAllocator
 from memray._test import MemoryAllocator
+from memray._test import PoolAllocator
 from memray._test import PymallocDomain
 from memray._test import PymallocMemoryAllocator
 from memray._test import _cython_allocate_in_two_places
+from memray._test import set_thread_name
 from tests.utils import filter_relevant_allocations
 
 ALLOCATORS = [
@@ -782,6 +784,55 @@ class TestHighWatermark:
         peak_memory = sum(x.size for x in peak_allocations)
         assert peak_memory == 17 * PAGE_SIZE
 
+    def test_mremap_grow(self, tmp_path):
+        """Growing a mapping with mremap should account for the new size only,
+        and not for both the old and the new mapping."""
+        # GIVEN/WHEN
+        output = tmp_path / "test.bin"
+        with Tracker(output):
+            alloc = MmapAllocator(2 * PAGE_SIZE)
+            alloc.mremap(2 * PAGE_SIZE, 8 * PAGE_SIZE)
+            alloc.munmap(8 * PAGE_SIZE)
+
+            MmapAllocator(4 * PAGE_SIZE)
+
+        # THEN
+        reader = FileReader(output)
+        peak_allocations = list(reader.get_high_watermark_allocation_records())
+        assert len(peak_allocations) == 1
+        assert peak_allocations[0].allocator == AllocatorType.MREMAP
+        assert peak_allocations[0].size == 8 * PAGE_SIZE
+
+        leaked_allocations = list(reader.get_leaked_allocation_records())
+        assert sum(x.size for x in leaked_allocations) == 4 * PAGE_SIZE
+
+    def test_madvise_dontneed(self, tmp_path):
+        """Pages released with madvise(MADV_DONTNEED) should no longer be
+        accounted for, even if the mapping itself is kept."""
+        # GIVEN/WHEN
+        output = tmp_path / "test.bin"
+        with Tracker(output):
+            alloc = MmapAllocator(8 * PAGE_SIZE)
+            alloc.madvise_dontneed(6 * PAGE_SIZE, PAGE_SIZE)
+
+            MmapAllocator(4 * PAGE_SIZE)
+
+        # THEN
+        reader = FileReader(output)
+        peak_allocations = list(reader.get_high_watermark_allocation_records())
+        assert sum(x.size for x in peak_allocations) == 8 * PAGE_SIZE
+
+        leaked_allocations = list(reader.get_leaked_allocation_records())
+        assert sum(x.size for x in leaked_allocations) == 6 * PAGE_SIZE
+
+        (madvise_record,) = [
+            record
+            for record in reader.get_allocation_records()
+            if record.allocator == AllocatorType.MADVISE
+        ]
+        assert madvise_record.address == alloc.address + PAGE_SIZE
+        assert madvise_record.size == 6 * PAGE_SIZE
+
 
 class TestLeaks:
     def test_leaks_allocations_are_detected(self, tmp_path):
@@ -1099,6 +1150,112 @@ class TestHeader:
         assert metadata.python_allocator == allocator_name
 
 
+class TestCaptureFilters:
+    def test_min_allocation_size(self, tmp_path):
+        # GIVEN
+        allocator = MemoryAllocator()
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        with Tracker(output, min_allocation_size=4096):
+            allocator.valloc(1024)
+            allocator.free()
+            allocator.valloc(8192)
+            allocator.free()
+
+        # THEN
+        reader = FileReader(output)
+        allocations = list(filter_relevant_allocations(reader.get_allocation_records()))
+        assert [(a.allocator, a.size) for a in allocations] == [
+            (AllocatorType.VALLOC, 8192),
+            (AllocatorType.FREE, 0),
+        ]
+        assert reader.metadata.dropped_by_size >= 1
+        assert reader.metadata.dropped_by_allocator == 0
+        assert reader.metadata.dropped_by_thread == 0
+
+    def test_min_allocation_size_drops_frees_of_reallocated_blocks(self, tmp_path):
+        # GIVEN
+        allocator = MemoryAllocator()
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        with Tracker(output, min_allocation_size=4096):
+            allocator.malloc(16)
+            allocator.realloc(16384)
+            allocator.free()
+
+        # THEN
+        records = list(FileReader(output).get_allocation_records())
+        (index,) = [
+            i
+            for i, record in enumerate(records)
+            if record.allocator == AllocatorType.REALLOC and record.size == 16384
+        ]
+        # Without filters, the FREE of the old block directly precedes the REALLOC
+        assert index == 0 or records[index - 1].allocator != AllocatorType.FREE
+        assert any(
+            record.allocator == AllocatorType.FREE
+            and record.address == records[index].address
+            for record in records[index + 1 :]
+        )
+
+    def test_allocators(self, tmp_path):
+        # GIVEN
+        allocator = MemoryAllocator()
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        with Tracker(output, allocators=[AllocatorType.MMAP]):
+            allocator.valloc(1024)
+            allocator.free()
+            mmap_allocator = MmapAllocator(2 * PAGE_SIZE)
+            mmap_allocator.munmap(2 * PAGE_SIZE)
+
+        # THEN
+        reader = FileReader(output)
+        records = reader.get_allocation_records()
+        allocations = list(filter_relevant_allocations(records, ranged=True))
+        assert [(a.allocator, a.size) for a in allocations] == [
+            (AllocatorType.MMAP, 2 * PAGE_SIZE),
+            (AllocatorType.MUNMAP, 2 * PAGE_SIZE),
+        ]
+        assert reader.metadata.dropped_by_allocator >= 1
+        assert reader.metadata.dropped_by_size == 0
+
+    def test_deallocators_are_not_valid_allocators(self, tmp_path):
+        # GIVEN / WHEN / THEN
+        with pytest.raises(ValueError, match="FREE is not an allocator"):
+            Tracker(tmp_path / "test.bin", allocators=[AllocatorType.FREE])
+
+    def test_thread_names(self, tmp_path):
+        # GIVEN
+        allocators = {"worker-1": MemoryAllocator(), "other": MemoryAllocator()}
+        output = tmp_path / "test.bin"
+
+        def allocating_thread(name, size):
+            set_thread_name(name)
+            allocators[name].valloc(size)
+
+        # WHEN
+        with Tracker(output, thread_names=["worker-*"]):
+            for name, size in [("worker-1", 1234), ("other", 4321)]:
+                thread = threading.Thread(target=allocating_thread, args=(name, size))
+                thread.start()
+                thread.join()
+            for allocator in allocators.values():
+                allocator.free()
+
+        # THEN
+        reader = FileReader(output)
+        allocations = list(filter_relevant_allocations(reader.get_allocation_records()))
+        assert [(a.allocator, a.size) for a in allocations] == [
+            (AllocatorType.VALLOC, 1234),
+            (AllocatorType.FREE, 0),
+        ]
+        assert reader.metadata.dropped_by_thread >= 1
+
+
 class TestMemoryRecords:
     @pytest.mark.valgrind
     def test_memory_records_are_written(self, tmp_path):
@@ -1141,3 +1298,112 @@ class TestMemoryRecords:
             _next.time - prev.time >= 20
             for prev, _next in zip(memory_records, memory_records[1:])
         )
+
+
+
+class TestTimestamps:
+    def test_allocations_have_timestamps(self, tmp_path):
+        # GIVEN
+        allocator = MemoryAllocator()
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        start_ms = time.time() * 1000
+        with Tracker(output, timestamps=True):
+            allocator.valloc(1234)
+            allocator.free()
+            time.sleep(0.1)
+            allocator.valloc(1234)
+            allocator.free()
+        end_ms = time.time() * 1000
+
+        reader = FileReader(output)
+        records = filter_relevant_allocations(reader.get_allocation_records())
+
+        # THEN
+        assert reader.metadata.has_timestamps
+        timestamps = [record.timestamp for record in records]
+        assert len(timestamps) == 4
+        assert timestamps == sorted(timestamps)
+        # The coarse clock can lag behind the precise one by a few ticks.
+        assert all(start_ms - 50 <= ts <= end_ms + 50 for ts in timestamps)
+        assert timestamps[1] - timestamps[0] < 50
+        assert timestamps[2] - timestamps[1] >= 90
+
+    def test_no_timestamps_by_default(self, tmp_path):
+        # GIVEN
+        allocator = MemoryAllocator()
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        with Tracker(output):
+            allocator.valloc(1234)
+            allocator.free()
+
+        reader = FileReader(output)
+        records = filter_relevant_allocations(reader.get_allocation_records())
+
+        # THEN
+        assert not reader.metadata.has_timestamps
+        assert [record.timestamp for record in records] == [None, None]
+
+class TestPoolAllocations:
+    def test_pool_allocations_are_tracked(self, tmp_path):
+        # GIVEN
+        output = tmp_path / "test.bin"
+        pool = PoolAllocator(4096, pool_id=7)
+
+        # WHEN
+        with Tracker(output):
+            first = pool.alloc(100)
+            second = pool.alloc(200)
+            pool.free(first)
+        pool.alloc(300)
+
+        # THEN
+        records = [
+            record
+            for record in FileReader(output).get_allocation_records()
+            if record.allocator in (AllocatorType.POOL_ALLOC, AllocatorType.POOL_FREE)
+        ]
+        assert [
+            (record.allocator, record.address, record.size, record.pool_id)
+            for record in records
+        ] == [
+            (AllocatorType.POOL_ALLOC, first, 100, 7),
+            (AllocatorType.POOL_ALLOC, second, 200, 7),
+            (AllocatorType.POOL_FREE, first, 0, 7),
+        ]
+
+    def test_pool_blocks_do_not_replace_the_allocations_they_come_from(
+        self, tmp_path
+    ):
+        # GIVEN
+        output = tmp_path / "test.bin"
+
+        # WHEN
+        with Tracker(output):
+            pool = PoolAllocator(4096, pool_id=1)
+            other_pool = PoolAllocator(4096, pool_id=2)
+            # The first block of each pool starts where its buffer does
+            block = pool.alloc(128)
+            other_block = other_pool.alloc(256)
+            other_pool.free(other_block)
+
+        # THEN
+        reader = FileReader(output)
+        leaks = {
+            (record.allocator, record.address, record.size)
+            for record in reader.get_leaked_allocation_records()
+        }
+        assert (AllocatorType.MALLOC, block, 4096) in leaks
+        assert (AllocatorType.MALLOC, other_block, 4096) in leaks
+        assert (AllocatorType.POOL_ALLOC, block, 128) in leaks
+        assert (AllocatorType.POOL_ALLOC, other_block, 256) not in leaks
+
+        peak = list(reader.get_high_watermark_allocation_records())
+        assert sum(
+            record.size
+            for record in peak
+            if record.allocator == AllocatorType.POOL_ALLOC
+        ) == 128 + 256
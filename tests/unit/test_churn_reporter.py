@@ -0,0 +1,99 @@
+from io import StringIO
+
+from memray import AllocatorType
+from memray._memray import AllocationLifetimeRecord
+from memray.reporters.churn import ChurnReporter
+from memray.reporters.churn import rank_by_churn
+from tests.utils import MockAllocationRecord
+
+
+def _lifetime_record(function, n_allocations, n_freed, median_lifetime):
+    allocation = MockAllocationRecord(
+        tid=1,
+        address=0x1000000,
+        size=64 * n_allocations,
+        allocator=AllocatorType.MALLOC,
+        stack_id=1,
+        n_allocations=n_allocations,
+        _stack=[(function, "fun.py", 12)],
+    )
+    return AllocationLifetimeRecord(
+        allocation=allocation,
+        n_freed=n_freed,
+        median_lifetime=median_lifetime,
+        p90_lifetime=2 * median_lifetime,
+        histogram=[(median_lifetime, n_freed)] if n_freed else [],
+    )
+
+
+def test_rank_by_churn():
+    # GIVEN
+    records = [
+        _lifetime_record("few", 10, 10, 1),
+        _lifetime_record("leaked", 100, 0, 0),
+        _lifetime_record("long_lived", 100, 100, 500),
+        _lifetime_record("short_lived", 100, 100, 3),
+    ]
+
+    # WHEN
+    ranked = rank_by_churn(records)
+
+    # THEN
+    assert [record.allocation.stack_trace()[0][0] for record in ranked] == [
+        "short_lived",
+        "long_lived",
+        "leaked",
+        "few",
+    ]
+
+
+def test_render():
+    # GIVEN
+    records = [
+        _lifetime_record("leaked", 5, 0, 0),
+        _lifetime_record("short_lived", 200, 150, 3),
+        _lifetime_record("few", 1, 1, 1),
+    ]
+    reporter = ChurnReporter(records, duration=2.0, num_largest=2)
+    output = StringIO()
+
+    # WHEN
+    reporter.render(file=output)
+
+    # THEN
+    lines = output.getvalue().splitlines()
+    assert lines[2].split() == [
+        "100.0",
+        "200",
+        "75%",
+        "3",
+        "6",
+        "12.500KB",
+        "short_lived:fun.py:12",
+    ]
+    assert lines[3].split() == [
+        "2.5",
+        "5",
+        "0%",
+        "-",
+        "-",
+        "320.000B",
+        "leaked:fun.py:12",
+    ]
+    assert len(lines) == 4
+
+
+def test_render_without_duration_or_allocations():
+    # GIVEN
+    output = StringIO()
+
+    # WHEN
+    ChurnReporter([], duration=0, num_largest=5).render(file=output)
+    ChurnReporter(
+        [_lifetime_record("few", 1, 1, 1)], duration=0, num_largest=5
+    ).render(file=output)
+
+    # THEN
+    text = output.getvalue()
+    assert "No allocations" in text
+    assert text.splitlines()[-1].split()[0] == "-"
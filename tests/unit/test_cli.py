@@ -5,6 +5,7 @@ from unittest.mock import patch
 
 import pytest
 
+from memray import AllocatorType
 from memray import FileDestination
 from memray import SocketDestination
 from memray.commands import main
@@ -78,6 +79,79 @@ class TestRunSubCommand:
             trace_python_allocators=True,
         )
 
+    def test_run_with_timestamps(
+        self, getpid_mock, runpy_mock, tracker_mock, validate_mock
+    ):
+        getpid_mock.return_value = 0
+        assert 0 == main(["run", "--timestamps", "-m", "foobar"])
+        tracker_mock.assert_called_with(
+            destination=FileDestination("memray-foobar.0.bin", overwrite=False),
+            native_traces=False,
+            timestamps=True,
+        )
+
+    def test_run_with_capture_filters(
+        self, getpid_mock, runpy_mock, tracker_mock, validate_mock
+    ):
+        getpid_mock.return_value = 0
+        assert 0 == main(
+            [
+                "run",
+                "--filter-min-size",
+                "65536",
+                "--filter-allocator",
+                "mmap",
+                "--filter-allocator",
+                "malloc",
+                "--filter-thread",
+                "worker-*",
+                "--max-python-stack-depth",
+                "64",
+                "--exclude-module",
+                "asyncio",
+                "-m",
+                "foobar",
+            ]
+        )
+        tracker_mock.assert_called_with(
+            destination=FileDestination("memray-foobar.0.bin", overwrite=False),
+            native_traces=False,
+            min_allocation_size=65536,
+            allocators=[AllocatorType.MMAP, AllocatorType.MALLOC],
+            thread_names=["worker-*"],
+            max_python_stack_depth=64,
+            excluded_modules=["asyncio"],
+        )
+
+    def test_run_with_native_unwind_limits(
+        self, getpid_mock, runpy_mock, tracker_mock, validate_mock
+    ):
+        getpid_mock.return_value = 0
+        assert 0 == main(
+            [
+                "run",
+                "--native",
+                "--max-native-stack-depth",
+                "32",
+                "--native-stop-at-python",
+                "-m",
+                "foobar",
+            ]
+        )
+        tracker_mock.assert_called_with(
+            destination=FileDestination("memray-foobar.0.bin", overwrite=False),
+            native_traces=True,
+            max_native_stack_depth=32,
+            native_stop_at_python=True,
+        )
+
+    def test_run_native_unwind_limits_require_native(
+        self, getpid_mock, runpy_mock, tracker_mock, validate_mock
+    ):
+        with pytest.raises(SystemExit):
+            main(["run", "--native-stop-at-python", "-m", "foobar"])
+        tracker_mock.assert_not_called()
+
     def test_run_override_output(
         self, getpid_mock, runpy_mock, tracker_mock, validate_mock
     ):
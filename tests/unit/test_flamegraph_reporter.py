@@ -3,9 +3,14 @@ import sys
 from memray import AllocatorType
 from memray import FileReader
 from memray import Tracker
+from memray._memray import ProcessAllocationRecord
+from memray._memray import SnapshotDiffRecord
+from memray._memray import TemporalAllocationRecord
 from memray._test import MemoryAllocator
 from memray.reporters.flamegraph import MAX_STACKS
+from memray.reporters.flamegraph import DiffFlameGraphReporter
 from memray.reporters.flamegraph import FlameGraphReporter
+from memray.reporters.flamegraph import TemporalFlameGraphReporter
 from tests.utils import MockAllocationRecord
 from tests.utils import filter_relevant_allocations
 
@@ -873,3 +878,185 @@ class TestFlameGraphReporter:
             "thread_id": "0x1",
             "value": 1024,
         }
+
+    def test_process_records_are_merged(self):
+        # GIVEN
+        records = [
+            ProcessAllocationRecord(
+                None, [("me", "fun.py", 12), ("parent", "fun.py", 8)], 3072, 3
+            ),
+            ProcessAllocationRecord(None, [("parent", "fun.py", 8)], 1024, 1),
+        ]
+
+        # WHEN
+        reporter = FlameGraphReporter.from_process_records(records, memory_records=[])
+
+        # THEN
+        data = reporter.data
+        assert data["value"] == 4096
+        assert data["n_allocations"] == 4
+        assert data["unique_threads"] == []
+        (parent,) = data["children"]
+        assert parent["name"] == "parent at fun.py:8"
+        assert parent["value"] == 4096
+        (child,) = parent["children"]
+        assert child["name"] == "me at fun.py:12"
+        assert child["value"] == 3072
+
+    def test_process_records_are_grouped_by_process(self):
+        # GIVEN
+        stack = [("me", "fun.py", 12), ("parent", "fun.py", 8)]
+        records = [
+            ProcessAllocationRecord(1234, stack, 3072, 3),
+            ProcessAllocationRecord(99, stack, 1024, 1),
+        ]
+
+        # WHEN
+        reporter = FlameGraphReporter.from_process_records(records, memory_records=[])
+
+        # THEN
+        data = reporter.data
+        assert data["value"] == 4096
+        assert data["unique_threads"] == ["process 99", "process 1234"]
+        by_name = {child["name"]: child for child in data["children"]}
+        assert sorted(by_name) == ["<process 1234>", "<process 99>"]
+        for pid, size in ((1234, 3072), (99, 1024)):
+            process = by_name[f"<process {pid}>"]
+            assert process["value"] == size
+            (parent,) = process["children"]
+            assert parent["name"] == "parent at fun.py:8"
+            assert parent["value"] == size
+            assert parent["thread_id"] == f"process {pid}"
+
+
+class TestTemporalFlameGraphReporter:
+    def test_works_with_no_allocations(self):
+        reporter = TemporalFlameGraphReporter.from_temporal_records(
+            [], memory_records=[], native_traces=False
+        )
+        assert reporter.data["name"] == "<root>"
+        assert reporter.data["children"] == []
+        assert reporter.data["intervals"] == []
+
+    def test_locations_are_attached_to_their_last_frame(self):
+        # GIVEN
+        records = [
+            TemporalAllocationRecord(
+                MockAllocationRecord(
+                    tid=1,
+                    address=0x1000000,
+                    size=1024,
+                    allocator=AllocatorType.MALLOC,
+                    stack_id=1,
+                    n_allocations=1,
+                    _stack=[
+                        ("me", "fun.py", 12),
+                        ("parent", "fun.py", 8),
+                    ],
+                ),
+                [(0, 3, 1, 1024)],
+            ),
+            TemporalAllocationRecord(
+                MockAllocationRecord(
+                    tid=1,
+                    address=0x2000000,
+                    size=2048,
+                    allocator=AllocatorType.MALLOC,
+                    stack_id=2,
+                    n_allocations=1,
+                    _stack=[
+                        ("parent", "fun.py", 10),
+                    ],
+                ),
+                [(1, 2, 1, 2048), (2, 4, 2, 4096)],
+            ),
+        ]
+
+        # WHEN
+        reporter = TemporalFlameGraphReporter.from_temporal_records(
+            records, memory_records=[], native_traces=False
+        )
+
+        # THEN
+        data = reporter.data
+        assert data["intervals"] == [
+            [(0, 3, 1, 1024)],
+            [(1, 2, 1, 2048), (2, 4, 2, 4096)],
+        ]
+        assert data["unique_threads"] == ["0x1"]
+        assert "locations" not in data
+        by_name = {child["name"]: child for child in data["children"]}
+        assert set(by_name) == {"parent at fun.py:8", "parent at fun.py:10"}
+
+        caller = by_name["parent at fun.py:8"]
+        assert "locations" not in caller
+        (callee,) = caller["children"]
+        assert callee["name"] == "me at fun.py:12"
+        assert callee["locations"] == [0]
+        assert callee["children"] == []
+
+        assert by_name["parent at fun.py:10"]["locations"] == [1]
+
+
+class TestDiffFlameGraphReporter:
+    def test_works_with_no_allocations(self):
+        reporter = DiffFlameGraphReporter.from_diff_records([], memory_records=[])
+        assert reporter.data["name"] == "<root>"
+        assert reporter.data["value"] == 0
+        assert reporter.data["children"] == []
+
+    def test_sizes_before_and_after_are_summed_up_to_the_root(self):
+        # GIVEN
+        records = [
+            SnapshotDiffRecord(
+                [("me", "fun.py", 12), ("parent", "fun.py", 8)], 1024, 1, 3072, 3
+            ),
+            SnapshotDiffRecord(
+                [("other", "fun.py", 20), ("parent", "fun.py", 8)], 2048, 2, 0, 0
+            ),
+        ]
+
+        # WHEN
+        reporter = DiffFlameGraphReporter.from_diff_records(records, memory_records=[])
+
+        # THEN
+        data = reporter.data
+        assert data["size_before"] == 3072
+        assert data["size_after"] == 3072
+        assert data["n_allocations_before"] == 3
+        assert data["n_allocations"] == 3
+        # Each child is as wide as the most it had, so the parent is as wide as
+        # both of them together, even if its own total never got that big.
+        assert data["value"] == 5120
+
+        (parent,) = data["children"]
+        assert parent["name"] == "parent at fun.py:8"
+        assert parent["value"] == 5120
+        by_name = {child["name"]: child for child in parent["children"]}
+        grown = by_name["me at fun.py:12"]
+        assert (grown["size_before"], grown["size_after"]) == (1024, 3072)
+        assert grown["value"] == 3072
+        # Frames whose memory went away are kept, with the size they had.
+        gone = by_name["other at fun.py:20"]
+        assert (gone["size_before"], gone["size_after"]) == (2048, 0)
+        assert gone["value"] == 2048
+
+    def test_frames_are_as_wide_as_their_own_memory_and_their_children(self):
+        # GIVEN
+        records = [
+            SnapshotDiffRecord([("parent", "fun.py", 8)], 1000, 1, 0, 0),
+            SnapshotDiffRecord(
+                [("child", "fun.py", 12), ("parent", "fun.py", 8)], 0, 0, 500, 1
+            ),
+        ]
+
+        # WHEN
+        reporter = DiffFlameGraphReporter.from_diff_records(records, memory_records=[])
+
+        # THEN
+        (parent,) = reporter.data["children"]
+        assert (parent["size_before"], parent["size_after"]) == (1000, 500)
+        (child,) = parent["children"]
+        assert child["value"] == 500
+        assert parent["value"] == 1500
+        assert reporter.data["value"] == 1500
@@ -0,0 +1,110 @@
+from io import StringIO
+
+from memray import AllocatorType
+from memray._memray import PageOccupancyRecord
+from memray.reporters.fragmentation import FragmentationReporter
+from memray.reporters.fragmentation import fragmentation_ratio
+from memray.reporters.fragmentation import sample_records
+from tests.utils import MockAllocationRecord
+
+
+def _occupancy(time, heap_size, occupied_pages):
+    return PageOccupancyRecord(
+        time=time,
+        rss=2 * occupied_pages * 4096,
+        heap_size=heap_size,
+        occupied_pages=occupied_pages,
+        partially_used_pages=1,
+        sparse_pages=1,
+        regions=1,
+    )
+
+
+def test_fragmentation_ratio():
+    # GIVEN
+    record = _occupancy(0, heap_size=4096, occupied_pages=4)
+
+    # WHEN
+    ratio = fragmentation_ratio(record, page_size=4096)
+
+    # THEN
+    assert ratio == 0.75
+
+
+def test_fragmentation_ratio_without_occupied_pages():
+    # GIVEN
+    record = _occupancy(0, heap_size=0, occupied_pages=0)
+
+    # WHEN
+    ratio = fragmentation_ratio(record, page_size=4096)
+
+    # THEN
+    assert ratio == 0
+
+
+def test_sample_records_keeps_first_and_last():
+    # GIVEN
+    records = [_occupancy(time, 0, 0) for time in range(100)]
+
+    # WHEN
+    samples = sample_records(records, 5)
+
+    # THEN
+    assert [record.time for record in samples] == [0, 25, 50, 74, 99]
+    assert sample_records(records[:3], 5) == records[:3]
+    assert sample_records(records, 1) == records[-1:]
+
+
+def test_render():
+    # GIVEN
+    occupancy_records = [
+        _occupancy(1000, heap_size=4096, occupied_pages=2),
+        _occupancy(1500, heap_size=4096, occupied_pages=8),
+        _occupancy(2000, heap_size=8192, occupied_pages=4),
+    ]
+    allocations = [
+        MockAllocationRecord(
+            tid=1,
+            address=0x1000000,
+            size=size,
+            allocator=AllocatorType.MALLOC,
+            stack_id=1,
+            n_allocations=3,
+            _stack=[(function, "fun.py", 12)],
+        )
+        for function, size in [("small", 100), ("big", 5000)]
+    ]
+    reporter = FragmentationReporter(
+        occupancy_records,
+        allocations,
+        page_size=4096,
+        num_largest=1,
+        num_samples=10,
+    )
+    output = StringIO()
+
+    # WHEN
+    reporter.render(file=output)
+
+    # THEN
+    text = output.getvalue()
+    assert "0.500s" in text
+    assert "Highest fragmentation: 87.5% at 0.500s" in text
+    assert "big:fun.py:12 -> 4.883KB unused (3 allocations)" in text
+    assert "small" not in text
+
+
+def test_render_without_records():
+    # GIVEN
+    reporter = FragmentationReporter(
+        [], [], page_size=4096, num_largest=5, num_samples=10
+    )
+    output = StringIO()
+
+    # WHEN
+    reporter.render(file=output)
+
+    # THEN
+    text = output.getvalue()
+    assert "No memory records in the capture" in text
+    assert "No sparse pages" in text
@@ -1,4 +1,6 @@
+import argparse
 import os
+from datetime import timedelta
 from pathlib import Path
 from unittest.mock import MagicMock
 from unittest.mock import Mock
@@ -9,6 +11,7 @@ import pytest
 
 from memray._errors import MemrayCommandError
 from memray.commands.common import HighWatermarkCommand
+from memray.commands.common import parse_snapshot_point
 
 
 class TestFilenameValidation:
@@ -198,3 +201,84 @@ class TestReportGeneration:
 
         reporter_factory_mock.assert_called_once()
         reporter_factory_mock().render.assert_called_once()
+
+    def test_tracker_and_reporter_interactions_for_snapshot_at(self, tmp_path):
+        # GIVEN
+        reporter_factory_mock = Mock()
+        command = HighWatermarkCommand(reporter_factory_mock, reporter_name="reporter")
+        result_path = tmp_path / "results.bin"
+        output_file = tmp_path / "output.txt"
+
+        # WHEN
+        with patch("memray.commands.common.FileReader") as reader_mock:
+            command.write_report(
+                result_path=result_path,
+                output_file=output_file,
+                show_memory_leaks=False,
+                snapshot_at=timedelta(minutes=37),
+            )
+
+        # THEN
+        calls = [
+            call(os.fspath(result_path)),
+            call().get_snapshot_at(timedelta(minutes=37), merge_threads=True),
+            call().get_memory_records(),
+        ]
+        reader_mock.assert_has_calls(calls)
+
+        reporter_factory_mock.assert_called_once()
+        reporter_factory_mock().render.assert_called_once()
+        _, kwargs = reporter_factory_mock().render.call_args
+        assert kwargs["snapshot_at"] == "2220 seconds after tracking started"
+
+    def test_tracker_and_reporter_interactions_with_spill_directory(self, tmp_path):
+        # GIVEN
+        reporter_factory_mock = Mock()
+        command = HighWatermarkCommand(reporter_factory_mock, reporter_name="reporter")
+        result_path = tmp_path / "results.bin"
+        output_file = tmp_path / "output.txt"
+
+        # WHEN
+        with patch("memray.commands.common.FileReader") as reader_mock:
+            command.write_report(
+                result_path=result_path,
+                output_file=output_file,
+                show_memory_leaks=False,
+                spill_directory=os.fspath(tmp_path),
+            )
+
+        # THEN
+        calls = [
+            call(os.fspath(result_path), spill_directory=os.fspath(tmp_path)),
+            call().get_high_watermark_allocation_records(merge_threads=True),
+            call().get_memory_records(),
+        ]
+        reader_mock.assert_has_calls(calls)
+        reporter_factory_mock().render.assert_called_once()
+
+
+class TestParseSnapshotPoint:
+    @pytest.mark.parametrize(
+        "value, expected",
+        [
+            ("0", 0),
+            ("12345", 12345),
+            ("37m", timedelta(minutes=37)),
+            ("90s", timedelta(seconds=90)),
+            ("1.5s", timedelta(milliseconds=1500)),
+            ("250ms", timedelta(milliseconds=250)),
+            ("1h2m3s", timedelta(hours=1, minutes=2, seconds=3)),
+        ],
+    )
+    def test_parses_indices_and_durations(self, value, expected):
+        # GIVEN / WHEN
+        parsed = parse_snapshot_point(value)
+
+        # THEN
+        assert parsed == expected
+
+    @pytest.mark.parametrize("value", ["", "-5", "1.5", "3d", "1m foo"])
+    def test_rejects_invalid_values(self, value):
+        # GIVEN / WHEN / THEN
+        with pytest.raises(argparse.ArgumentTypeError):
+            parse_snapshot_point(value)
@@ -1,11 +1,19 @@
+import mmap
 import os
+import time
+from datetime import timedelta
 
 import pytest
 
+from memray import AllocatorType
 from memray import FileDestination
 from memray import FileReader
+from memray import MultiFileReader
 from memray import Tracker
+from memray import compute_snapshot_diff
 from memray._memray import MemoryAllocator
+from memray._test import MmapAllocator
+from memray._test import write_synthetic_capture
 
 
 def test_rejects_different_header_magic(tmp_path):
@@ -79,3 +87,644 @@ def test_read_pid(tmp_path):
 
     # THEN
     assert FileReader(output).metadata.pid == os.getpid()
+
+
+def test_read_synthetic_capture(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+
+    # WHEN
+    write_synthetic_capture(
+        output, allocations=10_000, threads=3, leak_fraction=0.1, mmap_fraction=0
+    )
+
+    # THEN
+    reader = FileReader(output)
+    records = list(reader.get_allocation_records())
+    allocations = [r for r in records if r.allocator == AllocatorType.MALLOC]
+    frees = [r for r in records if r.allocator == AllocatorType.FREE]
+    assert len(allocations) == 10_000
+    assert len(frees) == len(records) - len(allocations)
+    assert {r.tid for r in records} == {1, 2, 3}
+    assert all(r.stack_trace() for r in allocations)
+    leaks = list(reader.get_leaked_allocation_records(merge_threads=False))
+    assert sum(leak.n_allocations for leak in leaks) == 10_000 - len(frees)
+    assert 800 < 10_000 - len(frees) < 1200
+
+
+def test_read_synthetic_capture_with_native_traces(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+
+    # WHEN
+    write_synthetic_capture(
+        output,
+        allocations=1_000,
+        mmap_fraction=0,
+        native_traces=True,
+        dlopen_churn=10,
+    )
+
+    # THEN
+    reader = FileReader(output)
+    assert reader.metadata.has_native_traces
+    records = [
+        record
+        for record in reader.get_allocation_records()
+        if record.allocator == AllocatorType.MALLOC
+    ]
+    assert len(records) == 1_000
+    assert all(list(record.native_stack_trace()) for record in records)
+
+
+def test_synthetic_capture_rejects_invalid_workloads(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+
+    # WHEN/THEN
+    with pytest.raises(ValueError, match="min_size"):
+        write_synthetic_capture(output, min_size=100, max_size=10)
+
+
+def test_page_occupancy_records(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    allocators = [MemoryAllocator() for _ in range(10)]
+
+    # WHEN
+    with Tracker(output, memory_interval_ms=1):
+        for allocator in allocators:
+            allocator.valloc(64)
+        time.sleep(0.1)
+
+    # THEN
+    records = list(FileReader(output).get_page_occupancy_records())
+    assert records
+    assert [record.time for record in records] == sorted(
+        record.time for record in records
+    )
+    last = records[-1]
+    assert last.rss > 0
+    assert last.heap_size >= 10 * 64
+    # Every valloc'd block starts a page that nothing else can fill up
+    assert last.occupied_pages >= 10
+    assert last.partially_used_pages >= 10
+    assert last.sparse_pages >= 10
+    assert last.regions >= 1
+
+
+def test_sparse_page_allocation_records(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    allocators = [MemoryAllocator() for _ in range(10)]
+
+    # WHEN
+    with Tracker(output):
+        for allocator in allocators:
+            allocator.valloc(64)
+
+    # THEN
+    records = list(
+        FileReader(output).get_sparse_page_allocation_records(
+            leaks=True, page_size=4096
+        )
+    )
+    vallocs = [
+        record
+        for record in records
+        if record.allocator == AllocatorType.VALLOC and record.n_allocations == 10
+    ]
+    assert len(vallocs) == 1
+    assert 0 < vallocs[0].size <= 10 * (4096 - 64)
+
+
+@pytest.mark.parametrize(
+    "page_size, sparse_threshold",
+    [(0, 0.5), (1000, 0.5), (4096, 0), (4096, 1.5)],
+)
+def test_page_occupancy_rejects_invalid_arguments(
+    tmp_path, page_size, sparse_threshold
+):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    with Tracker(output):
+        MemoryAllocator().valloc(64)
+    reader = FileReader(output)
+
+    # WHEN/THEN
+    with pytest.raises(ValueError):
+        list(
+            reader.get_page_occupancy_records(
+                page_size=page_size, sparse_threshold=sparse_threshold
+            )
+        )
+    with pytest.raises(ValueError):
+        list(
+            reader.get_sparse_page_allocation_records(
+                page_size=page_size, sparse_threshold=sparse_threshold
+            )
+        )
+
+
+def test_allocation_lifetime_records(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    allocators = [MemoryAllocator() for _ in range(10)]
+    short_lived = MemoryAllocator()
+
+    # WHEN
+    with Tracker(output):
+        for allocator in allocators:
+            allocator.valloc(1024)
+        for allocator in allocators:
+            allocator.free()
+        for _ in range(100):
+            short_lived.valloc(64)
+            short_lived.free()
+        allocators[0].valloc(2048)
+
+    # THEN
+    records = [
+        record
+        for record in FileReader(output).get_allocation_lifetime_records()
+        if record.allocation.allocator == AllocatorType.VALLOC
+    ]
+    by_size = {record.allocation.size: record for record in records}
+    assert set(by_size) == {10 * 1024, 100 * 64, 2048}
+
+    # Each of the first allocations is freed 10 records after it's made
+    batch = by_size[10 * 1024]
+    assert batch.allocation.n_allocations == batch.n_freed == 10
+    assert 10 <= batch.median_lifetime <= 12
+    assert sum(count for _, count in batch.histogram) == 10
+
+    churn = by_size[100 * 64]
+    assert churn.allocation.n_allocations == churn.n_freed == 100
+    assert churn.median_lifetime <= 2
+    assert churn.p90_lifetime <= 2
+
+    leaked = by_size[2048]
+    assert leaked.allocation.n_allocations == 1
+    assert leaked.n_freed == 0
+    assert leaked.histogram == []
+
+
+def test_temporal_allocation_records(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    freed = MemoryAllocator()
+    leaked = MemoryAllocator()
+
+    # WHEN
+    with Tracker(output):
+        freed.valloc(1024 * 1024)
+        time.sleep(0.05)
+        leaked.valloc(2 * 1024 * 1024)
+        time.sleep(0.05)
+        freed.free()
+        time.sleep(0.05)
+
+    # THEN
+    reader = FileReader(output)
+    n_snapshots = len(list(reader.get_memory_records())) + 1
+    records = {
+        record.allocation.size: record
+        for record in reader.get_temporal_allocation_records()
+        if record.allocation.allocator == AllocatorType.VALLOC
+    }
+    assert set(records) == {1024 * 1024, 2 * 1024 * 1024}
+
+    ((freed_begin, freed_end, n_allocations, n_bytes),) = records[
+        1024 * 1024
+    ].intervals
+    assert (n_allocations, n_bytes) == (1, 1024 * 1024)
+
+    ((leaked_begin, leaked_end, n_allocations, n_bytes),) = records[
+        2 * 1024 * 1024
+    ].intervals
+    assert (n_allocations, n_bytes) == (1, 2 * 1024 * 1024)
+
+    # The freed allocation was made first and freed before the end, while
+    # the leaked one was alive until the last snapshot.
+    assert freed_begin < leaked_begin < freed_end < leaked_end
+    assert leaked_end == n_snapshots
+
+
+def test_temporal_records_of_a_mapping_released_in_pieces(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    page = mmap.PAGESIZE
+
+    # WHEN
+    with Tracker(output):
+        mapping = MmapAllocator(10 * page)
+        time.sleep(0.05)
+        mapping.munmap(4 * page, offset=page)
+        time.sleep(0.05)
+        mapping.munmap(10 * page)
+        time.sleep(0.05)
+
+    # THEN
+    reader = FileReader(output)
+    n_snapshots = len(list(reader.get_memory_records())) + 1
+    (record,) = [
+        record
+        for record in reader.get_temporal_allocation_records()
+        if record.allocation.allocator == AllocatorType.MMAP
+    ]
+    assert [
+        (n_allocations, n_bytes) for _, _, n_allocations, n_bytes in record.intervals
+    ] == [(1, 10 * page), (1, 6 * page)]
+    # Releasing the rest of the split mapping closes its last interval.
+    assert record.intervals[-1][1] < n_snapshots
+
+
+def test_snapshot_at_allocation_record_index(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    allocator = MemoryAllocator()
+
+    with Tracker(output):
+        allocator.valloc(1024)
+        allocator.free()
+        allocator.valloc(2048)
+        allocator.free()
+
+    reader = FileReader(output)
+    records = [
+        record
+        for record in reader.get_allocation_records()
+        if record.allocator in {AllocatorType.VALLOC, AllocatorType.FREE}
+    ]
+    all_records = list(reader.get_allocation_records())
+    second_valloc = all_records.index(records[2])
+
+    # WHEN
+    snapshot = list(reader.get_snapshot_at(second_valloc + 1))
+
+    # THEN
+    vallocs = [
+        record for record in snapshot if record.allocator == AllocatorType.VALLOC
+    ]
+    assert len(vallocs) == 1
+    assert vallocs[0].size == 2048
+
+
+@pytest.mark.parametrize("timestamps", [True, False])
+def test_snapshot_at_time(tmp_path, timestamps):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    first = MemoryAllocator()
+    second = MemoryAllocator()
+
+    with Tracker(output, timestamps=timestamps):
+        first.valloc(1024 * 1024)
+        time.sleep(0.2)
+        second.valloc(2 * 1024 * 1024)
+        time.sleep(0.2)
+        first.free()
+        second.free()
+
+    reader = FileReader(output)
+
+    def valloc_sizes(snapshot):
+        return sorted(
+            record.size
+            for record in snapshot
+            if record.allocator == AllocatorType.VALLOC
+        )
+
+    # WHEN
+    early = valloc_sizes(reader.get_snapshot_at(timedelta(milliseconds=100)))
+    late = valloc_sizes(reader.get_snapshot_at(timedelta(milliseconds=300)))
+    end = valloc_sizes(reader.get_snapshot_at(timedelta(hours=1)))
+
+    # THEN
+    assert early == [1024 * 1024]
+    assert late == [1024 * 1024, 2 * 1024 * 1024]
+    assert end == []
+
+
+def test_snapshot_at_rejects_invalid_points(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    with Tracker(output):
+        pass
+    reader = FileReader(output)
+
+    # WHEN / THEN
+    with pytest.raises(ValueError, match="can't be negative"):
+        reader.get_snapshot_at(-1)
+    with pytest.raises(TypeError, match="not str"):
+        reader.get_snapshot_at("37m")
+
+
+def test_snapshot_diff_matches_locations_across_captures(tmp_path):
+    # GIVEN
+    def allocate(output, count):
+        allocators = [MemoryAllocator() for _ in range(count)]
+        with Tracker(output):
+            for allocator in allocators:
+                allocator.valloc(1024 * 1024)
+            for allocator in allocators:
+                allocator.free()
+
+    baseline = tmp_path / "baseline.bin"
+    candidate = tmp_path / "candidate.bin"
+    allocate(baseline, 1)
+    allocate(candidate, 3)
+
+    # WHEN
+    records = compute_snapshot_diff(FileReader(baseline), FileReader(candidate))
+
+    # THEN
+    (record,) = [
+        record
+        for record in records
+        if record.stack_trace and record.stack_trace[0][0] == "valloc"
+    ]
+    assert (record.size_before, record.n_allocations_before) == (1024 * 1024, 1)
+    assert (record.size_after, record.n_allocations_after) == (3 * 1024 * 1024, 3)
+    assert record.stack_trace[1][0] == "allocate"
+    # The biggest change comes first.
+    assert records[0] == record
+
+
+def test_snapshot_diff_of_leaks(tmp_path):
+    # GIVEN
+    baseline = tmp_path / "baseline.bin"
+    candidate = tmp_path / "candidate.bin"
+    freed = MemoryAllocator()
+    leaked = MemoryAllocator()
+
+    with Tracker(baseline):
+        freed.valloc(1024)
+        freed.free()
+    with Tracker(candidate):
+        leaked.valloc(1024)
+
+    # WHEN
+    records = compute_snapshot_diff(
+        FileReader(baseline), FileReader(candidate), leaks=True
+    )
+
+    # THEN
+    vallocs = [
+        record
+        for record in records
+        if record.stack_trace and record.stack_trace[0][0] == "valloc"
+    ]
+    assert [(record.size_before, record.size_after) for record in vallocs] == [
+        (0, 1024)
+    ]
+
+
+def _live_memory(snapshot):
+    return sorted(
+        (
+            record.tid,
+            record.size,
+            record.n_allocations,
+            tuple(record.stack_trace()),
+            tuple(record.native_stack_trace()),
+        )
+        for record in snapshot
+    )
+
+
+def test_slice_keeps_the_allocations_alive_when_it_starts(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    sliced = tmp_path / "slice.bin"
+    write_synthetic_capture(
+        output,
+        allocations=6000,
+        threads=3,
+        mean_lifetime=500,
+        leak_fraction=0.1,
+        native_traces=True,
+        dlopen_churn=3,
+    )
+    reader = FileReader(output)
+    start_live = list(reader.get_snapshot_at(2000))
+    n_live = sum(record.n_allocations for record in start_live)
+
+    # WHEN
+    written = reader.write_slice(sliced, start=2000, end=5000)
+
+    # THEN
+    assert written == n_live + 3000
+    slice_reader = FileReader(sliced)
+    assert len(list(slice_reader.get_allocation_records())) == written
+    assert slice_reader.metadata.start_time == reader.metadata.start_time
+    assert _live_memory(
+        slice_reader.get_leaked_allocation_records(merge_threads=False)
+    ) == _live_memory(reader.get_snapshot_at(5000, merge_threads=False))
+
+
+@pytest.mark.parametrize("timestamps", [True, False])
+def test_slice_by_time(tmp_path, timestamps):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    sliced = tmp_path / "slice.bin"
+    before = MemoryAllocator()
+    during = MemoryAllocator()
+    after = MemoryAllocator()
+
+    with Tracker(output, timestamps=timestamps):
+        before.valloc(1024)
+        time.sleep(0.2)
+        during.valloc(2048)
+        time.sleep(0.2)
+        after.valloc(4096)
+        before.free()
+        during.free()
+        after.free()
+
+    reader = FileReader(output)
+
+    # WHEN
+    reader.write_slice(
+        sliced, start=timedelta(milliseconds=100), end=timedelta(milliseconds=300)
+    )
+
+    # THEN
+    vallocs = [
+        record.size
+        for record in FileReader(sliced).get_allocation_records()
+        if record.allocator == AllocatorType.VALLOC
+    ]
+    assert vallocs == [1024, 2048]
+
+
+def test_compact_drops_short_lived_allocations(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    compacted = tmp_path / "compact.bin"
+    write_synthetic_capture(
+        output,
+        allocations=10_000,
+        threads=3,
+        functions=2000,
+        mean_lifetime=100,
+        leak_fraction=0.05,
+        mmap_fraction=0.01,
+    )
+    reader = FileReader(output)
+
+    # WHEN
+    written = reader.write_compacted(compacted, max_lifetime=1000)
+
+    # THEN
+    compacted_reader = FileReader(compacted)
+    assert written < reader.metadata.total_allocations / 2
+    assert compacted_reader.metadata.total_allocations == written
+    assert compacted_reader.metadata.total_frames < reader.metadata.total_frames
+    assert _live_memory(
+        compacted_reader.get_leaked_allocation_records(merge_threads=False)
+    ) == _live_memory(reader.get_leaked_allocation_records(merge_threads=False))
+    thread_names = {
+        record.thread_name for record in reader.get_allocation_records()
+    }
+    assert {
+        record.thread_name for record in compacted_reader.get_allocation_records()
+    } == thread_names
+
+
+def test_compact_without_max_lifetime_keeps_every_allocation(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    compacted = tmp_path / "compact.bin"
+    write_synthetic_capture(output, allocations=1000, leak_fraction=0.5)
+    reader = FileReader(output)
+
+    # WHEN
+    written = reader.write_compacted(compacted, max_lifetime=0)
+
+    # THEN
+    assert written == reader.metadata.total_allocations
+    assert [
+        (record.tid, record.address, record.size, record.allocator)
+        for record in FileReader(compacted).get_allocation_records()
+    ] == [
+        (record.tid, record.address, record.size, record.allocator)
+        for record in reader.get_allocation_records()
+    ]
+
+
+def test_rewriting_refuses_to_overwrite_the_capture(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    with Tracker(output):
+        pass
+    reader = FileReader(output)
+
+    # WHEN / THEN
+    with pytest.raises(ValueError, match="Can't overwrite the capture being read"):
+        reader.write_compacted(output, overwrite=True)
+    assert FileReader(output).metadata.total_allocations == 0
+
+
+def _snapshot_key(records):
+    return sorted(
+        (record.tid, record.size, record.n_allocations, record.stack_trace())
+        for record in records
+    )
+
+
+@pytest.mark.parametrize("merge_threads", [True, False])
+def test_spilling_snapshots_match_the_in_memory_ones(tmp_path, merge_threads):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    spill_directory = tmp_path / "spill"
+    spill_directory.mkdir()
+    write_synthetic_capture(
+        output,
+        allocations=5000,
+        threads=3,
+        leak_fraction=0.2,
+        mmap_fraction=0.1,
+    )
+    in_memory = FileReader(output)
+
+    # WHEN
+    spilling = FileReader(output, spill_directory=spill_directory)
+
+    # THEN
+    assert spilling.metadata.peak_memory == in_memory.metadata.peak_memory
+    assert _snapshot_key(
+        spilling.get_high_watermark_allocation_records(merge_threads=merge_threads)
+    ) == _snapshot_key(
+        in_memory.get_high_watermark_allocation_records(merge_threads=merge_threads)
+    )
+    assert _snapshot_key(
+        spilling.get_leaked_allocation_records(merge_threads=merge_threads)
+    ) == _snapshot_key(
+        in_memory.get_leaked_allocation_records(merge_threads=merge_threads)
+    )
+    assert _snapshot_key(
+        spilling.get_snapshot_at(2500, merge_threads=merge_threads)
+    ) == _snapshot_key(in_memory.get_snapshot_at(2500, merge_threads=merge_threads))
+    assert list(spill_directory.iterdir()) == []
+
+
+def test_spilling_reports_a_missing_spill_directory(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    write_synthetic_capture(output, allocations=100)
+
+    # WHEN / THEN
+    with pytest.raises(OSError, match="spill file"):
+        FileReader(output, spill_directory=tmp_path / "missing")
+
+
+def test_multi_file_reader_adds_up_the_snapshots_of_every_capture(tmp_path):
+    # GIVEN
+    outputs = [tmp_path / f"test.bin.{index}" for index in range(3)]
+    for seed, output in enumerate(outputs):
+        write_synthetic_capture(output, allocations=2000, leak_fraction=0.2, seed=seed)
+    readers = [FileReader(output) for output in outputs]
+
+    # WHEN
+    with MultiFileReader(outputs) as reader:
+        peak = reader.get_high_watermark_allocation_records()
+        leaks = reader.get_leaked_allocation_records()
+        metadata = reader.metadata
+        memory_records = list(reader.get_memory_records())
+
+    # THEN
+    assert sum(record.size for record in peak) == sum(
+        reader.metadata.peak_memory for reader in readers
+    )
+    assert metadata.peak_memory == sum(
+        reader.metadata.peak_memory for reader in readers
+    )
+    assert sum(record.size for record in leaks) == sum(
+        record.size
+        for reader in readers
+        for record in reader.get_leaked_allocation_records()
+    )
+    assert metadata.total_allocations == sum(
+        reader.metadata.total_allocations for reader in readers
+    )
+    # The captures share their frames, so their locations are merged.
+    assert len(leaks) == len({tuple(record.stack_trace) for record in leaks})
+    assert [record.size for record in leaks] == sorted(
+        (record.size for record in leaks), reverse=True
+    )
+    times = [record.time for record in memory_records]
+    assert times == sorted(set(times))
+    assert set(times) >= {
+        record.time for reader in readers for record in reader.get_memory_records()
+    }
+
+
+def test_multi_file_reader_reports_missing_captures(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    with Tracker(output):
+        pass
+
+    # WHEN / THEN
+    with pytest.raises(OSError, match="Could not open file"):
+        MultiFileReader([output, tmp_path / "missing.bin"])
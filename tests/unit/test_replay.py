@@ -0,0 +1,101 @@
+import threading
+
+import pytest
+
+from memray import FileReader
+from memray import Tracker
+from memray._memray import MemoryAllocator
+from memray._memray import MmapAllocator
+from memray._memray import replay_allocations
+from memray._test import write_synthetic_capture
+
+
+@pytest.mark.parametrize("preserve_order", [True, False])
+def test_replay_synthetic_capture(tmp_path, preserve_order):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    write_synthetic_capture(
+        output, allocations=10_000, threads=3, leak_fraction=0.1, mmap_fraction=0
+    )
+    reader = FileReader(output)
+    n_records = sum(1 for _ in reader.get_allocation_records())
+    leaked_bytes = sum(
+        record.size
+        for record in reader.get_leaked_allocation_records(merge_threads=False)
+    )
+
+    # WHEN
+    stats = replay_allocations(output, preserve_order=preserve_order)
+
+    # THEN
+    assert stats["threads"] == 3
+    assert stats["operations"] == n_records
+    assert stats["skipped_records"] == 0
+    assert stats["failed_allocations"] == 0
+    assert stats["final_live_bytes"] == leaked_bytes
+    assert stats["peak_live_bytes"] >= leaked_bytes
+    assert stats["seconds"] > 0
+
+
+def test_replay_preserving_order_reaches_the_same_peak(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    write_synthetic_capture(output, allocations=10_000, threads=4, mmap_fraction=0)
+    peak_bytes = sum(
+        record.size
+        for record in FileReader(output).get_high_watermark_allocation_records(
+            merge_threads=False
+        )
+    )
+
+    # WHEN
+    stats = replay_allocations(output, preserve_order=True)
+
+    # THEN
+    assert stats["peak_live_bytes"] == peak_bytes
+    assert stats["final_live_bytes"] == 0
+
+
+def test_replay_reallocations_and_partial_unmaps(tmp_path):
+    # GIVEN
+    output = tmp_path / "test.bin"
+    page = 4096
+    # Keep the threads alive until all are done, so that they get different ids
+    barrier = threading.Barrier(4)
+
+    def work():
+        allocator = MemoryAllocator()
+        for size in range(100, 1100):
+            allocator.realloc(size)
+        allocator.free()
+        mapping = MmapAllocator(10 * page)
+        mapping.munmap(page, page)
+        barrier.wait()
+
+    with Tracker(output, trace_python_allocators=True):
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+    # WHEN
+    stats = replay_allocations(output, preserve_order=True)
+
+    # THEN
+    assert stats["threads"] >= 4
+    assert stats["operations"] >= 4 * 1000
+    assert stats["failed_allocations"] == 0
+    # The Python allocator records are skipped
+    assert stats["skipped_records"] > 0
+    # Every thread leaks the 9 pages of its mapping that weren't unmapped
+    assert stats["final_live_bytes"] >= 4 * 9 * page
+
+
+def test_replay_missing_file(tmp_path):
+    # GIVEN
+    output = tmp_path / "does-not-exist.bin"
+
+    # WHEN/THEN
+    with pytest.raises(OSError, match="No such file"):
+        replay_allocations(output)
@@ -4,6 +4,8 @@ from typing import Tuple
 import pytest
 
 from memray import AllocatorType as AT
+from memray import Metadata
+from memray.reporters.stats import describe_dropped_allocations
 from memray.reporters.stats import draw_histogram
 from memray.reporters.stats import get_allocator_type_distribution
 from memray.reporters.stats import get_histogram_databins
@@ -395,3 +397,43 @@ def test_draw_histogram_invalid_input():
     # test#3 - Invalid hist_scale_factor value
     with pytest.raises(ValueError):
         _ = draw_histogram([100, 200, 300], bins=5, hist_scale_factor=0)
+
+
+def _metadata(**dropped):
+    return Metadata(
+        start_time=None,
+        end_time=None,
+        total_allocations=0,
+        total_frames=0,
+        peak_memory=0,
+        command_line="",
+        pid=0,
+        python_allocator="pymalloc",
+        has_native_traces=False,
+        **dropped,
+    )
+
+
+def test_describe_dropped_allocations_without_filters():
+    # GIVEN
+    metadata = _metadata()
+
+    # WHEN
+    description = describe_dropped_allocations(metadata)
+
+    # THEN
+    assert description is None
+
+
+def test_describe_dropped_allocations():
+    # GIVEN
+    metadata = _metadata(dropped_by_size=10, dropped_by_thread=2)
+
+    # WHEN
+    description = describe_dropped_allocations(metadata)
+
+    # THEN
+    assert description == (
+        "12 allocations were not recorded because of capture filters "
+        "(10 below the minimum size, 2 from excluded threads)"
+    )
@@ -10,7 +10,18 @@ from memray.reporters.templates import get_report_title
         ("flamegraph", True, "flamegraph report (memory leaks)"),
         ("table", False, "table report"),
         ("table", True, "table report (memory leaks)"),
+        ("temporal_flamegraph", False, "temporal flamegraph report"),
+        ("diff_flamegraph", False, "diff flamegraph report"),
     ],
 )
 def test_title_for_regular_report(kind, show_memory_leaks, expected):
     assert get_report_title(kind=kind, show_memory_leaks=show_memory_leaks) == expected
+
+
+def test_title_for_snapshot_at_report():
+    title = get_report_title(
+        kind="table",
+        show_memory_leaks=False,
+        snapshot_at="after 100 allocation records",
+    )
+    assert title == "table report (memory after 100 allocation records)"
@@ -6,6 +6,8 @@ module.exports = {
   entry: {
     flamegraph: "./src/memray/reporters/assets/flamegraph.js",
     table: "./src/memray/reporters/assets/table.js",
+    temporal_flamegraph: "./src/memray/reporters/assets/temporal_flamegraph.js",
+    diff_flamegraph: "./src/memray/reporters/assets/diff_flamegraph.js",
   },
   output: {
     path: path.resolve("src/memray/reporters/templates/assets"),